@@ -0,0 +1,107 @@
+/*
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see http://www.gnu.org/licenses/.
+*/
+/* -.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.
+* File Name : benchmarkDaeScaling.cpp
+* Creation Date : 17-10-2026
+_._._._._._._._._._._._._._._._._._._._._.*/
+
+// Measures how the electrical equation system scales with the number of cells. The pack consists of a serial
+// string of blocks with two cells in parallel, which yields one algebraic equation per block.
+
+#include "../src/misc/matrixInclude.h"
+
+#include <boost/shared_ptr.hpp>
+#include <boost/date_time.hpp>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#include "../src/electrical/capacity.h"
+#include "../src/electrical/ohmicresistance.h"
+#include "../src/electrical/parallelrc.h"
+#include "../src/electrical/paralleltwoport.h"
+#include "../src/electrical/serialtwoport.h"
+#include "../src/object/const_obj.h"
+#include "../src/system/stateSystemGroup.h"
+#include "../src/system/system.h"
+
+boost::shared_ptr< electrical::SerialTwoPort<> > GenerateCell( double resistance )
+{
+    boost::shared_ptr< electrical::SerialTwoPort<> > cell( new electrical::SerialTwoPort<>() );
+    cell->AddChild( new electrical::OhmicResistance<>( new object::ConstObj< double >( resistance ) ) );
+    cell->AddChild( new electrical::ParallelRC<>( new object::ConstObj< double >( 0.01 ), new object::ConstObj< double >( 10.0 ) ) );
+    cell->AddChild( new electrical::Capacity<>( new object::ConstObj< double >( 7200.0 ) ) );
+    return cell;
+}
+
+boost::shared_ptr< electrical::SerialTwoPort<> > GeneratePack( size_t parallelBlocks )
+{
+    boost::shared_ptr< electrical::SerialTwoPort<> > pack( new electrical::SerialTwoPort<>() );
+    for ( size_t i = 0; i < parallelBlocks; ++i )
+    {
+        boost::shared_ptr< electrical::ParallelTwoPort<> > block( new electrical::ParallelTwoPort<>() );
+        block->AddChild( GenerateCell( 0.001 ) );
+        block->AddChild( GenerateCell( 0.0012 ) );
+        pack->AddChild( block );
+    }
+    return pack;
+}
+
+void PerformTest( size_t parallelBlocks, size_t cycleCount )
+{
+    boost::shared_ptr< electrical::SerialTwoPort<> > pack( GeneratePack( parallelBlocks ) );
+
+    systm::StateSystemGroup< myMatrixType > stateSystemGroup;
+    pack->SetSystem( &stateSystemGroup );
+    stateSystemGroup.Initialize();
+    pack->SetInitialCurrent( 10.0 );
+    pack->UpdateStateSystemGroup();
+
+    systm::System< myMatrixType > system( &stateSystemGroup, 0.0 );
+
+    boost::posix_time::ptime start = boost::posix_time::microsec_clock::local_time();
+    for ( size_t i = 0; i < cycleCount; ++i )
+    {
+        pack->SetCurrent( ( i % 2 ) ? 10.0 : -10.0 );
+        pack->UpdateStateSystemGroup();
+        system.Solve();
+        pack->CalculateStateDependentValues();
+    }
+    boost::posix_time::time_duration duration = boost::posix_time::microsec_clock::local_time() - start;
+
+    const double seconds = static_cast< double >( duration.total_microseconds() ) / 1000000.0;
+    std::cout << 2 * parallelBlocks << ";" << stateSystemGroup.GetStateCount() << ";" << seconds << ";"
+              << seconds / cycleCount << std::endl;
+}
+
+int main( int argc, char *argv[] )
+{
+    if ( argc < 3 )
+    {
+        std::cout << "Command [cycles] [cellcount] [cellcount] ..." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    const size_t cycleCount = atoi( argv[1] );
+
+    std::cout << "cells;states;total time [s];time per step [s]" << std::endl;
+    for ( int i = 2; i < argc; ++i )
+    {
+        const size_t cellCount = atoi( argv[i] );
+        PerformTest( ( cellCount + 1 ) / 2, cycleCount );
+    }
+
+    return EXIT_SUCCESS;
+}
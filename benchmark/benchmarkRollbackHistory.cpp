@@ -0,0 +1,116 @@
+/*
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see http://www.gnu.org/licenses/.
+*/
+/* -.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.
+* File Name : benchmarkRollbackHistory.cpp
+* Creation Date : 17-10-2026
+_._._._._._._._._._._._._._._._._._._._._.*/
+
+// Measures memory and time of the state history that ElectricalSimulation keeps for the reset by the thermal stop
+// criterion. Every electrical step of one coupling interval is stored, then the states are looked up at a point of time
+// in the middle of the interval. The unbounded history, which stores every step and scans it linearly, is the reference.
+
+#include <boost/date_time.hpp>
+#include <boost/shared_ptr.hpp>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#include "../src/thermal/state_history.h"
+
+struct SocValue
+{
+    double GetValue() const { return mValue; }
+    double mValue;
+};
+
+double Seconds( const boost::posix_time::ptime &start )
+{
+    const boost::posix_time::time_duration duration = boost::posix_time::microsec_clock::local_time() - start;
+    return static_cast< double >( duration.total_microseconds() ) / 1000000.0;
+}
+
+void PerformTest( size_t stateCount, size_t stepCount, size_t capacity )
+{
+    std::vector< double > states( stateCount, 0.0 );
+    std::vector< boost::shared_ptr< SocValue > > socStates;
+    for ( size_t i = 0; i < 16; ++i )
+    {
+        socStates.push_back( boost::shared_ptr< SocValue >( new SocValue ) );
+        socStates.back()->mValue = 50.0;
+    }
+    const double resetTime = 0.5 * stepCount;
+
+    // Unbounded history
+    boost::posix_time::ptime start = boost::posix_time::microsec_clock::local_time();
+    std::vector< double > times;
+    std::vector< std::vector< double > > statesSteps;
+    std::vector< std::vector< double > > socValuesSteps;
+    for ( size_t i = 0; i < stepCount; ++i )
+    {
+        states[0] = static_cast< double >( i );
+        times.push_back( static_cast< double >( i ) );
+        statesSteps.push_back( states );
+        socValuesSteps.push_back( std::vector< double >( socStates.size() ) );
+        for ( size_t j = 0; j < socStates.size(); ++j )
+            socValuesSteps.back()[j] = socStates[j]->GetValue();
+    }
+    size_t unboundedIndex = 0;
+    for ( size_t i = 1; i < times.size(); ++i )
+        if ( times[i] > resetTime )
+        {
+            unboundedIndex = i - 1;
+            break;
+        }
+    const double unboundedSeconds = Seconds( start );
+    const double unboundedMegabytes = static_cast< double >( stepCount * ( stateCount + socStates.size() + 1 ) ) * 8.0 / 1.0e6;
+
+    // Bounded history
+    start = boost::posix_time::microsec_clock::local_time();
+    simulation::StateHistory< std::vector< double > > history( capacity );
+    for ( size_t i = 0; i < stepCount; ++i )
+    {
+        states[0] = static_cast< double >( i );
+        history.Add( static_cast< double >( i ), states, socStates );
+    }
+    const size_t boundedIndex = history.FindIndex( resetTime );
+    const double boundedSeconds = Seconds( start );
+    const double boundedMegabytes =
+     static_cast< double >( std::min( stepCount, capacity ) * ( stateCount + socStates.size() + 1 ) ) * 8.0 / 1.0e6;
+
+    // Distance of the point of time found to the reset time is the time resolution of the reset
+    std::cout << stateCount << ";" << stepCount << ";" << capacity << ";" << unboundedMegabytes << ";" << boundedMegabytes
+              << ";" << unboundedSeconds << ";" << boundedSeconds << ";" << resetTime - times[unboundedIndex] << ";"
+              << resetTime - history.GetTime( boundedIndex ) << std::endl;
+}
+
+int main( int argc, char *argv[] )
+{
+    if ( argc < 4 )
+    {
+        std::cout << "Command [states] [capacity] [steps] [steps] ..." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    const size_t stateCount = atoi( argv[1] );
+    const size_t capacity = atoi( argv[2] );
+
+    std::cout << "states;steps;capacity;unbounded [MB];bounded [MB];unbounded time [s];bounded time [s];unbounded "
+                 "resolution [s];bounded resolution [s]"
+              << std::endl;
+    for ( int i = 3; i < argc; ++i )
+        PerformTest( stateCount, atoi( argv[i] ), capacity );
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,136 @@
+/*
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see http://www.gnu.org/licenses/.
+*/
+/* -.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.
+* File Name : benchmarkThermalScaling.cpp
+* Creation Date : 17-10-2026
+_._._._._._._._._._._._._._._._._._._._._.*/
+
+// Measures how Update() and the right-hand side of OdeSystemThermal scale with the number of threads. The mesh is a
+// single rectangular block with a heated block on top, so that the thermal elements have conductivities, coolings and
+// power dissipation. The results of every thread count are compared to the sequential ones.
+
+#include "../src/misc/matrixInclude.h"
+
+#include <boost/date_time.hpp>
+#include <boost/shared_ptr.hpp>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#include "../src/thermal/blocks/rectangular_block.h"
+#include "../src/thermal/ode_system_thermal.h"
+#include "../src/thermal/thermal_model.h"
+
+using namespace thermal;
+using namespace geometry;
+
+boost::shared_ptr< OdeSystemThermal<> > GenerateOdeSystem( size_t elementsPerEdge, const Material<> *material,
+                                                           vector< shared_ptr< ::state::ThermalState<> > > &thermalStates )
+{
+    RectangularBlock<> block( "Block", Cartesian<>( 0.0, 0.0, 0.0 ), 0.2, 0.2, 0.05, elementsPerEdge, elementsPerEdge,
+                              elementsPerEdge / 4 + 1, material, 25.0 );
+    RectangularBlock<> heater( "Heater", Cartesian<>( 0.05, 0.05, 0.05 ), 0.1, 0.1, 0.01, 2, 2, 1, material, 25.0,
+                               thermalStates );
+
+    ThermalModel<> thermalModel( Tolerance<>( 0.000001, Angle<>::Deg( 0.001 ), 0.1 ), ThermalModel<>::AGGREGATE_BY_PLANE_AND_BLOCKS );
+    vector< shared_ptr< ThermalElement<> > > thermalElements;
+    vector< vector< IndexedValue< double > > > conductivityMatrix;
+    vector< IndexedArea< double > > surfaceElements;
+    shared_ptr< BlockGeometry<> > blockGeometry;
+    block.CreateData( thermalElements, conductivityMatrix, surfaceElements, blockGeometry );
+    thermalModel.AddBlock( thermalElements, conductivityMatrix, surfaceElements, blockGeometry );
+    heater.CreateData( thermalElements, conductivityMatrix, surfaceElements, blockGeometry );
+    thermalModel.AddBlock( thermalElements, conductivityMatrix, surfaceElements, blockGeometry );
+
+    vector< vector< TaylorData< double > > > coolingDataVector;
+    vector< vector< TaylorData< double > > > dirichletDataVector;
+    thermalModel.CreateDataByFusingBlocks( thermalElements, conductivityMatrix, coolingDataVector, dirichletDataVector );
+
+    vector< shared_ptr< DefaultConvection<> > > convection( 3 );
+    convection.at( TOP ) = shared_ptr< DefaultConvection<> >( new ConvectionByFormula<>( 0.71 ) );
+    convection.at( SIDE ) = shared_ptr< DefaultConvection<> >( new ConvectionByFormula<>( 0.548 ) );
+    shared_ptr< Radiation<> > radiation( new Radiation<> );
+
+    return boost::shared_ptr< OdeSystemThermal<> >(
+     new OdeSystemThermal<>( thermalElements, conductivityMatrix, coolingDataVector, dirichletDataVector, convection,
+                             radiation, 20.0, thermalStates ) );
+}
+
+/// Runs cycleCount updates and right-hand side evaluations and returns the duration in seconds
+double RunCycles( OdeSystemThermal<> &odeSystem, size_t cycleCount, vector< double > &dxdt )
+{
+    vector< double > temperatures;
+    odeSystem.GetTemperatureVector( temperatures );
+    dxdt.resize( temperatures.size() );
+
+    boost::posix_time::ptime start = boost::posix_time::microsec_clock::local_time();
+    for ( size_t i = 0; i < cycleCount; ++i )
+    {
+        odeSystem.Update( static_cast< double >( i + 1 ), 1.0 );
+        odeSystem( temperatures, dxdt, 0.0 );
+    }
+    boost::posix_time::time_duration duration = boost::posix_time::microsec_clock::local_time() - start;
+
+    return static_cast< double >( duration.total_microseconds() ) / 1000000.0;
+}
+
+void PerformTest( size_t elementsPerEdge, size_t cycleCount, const vector< size_t > &threadCounts )
+{
+    Material<> material( 2500.0, 1000.0, 50.0, 50.0, 5.0 );
+    vector< shared_ptr< ::state::ThermalState<> > > thermalStates( 1 );
+    thermalStates.at( 0 ).reset( new ::state::ThermalState<> );
+    thermalStates.at( 0 )->SetFixedPowerDissipation( 10.0 );
+
+    vector< double > sequentialDxdt;
+    double sequentialSeconds = 0.0;
+    {
+        boost::shared_ptr< OdeSystemThermal<> > odeSystem( GenerateOdeSystem( elementsPerEdge, &material, thermalStates ) );
+        sequentialSeconds = RunCycles( *odeSystem, cycleCount, sequentialDxdt );
+        std::cout << odeSystem->GetOdeSystemSize() << ";1;" << sequentialSeconds << ";1;1" << std::endl;
+    }
+
+    for ( size_t i = 0; i < threadCounts.size(); ++i )
+    {
+        if ( threadCounts[i] <= 1 )
+            continue;
+
+        boost::shared_ptr< OdeSystemThermal<> > odeSystem( GenerateOdeSystem( elementsPerEdge, &material, thermalStates ) );
+        odeSystem->SetNumberOfThreads( threadCounts[i] );
+        vector< double > dxdt;
+        const double seconds = RunCycles( *odeSystem, cycleCount, dxdt );
+        std::cout << odeSystem->GetOdeSystemSize() << ";" << threadCounts[i] << ";" << seconds << ";"
+                  << sequentialSeconds / seconds << ";" << ( dxdt == sequentialDxdt ) << std::endl;
+    }
+}
+
+int main( int argc, char *argv[] )
+{
+    if ( argc < 4 )
+    {
+        std::cout << "Command [cycles] [elements per edge] [threads] [threads] ..." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    const size_t cycleCount = atoi( argv[1] );
+    const size_t elementsPerEdge = atoi( argv[2] );
+    vector< size_t > threadCounts;
+    for ( int i = 3; i < argc; ++i )
+        threadCounts.push_back( atoi( argv[i] ) );
+
+    std::cout << "finite volumes;threads;total time [s];speedup;identical to sequential" << std::endl;
+    PerformTest( elementsPerEdge, cycleCount, threadCounts );
+
+    return EXIT_SUCCESS;
+}
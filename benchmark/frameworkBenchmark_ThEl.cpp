@@ -127,6 +127,8 @@ int main( int argc, char *argv[] )
         electricalSimulation.reset(
          new simulation::ElectricalSimulation< myMatrixType, double >( rootXmlNode, stepTime, stepTime * cycleCount,
                                                                        socStopCriterion, &cells ) );
+        if ( !electricalSimulation->IsStateSystemStampCompiled() )
+            printf( "Not all electrical elements support the compiled stamp, the equations are assembled in each step\n" );
         electricalObserver.reset( CreateTwoPortObserver< std::vector< TwoPort_t >, myMatrixType, true >( cells, rootXmlNode.get() ) );
         electricalObserver->AddFilter( new observer::CsvFilterTwoPort< myMatrixType >( "electricalStates.csv" ) );
 
@@ -159,11 +161,12 @@ int main( int argc, char *argv[] )
     //{
     // Output conductivity matrix
     std::ofstream fileConduction( "Conductivity.csv" );
-    BOOST_FOREACH ( const std::vector< thermal::IndexedValue< double > > &line,
-                    thermalSimulation->mThermalSystem->GetA_th_Conductivity() )
+    const thermal::JaggedArray< thermal::IndexedValue< double > > &conductivity =
+     thermalSimulation->mThermalSystem->GetA_th_Conductivity();
+    for ( size_t i = 0; i < conductivity.GetNumberOfArrays(); ++i )
     {
-        BOOST_FOREACH ( const thermal::IndexedValue< double > &indexedValue, line )
-            fileConduction << indexedValue.mIndex << ", " << indexedValue.mValue << "; ";
+        for ( const thermal::IndexedValue< double > *it = conductivity.Begin( i ); it != conductivity.End( i ); ++it )
+            fileConduction << it->mIndex << ", " << it->mValue << "; ";
         fileConduction << std::endl;
     }
 
@@ -178,8 +181,6 @@ int main( int argc, char *argv[] )
     ofstream AllGridVerticesTemperatures( "AllGridVerticesTemperatures.csv" );
 
     // Equation solvers
-    boost::numeric::odeint::result_of::make_controlled< boost::numeric::odeint::runge_kutta_cash_karp54< vector< double > > >::type stepperThermal =
-     make_controlled( 1.0e-10, 1.0e-10, boost::numeric::odeint::runge_kutta_cash_karp54< vector< double > >() );
 #if defined( _ARMADILLO_ ) && not defined( SPARSE_MATRIX_FORMAT )
     boost::numeric::odeint::result_of::make_controlled< boost::numeric::odeint::runge_kutta_cash_karp54< myMatrixType > >::type stepperElectrical =
      make_controlled( 1.0e-10, 1.0e-10, boost::numeric::odeint::runge_kutta_cash_karp54< myMatrixType >() );
@@ -276,9 +277,7 @@ int main( int argc, char *argv[] )
             }
 
             // Run thermal equation solver
-            while ( stepperThermal.try_step( boost::ref( *thermalSimulation->mThermalSystem ),
-                                             thermalSimulation->mTemperatures, thermalSimulation->mTime,
-                                             thermalSimulation->mDeltaTime ) != boost::numeric::odeint::success )
+            while ( !thermalSimulation->TryThermalStep() )
             {
             }
 
@@ -0,0 +1,105 @@
+/*
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see http://www.gnu.org/licenses/.
+*/
+/* -.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.
+* File Name : matio_chunked_data.cpp
+* Creation Date : 17-10-2026
+_._._._._._._._._._._._._._._._._._._._._.*/
+
+#include "matio_chunked_data.h"
+
+// STD
+#include <cstdio>
+
+// ETC
+#include "../exceptions/error_proto.h"
+
+namespace matlab
+{
+
+MatioChunkedData::MatioChunkedData( std::string name, std::string fileName, size_t rows, size_t chunkSize )
+    : mName( name )
+    , mFileName( fileName )
+    , mRows( rows )
+    , mNumberOfBufferedValues( 0 )
+    , mNumberOfValues( 0 )
+{
+    if ( chunkSize < 1 )
+        ErrorFunction< std::runtime_error >( __FUNCTION__, __LINE__, __FILE__, "MatlabFilterChunkSizeNotPositive" );
+
+    mChunk.resize( rows * chunkSize );
+    mFile.open( mFileName.c_str(), std::ios::out | std::ios::binary | std::ios::trunc );
+    if ( !mFile )
+        ErrorFunction< std::runtime_error >( __FUNCTION__, __LINE__, __FILE__, "MatioSpillFileNotWritable", mFileName.c_str() );
+}
+
+MatioChunkedData::~MatioChunkedData()
+{
+    mRegion.reset();
+    mMapping.reset();
+    if ( mFile.is_open() )
+        mFile.close();
+    std::remove( mFileName.c_str() );
+}
+
+void MatioChunkedData::Append( double value )
+{
+    mChunk[mNumberOfBufferedValues] = value;
+    ++mNumberOfBufferedValues;
+    ++mNumberOfValues;
+    if ( mNumberOfBufferedValues == mChunk.size() )
+        Flush();
+}
+
+void MatioChunkedData::Flush()
+{
+    if ( !mNumberOfBufferedValues )
+        return;
+
+    // Flushing the stream after each chunk keeps the spill file complete up to the last chunk if the simulation crashes
+    mFile.write( reinterpret_cast< const char * >( &mChunk[0] ), mNumberOfBufferedValues * sizeof( double ) );
+    mFile.flush();
+    if ( !mFile )
+        ErrorFunction< std::runtime_error >( __FUNCTION__, __LINE__, __FILE__, "MatioSpillFileNotWritable", mFileName.c_str() );
+    mNumberOfBufferedValues = 0;
+}
+
+size_t MatioChunkedData::GetNumberOfColumns() const
+{
+    if ( !mRows )
+        return 0;
+    return mNumberOfValues / mRows;
+}
+
+size_t MatioChunkedData::GetNumberOfRows() const { return mRows; }
+
+MatioData MatioChunkedData::GetMatioData()
+{
+    if ( !GetNumberOfColumns() )
+        ErrorFunction< std::runtime_error >( __FUNCTION__, __LINE__, __FILE__, "matioEmptyVariable" );
+
+    if ( !mRegion )
+    {
+        Flush();
+        mFile.close();
+        mChunk.clear();
+        mMapping.reset( new boost::interprocess::file_mapping( mFileName.c_str(), boost::interprocess::read_only ) );
+        mRegion.reset( new boost::interprocess::mapped_region( *mMapping, boost::interprocess::read_only ) );
+    }
+
+    // An incomplete last column is left out
+    return MatioData( static_cast< double * >( mRegion->get_address() ), mRows, GetNumberOfColumns(), mName );
+}
+
+} /* matlab */
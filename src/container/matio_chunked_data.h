@@ -0,0 +1,82 @@
+/*
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see http://www.gnu.org/licenses/.
+*/
+/* -.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.
+* File Name : matio_chunked_data.h
+* Creation Date : 17-10-2026
+_._._._._._._._._._._._._._._._._._._._._.*/
+#ifndef _MATIO_CHUNKED_DATA_
+#define _MATIO_CHUNKED_DATA_
+
+// STD
+#include <fstream>
+#include <string>
+#include <vector>
+
+// BOOST
+#include <boost/noncopyable.hpp>
+#include <boost/scoped_ptr.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+// ETC
+#include "matio_data.h"
+
+namespace matlab
+{
+
+/// Variable of a mat file that grows column by column during a simulation.
+/// The values are buffered in a chunk of chunkSize columns, full chunks are appended to a spill file, so the memory
+/// needed does not grow with the number of columns. The spill file is mapped for the final write into the mat file and
+/// removed afterwards. The values are stored column-major, like matlab does.
+/// This member should not be copied, due to ownership of the spill file --> boost::noncopyable
+struct MatioChunkedData : private boost::noncopyable
+{
+    /// \param name name of the variable inside the mat file e.g. diga.daten.StromVec
+    /// \param fileName spill file for the full chunks
+    /// \param rows number of values of one column
+    /// \param chunkSize number of columns that are buffered before they are appended to the spill file
+    MatioChunkedData( std::string name, std::string fileName, size_t rows, size_t chunkSize );
+
+    /// The destructor unmaps and removes the spill file
+    ~MatioChunkedData();
+
+    /// Append the next value, a column is complete after rows values
+    void Append( double value );
+
+    /// Number of complete columns
+    size_t GetNumberOfColumns() const;
+
+    size_t GetNumberOfRows() const;
+
+    /// Write the last chunk and map the spill file. The returned MatioData does not copy the values, it has to be
+    /// written before this object is destroyed. No values can be appended afterwards
+    MatioData GetMatioData();
+
+    private:
+    /// Append the buffered values to the spill file
+    void Flush();
+
+    const std::string mName;
+    const std::string mFileName;
+    const size_t mRows;
+    std::vector< double > mChunk;
+    size_t mNumberOfBufferedValues;
+    size_t mNumberOfValues;
+    std::ofstream mFile;
+    boost::scoped_ptr< boost::interprocess::file_mapping > mMapping;
+    boost::scoped_ptr< boost::interprocess::mapped_region > mRegion;
+};
+} /* matlab */
+#endif /* _MATIO_CHUNKED_DATA_ */
@@ -73,6 +73,12 @@ MatioData::MatioData( std::vector< std::vector< double > > &data, std::string na
     mMatlabVar = Mat_VarCreate( SetNames( name ).c_str(), MAT_C_DOUBLE, MAT_T_DOUBLE, 2, dims, &finalVec[0], 0 );
 }
 
+MatioData::MatioData( double *data, size_t rows, size_t columns, std::string name )
+{
+    size_t dims[2] = {rows, columns};
+    mMatlabVar = Mat_VarCreate( SetNames( name ).c_str(), MAT_C_DOUBLE, MAT_T_DOUBLE, 2, dims, data, MAT_F_DONT_COPY_DATA );
+}
+
 std::string MatioData::SetNames( std::string &name )
 {
     size_t found = name.find_last_of( "." );
@@ -56,6 +56,9 @@ struct MatioData
     MatioData( std::vector< double > &data, std::string name );
     /// Create Matio Data from a vector<vector>
     MatioData( std::vector< std::vector< double > > &data, std::string name );
+    /// Create Matio Data from column-major data with rows x columns values.
+    /// The data is not copied and has to outlive the write of the matfile
+    MatioData( double *data, size_t rows, size_t columns, std::string name );
 
 
     /// This function returns a slice of the matlab array as a dense vector
@@ -51,6 +51,10 @@ class Capacity : public ElectricalElement< T >
     virtual T* GetVoltage();    /// Returns Uc = 1
 
     virtual void SetSystem( systm::StateSystemGroup< T >* stateSystemGroup );
+#ifndef _SYMBOLIC_
+    virtual bool CompileStamp( TwoPortStamp< T >& stamp );
+    virtual void UpdateStampValues( std::vector< double >& values );
+#endif
 
     virtual const char* GetName() const;
 
@@ -63,6 +67,10 @@ class Capacity : public ElectricalElement< T >
 
     bool mVoltageSet;
 
+#ifndef _SYMBOLIC_
+    size_t mInverseCapacitySlot;
+#endif
+
     protected:
 };
 
@@ -72,6 +80,9 @@ Capacity< T >::Capacity( boost::shared_ptr< object::Object< double > > obj, cons
     , mUID( 0 )
     , mVoltageValue( T() )
     , mVoltageSet( false )
+#ifndef _SYMBOLIC_
+    , mInverseCapacitySlot( 0 )
+#endif
 {
 }
 
@@ -109,6 +120,25 @@ void Capacity< T >::SetSystem( systm::StateSystemGroup< T >* stateSystemGroup )
     mUID = stateSystemGroup->mDglStateSystem.GetNewEquation();
     TwoPort< T >::SetSystem( stateSystemGroup );
 }
+#ifndef _SYMBOLIC_
+template < typename T >
+bool Capacity< T >::CompileStamp( TwoPortStamp< T >& stamp )
+{
+    this->CompileCurrentStamp( stamp );
+    mInverseCapacitySlot = stamp.NewValue();
+    this->mVoltageStamp.push_back( StampTerm( mUID, STAMP_ONE, STAMP_ONE, 1.0 ) );
+    stamp.AddDglEquation( mUID, ScaleStampRow( this->mCurrentStamp, mInverseCapacitySlot ) );
+    return true;
+}
+
+template < typename T >
+void Capacity< T >::UpdateStampValues( std::vector< double >& values )
+{
+    TwoPort< T >::UpdateStampValues( values );
+    values[mInverseCapacitySlot] = 1.0 / this->GetValue();
+}
+#endif
+
 template < typename T >
 const char* Capacity< T >::GetName() const
 {
@@ -37,6 +37,9 @@ class ConstantPhaseElement : public ElectricalElement< T >
      typename TwoPort< T >::DataType dataValues = typename TwoPort< T >::DataType(new ElectricalDataStruct< ScalarUnit >));
     virtual ~ConstantPhaseElement(){};
     virtual T* GetVoltage();    ///< Abort the simulation
+#ifndef _SYMBOLIC_
+    virtual bool CompileStamp( TwoPortStamp< T >& stamp );    ///< Abort the simulation
+#endif
 
     virtual const char* GetName() const;
 
@@ -65,6 +68,15 @@ T* ConstantPhaseElement< T >::GetVoltage()
     return 0;
 }
 
+#ifndef _SYMBOLIC_
+template < typename T >
+bool ConstantPhaseElement< T >::CompileStamp( TwoPortStamp< T >& /* stamp */ )
+{
+    ErrorFunction< std::runtime_error >( __FUNCTION__, __LINE__, __FILE__, "NoSimulationPossible", GetName() );
+    return false;
+}
+#endif
+
 template < typename T >
 const char* ConstantPhaseElement< T >::GetName() const
 {
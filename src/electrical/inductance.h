@@ -35,6 +35,9 @@ class Inductance : public ElectricalElement< T >
                          typename TwoPort< T >::DataType dataValues = typename TwoPort< T >::DataType(new ElectricalDataStruct< ScalarUnit >));
     virtual ~Inductance(){};
     virtual T* GetVoltage();    ///< Abort the simulation
+#ifndef _SYMBOLIC_
+    virtual bool CompileStamp( TwoPortStamp< T >& stamp );    ///< Abort the simulation
+#endif
 
     virtual const char* GetName() const;
 
@@ -62,6 +65,15 @@ T* Inductance< T >::GetVoltage()
     return 0;
 }
 
+#ifndef _SYMBOLIC_
+template < typename T >
+bool Inductance< T >::CompileStamp( TwoPortStamp< T >& /* stamp */ )
+{
+    ErrorFunction< std::runtime_error >( __FUNCTION__, __LINE__, __FILE__, "NoSimulationPossible", GetName() );
+    return false;
+}
+#endif
+
 template < typename T >
 const char* Inductance< T >::GetName() const
 {
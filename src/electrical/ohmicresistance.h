@@ -40,17 +40,27 @@ class OhmicResistance : public ElectricalElement< T >
     virtual ~OhmicResistance(){};
 
     virtual T* GetVoltage();    ///< Returns i*R
+#ifndef _SYMBOLIC_
+    virtual bool CompileStamp( TwoPortStamp< T >& stamp );
+    virtual void UpdateStampValues( std::vector< double >& values );
+#endif
     virtual void CalculateStateDependentValues();
     virtual const char* GetName() const;
 
     private:
     protected:
+#ifndef _SYMBOLIC_
+    size_t mResistanceSlot;
+#endif
 };
 
 template < typename T >
 OhmicResistance< T >::OhmicResistance( boost::shared_ptr< object::Object< double > > obj, const bool observable,
                                        typename TwoPort< T >::DataType dataValues )
     : ElectricalElement< T >( obj, observable, dataValues )
+#ifndef _SYMBOLIC_
+    , mResistanceSlot( 0 )
+#endif
 {
 }
 
@@ -80,6 +90,24 @@ T* OhmicResistance< T >::GetVoltage()
     return TwoPort< T >::GetVoltage();
 }
 
+#ifndef _SYMBOLIC_
+template < typename T >
+bool OhmicResistance< T >::CompileStamp( TwoPortStamp< T >& stamp )
+{
+    this->CompileCurrentStamp( stamp );
+    mResistanceSlot = stamp.NewValue();
+    this->mVoltageStamp = ScaleStampRow( this->mCurrentStamp, mResistanceSlot );
+    return true;
+}
+
+template < typename T >
+void OhmicResistance< T >::UpdateStampValues( std::vector< double >& values )
+{
+    TwoPort< T >::UpdateStampValues( values );
+    values[mResistanceSlot] = this->GetValue();
+}
+#endif
+
 template < typename T >
 const char* OhmicResistance< T >::GetName() const
 {
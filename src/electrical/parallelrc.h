@@ -59,6 +59,10 @@ class ParallelRC : public ElectricalElement< T >
     virtual void SetCurrent( const T current );                ///< Sets the current
     virtual void SetCurrent( const ScalarUnit currentval );    ///< Sets the current value
     virtual void SetSystem( systm::StateSystemGroup< T >* stateSystemGroup );
+#ifndef _SYMBOLIC_
+    virtual bool CompileStamp( TwoPortStamp< T >& stamp );
+    virtual void UpdateStampValues( std::vector< double >& values );
+#endif
     virtual void CalculateStateDependentValues();
     virtual double GetValueC() const;    ///< Get Value of Object
 
@@ -77,6 +81,10 @@ class ParallelRC : public ElectricalElement< T >
 
     T mConstVoltageVector;
     T mDGLPart;
+#ifndef _SYMBOLIC_
+    size_t mResistanceByTauSlot;
+    size_t mInverseTauSlot;
+#endif
 
     protected:
 };
@@ -90,6 +98,10 @@ ParallelRC< T >::ParallelRC( boost::shared_ptr< object::Object< double > > objR,
     , mObjectTau( objC )
     , mConstVoltageVector( T() )
     , mDGLPart( T() )
+#ifndef _SYMBOLIC_
+    , mResistanceByTauSlot( 0 )
+    , mInverseTauSlot( 0 )
+#endif
 {
 }
 
@@ -143,6 +155,31 @@ void ParallelRC< T >::SetSystem( systm::StateSystemGroup< T >* stateSystemGroup
     TwoPort< T >::SetSystem( stateSystemGroup );
 }
 
+#ifndef _SYMBOLIC_
+template < typename T >
+bool ParallelRC< T >::CompileStamp( TwoPortStamp< T >& stamp )
+{
+    this->CompileCurrentStamp( stamp );
+    mResistanceByTauSlot = stamp.NewValue();
+    mInverseTauSlot = stamp.NewValue();
+    this->mVoltageStamp.push_back( StampTerm( mUID, STAMP_ONE, STAMP_ONE, 1.0 ) );
+
+    StampRow dglPart = ScaleStampRow( this->mCurrentStamp, mResistanceByTauSlot );
+    dglPart.push_back( StampTerm( mUID, mInverseTauSlot, STAMP_ONE, -1.0 ) );
+    stamp.AddDglEquation( mUID, dglPart );
+    return true;
+}
+
+template < typename T >
+void ParallelRC< T >::UpdateStampValues( std::vector< double >& values )
+{
+    TwoPort< T >::UpdateStampValues( values );
+    const double tau = GetTauValue();
+    values[mResistanceByTauSlot] = this->GetValue() / tau;
+    values[mInverseTauSlot] = 1.0 / tau;
+}
+#endif
+
 template < typename T >
 void ParallelRC< T >::CalculateStateDependentValues()
 {
@@ -51,6 +51,9 @@ class ParallelTwoPort : public TwoPortWithChild< T >
     size_t GetParallelChildren() const;    ///< Count the children of this TwoPort
 
     virtual T* GetVoltage();
+#ifndef _SYMBOLIC_
+    virtual bool CompileStamp( TwoPortStamp< T >& stamp );    ///< Records the voltage of the last child and the algebraic equations
+#endif
 
     virtual void SetSystem( systm::StateSystemGroup< T >* stateSystemGroup );    ///< For every child above 1 Increase the count of parallel UIDs
 
@@ -132,6 +135,36 @@ T* ParallelTwoPort< T >::GetVoltage()
     return TwoPort< T >::GetVoltage();
 }
 
+#ifndef _SYMBOLIC_
+template < typename T >
+bool ParallelTwoPort< T >::CompileStamp( TwoPortStamp< T >& stamp )
+{
+    if ( this->mChildren.empty() )
+        return false;
+
+    this->CompileCurrentStamp( stamp );
+    for ( size_t i = 0; i < this->mChildren.size(); ++i )
+        if ( !this->mChildren[i]->CompileStamp( stamp ) )
+            return false;
+
+    this->mVoltageStamp = this->mChildren.back()->GetVoltageStamp();
+    for ( size_t i = 1; i < this->mChildren.size() - 1; ++i )
+    {
+        StampRow equation( this->mVoltageStamp );
+        AddStampRow( equation, this->mChildren[i]->GetVoltageStamp(), -1.0 );
+        stamp.AddAlgEquation( mUIDs[i - 1], equation );
+    }
+
+    if ( this->mChildren.size() > 1 )
+    {
+        StampRow equation( this->mVoltageStamp );
+        AddStampRow( equation, this->mChildren[0]->GetVoltageStamp(), -1.0 );
+        stamp.AddAlgEquation( mUIDs.back(), equation );
+    }
+    return true;
+}
+#endif
+
 template < typename T >
 const char* ParallelTwoPort< T >::GetName() const
 {
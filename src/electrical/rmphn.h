@@ -42,36 +42,74 @@ class Rmphn : public SerialTwoPort< T >
                     typename SerialTwoPort< T >::DataType dataValues = typename SerialTwoPort< T >::DataType(new ElectricalDataStruct< ScalarUnit >))
         : SerialTwoPort< T >( observable, dataValues )
         , mR_Ct( rCtObj )
-        , mRMp( rMpObj ){};
+        , mRMp( rMpObj )
+#ifndef _SYMBOLIC_
+        , mSerialResistanceSlot( 0 )
+#endif
+    {
+    }
 
 
     virtual T* GetVoltage();    ///< returns the voltage over the RC element  Urc  = 1
+#ifndef _SYMBOLIC_
+    virtual bool CompileStamp( TwoPortStamp< T >& stamp );
+    virtual void UpdateStampValues( std::vector< double >& values );
+#endif
 
     virtual ~Rmphn(){};
 
     private:
+    double GetSerialResistance() const;    ///< Serial resistance at \omega = 0
+
     boost::shared_ptr< object::Object< double > > mR_Ct;    ///< This object decides the behaviour of the class, wheter it returns constant values or does a lookup
     boost::shared_ptr< object::Object< double > > mRMp;    ///< This object decides the behaviour of the class, wheter it returns constant values or does a lookup
+#ifndef _SYMBOLIC_
+    size_t mSerialResistanceSlot;
+#endif
     protected:
 };
 
 template < typename T >
-T* Rmphn< T >::GetVoltage()
+double Rmphn< T >::GetSerialResistance() const
 {
     const double r_CT = mR_Ct->GetValue();
     const double r_MP = mRMp->GetValue();
 
-    const double r_SER = std::pow( r_MP * r_CT, 0.5 ) * ( 1.0 / tanh( std::pow( r_MP / r_CT, 0.5 ) ) ) -
-                         r_CT;    // Could be helpful https://en.wikipedia.org/wiki/Fast_inverse_square_root
-
     // \omega = 0
     /*     R_ser = R_ser+real((R_MP.*(R_ct./(1+1i.*w.*Tau_dl).^Phi_HN)).^0.5 ...
                  .*coth((R_MP./(R_ct./(1+1i.*w.*Tau_dl).^Phi_HN)).^0.5)...
                      -R_ct);
                      */
+    return std::pow( r_MP * r_CT, 0.5 ) * ( 1.0 / tanh( std::pow( r_MP / r_CT, 0.5 ) ) ) -
+           r_CT;    // Could be helpful https://en.wikipedia.org/wiki/Fast_inverse_square_root
+}
 
-    this->mVoltage = *SerialTwoPort< T >::GetVoltage() + this->mCurrent * r_SER;
+template < typename T >
+T* Rmphn< T >::GetVoltage()
+{
+    this->mVoltage = *SerialTwoPort< T >::GetVoltage() + this->mCurrent * GetSerialResistance();
     return &this->mVoltage;
 }
+
+#ifndef _SYMBOLIC_
+template < typename T >
+bool Rmphn< T >::CompileStamp( TwoPortStamp< T >& stamp )
+{
+    if ( !SerialTwoPort< T >::CompileStamp( stamp ) )
+        return false;
+
+    mSerialResistanceSlot = stamp.NewValue();
+    AddStampRow( this->mVoltageStamp, ScaleStampRow( this->mCurrentStamp, mSerialResistanceSlot ) );
+    MergeStampRow( this->mVoltageStamp );
+    return true;
+}
+
+template < typename T >
+void Rmphn< T >::UpdateStampValues( std::vector< double >& values )
+{
+    TwoPort< T >::UpdateStampValues( values );
+    values[mSerialResistanceSlot] = GetSerialResistance();
+}
+#endif
 }
 #endif /* _RMN_ */
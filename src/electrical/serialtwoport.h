@@ -42,6 +42,9 @@ class SerialTwoPort : public TwoPortWithChild< T >
     virtual ~SerialTwoPort(){};
 
     virtual T* GetVoltage();
+#ifndef _SYMBOLIC_
+    virtual bool CompileStamp( TwoPortStamp< T >& stamp );    ///< The voltage is the sum of the voltages of the children
+#endif
 
     virtual bool IsSerialTwoPort() const;
     virtual const char* GetName() const;
@@ -68,6 +71,25 @@ bool SerialTwoPort< T >::IsSerialTwoPort() const
     return true;
 }
 
+#ifndef _SYMBOLIC_
+template < typename T >
+bool SerialTwoPort< T >::CompileStamp( TwoPortStamp< T >& stamp )
+{
+    if ( this->mChildren.empty() )
+        return false;
+
+    this->CompileCurrentStamp( stamp );
+    for ( size_t i = 0; i < this->mChildren.size(); ++i )
+    {
+        if ( !this->mChildren[i]->CompileStamp( stamp ) )
+            return false;
+        AddStampRow( this->mVoltageStamp, this->mChildren[i]->GetVoltageStamp() );
+    }
+    MergeStampRow( this->mVoltageStamp );
+    return true;
+}
+#endif
+
 template < typename T >
 const char* SerialTwoPort< T >::GetName() const
 {
@@ -68,6 +68,10 @@ class SphericalDiffusion : public TwoPort< T >
 
     void SetVoltage();
     virtual T* GetVoltage();    ///< Return a Voltage over the TwoPort including children
+#ifndef _SYMBOLIC_
+    virtual bool CompileStamp( TwoPortStamp< T >& stamp );
+    virtual void UpdateStampValues( std::vector< double >& values );
+#endif
 
     virtual void SetCurrent( const T currentval );    ///< Sets the current value
     virtual void SetSystem( systm::StateSystemGroup< T >* stateSystemGroup );
@@ -86,6 +90,12 @@ class SphericalDiffusion : public TwoPort< T >
     std::vector< size_t > mUIDs;
     boost::shared_ptr< object::Object< double > > mR;    ///< This object decides the behaviour of the class, wheter it returns constant values or does a lookup
     boost::shared_ptr< object::Object< double > > mTau;    ///< This object decides the behaviour of the class, wheter it returns constant values or does a lookup
+
+#ifndef _SYMBOLIC_
+    size_t mResistanceSlot = 0;
+    size_t mResistanceByTauSlot = 0;
+    size_t mInverseTauSlot = 0;
+#endif
 };
 
 template < typename T >
@@ -130,6 +140,49 @@ T* SphericalDiffusion< T >::GetVoltage()
     return &this->mVoltage;
 }
 
+#ifndef _SYMBOLIC_
+template < typename T >
+bool SphericalDiffusion< T >::CompileStamp( TwoPortStamp< T >& stamp )
+{
+    this->CompileCurrentStamp( stamp );
+    mResistanceSlot = stamp.NewValue();
+    mResistanceByTauSlot = stamp.NewValue();
+    mInverseTauSlot = stamp.NewValue();
+
+    const StampRow currentByC = ScaleStampRow( this->mCurrentStamp, mResistanceByTauSlot );
+    for ( size_t i = 0; i < mUIDCount; ++i )
+    {
+        StampRow dglPart;
+        AddStampRow( dglPart, currentByC, mRFactor[i] / mTauFactor[i] );
+        dglPart.push_back( StampTerm( mUIDs[i], mInverseTauSlot, STAMP_ONE, -1.0 / mTauFactor[i] ) );
+        stamp.AddDglEquation( mUIDs[i], dglPart );
+    }
+
+    if ( mHasCapacity )
+    {
+        StampRow dglPart;
+        AddStampRow( dglPart, currentByC, mHasCapacity * ( 3.0 / 2.0 ) );
+        stamp.AddDglEquation( mUIDs.back(), dglPart );
+    }
+
+    for ( size_t i = 0; i < mUIDs.size(); ++i )
+        this->mVoltageStamp.push_back( StampTerm( mUIDs[i], STAMP_ONE, STAMP_ONE, 1.0 ) );
+    AddStampRow( this->mVoltageStamp, ScaleStampRow( this->mCurrentStamp, mResistanceSlot ), mResidualResistanceFactor );
+    return true;
+}
+
+template < typename T >
+void SphericalDiffusion< T >::UpdateStampValues( std::vector< double >& values )
+{
+    TwoPort< T >::UpdateStampValues( values );
+    const double r = mR->GetValue();
+    const double tau = mTau->GetValue();
+    values[mResistanceSlot] = r;
+    values[mResistanceByTauSlot] = r / tau;
+    values[mInverseTauSlot] = 1.0 / tau;
+}
+#endif
+
 template < typename T >
 void SphericalDiffusion< T >::SetSystem( systm::StateSystemGroup< T >* stateSystemGroup )
 {
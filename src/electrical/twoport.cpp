@@ -28,5 +28,14 @@ double ReturnFirstElement( Eigen::SparseMatrix< double, RowMajor > &mat )
 {
     return mat.coeff( 0, 0 );
 }
+
+template <>
+double RowTimesColumn( const Eigen::SparseMatrix< double, RowMajor >& row, const Eigen::SparseMatrix< double, RowMajor >& column )
+{
+    double result = 0.0;
+    for ( Eigen::SparseMatrix< double, RowMajor >::InnerIterator it( row, 0 ); it; ++it )
+        result += it.value() * column.coeff( it.col(), 0 );
+    return result;
+}
 #endif /* _EIGEN_ */
 }
@@ -25,6 +25,7 @@ _._._._._._._._._._._._._._._._._._._._._.*/
 #include "electrical_data_struct.h"
 #include "../system/stateSystemGroup.h"
 #include "../exceptions/error_proto.h"
+#include "twoport_stamp.h"
 
 // STD
 #include <vector>
@@ -41,6 +42,7 @@ class TestDaeSystem;
 class TestStateSystem;
 class TestLinearSystem;
 class TestElectricalFactory;
+class TestTwoPortStamp;
 
 class TestVoltageCurrentPowerInjection;
 
@@ -65,6 +67,7 @@ class TwoPort
     friend class ::TestLinearSystem;
     friend class ::TestVoltageCurrentPowerInjection;
     friend class ::TestElectricalFactory;
+    friend class ::TestTwoPortStamp;
 
     public:
     typedef boost::shared_ptr< ElectricalDataStruct< ScalarUnit > > DataType;
@@ -103,6 +106,14 @@ class TwoPort
 
     virtual void LoadInternalData( std::vector< double >& dataVector );    ///< Loads the StateDependentValues from a vector. Some kind serialization. Used for parallelization.
     virtual void SaveInternalData( std::vector< double >& dataVector );    ///< Saves the StateDependentValues  to a vector.
+
+    bool CompileStateSystemStamp();    ///< Only called at the RootTwoPort after SetInitialCurrent. Compiles the equations of the network once, if all TwoPorts support it, and returns whether the compiled equations are used from now on.
+    virtual bool CompileStamp( TwoPortStamp< T >& stamp );    ///< Records the voltage and the equations of this TwoPort. Returns false if this TwoPort can not be compiled.
+    virtual void UpdateStampValues( std::vector< double >& values );    ///< Writes the values of this TwoPort for the current step
+    void AttachStamp( TwoPortStamp< T >* stamp, size_t observationIndex );    ///< Current and voltage are evaluated by the stamp from now on
+    bool HasStamp() const;    ///< Are the equations of this TwoPort compiled?
+    const StampRow& GetCurrentStamp() const;    ///< The compiled current row
+    const StampRow& GetVoltageStamp() const;    ///< The compiled voltage row
 #endif
 
     virtual void CalculateStateDependentValues();    ///< Calculates the StateDependentValues. Should be overwritten.
@@ -116,6 +127,11 @@ class TwoPort
     /// Calculate the voltage of the previous simulation step.
     void CalculateVoltageValue();
 
+#ifndef _SYMBOLIC_
+    /// Registers this TwoPort at the stamp and compiles mCurrent into mCurrentStamp
+    void CompileCurrentStamp( TwoPortStamp< T >& stamp );
+#endif
+
     DataType mDataStruct = 0;
 
     size_t mID;
@@ -128,6 +144,15 @@ class TwoPort
     systm::StateSystemGroup< T >* mStateSystemGroup;
 
     bool mObservable;
+
+#ifndef _SYMBOLIC_
+    StampRow mCurrentStamp;
+    StampRow mVoltageStamp;
+    size_t mCurrentSlot;
+    size_t mObservationIndex;
+    TwoPortStamp< T >* mStamp;
+    boost::shared_ptr< TwoPortStamp< T > > mRootStamp;    ///< Only set at the RootTwoPort
+#endif
 };
 
 template < typename T >
@@ -162,6 +187,71 @@ void TwoPort< T >::SaveInternalData( std::vector< double >& dataVector )
     dataVector.push_back( mVoltageValue );
     dataVector.push_back( mPowerValue );
 }
+
+template < typename T >
+bool TwoPort< T >::CompileStateSystemStamp()
+{
+    if ( mID )
+        ErrorFunction< std::runtime_error >( __FUNCTION__, __LINE__, __FILE__, "OnlyRootport" );
+
+    boost::shared_ptr< TwoPortStamp< T > > stamp( new TwoPortStamp< T >( mStateSystemGroup ) );
+    if ( !this->CompileStamp( *stamp ) )
+        return false;
+
+    stamp->Finalize();
+    mRootStamp = stamp;
+    return true;
+}
+
+template < typename T >
+bool TwoPort< T >::CompileStamp( TwoPortStamp< T >& /* stamp */ )
+{
+    return false;
+}
+
+template < typename T >
+void TwoPort< T >::UpdateStampValues( std::vector< double >& values )
+{
+    values[mCurrentSlot] = mCurrent( 0, mCurrent.n_cols - 1 );
+}
+
+template < typename T >
+void TwoPort< T >::AttachStamp( TwoPortStamp< T >* stamp, size_t observationIndex )
+{
+    mStamp = stamp;
+    mObservationIndex = observationIndex;
+}
+
+template < typename T >
+bool TwoPort< T >::HasStamp() const
+{
+    return mStamp != 0;
+}
+
+template < typename T >
+const StampRow& TwoPort< T >::GetCurrentStamp() const
+{
+    return mCurrentStamp;
+}
+
+template < typename T >
+const StampRow& TwoPort< T >::GetVoltageStamp() const
+{
+    return mVoltageStamp;
+}
+
+template < typename T >
+void TwoPort< T >::CompileCurrentStamp( TwoPortStamp< T >& stamp )
+{
+    stamp.RegisterTwoPort( this );
+    mCurrentSlot = stamp.NewValue();
+
+    // The state part of the current is fixed by the topology, only the input current changes
+    mCurrentStamp.clear();
+    AppendStateTerms( mCurrent, mCurrentStamp );
+    mCurrentStamp.push_back( StampTerm( mCurrent.n_cols - 1, mCurrentSlot, STAMP_ONE, 1.0 ) );
+    mVoltageStamp.clear();
+}
 #endif
 
 template < typename T >
@@ -189,23 +279,50 @@ inline double ReturnFirstElement( T& mat )
     return mat( 0, 0 );
 }
 
+/// Returns row * column without creating the 1x1 product matrix
+template < typename T >
+inline double RowTimesColumn( const T& row, const T& column )
+{
+    double result = 0.0;
+    for ( size_t i = 0; i < row.n_cols; ++i )
+        result += row( 0, i ) * column( i, 0 );
+    return result;
+}
+
 #ifdef _EIGEN_
 template <>
 double ReturnFirstElement( Eigen::SparseMatrix< double, RowMajor >& mat );
+
+template <>
+double RowTimesColumn( const Eigen::SparseMatrix< double, RowMajor >& row, const Eigen::SparseMatrix< double, RowMajor >& column );
 #endif
 
 template < typename T >
 void TwoPort< T >::CalculateCurrentValue()
 {
+#ifndef _SYMBOLIC_
+    if ( mStamp )
+        this->mCurrentValue = mStamp->EvaluateObservation( mObservationIndex );
+    else
+        this->mCurrentValue = RowTimesColumn( mCurrent, this->mStateSystemGroup->mStateVector );
+#else
     T m = ( mCurrent * this->mStateSystemGroup->mStateVector );
     this->mCurrentValue = ReturnFirstElement( m );
+#endif
 }
 
 template < typename T >
 void TwoPort< T >::CalculateVoltageValue()
 {
+#ifndef _SYMBOLIC_
+    if ( mStamp )
+        this->mVoltageValue = mStamp->EvaluateObservation( mObservationIndex + 1 );
+    else
+        this->mVoltageValue = RowTimesColumn( mVoltage, this->mStateSystemGroup->mStateVector );
+#else
     T m = ( mVoltage * this->mStateSystemGroup->mStateVector );
     this->mVoltageValue = ReturnFirstElement( m );
+#endif
 }
 
 template < typename T >
@@ -219,6 +336,11 @@ TwoPort< T >::TwoPort( const bool observable, DataType dataValues )
     , mPowerValue( mDataStruct->mPowerValue )
     , mStateSystemGroup( 0 )
     , mObservable( observable )
+#ifndef _SYMBOLIC_
+    , mCurrentSlot( 0 )
+    , mObservationIndex( 0 )
+    , mStamp( 0 )
+#endif
 {
 }
 
@@ -228,6 +350,13 @@ void TwoPort< T >::UpdateStateSystemGroup()
     if ( mID )
         ErrorFunction< std::runtime_error >( __FUNCTION__, __LINE__, __FILE__, "OnlyRootport" );
 
+#ifndef _SYMBOLIC_
+    if ( mStamp )
+    {
+        mStamp->UpdateStateSystemGroup();
+        return;
+    }
+#endif
     this->GetVoltage();
 }
 
@@ -0,0 +1,321 @@
+/*
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see http://www.gnu.org/licenses/.
+*/
+/* -.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.
+* File Name : twoport_stamp.h
+* Creation Date : 17-10-2026
+_._._._._._._._._._._._._._._._._._._._._.*/
+#ifndef _TWOPORT_STAMP_
+#define _TWOPORT_STAMP_
+
+#ifndef _SYMBOLIC_
+
+// STD
+#include <vector>
+#include <algorithm>
+
+// ETC
+#include "../system/stateSystemGroup.h"
+
+namespace electrical
+{
+
+template < typename T >
+class TwoPort;
+
+/// Index of the stamp value that is always 1
+const size_t STAMP_ONE = 0;
+
+/// One coefficient of a compiled row: mFactor * values[mFirstValue] * values[mSecondValue] in the column mColumn
+struct StampTerm
+{
+    StampTerm( size_t column, size_t firstValue, size_t secondValue, double factor )
+        : mColumn( column )
+        , mFirstValue( firstValue )
+        , mSecondValue( secondValue )
+        , mFactor( factor )
+    {
+    }
+
+    bool operator<( const StampTerm& rhs ) const
+    {
+        if ( mColumn != rhs.mColumn )
+            return mColumn < rhs.mColumn;
+        if ( mFirstValue != rhs.mFirstValue )
+            return mFirstValue < rhs.mFirstValue;
+        return mSecondValue < rhs.mSecondValue;
+    }
+
+    size_t mColumn;
+    size_t mFirstValue;
+    size_t mSecondValue;
+    double mFactor;
+};
+
+/// A row of the state system (states and the constant column) whose coefficients are products of constant factors and
+/// per step values
+typedef std::vector< StampTerm > StampRow;
+
+/// Returns row multiplied with values[valueIndex]. Every term of row may only use one value so far.
+inline StampRow ScaleStampRow( const StampRow& row, size_t valueIndex )
+{
+    StampRow result( row );
+    for ( size_t i = 0; i < result.size(); ++i )
+    {
+        if ( result[i].mFirstValue == STAMP_ONE )
+            result[i].mFirstValue = valueIndex;
+        else
+            result[i].mSecondValue = valueIndex;
+    }
+    return result;
+}
+
+/// Appends summand to row
+inline void AddStampRow( StampRow& row, const StampRow& summand, double factor = 1.0 )
+{
+    row.reserve( row.size() + summand.size() );
+    for ( size_t i = 0; i < summand.size(); ++i )
+    {
+        row.push_back( summand[i] );
+        row.back().mFactor *= factor;
+    }
+}
+
+/// Appends the state columns of a current or voltage row as constant terms
+template < typename T >
+void AppendStateTerms( const T& row, StampRow& stampRow )
+{
+    for ( size_t col = 0; col + 1 < row.n_cols; ++col )
+        if ( row( 0, col ) != 0 )
+            stampRow.push_back( StampTerm( col, STAMP_ONE, STAMP_ONE, row( 0, col ) ) );
+}
+
+#ifdef _EIGEN_
+inline void AppendStateTerms( const Eigen::SparseMatrix< double, RowMajor >& row, StampRow& stampRow )
+{
+    for ( Eigen::SparseMatrix< double, RowMajor >::InnerIterator it( row, 0 ); it; ++it )
+        if ( static_cast< size_t >( it.col() ) + 1 < static_cast< size_t >( row.cols() ) && it.value() != 0 )
+            stampRow.push_back( StampTerm( it.col(), STAMP_ONE, STAMP_ONE, it.value() ) );
+}
+#endif /* _EIGEN_ */
+
+/// Sorts row by column and merges the terms with the same values
+inline void MergeStampRow( StampRow& row )
+{
+    std::sort( row.begin(), row.end() );
+    size_t last = 0;
+    for ( size_t i = 1; i < row.size(); ++i )
+    {
+        if ( row[i].mColumn == row[last].mColumn && row[i].mFirstValue == row[last].mFirstValue &&
+             row[i].mSecondValue == row[last].mSecondValue )
+            row[last].mFactor += row[i].mFactor;
+        else
+            row[++last] = row[i];
+    }
+    if ( !row.empty() )
+        row.erase( row.begin() + last + 1, row.end() );
+}
+
+/// Compiled form of the equations of a TwoPort network with a fixed topology.
+/// While compiling, every TwoPort records its voltage and its equations as StampRows. The topology, i.e. which states
+/// appear in which row, is then fixed and every step only the values (resistances, inverse capacities, currents, ...)
+/// are collected from the registered TwoPorts and the equations are evaluated with a cost proportional to their
+/// number of terms instead of the number of states.
+/// The currents and voltages of all registered TwoPorts are kept as one sparse matrix whose coefficients are refreshed
+/// with every update, so that observing a TwoPort is a sparse dot product with the state vector.
+template < typename T >
+class TwoPortStamp
+{
+    public:
+    explicit TwoPortStamp( systm::StateSystemGroup< T >* stateSystemGroup );
+
+    /// Reserves a new per step value and returns its index
+    size_t NewValue();
+
+    /// The TwoPort writes its values in every step with UpdateStampValues()
+    void RegisterTwoPort( TwoPort< T >* twoPort );
+
+    void AddDglEquation( size_t equationNumber, StampRow row );
+    void AddAlgEquation( size_t equationNumber, StampRow row );
+
+    /// Finishes the compilation and attaches the stamp to all registered TwoPorts
+    void Finalize();
+
+    /// Collects the values and writes all equations into the StateSystemGroup
+    void UpdateStateSystemGroup();
+
+    /// Returns the current (observationIndex) or voltage (observationIndex + 1) of a registered TwoPort
+    double EvaluateObservation( size_t observationIndex ) const;
+
+    size_t GetValueCount() const { return mValues.size(); }
+    size_t GetTermCount() const;
+
+    private:
+    struct Equation
+    {
+        size_t mEquationNumber;
+        bool mIsDgl;
+        StampRow mTerms;                  ///< Sorted by column
+        std::vector< size_t > mColumns;    ///< Distinct columns of mTerms
+        std::vector< size_t > mSlots;      ///< Index into mColumns for every term
+    };
+
+    void AddEquation( size_t equationNumber, bool isDgl, StampRow& row );
+
+    systm::StateSystemGroup< T >* mStateSystemGroup;
+    std::vector< double > mValues;
+    std::vector< TwoPort< T >* > mTwoPorts;
+    std::vector< Equation > mEquations;
+    std::vector< double > mRowValues;
+
+    // Currents and voltages of the registered TwoPorts in compressed row storage
+    StampRow mObservationTerms;
+    std::vector< size_t > mObservationRowStarts;
+    std::vector< double > mObservationCoefficients;
+};
+
+template < typename T >
+TwoPortStamp< T >::TwoPortStamp( systm::StateSystemGroup< T >* stateSystemGroup )
+    : mStateSystemGroup( stateSystemGroup )
+    , mValues( 1, 1.0 )
+{
+}
+
+template < typename T >
+size_t TwoPortStamp< T >::NewValue()
+{
+    mValues.push_back( 0.0 );
+    return mValues.size() - 1;
+}
+
+template < typename T >
+void TwoPortStamp< T >::RegisterTwoPort( TwoPort< T >* twoPort )
+{
+    mTwoPorts.push_back( twoPort );
+}
+
+template < typename T >
+void TwoPortStamp< T >::AddDglEquation( size_t equationNumber, StampRow row )
+{
+    AddEquation( equationNumber, true, row );
+}
+
+template < typename T >
+void TwoPortStamp< T >::AddAlgEquation( size_t equationNumber, StampRow row )
+{
+    AddEquation( equationNumber, false, row );
+}
+
+template < typename T >
+void TwoPortStamp< T >::AddEquation( size_t equationNumber, bool isDgl, StampRow& row )
+{
+    MergeStampRow( row );
+
+    mEquations.push_back( Equation() );
+    Equation& equation = mEquations.back();
+    equation.mEquationNumber = equationNumber;
+    equation.mIsDgl = isDgl;
+    equation.mTerms.swap( row );
+    equation.mSlots.reserve( equation.mTerms.size() );
+    for ( size_t i = 0; i < equation.mTerms.size(); ++i )
+    {
+        if ( equation.mColumns.empty() || equation.mColumns.back() != equation.mTerms[i].mColumn )
+            equation.mColumns.push_back( equation.mTerms[i].mColumn );
+        equation.mSlots.push_back( equation.mColumns.size() - 1 );
+    }
+}
+
+template < typename T >
+void TwoPortStamp< T >::Finalize()
+{
+    // Entries outside of the compiled pattern may still be set by an uncompiled evaluation
+    T zeroRow;
+    zeroRow.zeros( 1, mStateSystemGroup->GetStateCount() + 1 );
+    for ( size_t i = 0; i < mEquations.size(); ++i )
+    {
+        systm::StateSystem< T >& stateSystem =
+         mEquations[i].mIsDgl ? mStateSystemGroup->mDglStateSystem : mStateSystemGroup->mAlgStateSystem;
+        stateSystem.AddEquations( mEquations[i].mEquationNumber, zeroRow );
+    }
+
+    mObservationRowStarts.assign( 1, 0 );
+    for ( size_t i = 0; i < mTwoPorts.size(); ++i )
+    {
+        mTwoPorts[i]->AttachStamp( this, mObservationRowStarts.size() - 1 );
+
+        StampRow current( mTwoPorts[i]->GetCurrentStamp() );
+        MergeStampRow( current );
+        mObservationTerms.insert( mObservationTerms.end(), current.begin(), current.end() );
+        mObservationRowStarts.push_back( mObservationTerms.size() );
+
+        StampRow voltage( mTwoPorts[i]->GetVoltageStamp() );
+        MergeStampRow( voltage );
+        mObservationTerms.insert( mObservationTerms.end(), voltage.begin(), voltage.end() );
+        mObservationRowStarts.push_back( mObservationTerms.size() );
+    }
+    mObservationCoefficients.assign( mObservationTerms.size(), 0.0 );
+}
+
+template < typename T >
+void TwoPortStamp< T >::UpdateStateSystemGroup()
+{
+    for ( size_t i = 0; i < mTwoPorts.size(); ++i )
+        mTwoPorts[i]->UpdateStampValues( mValues );
+
+    for ( size_t i = 0; i < mEquations.size(); ++i )
+    {
+        const Equation& equation = mEquations[i];
+        mRowValues.assign( equation.mColumns.size(), 0.0 );
+        for ( size_t j = 0; j < equation.mTerms.size(); ++j )
+        {
+            const StampTerm& term = equation.mTerms[j];
+            mRowValues[equation.mSlots[j]] += term.mFactor * mValues[term.mFirstValue] * mValues[term.mSecondValue];
+        }
+
+        systm::StateSystem< T >& stateSystem =
+         equation.mIsDgl ? mStateSystemGroup->mDglStateSystem : mStateSystemGroup->mAlgStateSystem;
+        stateSystem.SetEquation( equation.mEquationNumber, equation.mColumns, mRowValues );
+    }
+
+    for ( size_t i = 0; i < mObservationTerms.size(); ++i )
+    {
+        const StampTerm& term = mObservationTerms[i];
+        mObservationCoefficients[i] = term.mFactor * mValues[term.mFirstValue] * mValues[term.mSecondValue];
+    }
+}
+
+template < typename T >
+double TwoPortStamp< T >::EvaluateObservation( size_t observationIndex ) const
+{
+    const T& stateVector = mStateSystemGroup->mStateVector;
+    double result = 0.0;
+    for ( size_t i = mObservationRowStarts[observationIndex]; i < mObservationRowStarts[observationIndex + 1]; ++i )
+        result += mObservationCoefficients[i] * stateVector( mObservationTerms[i].mColumn, 0 );
+    return result;
+}
+
+template < typename T >
+size_t TwoPortStamp< T >::GetTermCount() const
+{
+    size_t count = 0;
+    for ( size_t i = 0; i < mEquations.size(); ++i )
+        count += mEquations[i].mTerms.size();
+    return count;
+}
+
+} /* END NAMESPACE */
+
+#endif /* _SYMBOLIC_ */
+
+#endif /* _TWOPORT_STAMP_ */
@@ -47,17 +47,27 @@ class VoltageSource : public ElectricalElement< T >
     virtual ~VoltageSource(){};
 
     virtual T* GetVoltage();
+#ifndef _SYMBOLIC_
+    virtual bool CompileStamp( TwoPortStamp< T >& stamp );
+    virtual void UpdateStampValues( std::vector< double >& values );
+#endif
     virtual void CalculateStateDependentValues();
     virtual const char* GetName() const;
 
     private:
     protected:
+#ifndef _SYMBOLIC_
+    size_t mVoltageSlot;
+#endif
 };
 
 template < typename T >
 VoltageSource< T >::VoltageSource( boost::shared_ptr< object::Object< double > > obj, const bool observable,
                                    typename TwoPort< T >::DataType dataValues )
     : ElectricalElement< T >( obj, observable, dataValues )
+#ifndef _SYMBOLIC_
+    , mVoltageSlot( 0 )
+#endif
 {
 }
 
@@ -83,6 +93,25 @@ T* VoltageSource< T >::GetVoltage()
     return TwoPort< T >::GetVoltage();
 }
 
+#ifndef _SYMBOLIC_
+template < typename T >
+bool VoltageSource< T >::CompileStamp( TwoPortStamp< T >& stamp )
+{
+    this->CompileCurrentStamp( stamp );
+    mVoltageSlot = stamp.NewValue();
+    this->mVoltageStamp.push_back( StampTerm( this->mCurrent.n_cols - 1, mVoltageSlot, STAMP_ONE, 1.0 ) );
+    return true;
+}
+
+template < typename T >
+void VoltageSource< T >::UpdateStampValues( std::vector< double >& values )
+{
+    TwoPort< T >::UpdateStampValues( values );
+    this->mVoltageValue = this->GetValue();
+    values[mVoltageSlot] = this->mVoltageValue;
+}
+#endif
+
 template < typename T >
 const char* VoltageSource< T >::GetName() const
 {
@@ -67,6 +67,10 @@ class Zarc : public TwoPort< T >
 
     virtual void SetSystem( systm::StateSystemGroup< T >* stateSystemGroup );
     virtual T* GetVoltage();    ///< Returns the voltage over the Zarc element
+#ifndef _SYMBOLIC_
+    virtual bool CompileStamp( TwoPortStamp< T >& stamp );
+    virtual void UpdateStampValues( std::vector< double >& values );
+#endif
     virtual void CalculateStateDependentValues();
 
     const std::vector< ScalarUnit >& GetRValues() const;
@@ -135,6 +139,11 @@ class Zarc : public TwoPort< T >
     static const double mRFactorInnen[];
 
     size_t mNumberOfElements;
+#ifndef _SYMBOLIC_
+    std::vector< size_t > mResistanceByTauSlots;
+    std::vector< size_t > mInverseTauSlots;
+    size_t mSerialResistanceSlot;
+#endif
     static const size_t THREE_TAU = 3;
     static const size_t MAX_RC_ELEMENTS = 3;
 
@@ -160,6 +169,9 @@ Zarc< T >::Zarc( boost::shared_ptr< object::Object< double > > lookupRelaxationT
     , mLookupPhi2RFactorAussen( std::vector< double >( mRFactorAussen, mRFactorAussen + 10 ),
                                 std::vector< double >( mPhi, mPhi + 10 ), lookup::LINEAR_INTERPOLATION )
     , mNumberOfElements( 0 )
+#ifndef _SYMBOLIC_
+    , mSerialResistanceSlot( 0 )
+#endif
 {
     InitializeZarc( dtValue );
 }
@@ -301,6 +313,63 @@ void Zarc< T >::AddOhmicResistanceToVoltage3R()
      this->mCurrent * ( ( 2 * mCurrentRcElements.rFactorAussen + mCurrentRcElements.rFactorInnen ) * mCurrentRcElements.const_r );
 }
 
+#ifndef _SYMBOLIC_
+template < typename T >
+bool Zarc< T >::CompileStamp( TwoPortStamp< T >& stamp )
+{
+    this->CompileCurrentStamp( stamp );
+    mResistanceByTauSlots.resize( mNumberOfElements );
+    mInverseTauSlots.resize( mNumberOfElements );
+    for ( size_t i = 0; i < mNumberOfElements; ++i )
+    {
+        mResistanceByTauSlots[i] = stamp.NewValue();
+        mInverseTauSlots[i] = stamp.NewValue();
+        this->mVoltageStamp.push_back( StampTerm( mUIDs[i], STAMP_ONE, STAMP_ONE, 1.0 ) );
+
+        StampRow dglPart = ScaleStampRow( this->mCurrentStamp, mResistanceByTauSlots[i] );
+        dglPart.push_back( StampTerm( mUIDs[i], mInverseTauSlots[i], STAMP_ONE, -1.0 ) );
+        stamp.AddDglEquation( mUIDs[i], dglPart );
+    }
+
+    // The RC elements that are too fast for the sample rate are replaced by their resistance
+    if ( mNumberOfElements < MAX_RC_ELEMENTS )
+    {
+        mSerialResistanceSlot = stamp.NewValue();
+        AddStampRow( this->mVoltageStamp, ScaleStampRow( this->mCurrentStamp, mSerialResistanceSlot ) );
+    }
+    return true;
+}
+
+/// Same values as FirstRcVoltage(), SecondRcVoltage(), ThirdRcVoltage() and AddOhmicResistanceToVoltage*R()
+template < typename T >
+void Zarc< T >::UpdateStampValues( std::vector< double >& values )
+{
+    TwoPort< T >::UpdateStampValues( values );
+    CalculateLookupValues();
+    const RcElements& rc = mCurrentRcElements;
+    const double resistances[MAX_RC_ELEMENTS] = {rc.rFactorAussen * rc.const_r, rc.rFactorInnen * rc.const_r,
+                                                 rc.rFactorAussen * rc.const_r};
+    const double taus[MAX_RC_ELEMENTS] = {rc.tauFactor * rc.const_tau, rc.const_tau, rc.const_tau / rc.tauFactor};
+
+    for ( size_t i = 0; i < mNumberOfElements; ++i )
+    {
+        mRValues[i] = resistances[i];
+        mCValues[i] = taus[i] / resistances[i];
+        values[mResistanceByTauSlots[i]] = resistances[i] / taus[i];
+        values[mInverseTauSlots[i]] = 1.0 / taus[i];
+    }
+
+    if ( mNumberOfElements < MAX_RC_ELEMENTS )
+    {
+        double serialResistance = 0.0;
+        for ( size_t i = mNumberOfElements; i < MAX_RC_ELEMENTS; ++i )
+            serialResistance += resistances[i];
+        mRValues[mNumberOfElements] = serialResistance;
+        values[mSerialResistanceSlot] = serialResistance;
+    }
+}
+#endif
+
 // TAU = R*C
 // C = TAU / R
 template < typename T >
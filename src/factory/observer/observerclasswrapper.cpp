@@ -26,6 +26,136 @@ _._._._._._._._._._._._._._._._._._._._._.*/
 namespace factory
 {
 
+void GetAsyncFilterParameters( const xmlparser::XmlParameter* param, size_t& queueSize, observer::AsyncBackpressure& backpressure )
+{
+    queueSize = 64;
+    if ( param->HasElement( "QueueSize" ) )
+    {
+        const int size = param->GetElementIntValue( "QueueSize" );
+        if ( size < 1 )
+            ErrorFunction< std::runtime_error >( __FUNCTION__, __LINE__, __FILE__, "AsyncFilterQueueSizeNotPositive" );
+        queueSize = size;
+    }
+
+    backpressure = observer::ASYNC_BLOCK;
+    const std::string backpressureName( param->GetElementStringValueWithDefaultValue( "Backpressure", "Block" ) );
+    if ( backpressureName == "Drop" )
+        backpressure = observer::ASYNC_DROP;
+    else if ( backpressureName == "Decimate" )
+        backpressure = observer::ASYNC_DECIMATE;
+    else if ( backpressureName != "Block" )
+        ErrorFunction< std::runtime_error >( __FUNCTION__, __LINE__, __FILE__, "UnknownAsyncBackpressure",
+                                             backpressureName.c_str() );
+}
+
+size_t GetMatlabFilterChunkSize( const xmlparser::XmlParameter* param )
+{
+    if ( !param->HasElement( "ChunkSize" ) )
+        return 1024;
+
+    const int chunkSize = param->GetElementIntValue( "ChunkSize" );
+    if ( chunkSize < 1 )
+        ErrorFunction< std::runtime_error >( __FUNCTION__, __LINE__, __FILE__, "MatlabFilterChunkSizeNotPositive" );
+    return chunkSize;
+}
+
+size_t GetBinaryFilterSizeOfValue( const xmlparser::XmlParameter* param )
+{
+    const std::string precision( param->GetElementStringValueWithDefaultValue( "Precision", "Double" ) );
+    if ( precision == "Single" )
+        return sizeof( float );
+    else if ( precision != "Double" )
+        ErrorFunction< std::runtime_error >( __FUNCTION__, __LINE__, __FILE__, "UnknownBinaryFilterPrecision",
+                                             precision.c_str() );
+    return sizeof( double );
+}
+
+size_t GetSignificantDigits( const xmlparser::XmlParameter* param, size_t defaultDigits )
+{
+    if ( !param->HasElement( "SignificantDigits" ) )
+        return defaultDigits;
+
+    const int significantDigits = param->GetElementIntValue( "SignificantDigits" );
+    if ( significantDigits < 0 || significantDigits > 17 )
+        ErrorFunction< std::runtime_error >( __FUNCTION__, __LINE__, __FILE__, "SignificantDigitsOutOfRange",
+                                             significantDigits );
+    return significantDigits;
+}
+
+namespace
+{
+/// Splits text at the commas and removes the spaces around the parts
+std::vector< std::string > SplitList( const std::string& text )
+{
+    std::vector< std::string > parts;
+    size_t begin = 0;
+    while ( begin <= text.size() )
+    {
+        size_t end = text.find( ',', begin );
+        if ( end == std::string::npos )
+            end = text.size();
+
+        const size_t first = text.find_first_not_of( " \t\r\n", begin );
+        if ( first < end )
+        {
+            const size_t last = text.find_last_not_of( " \t\r\n", end - 1 );
+            parts.push_back( text.substr( first, last + 1 - first ) );
+        }
+        begin = end + 1;
+    }
+    return parts;
+}
+
+/// Reads a positive element number and returns false if text is no number
+bool ReadElementNumber( const std::string& text, size_t& number )
+{
+    if ( text.empty() || text.find_first_not_of( "0123456789" ) != std::string::npos )
+        return false;
+    number = strtoul( text.c_str(), 0, 10 );
+    return true;
+}
+}
+
+observer::ElementSelection GetElementSelection( const xmlparser::XmlParameter* param, bool readNames )
+{
+    observer::ElementSelection selection;
+    if ( param->HasElement( "TimeDelay" ) )
+        selection.mTimeDelay = param->GetElementDoubleValue( "TimeDelay" );
+
+    if ( param->HasElement( "Elements" ) )
+    {
+        const std::vector< std::string > ranges( SplitList( param->GetElementStringValue( "Elements" ) ) );
+        for ( size_t i = 0; i < ranges.size(); ++i )
+        {
+            const size_t separator = ranges[i].find( '-' );
+            std::pair< size_t, size_t > range;
+            bool isValid = ReadElementNumber( ranges[i].substr( 0, separator ), range.first );
+            if ( separator == std::string::npos )
+                range.second = range.first;
+            else
+                isValid = isValid && ReadElementNumber( ranges[i].substr( separator + 1 ), range.second );
+
+            if ( !isValid )
+                ErrorFunction< std::runtime_error >( __FUNCTION__, __LINE__, __FILE__, "InvalidSelectFilterRange",
+                                                     ranges[i].c_str() );
+            selection.mRanges.push_back( range );
+        }
+    }
+
+    if ( readNames && param->HasElement( "Names" ) )
+        selection.mNames = SplitList( param->GetElementStringValue( "Names" ) );
+    return selection;
+}
+
+template class ObserverClassWrapperTwoPort< myMatrixType, observer::BinaryFilterTwoPort >;
+template class ObserverClassWrapperThermal< double, observer::BinaryFilterThermal >;
+
+template class ObserverClassWrapperTwoPort< myMatrixType, observer::SelectFilterTwoPort >;
+template class ObserverClassWrapperThermal< double, observer::SelectFilterThermal >;
+
+template class ObserverClassWrapperTwoPort< myMatrixType, observer::AsyncFilterTwoPort >;
+template class ObserverClassWrapperThermal< double, observer::AsyncFilterThermal >;
+
 template class ObserverClassWrapperTwoPort< myMatrixType, observer::DecimateFilterTwoPort >;
 template class ObserverClassWrapperThermal< myMatrixType, observer::DecimateFilterThermal >;
 
@@ -24,9 +24,12 @@ _._._._._._._._._._._._._._._._._._._._._.*/
 
 
 // ETC
+#include "../../observer/filter/asyncFilter.h"
+#include "../../observer/filter/binaryFilter.h"
 #include "../../observer/filter/csvfilter.h"
 #include "../../observer/filter/decimatefilter.h"
 #include "../../observer/filter/matlabFilter.h"
+#include "../../observer/filter/selectFilter.h"
 #include "../../observer/filter/stdoutfilter.h"
 #include "../../observer/filter/vcpfilter.h"
 #include "../../observer/filter/filter.h"
@@ -46,6 +49,43 @@ struct ArgumentTypeObserver
     ArgumentTypeObserver(){};
 };
 
+/// Reads QueueSize and Backpressure of an AsyncFilter
+void GetAsyncFilterParameters( const xmlparser::XmlParameter* param, size_t& queueSize,
+                               observer::AsyncBackpressure& backpressure );
+
+/// Reads ChunkSize of a MatlabFilter
+size_t GetMatlabFilterChunkSize( const xmlparser::XmlParameter* param );
+
+/// Reads Precision of a BinaryFilter and returns the size of the stored values
+size_t GetBinaryFilterSizeOfValue( const xmlparser::XmlParameter* param );
+
+/// Reads SignificantDigits of a CsvFilter or StdoutFilter, 0 stands for the shortest exact text of a value
+size_t GetSignificantDigits( const xmlparser::XmlParameter* param, size_t defaultDigits );
+
+/// Reads Elements, Names and TimeDelay of a group of a SelectFilter. Elements is a list like "1-10, 15".
+observer::ElementSelection GetElementSelection( const xmlparser::XmlParameter* param, bool readNames );
+
+/// Adds the groups of a SelectFilter and creates their filters with observerFactory
+template < typename SelectFilterT, typename FactoryT >
+void AddSelectFilterGroups( SelectFilterT* filter, const xmlparser::XmlParameter* param, FactoryT* observerFactory,
+                            bool readNames )
+{
+    if ( !param->HasElement( "Groups" ) )
+        return;
+
+    std::vector< boost::shared_ptr< xmlparser::XmlParameter > > groups = param->GetElementChildren( "Groups" );
+    for ( size_t i = 0; i < groups.size(); ++i )
+    {
+        typename SelectFilterT::GroupT& group = filter->AddGroup( GetElementSelection( groups[i].get(), readNames ) );
+        if ( !groups[i]->HasElement( "Filters" ) )
+            continue;
+
+        std::vector< boost::shared_ptr< xmlparser::XmlParameter > > filters = groups[i]->GetElementChildren( "Filters" );
+        for ( size_t j = 0; j < filters.size(); ++j )
+            group.AddFilter( observerFactory->CreateInstance( filters[j] ) );
+    }
+}
+
 /// Classwrapper for ::observer namespace. This template class has to be specialized in order to create an instance of a
 /// particular class.
 template < typename MatrixT, template < typename > class TConcrete, typename ArgumentType >
@@ -113,6 +153,50 @@ class ObserverClassWrapperThermal< MatrixT, observer::DecimateFilterThermal >
 };
 
 
+/// Classwrapper for observer::AsyncFilter
+template < typename MatrixT >
+class ObserverClassWrapperTwoPort< MatrixT, observer::AsyncFilterTwoPort >
+ : public ObserverClassWrapperBase< MatrixT, electrical::TwoPort, observer::PreparationType< MatrixT > >
+{
+    public:
+    ObserverClassWrapperTwoPort()
+        : ObserverClassWrapperBase< MatrixT, electrical::TwoPort, observer::PreparationType< MatrixT > >(){};
+
+    virtual boost::shared_ptr< observer::Filter< MatrixT, electrical::TwoPort, observer::PreparationType< MatrixT > > >
+    CreateInstance( const xmlparser::XmlParameter* param, const ArgumentTypeObserver* arg = 0 )
+    {
+        UNUSED( arg );
+        size_t queueSize;
+        observer::AsyncBackpressure backpressure;
+        GetAsyncFilterParameters( param, queueSize, backpressure );
+
+        return boost::shared_ptr< observer::Filter< MatrixT, electrical::TwoPort, observer::PreparationType< MatrixT > > >(
+         new observer::AsyncFilterTwoPort< MatrixT >( queueSize, backpressure ) );
+    }
+};
+
+template < typename MatrixT >
+class ObserverClassWrapperThermal< MatrixT, observer::AsyncFilterThermal >
+ : public ObserverClassWrapperBase< MatrixT, thermal::ThermalElement, observer::ThermalPreperation >
+{
+    public:
+    ObserverClassWrapperThermal()
+        : ObserverClassWrapperBase< MatrixT, thermal::ThermalElement, observer::ThermalPreperation >(){};
+
+    virtual boost::shared_ptr< observer::Filter< MatrixT, thermal::ThermalElement, observer::ThermalPreperation > >
+    CreateInstance( const xmlparser::XmlParameter* param, const ArgumentTypeObserver* arg = 0 )
+    {
+        UNUSED( arg );
+        size_t queueSize;
+        observer::AsyncBackpressure backpressure;
+        GetAsyncFilterParameters( param, queueSize, backpressure );
+
+        return boost::shared_ptr< observer::Filter< MatrixT, thermal::ThermalElement, observer::ThermalPreperation > >(
+         new observer::AsyncFilterThermal< MatrixT >( queueSize, backpressure ) );
+    }
+};
+
+
 /// Classwrapper for observer::CsvFilter
 template < typename MatrixT >
 class ObserverClassWrapperTwoPort< MatrixT, observer::CsvFilterTwoPort >
@@ -131,7 +215,8 @@ class ObserverClassWrapperTwoPort< MatrixT, observer::CsvFilterTwoPort >
             printHeader = param->GetElementBoolValue( "PrintHeader" );
 
         return boost::shared_ptr< observer::Filter< MatrixT, electrical::TwoPort, observer::PreparationType< MatrixT > > >(
-         new observer::CsvFilterTwoPort< MatrixT >( param->GetElementStringValue( "filename" ), printHeader ) );
+         new observer::CsvFilterTwoPort< MatrixT >( param->GetElementStringValue( "filename" ), printHeader,
+                                                    GetSignificantDigits( param, 0 ) ) );
     }
 };
 
@@ -162,7 +247,96 @@ class ObserverClassWrapperThermal< MatrixT, observer::CsvFilterThermal >
          param->GetElementStringValueWithDefaultValue( "VolumesNameFile", "Patch_VolumeNames.csv" ) );
         return boost::shared_ptr< observer::Filter< MatrixT, thermal::ThermalElement, observer::ThermalPreperation > >(
          new observer::CsvFilterThermal< MatrixT >( param->GetElementStringValue( "Filename" ), printHeader, fileNameVertices,
-                                                    fileNameAreas, fileNameVolumes, fileNameVolumeNames ) );
+                                                    fileNameAreas, fileNameVolumes, fileNameVolumeNames,
+                                                    GetSignificantDigits( param, 0 ) ) );
+    }
+};
+
+/// Classwrapper for observer::SelectFilter
+template < typename MatrixT >
+class ObserverClassWrapperTwoPort< MatrixT, observer::SelectFilterTwoPort >
+ : public ObserverClassWrapperBase< MatrixT, electrical::TwoPort, observer::PreparationType< MatrixT > >
+{
+    public:
+    typedef Factory< observer::Filter< MatrixT, electrical::TwoPort, observer::PreparationType< MatrixT > >, ArgumentTypeObserver > FactoryT;
+
+    /// \param observerFactory Creates the filters of the groups
+    ObserverClassWrapperTwoPort( FactoryT* observerFactory )
+        : ObserverClassWrapperBase< MatrixT, electrical::TwoPort, observer::PreparationType< MatrixT > >()
+        , mObserverFactory( observerFactory ){};
+
+    virtual boost::shared_ptr< observer::Filter< MatrixT, electrical::TwoPort, observer::PreparationType< MatrixT > > >
+    CreateInstance( const xmlparser::XmlParameter* param, const ArgumentTypeObserver* arg = 0 )
+    {
+        UNUSED( arg );
+        boost::shared_ptr< observer::SelectFilterTwoPort< MatrixT > > filter( new observer::SelectFilterTwoPort< MatrixT >() );
+        AddSelectFilterGroups( filter.get(), param, mObserverFactory, true );
+        return filter;
+    }
+
+    private:
+    FactoryT* const mObserverFactory;
+};
+
+template < typename MatrixT >
+class ObserverClassWrapperThermal< MatrixT, observer::SelectFilterThermal >
+ : public ObserverClassWrapperBase< MatrixT, thermal::ThermalElement, observer::ThermalPreperation >
+{
+    public:
+    typedef Factory< observer::Filter< MatrixT, thermal::ThermalElement, observer::ThermalPreperation >, ArgumentTypeObserver > FactoryT;
+
+    /// \param observerFactory Creates the filters of the groups
+    ObserverClassWrapperThermal( FactoryT* observerFactory )
+        : ObserverClassWrapperBase< MatrixT, thermal::ThermalElement, observer::ThermalPreperation >()
+        , mObserverFactory( observerFactory ){};
+
+    virtual boost::shared_ptr< observer::Filter< MatrixT, thermal::ThermalElement, observer::ThermalPreperation > >
+    CreateInstance( const xmlparser::XmlParameter* param, const ArgumentTypeObserver* arg = 0 )
+    {
+        UNUSED( arg );
+        boost::shared_ptr< observer::SelectFilterThermal< MatrixT > > filter( new observer::SelectFilterThermal< MatrixT >() );
+        AddSelectFilterGroups( filter.get(), param, mObserverFactory, false );
+        return filter;
+    }
+
+    private:
+    FactoryT* const mObserverFactory;
+};
+
+/// Classwrapper for observer::BinaryFilter
+template < typename MatrixT >
+class ObserverClassWrapperTwoPort< MatrixT, observer::BinaryFilterTwoPort >
+ : public ObserverClassWrapperBase< MatrixT, electrical::TwoPort, observer::PreparationType< MatrixT > >
+{
+    public:
+    ObserverClassWrapperTwoPort()
+        : ObserverClassWrapperBase< MatrixT, electrical::TwoPort, observer::PreparationType< MatrixT > >(){};
+
+    virtual boost::shared_ptr< observer::Filter< MatrixT, electrical::TwoPort, observer::PreparationType< MatrixT > > >
+    CreateInstance( const xmlparser::XmlParameter* param, const ArgumentTypeObserver* arg = 0 )
+    {
+        UNUSED( arg );
+        return boost::shared_ptr< observer::Filter< MatrixT, electrical::TwoPort, observer::PreparationType< MatrixT > > >(
+         new observer::BinaryFilterTwoPort< MatrixT >( param->GetElementStringValue( "Filename" ),
+                                                       GetBinaryFilterSizeOfValue( param ) ) );
+    }
+};
+
+template < typename MatrixT >
+class ObserverClassWrapperThermal< MatrixT, observer::BinaryFilterThermal >
+ : public ObserverClassWrapperBase< MatrixT, thermal::ThermalElement, observer::ThermalPreperation >
+{
+    public:
+    ObserverClassWrapperThermal()
+        : ObserverClassWrapperBase< MatrixT, thermal::ThermalElement, observer::ThermalPreperation >(){};
+
+    virtual boost::shared_ptr< observer::Filter< MatrixT, thermal::ThermalElement, observer::ThermalPreperation > >
+    CreateInstance( const xmlparser::XmlParameter* param, const ArgumentTypeObserver* arg = 0 )
+    {
+        UNUSED( arg );
+        return boost::shared_ptr< observer::Filter< MatrixT, thermal::ThermalElement, observer::ThermalPreperation > >(
+         new observer::BinaryFilterThermal< MatrixT >( param->GetElementStringValue( "Filename" ),
+                                                       GetBinaryFilterSizeOfValue( param ) ) );
     }
 };
 
@@ -257,10 +431,9 @@ class ObserverClassWrapperTwoPort< MatrixT, observer::StdoutFilterTwoPort >
     virtual boost::shared_ptr< observer::Filter< MatrixT, electrical::TwoPort, observer::PreparationType< MatrixT > > >
     CreateInstance( const xmlparser::XmlParameter* param, const ArgumentTypeObserver* arg = 0 )
     {
-        UNUSED( param );
         UNUSED( arg );
         return boost::shared_ptr< observer::Filter< MatrixT, electrical::TwoPort, observer::PreparationType< MatrixT > > >(
-         new observer::StdoutFilterTwoPort< MatrixT >() );
+         new observer::StdoutFilterTwoPort< MatrixT >( GetSignificantDigits( param, 6 ) ) );
     }
 };
 
@@ -279,7 +452,8 @@ class ObserverClassWrapperTwoPort< MatrixT, observer::MatlabFilterTwoPort >
         UNUSED( arg );
 
         return boost::shared_ptr< observer::Filter< MatrixT, electrical::TwoPort, observer::PreparationType< MatrixT > > >(
-         new observer::MatlabFilterTwoPort< MatrixT >( param->GetElementStringValue( "Filename" ) ) );
+         new observer::MatlabFilterTwoPort< MatrixT >( param->GetElementStringValue( "Filename" ),
+                                                       GetMatlabFilterChunkSize( param ) ) );
     }
 };
 
@@ -297,7 +471,8 @@ class ObserverClassWrapperThermal< MatrixT, observer::MatlabFilterThermal >
         UNUSED( arg );
 
         return boost::shared_ptr< observer::Filter< MatrixT, thermal::ThermalElement, observer::ThermalPreperation > >(
-         new observer::MatlabFilterThermal< MatrixT >( param->GetElementStringValue( "Filename" ) ) );
+         new observer::MatlabFilterThermal< MatrixT >( param->GetElementStringValue( "Filename" ),
+                                                       GetMatlabFilterChunkSize( param ) ) );
     }
 };
 
@@ -73,6 +73,12 @@ BuildObserverFactoryTwoPort()
                                  "StdoutFilter" );
     observerFactory->AddWrapper( new ObserverClassWrapperTwoPort< MatrixT, observer::DecimateFilterTwoPort >,
                                  "DecimateFilter" );
+    observerFactory->AddWrapper( new ObserverClassWrapperTwoPort< MatrixT, observer::AsyncFilterTwoPort >,
+                                 "AsyncFilter" );
+    observerFactory->AddWrapper( new ObserverClassWrapperTwoPort< MatrixT, observer::BinaryFilterTwoPort >,
+                                 "BinaryFilter" );
+    observerFactory->AddWrapper( new ObserverClassWrapperTwoPort< MatrixT, observer::SelectFilterTwoPort >( observerFactory ),
+                                 "SelectFilter" );
     AddExternalFilterTwoPort< MatrixT, matlabSupport >( observerFactory );
     return observerFactory;
 }
@@ -90,6 +96,12 @@ BuildObserverFactoryThermal()
                                  "ElementCounterFilter" );
     observerFactory->AddWrapper( new ObserverClassWrapperThermal< MatrixT, observer::DecimateFilterThermal >,
                                  "DecimateFilter" );
+    observerFactory->AddWrapper( new ObserverClassWrapperThermal< MatrixT, observer::AsyncFilterThermal >,
+                                 "AsyncFilter" );
+    observerFactory->AddWrapper( new ObserverClassWrapperThermal< MatrixT, observer::BinaryFilterThermal >,
+                                 "BinaryFilter" );
+    observerFactory->AddWrapper( new ObserverClassWrapperThermal< MatrixT, observer::SelectFilterThermal >( observerFactory ),
+                                 "SelectFilter" );
     AddExternalFilterThermal< MatrixT, matlabSupport >( observerFactory );
     return observerFactory;
 }
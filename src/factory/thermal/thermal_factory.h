@@ -20,6 +20,8 @@ along with this program.  If not, see http://www.gnu.org/licenses/.
 #include <boost/foreach.hpp>
 // C
 #include <cstdlib>
+// STD
+#include <string>
 
 // ETC
 #include "blockfactorybuilder.h"
@@ -77,8 +79,19 @@ class ThermalFactory
                              const vector< shared_ptr< ::state::ThermalState< T > > > *thermalStates,
                              vector< vector< shared_ptr< ThermalState< T > > > > *thermalStatesOfCellBlocks,
                              vector< ::probe::ThermalProbe > *thermalProbes = 0 ) const;
+    /**
+     * Collects the parts of the XML file that CreateThermalModel reads in the same sequence as CreateThermalModel
+     * @param[in] paramXmlRoot  Root element of XML file
+     * @param[out] description Returns the xml text of the thermal part of the model. Parameters of the electrical part
+     * of the model are left out, so that it only changes if the thermal model changes.
+     */
+    void GetThermalModelDescription( const shared_ptr< xmlparser::XmlParameter > &paramXmlRoot, std::string &description ) const;
 
     private:
+    /// Called recursively by GetThermalModelDescription upon RootElement element like ParseRootElement
+    void AppendRootElementDescription( const shared_ptr< xmlparser::XmlParameter > &param, std::string &description ) const;
+    /// Appends the attributes of param that move blocks and count loops
+    void AppendOffsetDescription( const shared_ptr< xmlparser::XmlParameter > &param, std::string &description ) const;
     /**
      * Parses through RootElement element
      *
@@ -362,6 +375,84 @@ void ThermalFactory< T >::ParseRootElement( const shared_ptr< xmlparser::XmlPara
     }
 }
 
+template < typename T >
+void ThermalFactory< T >::GetThermalModelDescription( const shared_ptr< xmlparser::XmlParameter > &paramXmlRoot,
+                                                      std::string &description ) const
+{
+    description.clear();
+
+    const char *thermalNodes[] = {"ThermalMaterials", "CachedCoolings", "CoolingBlocks", "ThermalProbe"};
+    for ( size_t i = 0; i < sizeof( thermalNodes ) / sizeof( thermalNodes[0] ); ++i )
+    {
+        description += thermalNodes[i];
+        description += '\n';
+        if ( paramXmlRoot->HasElement( thermalNodes[i] ) )
+            description += paramXmlRoot->GetElementChild( thermalNodes[i] )->GetElementAsString();
+    }
+
+    AppendRootElementDescription( paramXmlRoot->GetElementChild( "RootElement" ), description );
+}
+
+template < typename T >
+void ThermalFactory< T >::AppendRootElementDescription( const shared_ptr< xmlparser::XmlParameter > &param,
+                                                        std::string &description ) const
+{
+    description += param->GetElementAttribute( "class" );
+    description += '\n';
+
+    // Only the thermal subelements of cells and ohmic resistances are taken, their electrical objects are left out
+    if ( param->HasElement( "ThermalBlock" ) )
+        description += param->GetElementChild( "ThermalBlock" )->GetElementAsString();
+
+    const char *blockNodes[] = {"AdditionalBlocks", "CoolingBlocks"};
+    for ( size_t i = 0; i < sizeof( blockNodes ) / sizeof( blockNodes[0] ); ++i )
+    {
+        if ( !param->HasElement( blockNodes[i] ) )
+            continue;
+
+        description += blockNodes[i];
+        description += '\n';
+        const vector< shared_ptr< xmlparser::XmlParameter > > blocksChildren = param->GetElementChildren( blockNodes[i] );
+        const vector< shared_ptr< xmlparser::XmlParameter > > blocksUnreferencedChildren =
+         param->GetUnreferencedElementChildren( blockNodes[i] );
+        for ( size_t j = 0; j < blocksChildren.size(); ++j )
+        {
+            AppendOffsetDescription( blocksUnreferencedChildren[j], description );
+            description += blocksChildren[j]->GetElementAsString();
+        }
+    }
+
+    if ( param->HasElement( "Children" ) )
+    {
+        description += "Children";
+        AppendOffsetDescription( param->GetElementChild( "Children" ), description );
+        const vector< shared_ptr< xmlparser::XmlParameter > > children = param->GetElementChildren( "Children" );
+        const vector< shared_ptr< xmlparser::XmlParameter > > unreferencedChildren =
+         param->GetUnreferencedElementChildren( "Children" );
+        for ( size_t j = 0; j < children.size(); ++j )
+        {
+            AppendOffsetDescription( unreferencedChildren[j], description );
+            AppendRootElementDescription( children[j], description );
+        }
+    }
+}
+
+template < typename T >
+void ThermalFactory< T >::AppendOffsetDescription( const shared_ptr< xmlparser::XmlParameter > &param,
+                                                   std::string &description ) const
+{
+    const char *attributes[] = {"count", "dx", "dy", "dz"};
+    for ( size_t i = 0; i < sizeof( attributes ) / sizeof( attributes[0] ); ++i )
+        if ( param->HasElementAttribute( attributes[i] ) )
+        {
+            description += ' ';
+            description += attributes[i];
+            description += '=';
+            description += param->GetElementAttribute( attributes[i] );
+        }
+    description += '\n';
+}
+
 template < typename T >
 void ThermalFactory< T >::CreateThermalProbe( const xmlparser::XmlParameter *param, vector< ::probe::ThermalProbe > *thermalProbes ) const
 {
@@ -15,6 +15,8 @@ along with this program.  If not, see http://www.gnu.org/licenses/.
 #ifndef _BLOCK_GEOMETRY_
 #define _BLOCK_GEOMETRY_
 
+#include <algorithm>
+#include <utility>
 #include "geometry2D.h"
 #include "../misc/StrCont.h"
 
@@ -60,13 +62,30 @@ class BlockGeometry
     const char *GetDescription() const;
     /// Returns base area and the extension in z-direction
     const Geometry2D< T > *GetInternalData( T &zLower, T &zUpper ) const;    // UnitTest only
+    /// Returns the smallest box with edges parallel to the coordinate axes that contains this instance
+    void GetBoundingBox( TwoDim< T > &lowerEdge, TwoDim< T > &higherEdge, T &zLower, T &zUpper ) const;
+
     private:
     Geometry2D< T > mBase;
     T mZLower;
     T mZUpper;
     misc::StrCont mDescription;
+    TwoDim< T > mLowerEdge;     ///< Lower edge of the envelope of mBase
+    TwoDim< T > mHigherEdge;    ///< Higher edge of the envelope of mBase
 };
 
+/**
+ * Finds all pairs of blocks whose bounding boxes are not further apart than distance by sweeping along the x-axis and
+ * pruning by y- and z-extension. Two blocks can only collide or be adjacent if they are such a pair, so that the exact
+ * tests of CollidesWith() and IsAdjacentTo() are only needed for these pairs.
+ * @param[in] blocks Blocks to be tested against each other
+ * @param[in] distance Maximum distance between two bounding boxes of a pair
+ * @param[out] candidatePairs Pairs of indices into blocks with the smaller index first, sorted in ascending order
+ */
+template < typename T >
+void FindBoundingBoxCandidatePairs( const vector< const BlockGeometry< T > * > &blocks, T distance,
+                                    vector< std::pair< size_t, size_t > > &candidatePairs );
+
 
 template < typename T >
 BlockGeometry< T >::BlockGeometry( const Geometry2D< T > &base, T zLower, T zUpper, const char *description )
@@ -77,6 +96,8 @@ BlockGeometry< T >::BlockGeometry( const Geometry2D< T > &base, T zLower, T zUpp
 {
     if ( zLower > zUpper )
         ErrorFunction< std::runtime_error >( __FUNCTION__, __LINE__, __FILE__, "zLowerToSmall" );
+
+    mBase.Envelope( mLowerEdge, mHigherEdge );
 }
 
 template < typename T >
@@ -154,5 +175,74 @@ const Geometry2D< T > *BlockGeometry< T >::GetInternalData( T &zLower, T &zUpper
     zUpper = mZUpper;
     return &mBase;
 }
+
+template < typename T >
+void BlockGeometry< T >::GetBoundingBox( TwoDim< T > &lowerEdge, TwoDim< T > &higherEdge, T &zLower, T &zUpper ) const
+{
+    lowerEdge = mLowerEdge;
+    higherEdge = mHigherEdge;
+    zLower = mZLower;
+    zUpper = mZUpper;
+}
+
+/// Orders indices of bounding boxes by the lower end of their extension in x-direction
+template < typename T >
+class BoundingBoxLowerXLess
+{
+    public:
+    explicit BoundingBoxLowerXLess( const vector< TwoDim< T > > &lowerEdges )
+        : mLowerEdges( lowerEdges )
+    {
+    }
+    bool operator()( size_t lhs, size_t rhs ) const { return mLowerEdges[lhs].Get1() < mLowerEdges[rhs].Get1(); }
+
+    private:
+    const vector< TwoDim< T > > &mLowerEdges;
+};
+
+template < typename T >
+void FindBoundingBoxCandidatePairs( const vector< const BlockGeometry< T > * > &blocks, T distance,
+                                    vector< std::pair< size_t, size_t > > &candidatePairs )
+{
+    candidatePairs.clear();
+
+    vector< TwoDim< T > > lowerEdges( blocks.size() );
+    vector< TwoDim< T > > higherEdges( blocks.size() );
+    vector< T > zLowers( blocks.size() );
+    vector< T > zUppers( blocks.size() );
+    vector< size_t > sweepOrder( blocks.size() );
+    for ( size_t i = 0; i < blocks.size(); ++i )
+    {
+        blocks[i]->GetBoundingBox( lowerEdges[i], higherEdges[i], zLowers[i], zUppers[i] );
+        sweepOrder[i] = i;
+    }
+    std::sort( sweepOrder.begin(), sweepOrder.end(), BoundingBoxLowerXLess< T >( lowerEdges ) );
+
+    // Blocks whose extension in x-direction may still reach the block at the sweep position
+    vector< size_t > activeBlocks;
+    for ( size_t k = 0; k < sweepOrder.size(); ++k )
+    {
+        const size_t i = sweepOrder[k];
+
+        size_t remainingBlocks = 0;
+        for ( size_t l = 0; l < activeBlocks.size(); ++l )
+        {
+            const size_t j = activeBlocks[l];
+            if ( higherEdges[j].Get1() + distance < lowerEdges[i].Get1() )
+                continue;
+            activeBlocks[remainingBlocks++] = j;
+
+            if ( higherEdges[j].Get2() + distance < lowerEdges[i].Get2() || higherEdges[i].Get2() + distance < lowerEdges[j].Get2() )
+                continue;
+            if ( zUppers[j] + distance < zLowers[i] || zUppers[i] + distance < zLowers[j] )
+                continue;
+            candidatePairs.push_back( std::make_pair( std::min( i, j ), std::max( i, j ) ) );
+        }
+        activeBlocks.resize( remainingBlocks );
+        activeBlocks.push_back( i );
+    }
+
+    std::sort( candidatePairs.begin(), candidatePairs.end() );
+}
 }
 #endif
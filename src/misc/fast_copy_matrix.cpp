@@ -103,11 +103,21 @@ void FastCopyMatrix( real_T *array, const Eigen::SparseMatrix< double, RowMajor
 template <>
 void FastCopyMatrix( Eigen::SparseMatrix< double, RowMajor > &matrix, const real_T *array, unsigned int numberOfElements )
 {
-    // There might be a faster way...
+    // A compressed column vector whose first rows are all stored can be written without any lookups
+    if ( matrix.isCompressed() && matrix.outerSize() >= static_cast< int >( numberOfElements ) &&
+         matrix.outerIndexPtr()[numberOfElements] == static_cast< int >( numberOfElements ) )
+    {
+        memcpy( (void *)matrix.valuePtr(), array, numberOfElements * sizeof( real_T ) );
+        return;
+    }
+
     for ( unsigned int i = 0; i < numberOfElements; ++i )
     {
         matrix( i, 0 ) = array[i];
     }
+    // Inserting entries leaves the matrix uncompressed. Compressing it once lets the following calls take the memcpy
+    // above, as long as no entry is removed.
+    matrix.makeCompressed();
 }
 
 
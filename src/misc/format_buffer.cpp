@@ -0,0 +1,333 @@
+/*
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see http://www.gnu.org/licenses/.
+*/
+/* -.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.
+* File Name : format_buffer.cpp
+* Creation Date : 17-10-2026
+_._._._._._._._._._._._._._._._._._._._._.*/
+#include "format_buffer.h"
+
+// STD
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+namespace misc
+{
+
+namespace
+{
+const double POWERS_OF_TEN[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+                                1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+const unsigned long long INTEGER_POWERS_OF_TEN[] = {1ULL,
+                                                    10ULL,
+                                                    100ULL,
+                                                    1000ULL,
+                                                    10000ULL,
+                                                    100000ULL,
+                                                    1000000ULL,
+                                                    10000000ULL,
+                                                    100000000ULL,
+                                                    1000000000ULL,
+                                                    10000000000ULL,
+                                                    100000000000ULL,
+                                                    1000000000000ULL,
+                                                    10000000000000ULL,
+                                                    100000000000000ULL,
+                                                    1000000000000000ULL,
+                                                    10000000000000000ULL,
+                                                    100000000000000000ULL};
+// Integers up to 2^53 are exact as double
+const unsigned long long MAX_EXACT_INTEGER = 9007199254740992ULL;
+const unsigned long long MAX_DIGITS = 17;
+
+/// Writes the digits of value and returns the position behind the last one
+char *WriteUnsigned( char *buffer, unsigned long long value )
+{
+    char digits[20];
+    size_t size = 0;
+    do
+    {
+        digits[size++] = static_cast< char >( '0' + value % 10 );
+        value /= 10;
+    } while ( value );
+
+    while ( size )
+        *buffer++ = digits[--size];
+    return buffer;
+}
+
+/// Returns value * 10^scale rounded to the nearest integer. The powers of ten are exact doubles, so fma yields the
+/// exact rounding error of the product and value * 10^scale == scaled + error holds exactly. The result is the same as
+/// rounding the exact product.
+unsigned long long RoundScaled( double value, int scale )
+{
+    const double scaled = value * POWERS_OF_TEN[scale];
+    const double error = std::fma( value, POWERS_OF_TEN[scale], -scaled );
+
+    // Above 2^53 every double is an even integer, so the tie of the sum is resolved like the tie of error
+    if ( scaled >= static_cast< double >( MAX_EXACT_INTEGER ) )
+    {
+        const double roundedError = std::nearbyint( error );
+        return roundedError < 0 ? static_cast< unsigned long long >( scaled ) - static_cast< unsigned long long >( -roundedError )
+                                : static_cast< unsigned long long >( scaled ) + static_cast< unsigned long long >( roundedError );
+    }
+
+    const double lower = std::floor( scaled );
+    // The sign of the rounded sum is the sign of the exact sum
+    const double offset = ( scaled - lower - 0.5 ) + error;
+    unsigned long long result = static_cast< unsigned long long >( lower );
+    if ( offset > 0 || ( offset == 0 && result % 2 ) )
+        ++result;
+    return result;
+}
+
+/// Returns whether mantissa * 10^-scale is read back as the positive value
+bool IsReadBackAs( unsigned long long mantissa, int scale, double value )
+{
+    // Both are exact doubles, so the division is rounded like reading the text back
+    if ( mantissa <= MAX_EXACT_INTEGER )
+        return static_cast< double >( mantissa ) / POWERS_OF_TEN[scale] == value;
+
+    // The text is read back as value if it is closer to value than to the neighbouring doubles. Scaled by 10^scale,
+    // value is scaled + error exactly, and the half distances to the neighbours are exact, as they are a power of two
+    // times an exact power of ten.
+    const double scaled = value * POWERS_OF_TEN[scale];
+    const double error = std::fma( value, POWERS_OF_TEN[scale], -scaled );
+    const double below = ( value - std::nextafter( value, 0.0 ) ) * 0.5 * POWERS_OF_TEN[scale];
+    const double above = ( std::nextafter( value, HUGE_VAL ) - value ) * 0.5 * POWERS_OF_TEN[scale];
+
+    // mantissa - value * 10^scale == difference - error has to lie between -below and above
+    const double difference =
+     static_cast< double >( static_cast< long long >( mantissa - static_cast< unsigned long long >( scaled ) ) );
+    const double lower = difference - above;
+    const double upper = difference + below;
+    if ( error > lower && error < upper )
+        return true;
+
+    // A tie is read back as the double with the even significand
+    unsigned long long bits;
+    std::memcpy( &bits, &value, sizeof( bits ) );
+    return ( error == lower || error == upper ) && bits % 2 == 0;
+}
+
+/// Adds step, which is 1 or -1, to the last digit of the mantissa in front of exponentPosition in text written with %e.
+/// Returns false and leaves text unchanged if the first digit would overflow or become 0.
+bool StepLastDigit( char *text, char *exponentPosition, int step )
+{
+    const char carryDigit = step > 0 ? '9' : '0';
+    char *position = exponentPosition - 1;
+    for ( ; position >= text; --position )
+    {
+        if ( *position == '.' )
+            continue;
+        if ( *position != carryDigit )
+            break;
+    }
+    if ( position < text || *position < '0' || *position > '9' ||
+         ( step < 0 && *position == '1' && ( position == text || position[-1] == '-' ) ) )
+        return false;
+
+    *position = static_cast< char >( *position + step );
+    for ( char *digit = position + 1; digit < exponentPosition; ++digit )
+        if ( *digit != '.' )
+            *digit = step > 0 ? '0' : '9';
+    return true;
+}
+
+/**
+ * Writes the positive value rounded to digits significant digits without exponent.
+ * If checkRoundTrip is true, the text is only written if it is read back as value.
+ * @param[in] exponent Decimal exponent of value, which may be off by one
+ * @return False if value is outside of the range of this function or does not round trip
+ */
+bool WriteFixed( char *&buffer, double value, int exponent, size_t digits, bool checkRoundTrip )
+{
+    if ( exponent < -5 || exponent > 14 )
+        return false;
+
+    // value = mantissa * 10^-scale
+    int scale = static_cast< int >( digits ) - 1 - exponent;
+    if ( scale < 0 || scale > 22 )
+        return false;
+    unsigned long long mantissa = RoundScaled( value, scale );
+    if ( mantissa < INTEGER_POWERS_OF_TEN[digits - 1] && scale < 22 )
+        mantissa = RoundScaled( value, ++scale );
+    else if ( mantissa > INTEGER_POWERS_OF_TEN[digits] && scale > 0 )
+        mantissa = RoundScaled( value, --scale );
+
+    // Rounding up to the next power of ten
+    if ( mantissa == INTEGER_POWERS_OF_TEN[digits] )
+    {
+        mantissa /= 10;
+        --scale;
+    }
+    if ( mantissa < INTEGER_POWERS_OF_TEN[digits - 1] || mantissa >= INTEGER_POWERS_OF_TEN[digits] || scale < 0 )
+        return false;
+
+    if ( checkRoundTrip && !IsReadBackAs( mantissa, scale, value ) )
+        return false;
+
+    while ( scale > 0 && mantissa % 10 == 0 )
+    {
+        mantissa /= 10;
+        --scale;
+    }
+
+    char digitsText[20];
+    const size_t size = WriteUnsigned( digitsText, mantissa ) - digitsText;
+    const size_t integerDigits = size > static_cast< size_t >( scale ) ? size - scale : 0;
+    if ( integerDigits )
+    {
+        std::memcpy( buffer, digitsText, integerDigits );
+        buffer += integerDigits;
+    }
+    else
+        *buffer++ = '0';
+    if ( integerDigits == size )
+        return true;
+
+    *buffer++ = '.';
+    for ( size_t i = size; i < static_cast< size_t >( scale ); ++i )
+        *buffer++ = '0';
+    std::memcpy( buffer, digitsText + integerDigits, size - integerDigits );
+    buffer += size - integerDigits;
+    return true;
+}
+}
+
+char *DoubleToChars( char *buffer, double value, size_t significantDigits )
+{
+    if ( value != value )
+    {
+        std::memcpy( buffer, "nan", 3 );
+        return buffer + 3;
+    }
+    if ( value < 0 )
+    {
+        *buffer++ = '-';
+        value = -value;
+    }
+    if ( value == 0 )
+    {
+        *buffer++ = '0';
+        return buffer;
+    }
+    if ( value > 1.7976931348623157e308 )
+    {
+        std::memcpy( buffer, "inf", 3 );
+        return buffer + 3;
+    }
+
+    const int exponent = static_cast< int >( std::floor( std::log10( value ) ) );
+    if ( significantDigits == 0 )
+    {
+        // 15 digits are enough for most values, 17 correctly rounded digits always round trip
+        if ( WriteFixed( buffer, value, exponent, 15, true ) || WriteFixed( buffer, value, exponent, 16, true ) ||
+             WriteFixed( buffer, value, exponent, MAX_DIGITS, false ) )
+            return buffer;
+
+        // %g drops trailing zeros, so 15 digits give the shortest text if it has up to 15 digits. Subnormal doubles have
+        // fewer significant digits, so the shortest text is searched from one digit on.
+        for ( int digits = value < DBL_MIN ? 1 : 15; digits < 17; ++digits )
+        {
+            const int size = snprintf( buffer, MAX_DOUBLE_CHARS - 1, "%.*g", digits, value );
+            if ( strtod( buffer, 0 ) == value )
+                return buffer + size;
+        }
+
+        // At some powers of two the distance to the lower neighbouring double is only half the distance to the upper
+        // one. Then the correctly rounded 16 digits may not be read back as value, but a neighbour of them is.
+        const int size = snprintf( buffer, MAX_DOUBLE_CHARS - 1, "%.15e", value );
+        char *const exponentPosition = std::strchr( buffer, 'e' );
+        for ( int step = 1; step >= -1; step -= 2 )
+        {
+            if ( StepLastDigit( buffer, exponentPosition, step ) && strtod( buffer, 0 ) == value )
+                return buffer + size;
+            StepLastDigit( buffer, exponentPosition, -step );
+        }
+        return buffer + snprintf( buffer, MAX_DOUBLE_CHARS - 1, "%.17g", value );
+    }
+
+    significantDigits = std::min( significantDigits, static_cast< size_t >( MAX_DIGITS ) );
+    if ( WriteFixed( buffer, value, exponent, significantDigits, false ) )
+        return buffer;
+    return buffer + snprintf( buffer, MAX_DOUBLE_CHARS - 1, "%.*g", static_cast< int >( significantDigits ), value );
+}
+
+FormatBuffer::FormatBuffer( size_t significantDigits, size_t blockSize )
+    : mSignificantDigits( significantDigits )
+    , mBlockSize( blockSize )
+    , mBuffer( blockSize + MAX_DOUBLE_CHARS )
+    , mSize( 0 )
+{
+}
+
+char *FormatBuffer::Reserve( size_t size )
+{
+    if ( mSize + size > mBuffer.size() )
+        mBuffer.resize( 2 * ( mSize + size ) );
+    return &mBuffer[mSize];
+}
+
+FormatBuffer &FormatBuffer::operator<<( double value )
+{
+    char *position = Reserve( MAX_DOUBLE_CHARS );
+    mSize += DoubleToChars( position, value, mSignificantDigits ) - position;
+    return *this;
+}
+
+FormatBuffer &FormatBuffer::operator<<( int value )
+{
+    char *position = Reserve( 12 );
+    char *end = position;
+    if ( value < 0 )
+    {
+        *end++ = '-';
+        end = WriteUnsigned( end, -static_cast< long long >( value ) );
+    }
+    else
+        end = WriteUnsigned( end, value );
+    mSize += end - position;
+    return *this;
+}
+
+FormatBuffer &FormatBuffer::operator<<( size_t value )
+{
+    char *position = Reserve( 20 );
+    mSize += WriteUnsigned( position, value ) - position;
+    return *this;
+}
+
+FormatBuffer &FormatBuffer::operator<<( const char *text )
+{
+    const size_t size = std::strlen( text );
+    std::memcpy( Reserve( size ), text, size );
+    mSize += size;
+    return *this;
+}
+
+bool FormatBuffer::IsFull() const { return mSize >= mBlockSize; }
+
+void FormatBuffer::WriteTo( std::ostream &stream )
+{
+    if ( mSize )
+        stream.write( &mBuffer[0], mSize );
+    mSize = 0;
+}
+
+} /* namespace misc */
@@ -0,0 +1,66 @@
+/*
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see http://www.gnu.org/licenses/.
+*/
+/* -.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.
+* File Name : format_buffer.h
+* Creation Date : 17-10-2026
+_._._._._._._._._._._._._._._._._._._._._.*/
+#ifndef _FORMAT_BUFFER_
+#define _FORMAT_BUFFER_
+
+// STD
+#include <cstddef>
+#include <ostream>
+#include <vector>
+
+namespace misc
+{
+
+/// Maximum number of chars DoubleToChars writes
+const size_t MAX_DOUBLE_CHARS = 32;
+
+/// Writes value as decimal text into buffer without terminating null and returns the position behind the last char.
+/// With significantDigits 0 the shortest text that is read back as the same double is written, otherwise the value is
+/// rounded to significantDigits digits. Values from 1e-5 to 1e15 are written without exponent and without iostreams.
+char *DoubleToChars( char *buffer, double value, size_t significantDigits = 0 );
+
+/// FormatBuffer collects formatted text, so that a file is written in large blocks instead of value by value.
+/// Doubles are formatted with DoubleToChars.
+class FormatBuffer
+{
+    public:
+    /// \param significantDigits see DoubleToChars
+    /// \param blockSize size in bytes from which on IsFull returns true
+    explicit FormatBuffer( size_t significantDigits = 0, size_t blockSize = 1 << 16 );
+
+    FormatBuffer &operator<<( double value );
+    FormatBuffer &operator<<( int value );
+    FormatBuffer &operator<<( size_t value );
+    FormatBuffer &operator<<( const char *text );
+
+    bool IsFull() const;
+    /// Writes the collected text to stream and clears the buffer
+    void WriteTo( std::ostream &stream );
+
+    private:
+    /// Makes room for size more chars and returns the position to write them to
+    char *Reserve( size_t size );
+
+    const size_t mSignificantDigits;
+    const size_t mBlockSize;
+    std::vector< char > mBuffer;
+    size_t mSize;
+};
+} /* namespace misc */
+#endif /* _FORMAT_BUFFER_ */
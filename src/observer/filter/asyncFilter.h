@@ -0,0 +1,459 @@
+/*
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see http://www.gnu.org/licenses/.
+*/
+/* -.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.
+* File Name : asyncFilter.h
+* Creation Date : 17-10-2026
+_._._._._._._._._._._._._._._._._._._._._.*/
+#ifndef _ASYNCFILTER_
+#define _ASYNCFILTER_
+
+// STD
+#include <iostream>
+#include <vector>
+
+// BOOST
+#include <boost/shared_ptr.hpp>
+#ifdef BOOST_THREAD
+#include <boost/atomic.hpp>
+#include <boost/scoped_ptr.hpp>
+#include <boost/thread.hpp>
+#ifdef __EXCEPTIONS__
+#include <boost/exception_ptr.hpp>
+#endif
+#endif
+
+#include "filter.h"
+#include "../../electrical/cellelement.h"
+#include "../../thermal/blocks/elements/thermal_element.h"
+#include "../../exceptions/error_proto.h"
+
+namespace observer
+{
+
+/// Behaviour of AsyncFilter if the writer thread falls behind
+enum AsyncBackpressure
+{
+    ASYNC_BLOCK,       ///< Waits until the writer thread has freed a slot of the queue
+    ASYNC_DROP,        ///< Discards the data if all slots of the queue are occupied
+    ASYNC_DECIMATE    ///< Passes only every second data set if the queue is half full and discards it if the queue is full
+};
+
+/// AsyncSnapshot copies the observed values into a slot of the queue of AsyncFilter and loads them into copies of the
+/// observed objects, which are passed to the following filters. It is specialized for every observed type.
+template < typename T, template < typename > class TConcrete, typename ArgumentType >
+class AsyncSnapshot;
+
+/// Snapshot of electrical::TwoPort, which stores voltage, current, power, SoC and temperature per TwoPort
+template < typename T >
+class AsyncSnapshot< T, electrical::TwoPort, PreparationType< T > >
+{
+    /// Soc that returns the value of the snapshot
+    class SocCopy : public electrical::state::Soc
+    {
+        public:
+        SocCopy()
+            : electrical::state::Soc( 1.0, 0.0, std::vector< double >() )
+            , mValue( 0.0 ){};
+        double GetValue() const { return mValue; };
+        double mValue;
+    };
+
+    struct TwoPortCopy
+    {
+        boost::shared_ptr< electrical::TwoPort< T > > mTwoPort;
+        typename electrical::TwoPort< T >::DataType mValues;
+        boost::shared_ptr< ::state::ThermalState< double > > mThermalState;
+        boost::shared_ptr< SocCopy > mSoc;
+    };
+
+    public:
+    typedef std::vector< electrical::TwoPort< T > * > Data_t;
+    static const size_t VALUES_PER_TWOPORT = 5;
+
+    AsyncSnapshot()
+        : mRootPort( 0 ){};
+    void PrepareFilter( PreparationType< T > &prepData ) { mRootPort = prepData.mRootPort; };
+    void PrepareFollowingFilter( PreparationType< T > &prepData )
+    {
+        if ( !prepData.mRootPort )
+            return;
+        if ( !mRootPortCopy.mTwoPort )
+            mRootPortCopy = CreateCopy( prepData.mRootPort );
+        prepData.mRootPort = mRootPortCopy.mTwoPort.get();
+    };
+    /// Creates the copies of the TwoPorts of data and returns the number of values of a snapshot
+    size_t Initialize( const Data_t &data )
+    {
+        mCopies.resize( data.size() );
+        mCopiedTwoPorts.resize( data.size() );
+        for ( size_t i = 0; i < data.size(); ++i )
+        {
+            mCopies[i] = CreateCopy( data[i] );
+            mCopiedTwoPorts[i] = mCopies[i].mTwoPort.get();
+        }
+        if ( mRootPort && !mRootPortCopy.mTwoPort )
+            mRootPortCopy = CreateCopy( mRootPort );
+        return ( data.size() + 1 ) * VALUES_PER_TWOPORT;
+    };
+    void Save( const Data_t &data, double *values ) const
+    {
+        for ( size_t i = 0; i < data.size(); ++i )
+            SaveTwoPort( data[i], values + i * VALUES_PER_TWOPORT );
+        if ( mRootPort )
+            SaveTwoPort( mRootPort, values + data.size() * VALUES_PER_TWOPORT );
+    };
+    const Data_t &Load( const double *values )
+    {
+        for ( size_t i = 0; i < mCopies.size(); ++i )
+            LoadTwoPort( mCopies[i], values + i * VALUES_PER_TWOPORT );
+        if ( mRootPortCopy.mTwoPort )
+            LoadTwoPort( mRootPortCopy, values + mCopies.size() * VALUES_PER_TWOPORT );
+        return mCopiedTwoPorts;
+    };
+
+    private:
+    static TwoPortCopy CreateCopy( const electrical::TwoPort< T > *twoPort )
+    {
+        TwoPortCopy copy;
+        copy.mValues.reset( new ElectricalDataStruct< electrical::ScalarUnit > );
+        if ( twoPort->IsCellelement() )
+        {
+            copy.mThermalState.reset( new ::state::ThermalState< double > );
+            copy.mSoc.reset( new SocCopy );
+            boost::shared_ptr< electrical::state::Soc > soc( copy.mSoc );
+            copy.mTwoPort.reset( new electrical::Cellelement< T >( copy.mThermalState, soc, true, copy.mValues ) );
+        }
+        else
+            copy.mTwoPort.reset( new electrical::TwoPort< T >( true, copy.mValues ) );
+        return copy;
+    };
+    static void SaveTwoPort( const electrical::TwoPort< T > *twoPort, double *values )
+    {
+        values[0] = twoPort->GetVoltageValue();
+        values[1] = twoPort->GetCurrentValue();
+        values[2] = twoPort->GetPowerValue();
+        if ( twoPort->IsCellelement() )
+        {
+            const electrical::Cellelement< T > *cell = static_cast< const electrical::Cellelement< T > * >( twoPort );
+            values[3] = cell->GetSocStateValue();
+            values[4] = cell->GetThermalState()->GetValue();
+        }
+    };
+    static void LoadTwoPort( TwoPortCopy &copy, const double *values )
+    {
+        copy.mValues->mVoltageValue = values[0];
+        copy.mValues->mCurrentValue = values[1];
+        copy.mValues->mPowerValue = values[2];
+        if ( copy.mSoc )
+        {
+            copy.mSoc->mValue = values[3];
+            copy.mThermalState->ResetTemperature();
+            copy.mThermalState->AddTemperature( values[4], 1.0 );
+        }
+    };
+
+    electrical::TwoPort< T > *mRootPort;
+    std::vector< TwoPortCopy > mCopies;
+    Data_t mCopiedTwoPorts;
+    TwoPortCopy mRootPortCopy;
+};
+
+/// Snapshot of thermal::ThermalElement, which stores the temperature per element
+template < typename T >
+class AsyncSnapshot< T, thermal::ThermalElement, ThermalPreperation >
+{
+    class ThermalElementCopy : public thermal::ThermalElement< T >
+    {
+        public:
+        ThermalElementCopy()
+            : thermal::ThermalElement< T >(){};
+    };
+
+    public:
+    typedef std::vector< thermal::ThermalElement< T > * > Data_t;
+
+    void PrepareFilter( ThermalPreperation &prepData ) { UNUSED( prepData ); };
+    void PrepareFollowingFilter( ThermalPreperation &prepData ) { UNUSED( prepData ); };
+    size_t Initialize( const Data_t &data )
+    {
+        mCopies.resize( data.size() );
+        mCopiedElements.resize( data.size() );
+        for ( size_t i = 0; i < data.size(); ++i )
+            mCopiedElements[i] = &mCopies[i];
+        return data.size();
+    };
+    void Save( const Data_t &data, double *values ) const
+    {
+        for ( size_t i = 0; i < data.size(); ++i )
+            values[i] = data[i]->GetTemperature();
+    };
+    const Data_t &Load( const double *values )
+    {
+        for ( size_t i = 0; i < mCopies.size(); ++i )
+            mCopies[i].SetTemperature( values[i] );
+        return mCopiedElements;
+    };
+
+    private:
+    std::vector< ThermalElementCopy > mCopies;
+    Data_t mCopiedElements;
+};
+
+
+/**
+ * AsyncFilter passes the data to the following filters on a writer thread, so formatting and file output do not block
+ * the simulation. ProcessData copies the observed values into a preallocated slot of a lock-free single producer single
+ * consumer ring buffer. The writer thread loads the slots into copies of the observed objects and passes these to the
+ * following filters. Without BOOST_THREAD the data is passed on directly.
+ */
+template < typename T, template < typename > class TConcrete, typename ArgumentType >
+class AsyncFilter : public Filter< T, TConcrete, ArgumentType >
+{
+    public:
+    typedef Filter< T, TConcrete, ArgumentType > FilterT;
+
+    /**
+     * @param[in] queueSize Number of snapshots that can wait for the writer thread
+     * @param[in] backpressure Behaviour if the writer thread falls behind
+     */
+    AsyncFilter( size_t queueSize = 64, AsyncBackpressure backpressure = ASYNC_BLOCK );
+    /// Writes the queued snapshots, an error of the following filters that has not been thrown yet is printed on
+    /// std::cerr
+    virtual ~AsyncFilter();
+
+    virtual void ProcessData( const typename FilterT::Data_t &data, const double t );
+    virtual void PrepareFilter( ArgumentType &prepData );
+    virtual void PrepareFollowingFilter( ArgumentType &prepData );
+    /// Returns the number of snapshots that have been discarded by the backpressure
+    size_t GetNumberOfDroppedSnapshots() const { return mNumberOfDroppedSnapshots; };
+
+    private:
+    const size_t mQueueSize;
+    const AsyncBackpressure mBackpressure;
+    size_t mNumberOfDroppedSnapshots;
+
+#ifdef BOOST_THREAD
+    /// Passes the queued snapshots to the following filters until the filter is destroyed
+    void Write();
+    /// Waits until the queued snapshots are written and ends the writer thread
+    void Stop();
+    void RethrowWriterError();
+
+    AsyncSnapshot< T, TConcrete, ArgumentType > mSnapshot;
+    size_t mSlotSize;
+    std::vector< double > mSlotValues;
+    std::vector< double > mSlotTimes;
+    bool mSkipSnapshot;
+    // Counters of queued and written snapshots, each of them is only increased by one thread
+    boost::atomic< size_t > mNumberOfQueuedSnapshots;
+    boost::atomic< size_t > mNumberOfWrittenSnapshots;
+    boost::atomic< bool > mTerminate;
+    boost::atomic< bool > mHasWriterError;
+#ifdef __EXCEPTIONS__
+    boost::exception_ptr mWriterError;
+#endif
+    boost::scoped_ptr< boost::thread > mThread;
+#endif
+};
+
+template < typename T, template < typename > class TConcrete, typename ArgumentType >
+AsyncFilter< T, TConcrete, ArgumentType >::AsyncFilter( size_t queueSize, AsyncBackpressure backpressure )
+    : FilterT()
+    , mQueueSize( queueSize )
+    , mBackpressure( backpressure )
+    , mNumberOfDroppedSnapshots( 0 )
+#ifdef BOOST_THREAD
+    , mSlotSize( 0 )
+    , mSkipSnapshot( false )
+    , mNumberOfQueuedSnapshots( 0 )
+    , mNumberOfWrittenSnapshots( 0 )
+    , mTerminate( false )
+    , mHasWriterError( false )
+#endif
+{
+    if ( mQueueSize < 1 )
+        ErrorFunction< std::runtime_error >( __FUNCTION__, __LINE__, __FILE__, "AsyncFilterQueueSizeNotPositive" );
+}
+
+template < typename T, template < typename > class TConcrete, typename ArgumentType >
+AsyncFilter< T, TConcrete, ArgumentType >::~AsyncFilter()
+{
+#ifdef BOOST_THREAD
+    Stop();
+#ifdef __EXCEPTIONS__
+    // The destructor must not throw, so the error of the last snapshots is printed instead
+    try
+    {
+        RethrowWriterError();
+    }
+    catch ( const std::exception &e )
+    {
+        std::cerr << "AsyncFilter could not write all snapshots: " << e.what() << std::endl;
+    }
+    catch ( ... )
+    {
+        std::cerr << "AsyncFilter could not write all snapshots" << std::endl;
+    }
+#endif
+#endif
+}
+
+template < typename T, template < typename > class TConcrete, typename ArgumentType >
+void AsyncFilter< T, TConcrete, ArgumentType >::PrepareFilter( ArgumentType &prepData )
+{
+#ifdef BOOST_THREAD
+    mSnapshot.PrepareFilter( prepData );
+#else
+    UNUSED( prepData );
+#endif
+}
+
+template < typename T, template < typename > class TConcrete, typename ArgumentType >
+void AsyncFilter< T, TConcrete, ArgumentType >::PrepareFollowingFilter( ArgumentType &prepData )
+{
+#ifdef BOOST_THREAD
+    mSnapshot.PrepareFollowingFilter( prepData );
+#else
+    UNUSED( prepData );
+#endif
+}
+
+#ifndef BOOST_THREAD
+template < typename T, template < typename > class TConcrete, typename ArgumentType >
+void AsyncFilter< T, TConcrete, ArgumentType >::ProcessData( const typename FilterT::Data_t &data, const double t )
+{
+    FilterT::ProcessData( data, t );
+}
+#else
+template < typename T, template < typename > class TConcrete, typename ArgumentType >
+void AsyncFilter< T, TConcrete, ArgumentType >::ProcessData( const typename FilterT::Data_t &data, const double t )
+{
+    RethrowWriterError();
+    if ( !this->mNext )
+        return;
+
+    // The copies of the observed objects are created by the simulation thread before the writer thread is started
+    if ( !mThread )
+    {
+        mSlotSize = mSnapshot.Initialize( data );
+        mSlotValues.resize( mQueueSize * mSlotSize );
+        mSlotTimes.resize( mQueueSize );
+        mThread.reset( new boost::thread( &AsyncFilter< T, TConcrete, ArgumentType >::Write, this ) );
+    }
+
+    const size_t queued = mNumberOfQueuedSnapshots.load( boost::memory_order_relaxed );
+    size_t occupiedSlots = queued - mNumberOfWrittenSnapshots.load( boost::memory_order_acquire );
+    if ( mBackpressure == ASYNC_BLOCK )
+    {
+        while ( occupiedSlots == mQueueSize )
+        {
+            boost::this_thread::yield();
+            RethrowWriterError();
+            occupiedSlots = queued - mNumberOfWrittenSnapshots.load( boost::memory_order_acquire );
+        }
+    }
+    else if ( occupiedSlots == mQueueSize )
+    {
+        ++mNumberOfDroppedSnapshots;
+        return;
+    }
+    else if ( mBackpressure == ASYNC_DECIMATE && 2 * occupiedSlots >= mQueueSize )
+    {
+        mSkipSnapshot = !mSkipSnapshot;
+        if ( mSkipSnapshot )
+        {
+            ++mNumberOfDroppedSnapshots;
+            return;
+        }
+    }
+    else
+        mSkipSnapshot = false;
+
+    const size_t slot = queued % mQueueSize;
+    mSnapshot.Save( data, &mSlotValues[slot * mSlotSize] );
+    mSlotTimes[slot] = t;
+    mNumberOfQueuedSnapshots.store( queued + 1, boost::memory_order_release );
+}
+
+template < typename T, template < typename > class TConcrete, typename ArgumentType >
+void AsyncFilter< T, TConcrete, ArgumentType >::Write()
+{
+    while ( true )
+    {
+        const size_t written = mNumberOfWrittenSnapshots.load( boost::memory_order_relaxed );
+        if ( written == mNumberOfQueuedSnapshots.load( boost::memory_order_acquire ) )
+        {
+            // Snapshots queued before mTerminate has been set are still written
+            if ( mTerminate.load( boost::memory_order_acquire ) &&
+                 written == mNumberOfQueuedSnapshots.load( boost::memory_order_acquire ) )
+                return;
+            boost::this_thread::sleep( boost::posix_time::microseconds( 100 ) );
+            continue;
+        }
+
+        // After an error the snapshots are only released, so the simulation thread is not blocked
+        const size_t slot = written % mQueueSize;
+        if ( !mHasWriterError.load( boost::memory_order_relaxed ) )
+        {
+#ifdef __EXCEPTIONS__
+            try
+            {
+#endif
+                FilterT::ProcessData( mSnapshot.Load( &mSlotValues[slot * mSlotSize] ), mSlotTimes[slot] );
+#ifdef __EXCEPTIONS__
+            }
+            catch ( ... )
+            {
+                mWriterError = boost::current_exception();
+                mHasWriterError.store( true, boost::memory_order_release );
+            }
+#endif
+        }
+        mNumberOfWrittenSnapshots.store( written + 1, boost::memory_order_release );
+    }
+}
+
+template < typename T, template < typename > class TConcrete, typename ArgumentType >
+void AsyncFilter< T, TConcrete, ArgumentType >::Stop()
+{
+    if ( !mThread )
+        return;
+    mTerminate.store( true, boost::memory_order_release );
+    mThread->join();
+    mThread.reset();
+}
+
+template < typename T, template < typename > class TConcrete, typename ArgumentType >
+void AsyncFilter< T, TConcrete, ArgumentType >::RethrowWriterError()
+{
+#ifdef __EXCEPTIONS__
+    if ( mHasWriterError.load( boost::memory_order_acquire ) && mWriterError )
+    {
+        const boost::exception_ptr writerError = mWriterError;
+        mWriterError = boost::exception_ptr();
+        boost::rethrow_exception( writerError );
+    }
+#endif
+}
+#endif /* BOOST_THREAD */
+
+template < typename T >
+using AsyncFilterTwoPort = AsyncFilter< T, electrical::TwoPort, PreparationType< T > >;
+
+template < typename T >
+using AsyncFilterThermal = AsyncFilter< T, thermal::ThermalElement, ThermalPreperation >;
+
+} /* END NAMESPACE */
+#endif /* _ASYNCFILTER_ */
@@ -0,0 +1,29 @@
+/*
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see http://www.gnu.org/licenses/.
+*/
+/* -.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.
+* File Name : binaryFilter.cpp
+* Creation Date : 17-10-2026
+_._._._._._._._._._._._._._._._._._._._._.*/
+
+#include "binaryFilter.h"
+
+
+namespace observer
+{
+#ifndef __NO_STRING__
+template class BinaryFilterBase< myMatrixType, electrical::TwoPort, PreparationType< myMatrixType > >;
+template class BinaryFilterBase< double, thermal::ThermalElement, ThermalPreperation >;
+#endif /* __NO_STRING__ */
+} /*namespace*/
@@ -0,0 +1,173 @@
+/*
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see http://www.gnu.org/licenses/.
+*/
+/* -.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.
+* File Name : binaryFilter.h
+* Creation Date : 17-10-2026
+_._._._._._._._._._._._._._._._._._._._._.*/
+#ifndef _BINARY_FILTER_
+#define _BINARY_FILTER_
+
+#ifndef __NO_STRING__
+// BOOST
+#include <boost/foreach.hpp>
+#include <boost/scoped_ptr.hpp>
+
+// STD
+#include <string>
+#include <vector>
+
+#include "../observer.h"
+#include "binaryResultFile.h"
+#include "filter.h"
+
+#include "../../electrical/cellelement.h"
+#include "../../thermal/blocks/elements/thermal_element.h"
+
+namespace observer
+{
+
+/// Binary Filter writes the observed values into a binary result file, see BinaryResultFormat. The values are not
+/// formatted as text, which makes the file smaller and the filter faster than the CsvFilter. The file is written when
+/// the first data arrives, because the number of elements is only known then.
+template < typename T, template < typename > class TConcrete, typename ArgumentType = PreparationType< T > >
+class BinaryFilter : public Filter< T, TConcrete, ArgumentType >
+{
+    public:
+    typedef Filter< T, TConcrete, ArgumentType > FilterT;
+
+    /// \param sizeOfValue Size of the stored values, 4 for float32 or 8 for float64
+    BinaryFilter( std::string filename, size_t sizeOfValue )
+        : FilterT()
+        , mFileName( filename )
+        , mSizeOfValue( sizeOfValue ){};
+
+    protected:
+    void OpenFile( const std::vector< std::string > &names, const std::vector< std::string > &units,
+                   const std::vector< boost::int64_t > &elementIds )
+    {
+        mWriter.reset( new BinaryResultWriter( mFileName, names, units, elementIds, mSizeOfValue ) );
+        mValues.resize( names.size() * elementIds.size() );
+    }
+
+    const std::string mFileName;
+    const size_t mSizeOfValue;
+    boost::scoped_ptr< BinaryResultWriter > mWriter;
+    std::vector< double > mValues;
+};
+
+template < typename T, template < typename > class TConcrete, typename ArgumentType >
+class BinaryFilterBase : public BinaryFilter< T, TConcrete, ArgumentType >
+{
+    public:
+    BinaryFilterBase( std::string filename, size_t sizeOfValue = sizeof( double ) )
+        : BinaryFilter< T, TConcrete, ArgumentType >( filename, sizeOfValue ){};
+};
+
+template < typename T >
+class BinaryFilterBase< T, electrical::TwoPort, PreparationType< T > >
+ : public BinaryFilter< T, electrical::TwoPort, PreparationType< T > >
+{
+    private:
+    electrical::TwoPort< T > *mRootPort;
+
+    public:
+    typedef Filter< T, electrical::TwoPort, PreparationType< T > > FilterT;
+
+    BinaryFilterBase( std::string filename, size_t sizeOfValue = sizeof( double ) )
+        : BinaryFilter< T, electrical::TwoPort, PreparationType< T > >( filename, sizeOfValue )
+        , mRootPort( 0 ){};
+
+    virtual void PrepareFilter( PreparationType< T > &prePareData ) { mRootPort = prePareData.mRootPort; }
+
+    virtual void ProcessData( const typename FilterT::Data_t &data, const double t )
+    {
+        // Like in the CsvFilter the elements are numbered from 1 and the root port has the id -1
+        const size_t numberOfElements = data.size() + ( mRootPort ? 1 : 0 );
+        if ( !this->mWriter )
+        {
+            std::vector< boost::int64_t > elementIds( numberOfElements, -1 );
+            for ( size_t i = 0; i < data.size(); ++i )
+                elementIds[i] = i + 1;
+
+            const char *names[] = {"Voltage", "Current", "Power", "SOC", "Temperature"};
+            const char *units[] = {"V", "A", "W", "%", "°C"};
+            this->OpenFile( std::vector< std::string >( names, names + 5 ), std::vector< std::string >( units, units + 5 ),
+                            elementIds );
+        }
+
+        for ( size_t i = 0; i < numberOfElements; ++i )
+        {
+            electrical::TwoPort< T > *port = i < data.size() ? data[i] : mRootPort;
+            this->mValues[i] = port->GetVoltageValue();
+            this->mValues[numberOfElements + i] = port->GetCurrentValue();
+            this->mValues[2 * numberOfElements + i] = port->GetPowerValue();
+
+            if ( port->IsCellelement() )
+            {
+                electrical::Cellelement< T > *cell = static_cast< electrical::Cellelement< T > * >( port );
+                this->mValues[3 * numberOfElements + i] = cell->GetSocStateValue();
+                this->mValues[4 * numberOfElements + i] = cell->GetThermalState()->GetValue();
+            }
+            else
+            {
+                this->mValues[3 * numberOfElements + i] = -1.0;
+                this->mValues[4 * numberOfElements + i] = -273;
+            }
+        }
+        this->mWriter->Write( t, this->mValues );
+        FilterT::ProcessData( data, t );
+    }
+};
+
+template < typename T >
+class BinaryFilterBase< T, thermal::ThermalElement, ThermalPreperation >
+ : public BinaryFilter< T, thermal::ThermalElement, ThermalPreperation >
+{
+    public:
+    typedef Filter< T, thermal::ThermalElement, ThermalPreperation > FilterT;
+
+    BinaryFilterBase( std::string filename, size_t sizeOfValue = sizeof( double ) )
+        : BinaryFilter< T, thermal::ThermalElement, ThermalPreperation >( filename, sizeOfValue ){};
+
+    virtual void ProcessData( const typename FilterT::Data_t &data, const double t )
+    {
+        if ( !this->mWriter )
+        {
+            std::vector< boost::int64_t > elementIds( data.size() );
+            for ( size_t i = 0; i < data.size(); ++i )
+                elementIds[i] = i + 1;
+            this->OpenFile( std::vector< std::string >( 1, "Temperature" ), std::vector< std::string >( 1, "°C" ), elementIds );
+        }
+
+        size_t element = 0;
+        BOOST_FOREACH ( const thermal::ThermalElement< T > *thermalElement, data )
+        {
+            this->mValues[element] = thermalElement->GetTemperature();
+            ++element;
+        }
+        this->mWriter->Write( t, this->mValues );
+        FilterT::ProcessData( data, t );
+    }
+};
+
+template < typename T >
+using BinaryFilterTwoPort = BinaryFilterBase< T, electrical::TwoPort, PreparationType< T > >;
+
+template < typename T >
+using BinaryFilterThermal = BinaryFilterBase< T, thermal::ThermalElement, ThermalPreperation >;
+}
+
+#endif /* __NO_STRING__ */
+#endif /* _BINARY_FILTER_ */
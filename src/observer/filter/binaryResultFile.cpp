@@ -0,0 +1,324 @@
+/*
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see http://www.gnu.org/licenses/.
+*/
+/* -.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.
+* File Name : binaryResultFile.cpp
+* Creation Date : 17-10-2026
+_._._._._._._._._._._._._._._._._._._._._.*/
+
+#include "binaryResultFile.h"
+
+// STD
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+// ETC
+#include "../../exceptions/error_proto.h"
+
+namespace observer
+{
+
+const boost::uint64_t BinaryResultFormat::MAGIC_NUMBER;
+const boost::uint64_t BinaryResultFormat::FORMAT_VERSION;
+
+size_t BinaryResultFormat::Align( size_t size ) { return ( size + 7 ) & ~static_cast< size_t >( 7 ); }
+
+size_t BinaryResultFormat::GetSizeOfColumnBlock( size_t sizeOfValue, size_t numberOfElements, size_t recordsPerChunk )
+{
+    return Align( sizeOfValue * numberOfElements * recordsPerChunk );
+}
+
+size_t BinaryResultFormat::GetSizeOfChunk( size_t sizeOfValue, size_t numberOfQuantities, size_t numberOfElements,
+                                           size_t recordsPerChunk )
+{
+    return GetColumnBlockOffset( sizeOfValue, numberOfElements, recordsPerChunk, numberOfQuantities );
+}
+
+size_t BinaryResultFormat::GetColumnBlockOffset( size_t sizeOfValue, size_t numberOfElements, size_t recordsPerChunk,
+                                                 size_t quantity )
+{
+    // Number of records and the time column come first
+    return sizeof( boost::uint64_t ) + recordsPerChunk * sizeof( double ) +
+           quantity * GetSizeOfColumnBlock( sizeOfValue, numberOfElements, recordsPerChunk );
+}
+
+BinaryResultWriter::BinaryResultWriter( const std::string &fileName, const std::vector< std::string > &names,
+                                        const std::vector< std::string > &units,
+                                        const std::vector< boost::int64_t > &elementIds, size_t sizeOfValue, size_t bufferSize )
+    : mFileName( fileName )
+    , mSizeOfValue( sizeOfValue )
+    , mNumberOfQuantities( names.size() )
+    , mNumberOfElements( elementIds.size() )
+    , mRecordsPerChunk( std::max< size_t >( bufferSize / ( sizeof( double ) + sizeOfValue * names.size() * elementIds.size() ), 1 ) )
+    , mNumberOfBufferedRecords( 0 )
+{
+    mChunk.resize( BinaryResultFormat::GetSizeOfChunk( mSizeOfValue, mNumberOfQuantities, mNumberOfElements, mRecordsPerChunk ) );
+    mColumnBlockOffsets.resize( mNumberOfQuantities );
+    std::vector< boost::uint64_t > columnBlockIndex( mNumberOfQuantities );
+    for ( size_t i = 0; i < mNumberOfQuantities; ++i )
+    {
+        mColumnBlockOffsets[i] =
+         BinaryResultFormat::GetColumnBlockOffset( mSizeOfValue, mNumberOfElements, mRecordsPerChunk, i );
+        columnBlockIndex[i] = mColumnBlockOffsets[i];
+    }
+
+    mFile.open( mFileName.c_str(), std::ios::out | std::ios::binary | std::ios::trunc );
+    if ( !mFile )
+        ErrorFunction< std::runtime_error >( __FUNCTION__, __LINE__, __FILE__, "BinaryResultFileNotWritable", mFileName.c_str() );
+
+    std::vector< char > namesAndUnits;
+    for ( size_t i = 0; i < names.size(); ++i )
+    {
+        namesAndUnits.insert( namesAndUnits.end(), names[i].begin(), names[i].end() );
+        namesAndUnits.push_back( '\0' );
+        namesAndUnits.insert( namesAndUnits.end(), units[i].begin(), units[i].end() );
+        namesAndUnits.push_back( '\0' );
+    }
+    namesAndUnits.resize( BinaryResultFormat::Align( namesAndUnits.size() ), '\0' );
+
+    BinaryResultFormat::Header header;
+    header.mMagicNumber = BinaryResultFormat::MAGIC_NUMBER;
+    header.mFormatVersion = BinaryResultFormat::FORMAT_VERSION;
+    header.mSizeOfValue = mSizeOfValue;
+    header.mNumberOfQuantities = mNumberOfQuantities;
+    header.mNumberOfElements = mNumberOfElements;
+    header.mSizeOfHeader = sizeof( header ) + mNumberOfElements * sizeof( boost::int64_t ) +
+                           mNumberOfQuantities * sizeof( boost::uint64_t ) + namesAndUnits.size();
+    header.mRecordsPerChunk = mRecordsPerChunk;
+    header.mSizeOfChunk = mChunk.size();
+
+    mFile.write( reinterpret_cast< const char * >( &header ), sizeof( header ) );
+    if ( !elementIds.empty() )
+        mFile.write( reinterpret_cast< const char * >( &elementIds[0] ), elementIds.size() * sizeof( boost::int64_t ) );
+    if ( !columnBlockIndex.empty() )
+        mFile.write( reinterpret_cast< const char * >( &columnBlockIndex[0] ), columnBlockIndex.size() * sizeof( boost::uint64_t ) );
+    if ( !namesAndUnits.empty() )
+        mFile.write( &namesAndUnits[0], namesAndUnits.size() );
+    if ( !mFile )
+        ErrorFunction< std::runtime_error >( __FUNCTION__, __LINE__, __FILE__, "BinaryResultFileNotWritable", mFileName.c_str() );
+}
+
+BinaryResultWriter::~BinaryResultWriter()
+{
+    if ( mNumberOfBufferedRecords )
+        WriteChunk();
+    mFile.close();
+}
+
+void BinaryResultWriter::Write( double time, const std::vector< double > &values )
+{
+    if ( values.size() != mNumberOfQuantities * mNumberOfElements )
+        ErrorFunction< std::runtime_error >( __FUNCTION__, __LINE__, __FILE__, "BinaryResultRecordSize", values.size(),
+                                             mNumberOfQuantities * mNumberOfElements );
+
+    std::memcpy( &mChunk[sizeof( boost::uint64_t ) + mNumberOfBufferedRecords * sizeof( double )], &time, sizeof( double ) );
+    if ( mSizeOfValue == sizeof( float ) )
+        CopyValues< float >( values );
+    else
+        CopyValues< double >( values );
+
+    ++mNumberOfBufferedRecords;
+    if ( mNumberOfBufferedRecords == mRecordsPerChunk )
+        Flush();
+}
+
+template < typename ValueT >
+void BinaryResultWriter::CopyValues( const std::vector< double > &values )
+{
+    // values holds the point of time of all columns, so it is scattered into the columns at the slot of this record
+    for ( size_t quantity = 0; quantity < mNumberOfQuantities; ++quantity )
+    {
+        char *position = &mChunk[mColumnBlockOffsets[quantity] + mNumberOfBufferedRecords * sizeof( ValueT )];
+        const double *quantityValues = &values[quantity * mNumberOfElements];
+        for ( size_t element = 0; element < mNumberOfElements; ++element, position += mRecordsPerChunk * sizeof( ValueT ) )
+        {
+            const ValueT value = static_cast< ValueT >( quantityValues[element] );
+            std::memcpy( position, &value, sizeof( ValueT ) );
+        }
+    }
+}
+
+void BinaryResultWriter::WriteChunk()
+{
+    const boost::uint64_t numberOfRecords = mNumberOfBufferedRecords;
+    std::memcpy( &mChunk[0], &numberOfRecords, sizeof( numberOfRecords ) );
+    mFile.write( &mChunk[0], mChunk.size() );
+
+    // Slots that are not filled by the next chunk are written as zeros
+    std::fill( mChunk.begin(), mChunk.end(), '\0' );
+    mNumberOfBufferedRecords = 0;
+}
+
+void BinaryResultWriter::Flush()
+{
+    if ( !mNumberOfBufferedRecords )
+        return;
+
+    WriteChunk();
+    mFile.flush();
+    if ( !mFile )
+        ErrorFunction< std::runtime_error >( __FUNCTION__, __LINE__, __FILE__, "BinaryResultFileNotWritable", mFileName.c_str() );
+}
+
+BinaryResultReader::BinaryResultReader( const std::string &fileName )
+{
+    // Mapping an empty or missing file throws, so both are checked before
+    {
+        std::ifstream file( fileName.c_str(), std::ios::in | std::ios::binary | std::ios::ate );
+        if ( !file || file.tellg() < static_cast< std::streamoff >( sizeof( BinaryResultFormat::Header ) ) )
+            ErrorFunction< std::runtime_error >( __FUNCTION__, __LINE__, __FILE__, "BinaryResultFileInvalid", fileName.c_str() );
+    }
+
+    mMapping.reset( new boost::interprocess::file_mapping( fileName.c_str(), boost::interprocess::read_only ) );
+    mRegion.reset( new boost::interprocess::mapped_region( *mMapping, boost::interprocess::read_only ) );
+    const char *begin = static_cast< const char * >( mRegion->get_address() );
+    const size_t size = mRegion->get_size();
+
+    std::memcpy( &mHeader, begin, sizeof( mHeader ) );
+    if ( mHeader.mMagicNumber != BinaryResultFormat::MAGIC_NUMBER ||
+         mHeader.mFormatVersion != BinaryResultFormat::FORMAT_VERSION ||
+         ( mHeader.mSizeOfValue != sizeof( float ) && mHeader.mSizeOfValue != sizeof( double ) ) ||
+         mHeader.mSizeOfHeader > size || !mHeader.mRecordsPerChunk ||
+         mHeader.mSizeOfChunk != BinaryResultFormat::GetSizeOfChunk( mHeader.mSizeOfValue, mHeader.mNumberOfQuantities,
+                                                                     mHeader.mNumberOfElements, mHeader.mRecordsPerChunk ) ||
+         sizeof( mHeader ) + mHeader.mNumberOfElements * sizeof( boost::int64_t ) +
+          mHeader.mNumberOfQuantities * sizeof( boost::uint64_t ) >
+          mHeader.mSizeOfHeader )
+        ErrorFunction< std::runtime_error >( __FUNCTION__, __LINE__, __FILE__, "BinaryResultFileInvalid", fileName.c_str() );
+
+    const char *position = begin + sizeof( mHeader );
+    mElementIds.resize( mHeader.mNumberOfElements );
+    if ( !mElementIds.empty() )
+        std::memcpy( &mElementIds[0], position, mElementIds.size() * sizeof( boost::int64_t ) );
+    position += mElementIds.size() * sizeof( boost::int64_t );
+
+    mColumnBlockOffsets.resize( mHeader.mNumberOfQuantities );
+    if ( !mColumnBlockOffsets.empty() )
+        std::memcpy( &mColumnBlockOffsets[0], position, mColumnBlockOffsets.size() * sizeof( boost::uint64_t ) );
+    position += mColumnBlockOffsets.size() * sizeof( boost::uint64_t );
+    for ( size_t i = 0; i < mColumnBlockOffsets.size(); ++i )
+        if ( mColumnBlockOffsets[i] + BinaryResultFormat::GetSizeOfColumnBlock( mHeader.mSizeOfValue, mHeader.mNumberOfElements,
+                                                                                mHeader.mRecordsPerChunk ) >
+             mHeader.mSizeOfChunk )
+            ErrorFunction< std::runtime_error >( __FUNCTION__, __LINE__, __FILE__, "BinaryResultFileInvalid", fileName.c_str() );
+
+    const char *end = begin + mHeader.mSizeOfHeader;
+    for ( size_t i = 0; i < mHeader.mNumberOfQuantities; ++i )
+    {
+        const char *name = position;
+        position = std::find( position, end, '\0' );
+        const char *unit = position + 1;
+        if ( position == end || unit == end )
+            ErrorFunction< std::runtime_error >( __FUNCTION__, __LINE__, __FILE__, "BinaryResultFileInvalid", fileName.c_str() );
+        position = std::find( unit, end, '\0' );
+        if ( position == end )
+            ErrorFunction< std::runtime_error >( __FUNCTION__, __LINE__, __FILE__, "BinaryResultFileInvalid", fileName.c_str() );
+        mNames.push_back( std::string( name, unit - 1 ) );
+        mUnits.push_back( std::string( unit, position ) );
+        ++position;
+    }
+
+    // Only the number of records has to be read from every chunk to find the chunk of a record
+    const size_t numberOfChunks = ( size - mHeader.mSizeOfHeader ) / mHeader.mSizeOfChunk;
+    mFirstRecordOfChunk.resize( numberOfChunks + 1, 0 );
+    for ( size_t i = 0; i < numberOfChunks; ++i )
+    {
+        boost::uint64_t numberOfRecords;
+        std::memcpy( &numberOfRecords, end + i * mHeader.mSizeOfChunk, sizeof( numberOfRecords ) );
+        if ( numberOfRecords > mHeader.mRecordsPerChunk )
+            ErrorFunction< std::runtime_error >( __FUNCTION__, __LINE__, __FILE__, "BinaryResultFileInvalid", fileName.c_str() );
+        mFirstRecordOfChunk[i + 1] = mFirstRecordOfChunk[i] + numberOfRecords;
+    }
+}
+
+size_t BinaryResultReader::GetNumberOfQuantities() const { return mHeader.mNumberOfQuantities; }
+
+size_t BinaryResultReader::GetNumberOfElements() const { return mHeader.mNumberOfElements; }
+
+size_t BinaryResultReader::GetNumberOfRecords() const { return mFirstRecordOfChunk.back(); }
+
+size_t BinaryResultReader::GetSizeOfValue() const { return mHeader.mSizeOfValue; }
+
+const std::string &BinaryResultReader::GetName( size_t quantity ) const { return mNames.at( quantity ); }
+
+const std::string &BinaryResultReader::GetUnit( size_t quantity ) const { return mUnits.at( quantity ); }
+
+boost::int64_t BinaryResultReader::GetElementId( size_t element ) const { return mElementIds.at( element ); }
+
+const char *BinaryResultReader::GetChunk( size_t record, size_t &slot ) const
+{
+    if ( record >= GetNumberOfRecords() )
+        ErrorFunction< std::out_of_range >( __FUNCTION__, __LINE__, __FILE__, "OutOfBound", record, GetNumberOfRecords() );
+
+    // Only a flushed chunk can be incomplete, so the chunk is usually found at the first guess
+    size_t chunk = std::min( record / mHeader.mRecordsPerChunk, mFirstRecordOfChunk.size() - 2 );
+    if ( mFirstRecordOfChunk[chunk] > record || mFirstRecordOfChunk[chunk + 1] <= record )
+        chunk = std::upper_bound( mFirstRecordOfChunk.begin(), mFirstRecordOfChunk.end(), record ) - mFirstRecordOfChunk.begin() - 1;
+
+    slot = record - mFirstRecordOfChunk[chunk];
+    return static_cast< const char * >( mRegion->get_address() ) + mHeader.mSizeOfHeader + chunk * mHeader.mSizeOfChunk;
+}
+
+const char *BinaryResultReader::GetValueColumn( const char *chunk, size_t quantity, size_t element ) const
+{
+    if ( quantity >= mHeader.mNumberOfQuantities || element >= mHeader.mNumberOfElements )
+        ErrorFunction< std::out_of_range >( __FUNCTION__, __LINE__, __FILE__, "OutOfBound", element, mHeader.mNumberOfElements );
+    return chunk + mColumnBlockOffsets[quantity] + element * mHeader.mRecordsPerChunk * mHeader.mSizeOfValue;
+}
+
+double BinaryResultReader::ReadValue( const char *position ) const
+{
+    if ( mHeader.mSizeOfValue == sizeof( float ) )
+    {
+        float value;
+        std::memcpy( &value, position, sizeof( float ) );
+        return value;
+    }
+    double value;
+    std::memcpy( &value, position, sizeof( double ) );
+    return value;
+}
+
+double BinaryResultReader::GetTime( size_t record ) const
+{
+    size_t slot;
+    double time;
+    std::memcpy( &time, GetChunk( record, slot ) + sizeof( boost::uint64_t ) + slot * sizeof( double ), sizeof( double ) );
+    return time;
+}
+
+double BinaryResultReader::GetValue( size_t record, size_t quantity, size_t element ) const
+{
+    size_t slot;
+    const char *chunk = GetChunk( record, slot );
+    return ReadValue( GetValueColumn( chunk, quantity, element ) + slot * mHeader.mSizeOfValue );
+}
+
+void BinaryResultReader::GetValues( size_t quantity, size_t element, std::vector< double > &values ) const
+{
+    if ( quantity >= mHeader.mNumberOfQuantities || element >= mHeader.mNumberOfElements )
+        ErrorFunction< std::out_of_range >( __FUNCTION__, __LINE__, __FILE__, "OutOfBound", element, mHeader.mNumberOfElements );
+
+    values.resize( GetNumberOfRecords() );
+    const char *chunk = static_cast< const char * >( mRegion->get_address() ) + mHeader.mSizeOfHeader;
+    for ( size_t i = 0; i + 1 < mFirstRecordOfChunk.size(); ++i, chunk += mHeader.mSizeOfChunk )
+    {
+        const char *position = GetValueColumn( chunk, quantity, element );
+        for ( size_t record = mFirstRecordOfChunk[i]; record < mFirstRecordOfChunk[i + 1]; ++record, position += mHeader.mSizeOfValue )
+            values[record] = ReadValue( position );
+    }
+}
+
+} /* namespace observer */
@@ -0,0 +1,145 @@
+/*
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see http://www.gnu.org/licenses/.
+*/
+/* -.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.
+* File Name : binaryResultFile.h
+* Creation Date : 17-10-2026
+_._._._._._._._._._._._._._._._._._._._._.*/
+#ifndef _BINARY_RESULT_FILE_
+#define _BINARY_RESULT_FILE_
+
+// STD
+#include <fstream>
+#include <string>
+#include <vector>
+
+// BOOST
+#include <boost/cstdint.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/scoped_ptr.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+namespace observer
+{
+
+/**
+ * Layout of the binary result files written by BinaryFilter.
+ * The file starts with a Header, followed by the id of every element as int64, the index of the column blocks as the
+ * offset of every quantity within a chunk as uint64 and the name and unit of every quantity as null terminated strings,
+ * padded to 8 bytes. Then the values follow in chunks of mRecordsPerChunk points of time. Each chunk holds the number
+ * of points of time stored in it as uint64, a column with the times as float64 and one column block per quantity. A
+ * column block holds the consecutive values of one element after the other, so that the time series of an element is
+ * contiguous within a chunk, and is padded to 8 bytes. Columns of a chunk that is not full are filled up, so that all
+ * chunks have the same size. The values are stored as float32 or float64 in the byte order of the writing machine. The
+ * number of chunks follows from the file size, so a file that has been cut by a crash can still be read up to the last
+ * complete chunk.
+ */
+struct BinaryResultFormat
+{
+    static const boost::uint64_t MAGIC_NUMBER = 0x544c535241455349ULL;    // "ISEARSLT"
+    static const boost::uint64_t FORMAT_VERSION = 2;
+
+    struct Header
+    {
+        boost::uint64_t mMagicNumber;
+        boost::uint64_t mFormatVersion;
+        boost::uint64_t mSizeOfValue;
+        boost::uint64_t mNumberOfQuantities;
+        boost::uint64_t mNumberOfElements;
+        boost::uint64_t mSizeOfHeader;
+        boost::uint64_t mRecordsPerChunk;
+        boost::uint64_t mSizeOfChunk;
+    };
+
+    /// Returns size rounded up to a multiple of 8
+    static size_t Align( size_t size );
+    static size_t GetSizeOfColumnBlock( size_t sizeOfValue, size_t numberOfElements, size_t recordsPerChunk );
+    static size_t GetSizeOfChunk( size_t sizeOfValue, size_t numberOfQuantities, size_t numberOfElements, size_t recordsPerChunk );
+    /// Returns the offset of the column block of quantity within a chunk
+    static size_t GetColumnBlockOffset( size_t sizeOfValue, size_t numberOfElements, size_t recordsPerChunk, size_t quantity );
+};
+
+/// Writes a binary result file. The points of time are collected in a chunk of at most bufferSize bytes, which is
+/// transposed into columns while writing into it and is written at once when it is full
+struct BinaryResultWriter : private boost::noncopyable
+{
+    /**
+     * @param[in] names Names of the quantities
+     * @param[in] units Units of the quantities
+     * @param[in] elementIds Id of every element
+     * @param[in] sizeOfValue Size of the stored values, 4 for float32 or 8 for float64
+     * @param[in] bufferSize Size of a chunk in bytes, a chunk holds at least one point of time
+     */
+    BinaryResultWriter( const std::string &fileName, const std::vector< std::string > &names,
+                        const std::vector< std::string > &units, const std::vector< boost::int64_t > &elementIds,
+                        size_t sizeOfValue, size_t bufferSize = 1 << 20 );
+    /// The destructor writes the buffered chunk
+    ~BinaryResultWriter();
+    /// Appends a point of time, values holds the values of all elements for each quantity in turn
+    void Write( double time, const std::vector< double > &values );
+    /// Writes the buffered chunk to the file, even if it is not full
+    void Flush();
+
+    private:
+    template < typename ValueT >
+    void CopyValues( const std::vector< double > &values );
+    void WriteChunk();
+
+    const std::string mFileName;
+    const size_t mSizeOfValue;
+    const size_t mNumberOfQuantities;
+    const size_t mNumberOfElements;
+    const size_t mRecordsPerChunk;
+    std::vector< size_t > mColumnBlockOffsets;
+    std::vector< char > mChunk;
+    size_t mNumberOfBufferedRecords;
+    std::ofstream mFile;
+};
+
+/// Reads a binary result file, which is memory mapped
+struct BinaryResultReader : private boost::noncopyable
+{
+    explicit BinaryResultReader( const std::string &fileName );
+    size_t GetNumberOfQuantities() const;
+    size_t GetNumberOfElements() const;
+    /// Returns the number of points of time in complete chunks
+    size_t GetNumberOfRecords() const;
+    size_t GetSizeOfValue() const;
+    const std::string &GetName( size_t quantity ) const;
+    const std::string &GetUnit( size_t quantity ) const;
+    boost::int64_t GetElementId( size_t element ) const;
+    double GetTime( size_t record ) const;
+    double GetValue( size_t record, size_t quantity, size_t element ) const;
+    /// Returns the values of an element for all points of time, which are read column by column
+    void GetValues( size_t quantity, size_t element, std::vector< double > &values ) const;
+
+    private:
+    /// Returns the chunk that holds record and sets slot to the position of record within it
+    const char *GetChunk( size_t record, size_t &slot ) const;
+    const char *GetValueColumn( const char *chunk, size_t quantity, size_t element ) const;
+    double ReadValue( const char *position ) const;
+
+    boost::scoped_ptr< boost::interprocess::file_mapping > mMapping;
+    boost::scoped_ptr< boost::interprocess::mapped_region > mRegion;
+    BinaryResultFormat::Header mHeader;
+    std::vector< boost::int64_t > mElementIds;
+    std::vector< boost::uint64_t > mColumnBlockOffsets;
+    std::vector< std::string > mNames;
+    std::vector< std::string > mUnits;
+    /// Index of the first record of every chunk, followed by the number of records
+    std::vector< size_t > mFirstRecordOfChunk;
+};
+} /* namespace observer */
+#endif /* _BINARY_RESULT_FILE_ */
@@ -27,8 +27,6 @@ _._._._._._._._._._._._._._._._._._._._._.*/
 
 // STD
 #include <fstream>
-#include <iomanip>
-#include <limits>
 #include <string>
 
 #include "../observer.h"
@@ -36,30 +34,46 @@ _._._._._._._._._._._._._._._._._._._._._.*/
 #include "filter.h"
 
 #include "../../electrical/cellelement.h"
+#include "../../misc/format_buffer.h"
 #include "../../thermal/blocks/elements/thermal_element.h"
 
 namespace observer
 {
 
 /// CSV Filter for electrical TwoPorts. Puts Voltage, Current, Power and SOC if availabe into a file
+/// The values are formatted into mBuffer, which is written to the file in large blocks and not after every line.
+/// With significantDigits 0 every value is written with the shortest text that is read back as the same value.
 template < typename T, template < typename > class TConcrete, typename ArgumentType = PreparationType< T > >
 class CsvFilter : public Filter< T, TConcrete, ArgumentType >
 {
     public:
     typedef Filter< T, TConcrete, ArgumentType > FilterT;
-    CsvFilter( std::string filename );
+    CsvFilter( std::string filename, size_t significantDigits = 0 );
     virtual void PrintHeader() = 0;
-    virtual ~CsvFilter() { mFilestream.close(); };
+    virtual ~CsvFilter()
+    {
+        mBuffer.WriteTo( mFilestream );
+        mFilestream.close();
+    };
     // virtual void ProcessData( const typename FilterT::Data_t& data, const double t );
 
     protected:
+    /// Writes mBuffer to the file if enough lines have been collected
+    void WriteBuffer()
+    {
+        if ( mBuffer.IsFull() )
+            mBuffer.WriteTo( mFilestream );
+    }
+
     std::vector< double > mTimes;
     std::ofstream mFilestream;
+    misc::FormatBuffer mBuffer;
 };
 
 template < typename T, template < typename > class TConcrete, typename ArgumentType >
-CsvFilter< T, TConcrete, ArgumentType >::CsvFilter( std::string filename )
+CsvFilter< T, TConcrete, ArgumentType >::CsvFilter( std::string filename, size_t significantDigits )
     : FilterT()
+    , mBuffer( significantDigits )
 {
     size_t found = filename.find_last_of( ".csv" );
     const unsigned offset = 4;
@@ -70,17 +84,14 @@ CsvFilter< T, TConcrete, ArgumentType >::CsvFilter( std::string filename )
 
     if ( !mFilestream.is_open() )
         ErrorFunction< CantOpenFile >( __FUNCTION__, __LINE__, __FILE__, "FileNotWorking", filename.c_str() );
-
-    mFilestream << std::fixed << std::setprecision( std::numeric_limits< double >::digits10 + 1 );
-    mFilestream << std::fixed << std::setprecision( std::numeric_limits< double >::digits10 + 1 );
 }
 
 template < typename T, template < typename > class TConcrete, typename ArgumentType >
 class CsvFilterBase : public CsvFilter< T, TConcrete, ArgumentType >
 {
     public:
-    CsvFilterBase( std::string filename, bool printHeader = true )
-        : CsvFilter< T, TConcrete, ArgumentType >( filename ){};
+    CsvFilterBase( std::string filename, bool printHeader = true, size_t significantDigits = 0 )
+        : CsvFilter< T, TConcrete, ArgumentType >( filename, significantDigits ){};
 };
 
 template < typename T >
@@ -90,11 +101,35 @@ class CsvFilterBase< T, electrical::TwoPort, PreparationType< T > >
     private:
     electrical::TwoPort< T >* mRootPort;
 
+    void PrintPort( const double t, const int elementNumber, electrical::TwoPort< T >* port )
+    {
+        misc::FormatBuffer& buffer = this->mBuffer;
+        buffer << t << "," << elementNumber;
+        buffer << "," << port->GetVoltageValue();
+        buffer << "," << port->GetCurrentValue();
+        buffer << "," << port->GetPowerValue();
+
+        if ( port->IsCellelement() )
+        {
+            electrical::Cellelement< T >* cell = static_cast< electrical::Cellelement< T >* >( port );
+
+            buffer << "," << cell->GetSocStateValue();
+            buffer << "," << cell->GetThermalState()->GetValue();
+        }
+        else
+        {
+            buffer << "," << -1.0;
+            buffer << "," << -273;
+        }
+
+        buffer << "\n";
+    }
+
     public:
     typedef Filter< T, electrical::TwoPort, PreparationType< T > > FilterT;
 
-    CsvFilterBase( std::string filename, bool printHeader = true )
-        : CsvFilter< T, electrical::TwoPort, PreparationType< T > >( filename )
+    CsvFilterBase( std::string filename, bool printHeader = true, size_t significantDigits = 0 )
+        : CsvFilter< T, electrical::TwoPort, PreparationType< T > >( filename, significantDigits )
     {
         if ( printHeader )
             PrintHeader();
@@ -104,60 +139,17 @@ class CsvFilterBase< T, electrical::TwoPort, PreparationType< T > >
 
     virtual void PrintHeader()
     {
-        this->mFilestream << "#Time, Elementnr, Voltage, Current, Power, SOC, Temperature\n";
-        this->mFilestream << "#s, Number , Voltage / V, Current / A, Power / W, SOC / %, Temperature / °C\n";
+        this->mBuffer << "#Time, Elementnr, Voltage, Current, Power, SOC, Temperature\n";
+        this->mBuffer << "#s, Number , Voltage / V, Current / A, Power / W, SOC / %, Temperature / °C\n";
     }
 
     virtual void ProcessData( const typename FilterT::Data_t& data, const double t )
     {
         for ( size_t i = 0; i < data.size(); ++i )
-        {
-            this->mFilestream << t << "," << i + 1;
-
-            electrical::TwoPort< T >* port = data[i];
-            this->mFilestream << "," << port->GetVoltageValue();
-            this->mFilestream << "," << port->GetCurrentValue();
-            this->mFilestream << "," << port->GetPowerValue();
-
-            if ( port->IsCellelement() )
-            {
-                electrical::Cellelement< T >* cell = static_cast< electrical::Cellelement< T >* >( port );
-
-                this->mFilestream << "," << cell->GetSocStateValue();
-                this->mFilestream << "," << cell->GetThermalState()->GetValue();
-            }
-            else
-            {
-                this->mFilestream << "," << -1.0;
-                this->mFilestream << "," << -273;
-            }
-
-            this->mFilestream << "\n";
-        }
+            PrintPort( t, static_cast< int >( i + 1 ), data[i] );
         if ( mRootPort )
-        {
-            this->mFilestream << t << "," << -1;
-
-            electrical::TwoPort< T >* port = mRootPort;
-            this->mFilestream << "," << port->GetVoltageValue();
-            this->mFilestream << "," << port->GetCurrentValue();
-            this->mFilestream << "," << port->GetPowerValue();
-
-            if ( port->IsCellelement() )
-            {
-                electrical::Cellelement< T >* cell = static_cast< electrical::Cellelement< T >* >( port );
-
-                this->mFilestream << "," << cell->GetSocStateValue();
-                this->mFilestream << "," << cell->GetThermalState()->GetValue();
-            }
-            else
-            {
-                this->mFilestream << "," << -1.0;
-                this->mFilestream << "," << -273;
-            }
-
-            this->mFilestream << "\n";
-        }
+            PrintPort( t, -1, mRootPort );
+        this->WriteBuffer();
         FilterT::ProcessData( data, t );
     }
 };
@@ -172,8 +164,8 @@ class CsvFilterBase< T, thermal::ThermalElement, ThermalPreperation >
     CsvFilterBase( std::string filename = "./Patch_Temperatures.csv", bool printHeader = true,
                    std::string fileNameVertices = "Patch_Vertices.csv", std::string fileNameAreas = "Patch_Areas.csv",
                    std::string fileNameVolumes = "Patch_Volumes.csv",
-                   std::string fileNameVolumeNames = "Patch_VolumeNames.csv" )
-        : CsvFilter< T, thermal::ThermalElement, ThermalPreperation >( filename )
+                   std::string fileNameVolumeNames = "Patch_VolumeNames.csv", size_t significantDigits = 0 )
+        : CsvFilter< T, thermal::ThermalElement, ThermalPreperation >( filename, significantDigits )
         , mFileNameVertices( fileNameVertices )
         , mFileNameAreas( fileNameAreas )
         , mFileNameVolumes( fileNameVolumes )
@@ -234,18 +226,18 @@ class CsvFilterBase< T, thermal::ThermalElement, ThermalPreperation >
 
     virtual void PrintHeader()
     {
-        this->mFilestream << "#Time, Temperature of Element 1...n\n";
-        this->mFilestream << "#s, °C\n";
+        this->mBuffer << "#Time, Temperature of Element 1...n\n";
+        this->mBuffer << "#s, °C\n";
     }
 
     virtual void ProcessData( const typename FilterT::Data_t& data, const double t )
     {
-        this->mFilestream << t;
+        this->mBuffer << t;
         BOOST_FOREACH ( const thermal::ThermalElement< T >* thermalElement, data )
-            this->mFilestream << ", " << thermalElement->GetTemperature();
+            this->mBuffer << ", " << thermalElement->GetTemperature();
 
-        this->mFilestream << "\n";
-        this->mFilestream << std::flush;
+        this->mBuffer << "\n";
+        this->WriteBuffer();
         FilterT::ProcessData( data, t );
     }
 
@@ -82,8 +82,11 @@ class Filter
     virtual ~Filter(){};
     virtual void ProcessData( const typename Filter< T, TConcrete, ArgumentType >::Data_t &data, const double t );
     virtual void PrepareFilter( ArgumentType &prePareData ) { UNUSED( prePareData ); };
+    /// Adapts the preparation data for the filters that follow this one in the chain
+    virtual void PrepareFollowingFilter( ArgumentType &prePareData ) { UNUSED( prePareData ); };
 
     void SetNext( Filter< T, TConcrete, ArgumentType > *newNext );
+    Filter< T, TConcrete, ArgumentType > *GetNext() const { return mNext; };
 
     private:
     protected:
@@ -34,6 +34,7 @@ _._._._._._._._._._._._._._._._._._._._._.*/
 #include "../observer.h"
 #include "../../container/matio_file.h"
 #include "../../container/matio_data.h"
+#include "../../container/matio_chunked_data.h"
 #include "../../electrical/cellelement.h"
 #include "../../thermal/blocks/elements/thermal_element.h"
 
@@ -47,28 +48,50 @@ class MatlabFilter : public Filter< T, TConcrete, ArgumentType >
     typedef Filter< T, TConcrete, ArgumentType > FilterT;
 
 
-    MatlabFilter( std::string filename )
+    /// \param chunkSize Number of points of time that are buffered per variable before they are appended to its spill file
+    MatlabFilter( std::string filename, size_t chunkSize = 1024 )
         : FilterT()
+        , mFileName( filename )
+        , mChunkSize( chunkSize )
         , mMatFile( filename, MAT_ACC_RDWR ){};
 
 
     virtual ~MatlabFilter()
     {
-        if ( mTime.empty() )
-            return;
-        mMatFile << matlab::MatioData( mTime, "diga.daten.Programmdauer" );
+        // The variables map their spill files and have to outlive the write of the mat file in its destructor
+        for ( size_t i = 0; i < mVariables.size(); ++i )
+        {
+            if ( mVariables[i]->GetNumberOfColumns() )
+                mMatFile << mVariables[i]->GetMatioData();
+        }
     }
 
     virtual void ProcessData( const typename FilterT::Data_t &data, const double t )
     {
-        UNUSED( data );
-        mTime.push_back( t );
+        if ( !mTime )
+            mTime = AddVariable( "diga.daten.Programmdauer", 1 );
+        mTime->Append( t );
         FilterT::ProcessData( data, t );
     };
     virtual void PrepareFilter( ArgumentType &prepData ) = 0;
 
     protected:
-    std::vector< double > mTime;
+    /// Creates a variable with rows values per point of time, which is written to the mat file in the destructor
+    boost::shared_ptr< matlab::MatioChunkedData > AddVariable( const std::string &name, size_t rows )
+    {
+        const std::string spillFileName = mFileName + name.substr( name.find_last_of( "." ) ) + ".tmp";
+        mVariables.push_back(
+         boost::shared_ptr< matlab::MatioChunkedData >( new matlab::MatioChunkedData( name, spillFileName, rows, mChunkSize ) ) );
+        return mVariables.back();
+    }
+
+    private:
+    const std::string mFileName;
+    const size_t mChunkSize;
+    boost::shared_ptr< matlab::MatioChunkedData > mTime;
+    std::vector< boost::shared_ptr< matlab::MatioChunkedData > > mVariables;
+
+    protected:
     matlab::MatFile mMatFile;
 };
 
@@ -78,8 +101,8 @@ class MatlabFilterBase : public MatlabFilter< T, TConcrete, ArgumentType >
 
     public:
     virtual void PrepareFilter( ArgumentType &prepData ) = 0;
-    MatlabFilterBase( std::string filename )
-        : MatlabFilter< T, TConcrete, ArgumentType >( filename ){};
+    MatlabFilterBase( std::string filename, size_t chunkSize = 1024 )
+        : MatlabFilter< T, TConcrete, ArgumentType >( filename, chunkSize ){};
 };
 
 
@@ -94,104 +117,74 @@ class MatlabFilterBase< T, electrical::TwoPort, PreparationType< T > >
     typedef Filter< T, electrical::TwoPort, PreparationType< T > > FilterT;
 
     public:
-    MatlabFilterBase( std::string filename )
-        : MatlabFilter< T, electrical::TwoPort, PreparationType< T > >( filename ){};
-
-    ~MatlabFilterBase()
-    {
-        if ( mCurrentVec.empty() || mVoltageVec.empty() || mPowerVec.empty() || mSocVec.empty() || mTemperatureVec.empty() )
-            return;
-
-        size_t resizer = 0;
-        for ( size_t i = 0; i < mCurrentVec.size(); ++i )
-        {
-            if ( mCurrentVec[i].empty() )
-            {
-                resizer = i;
-                break;
-            }
-        }
-        if ( resizer )
-        {
-            mCurrentVec.resize( resizer );
-            mVoltageVec.resize( resizer );
-            mPowerVec.resize( resizer );
-            mSocVec.resize( resizer );
-            mTemperatureVec.resize( resizer );
-        }
+    MatlabFilterBase( std::string filename, size_t chunkSize = 1024 )
+        : MatlabFilter< T, electrical::TwoPort, PreparationType< T > >( filename, chunkSize )
+        , mRootPort( 0 ){};
 
-        this->mMatFile << matlab::MatioData( mCurrentVec, "diga.daten.StromVec" );
-        this->mMatFile << matlab::MatioData( mVoltageVec, "diga.daten.SpannungVec" );
-        this->mMatFile << matlab::MatioData( mPowerVec, "diga.daten.ThermischLeistungVec" );
-        this->mMatFile << matlab::MatioData( mSocVec, "diga.daten.SOCVec" );
-        this->mMatFile << matlab::MatioData( mTemperatureVec, "diga.daten.TemperaturVec" );
-
-        if ( mCurrent.empty() || mVoltage.empty() || mPower.empty() )
-            return;
-
-        this->mMatFile << matlab::MatioData( mCurrent, "diga.daten.Strom" );
-        this->mMatFile << matlab::MatioData( mVoltage, "diga.daten.Spannung" );
-        this->mMatFile << matlab::MatioData( mPower, "diga.daten.ThermischLeistung" );
-    }
-
-    virtual void PrepareFilter( PreparationType< T > &prePareData )
-    {
-        InitializeVectors( prePareData.mNumberOfElements );
-        mRootPort = prePareData.mRootPort;
-    };
+    virtual void PrepareFilter( PreparationType< T > &prePareData ) { mRootPort = prePareData.mRootPort; };
 
     virtual void ProcessData( const typename FilterT::Data_t &data, const double t )
     {
+        // The number of rows is only known with the first data
+        if ( !mCurrentVec )
+            InitializeVariables( data.size() );
 
         for ( size_t i = 0; i < data.size(); ++i )
         {
             electrical::TwoPort< T > *port = data[i];
-            mVoltageVec[i].push_back( port->GetVoltageValue() );
-            mCurrentVec[i].push_back( port->GetCurrentValue() );
-            mPowerVec[i].push_back( port->GetPowerValue() );
+            mVoltageVec->Append( port->GetVoltageValue() );
+            mCurrentVec->Append( port->GetCurrentValue() );
+            mPowerVec->Append( port->GetPowerValue() );
 
             if ( port->IsCellelement() )
             {
                 electrical::Cellelement< T > *cell = static_cast< electrical::Cellelement< T > * >( port );
-                mSocVec[i].push_back( cell->GetSocStateValue() );
-                mTemperatureVec[i].push_back( cell->GetThermalState()->GetValue() );
+                mSocVec->Append( cell->GetSocStateValue() );
+                mTemperatureVec->Append( cell->GetThermalState()->GetValue() );
             }
             else
             {
-                mSocVec[i].push_back( -1.0 );
-                mTemperatureVec[i].push_back( -273 );
+                mSocVec->Append( -1.0 );
+                mTemperatureVec->Append( -273 );
             }
         }
 
         if ( mRootPort )
         {
             electrical::TwoPort< T > *port = mRootPort;
-            mVoltage.push_back( port->GetVoltageValue() );
-            mCurrent.push_back( port->GetCurrentValue() );
-            mPower.push_back( port->GetPowerValue() );
+            mVoltage->Append( port->GetVoltageValue() );
+            mCurrent->Append( port->GetCurrentValue() );
+            mPower->Append( port->GetPowerValue() );
         }
         MatlabFilter< T, electrical::TwoPort, PreparationType< T > >::ProcessData( data, t );
     }
 
     private:
-    void InitializeVectors( const size_t vectorSizes )
+    void InitializeVariables( const size_t rows )
     {
-        mCurrentVec.resize( vectorSizes );
-        mVoltageVec.resize( vectorSizes );
-        mSocVec.resize( vectorSizes );
-        mPowerVec.resize( vectorSizes );
-        mTemperatureVec.resize( vectorSizes );
+        mCurrentVec = this->AddVariable( "diga.daten.StromVec", rows );
+        mVoltageVec = this->AddVariable( "diga.daten.SpannungVec", rows );
+        mPowerVec = this->AddVariable( "diga.daten.ThermischLeistungVec", rows );
+        mSocVec = this->AddVariable( "diga.daten.SOCVec", rows );
+        mTemperatureVec = this->AddVariable( "diga.daten.TemperaturVec", rows );
+
+        if ( !mRootPort )
+            return;
+
+        mCurrent = this->AddVariable( "diga.daten.Strom", 1 );
+        mVoltage = this->AddVariable( "diga.daten.Spannung", 1 );
+        mPower = this->AddVariable( "diga.daten.ThermischLeistung", 1 );
     };
 
-    std::vector< std::vector< double > > mCurrentVec;
-    std::vector< std::vector< double > > mVoltageVec;
-    std::vector< std::vector< double > > mSocVec;
-    std::vector< std::vector< double > > mPowerVec;
-    std::vector< std::vector< double > > mTemperatureVec;
+    boost::shared_ptr< matlab::MatioChunkedData > mCurrentVec;
+    boost::shared_ptr< matlab::MatioChunkedData > mVoltageVec;
+    boost::shared_ptr< matlab::MatioChunkedData > mSocVec;
+    boost::shared_ptr< matlab::MatioChunkedData > mPowerVec;
+    boost::shared_ptr< matlab::MatioChunkedData > mTemperatureVec;
 
-    std::vector< double > mCurrent;
-    std::vector< double > mVoltage;
-    std::vector< double > mPower;
+    boost::shared_ptr< matlab::MatioChunkedData > mCurrent;
+    boost::shared_ptr< matlab::MatioChunkedData > mVoltage;
+    boost::shared_ptr< matlab::MatioChunkedData > mPower;
 };
 
 template < typename T >
@@ -202,8 +195,8 @@ class MatlabFilterBase< T, thermal::ThermalElement, ThermalPreperation >
     typedef Filter< T, thermal::ThermalElement, ThermalPreperation > FilterT;
 
     public:
-    MatlabFilterBase( std::string filename )
-        : MatlabFilter< T, thermal::ThermalElement, ThermalPreperation >( filename )
+    MatlabFilterBase( std::string filename, size_t chunkSize = 1024 )
+        : MatlabFilter< T, thermal::ThermalElement, ThermalPreperation >( filename, chunkSize )
         , mFileNameVertices( "Patch_Vertices.csv" )
         , mFileNameAreas( "Patch_Areas.csv" )
         , mFileNameAreasElectrical( "Patch_AreasElectrical.csv" )
@@ -212,17 +205,8 @@ class MatlabFilterBase< T, thermal::ThermalElement, ThermalPreperation >
         , mFileNameVolumeNames( "Patch_VolumeNames.csv" )
         , mFileNameVolumeMaterials( "Patch_VolumeMaterials.csv" ){};
 
-    ~MatlabFilterBase()
-    {
-        if ( mTemperature.empty() )
-            return;
-        this->mMatFile << matlab::MatioData( mTemperature, "diga.daten.Temperature" );
-    }
-
     virtual void PrepareFilter( ThermalPreperation &prepData )
     {
-        InitializeVectors( prepData.mAreas.size() );
-
         std::ofstream fileVertices( mFileNameVertices );
         std::ofstream fileAreas( mFileNameAreas );
         std::ofstream fileVolumes( mFileNameVolumes );
@@ -274,24 +258,21 @@ class MatlabFilterBase< T, thermal::ThermalElement, ThermalPreperation >
 
     virtual void ProcessData( const typename FilterT::Data_t &data, const double t )
     {
-        size_t element = 0;
+        if ( !mTemperature )
+            mTemperature = this->AddVariable( "diga.daten.Temperature", data.size() );
+
         BOOST_FOREACH ( const thermal::ThermalElement< T > *thermalElement, data )
-        {
-            mTemperature[element].push_back( thermalElement->GetTemperature() );
-            ++element;
-        }
+            mTemperature->Append( thermalElement->GetTemperature() );
 
         MatlabFilter< T, thermal::ThermalElement, ThermalPreperation >::ProcessData( data, t );
     }
 
-    void InitializeVectors( const size_t vectorSizes ) { mTemperature.resize( vectorSizes ); }
-
     protected:
     std::string mFileNameVertices, mFileNameAreas, mFileNameAreasElectrical, mFileNameElectricThermalMapping,
      mFileNameVolumes, mFileNameVolumeNames, mFileNameVolumeMaterials;
 
     private:
-    std::vector< std::vector< double > > mTemperature;
+    boost::shared_ptr< matlab::MatioChunkedData > mTemperature;
 };
 
 
@@ -299,16 +280,16 @@ template < typename T >
 class MatlabFilterTwoPort : public MatlabFilterBase< T, electrical::TwoPort, PreparationType< T > >
 {
     public:
-    MatlabFilterTwoPort( std::string filename )
-        : MatlabFilterBase< T, electrical::TwoPort, PreparationType< T > >( filename ){};
+    MatlabFilterTwoPort( std::string filename, size_t chunkSize = 1024 )
+        : MatlabFilterBase< T, electrical::TwoPort, PreparationType< T > >( filename, chunkSize ){};
 };
 
 template < typename T >
 class MatlabFilterThermal : public MatlabFilterBase< T, thermal::ThermalElement, ThermalPreperation >
 {
     public:
-    MatlabFilterThermal( std::string filename )
-        : MatlabFilterBase< T, thermal::ThermalElement, ThermalPreperation >( filename ){};
+    MatlabFilterThermal( std::string filename, size_t chunkSize = 1024 )
+        : MatlabFilterBase< T, thermal::ThermalElement, ThermalPreperation >( filename, chunkSize ){};
 };
 
 } /* namespace */
@@ -0,0 +1,318 @@
+/*
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see http://www.gnu.org/licenses/.
+*/
+/* -.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.
+* File Name : selectFilter.h
+* Creation Date : 17-10-2026
+_._._._._._._._._._._._._._._._._._._._._.*/
+#ifndef _SELECT_FILTER_
+#define _SELECT_FILTER_
+
+// STD
+#include <cmath>
+#include <string>
+#include <utility>
+#include <vector>
+
+// BOOST
+#include <boost/foreach.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include "filter.h"
+#include "../../electrical/twoport.h"
+#include "../../exceptions/error_proto.h"
+#include "../../thermal/blocks/elements/thermal_element.h"
+
+namespace observer
+{
+
+/// Elements passed to a group of a SelectFilter
+struct ElementSelection
+{
+    ElementSelection()
+        : mTimeDelay( 0.0 ){};
+
+    /// Ranges of element numbers including both limits. The elements are numbered from 1 like in the CsvFilter.
+    std::vector< std::pair< size_t, size_t > > mRanges;
+    /// Elements whose GetName() is one of these names are passed as well
+    std::vector< std::string > mNames;
+    /// Least time between two points of time passed to the group like in the DecimateFilter
+    double mTimeDelay;
+};
+
+/// Group of a SelectFilter with its own chain of filters, which only gets the selected elements
+template < typename T, template < typename > class TConcrete, typename ArgumentType >
+class SelectFilterGroup
+{
+    public:
+    typedef Filter< T, TConcrete, ArgumentType > FilterT;
+
+    SelectFilterGroup( const ElementSelection &selection )
+        : mSelection( selection )
+        , mLastPassedTime( -10 ){};
+
+    ~SelectFilterGroup()
+    {
+        // Like in the Observer a filter may still pass data to the following filters while it is destroyed
+        for ( size_t i = 0; i < mFilterChain.size(); ++i )
+            mFilterChain[i].reset();
+    }
+
+    void AddFilter( boost::shared_ptr< FilterT > filter )
+    {
+        if ( !mFilterChain.empty() )
+            mFilterChain.back()->SetNext( filter.get() );
+        mFilterChain.push_back( filter );
+    }
+
+    /// Prepares the filters of the group like the Observer prepares its chain
+    void Prepare( ArgumentType &prepData )
+    {
+        for ( size_t i = 0; i < mFilterChain.size(); ++i )
+        {
+            mFilterChain[i]->PrepareFilter( prepData );
+            mFilterChain[i]->PrepareFollowingFilter( prepData );
+        }
+    }
+
+    void ProcessData( const typename FilterT::Data_t &data, const double t )
+    {
+        if ( mFilterChain.empty() || std::abs( t - mLastPassedTime ) < mSelection.mTimeDelay )
+            return;
+        mLastPassedTime = t;
+
+        for ( size_t i = 0; i < mIndices.size(); ++i )
+            mSelectedData[i] = data[mIndices[i]];
+        mFilterChain.front()->ProcessData( mSelectedData, t );
+    }
+
+    const ElementSelection &GetSelection() const { return mSelection; };
+    const std::vector< size_t > &GetIndices() const { return mIndices; };
+    void SetIndices( const std::vector< size_t > &indices )
+    {
+        mIndices = indices;
+        mSelectedData.resize( mIndices.size() );
+    }
+
+    private:
+    const ElementSelection mSelection;
+    double mLastPassedTime;
+    std::vector< size_t > mIndices;
+    typename FilterT::Data_t mSelectedData;
+    std::vector< boost::shared_ptr< FilterT > > mFilterChain;
+};
+
+/// Select Filter passes chosen elements to the filter chains of its groups, e.g. a few cells at every step and the
+/// others at a low rate. The chosen elements are resolved once into index vectors, so elements that are not chosen
+/// cost nothing per step. All elements are passed unchanged to the following filter.
+template < typename T, template < typename > class TConcrete, typename ArgumentType = PreparationType< T > >
+class SelectFilter : public Filter< T, TConcrete, ArgumentType >
+{
+    public:
+    typedef Filter< T, TConcrete, ArgumentType > FilterT;
+    typedef SelectFilterGroup< T, TConcrete, ArgumentType > GroupT;
+
+    SelectFilter()
+        : FilterT(){};
+
+    /// Adds a group, whose filters have to be added before the SelectFilter is added to the observer
+    GroupT &AddGroup( const ElementSelection &selection )
+    {
+        mGroups.push_back( boost::shared_ptr< GroupT >( new GroupT( selection ) ) );
+        return *mGroups.back();
+    }
+
+    virtual void ProcessData( const typename FilterT::Data_t &data, const double t )
+    {
+        for ( size_t i = 0; i < mGroups.size(); ++i )
+            mGroups[i]->ProcessData( data, t );
+        FilterT::ProcessData( data, t );
+    }
+
+    protected:
+    /// Returns for each of the numberOfElements elements whether it is in one of the ranges of selection
+    static std::vector< bool > SelectRanges( const ElementSelection &selection, const size_t numberOfElements )
+    {
+        std::vector< bool > isSelected( numberOfElements, false );
+        for ( size_t i = 0; i < selection.mRanges.size(); ++i )
+        {
+            const size_t first = selection.mRanges[i].first;
+            const size_t last = selection.mRanges[i].second;
+            if ( first < 1 || first > last || last > numberOfElements )
+                ErrorFunction< std::out_of_range >( __FUNCTION__, __LINE__, __FILE__, "SelectFilterElementOutOfRange",
+                                                    first, last, numberOfElements );
+            for ( size_t element = first; element <= last; ++element )
+                isSelected[element - 1] = true;
+        }
+        return isSelected;
+    }
+
+    static std::vector< size_t > GetIndices( const std::vector< bool > &isSelected )
+    {
+        std::vector< size_t > indices;
+        for ( size_t i = 0; i < isSelected.size(); ++i )
+            if ( isSelected[i] )
+                indices.push_back( i );
+        return indices;
+    }
+
+    std::vector< boost::shared_ptr< GroupT > > mGroups;
+};
+
+template < typename T, template < typename > class TConcrete, typename ArgumentType >
+class SelectFilterBase : public SelectFilter< T, TConcrete, ArgumentType >
+{
+    public:
+    SelectFilterBase()
+        : SelectFilter< T, TConcrete, ArgumentType >(){};
+};
+
+/// The ranges are resolved in PrepareFilter. The names need the TwoPorts, which are first passed with the data, so
+/// groups with names are resolved and prepared once at the first point of time.
+template < typename T >
+class SelectFilterBase< T, electrical::TwoPort, PreparationType< T > >
+ : public SelectFilter< T, electrical::TwoPort, PreparationType< T > >
+{
+    public:
+    typedef Filter< T, electrical::TwoPort, PreparationType< T > > FilterT;
+    typedef SelectFilterGroup< T, electrical::TwoPort, PreparationType< T > > GroupT;
+
+    SelectFilterBase()
+        : SelectFilter< T, electrical::TwoPort, PreparationType< T > >()
+        , mRootPort( 0 )
+        , mNamesResolved( false ){};
+
+    virtual void PrepareFilter( PreparationType< T > &prepData )
+    {
+        mRootPort = prepData.mRootPort;
+        BOOST_FOREACH ( boost::shared_ptr< GroupT > &group, this->mGroups )
+        {
+            group->SetIndices( this->GetIndices( this->SelectRanges( group->GetSelection(), prepData.mNumberOfElements ) ) );
+            if ( group->GetSelection().mNames.empty() )
+                PrepareGroup( *group );
+        }
+    }
+
+    virtual void ProcessData( const typename FilterT::Data_t &data, const double t )
+    {
+        if ( !mNamesResolved )
+        {
+            ResolveNames( data );
+            mNamesResolved = true;
+        }
+        SelectFilter< T, electrical::TwoPort, PreparationType< T > >::ProcessData( data, t );
+    }
+
+    private:
+    void PrepareGroup( GroupT &group )
+    {
+        PreparationType< T > prepData( group.GetIndices().size(), mRootPort );
+        group.Prepare( prepData );
+    }
+
+    void ResolveNames( const typename FilterT::Data_t &data )
+    {
+        BOOST_FOREACH ( boost::shared_ptr< GroupT > &group, this->mGroups )
+        {
+            const std::vector< std::string > &names = group->GetSelection().mNames;
+            if ( names.empty() )
+                continue;
+
+            std::vector< bool > isSelected( data.size(), false );
+            BOOST_FOREACH ( size_t index, group->GetIndices() )
+                isSelected[index] = true;
+            for ( size_t i = 0; i < data.size(); ++i )
+                for ( size_t j = 0; j < names.size() && !isSelected[i]; ++j )
+                    isSelected[i] = names[j] == data[i]->GetName();
+
+            group->SetIndices( this->GetIndices( isSelected ) );
+            PrepareGroup( *group );
+        }
+    }
+
+    electrical::TwoPort< T > *mRootPort;
+    bool mNamesResolved;
+};
+
+/// Every thermal element belongs to one area. The groups get only the chosen areas and the volumes made of them.
+/// Thermal elements have no names, so only the ranges are used.
+template < typename T >
+class SelectFilterBase< T, thermal::ThermalElement, ThermalPreperation >
+ : public SelectFilter< T, thermal::ThermalElement, ThermalPreperation >
+{
+    /// Visualization data of the chosen areas, which has to outlive the preparation of the filters of a group
+    struct Geometry
+    {
+        std::vector< std::vector< size_t > > mAreas;
+        std::vector< std::vector< size_t > > mVolumes;
+        std::vector< misc::StrCont > mVolumeNames;
+    };
+
+    public:
+    typedef SelectFilterGroup< T, thermal::ThermalElement, ThermalPreperation > GroupT;
+
+    SelectFilterBase()
+        : SelectFilter< T, thermal::ThermalElement, ThermalPreperation >(){};
+
+    virtual void PrepareFilter( ThermalPreperation &prepData )
+    {
+        mGeometries.resize( this->mGroups.size() );
+        for ( size_t i = 0; i < this->mGroups.size(); ++i )
+        {
+            GroupT &group = *this->mGroups[i];
+            group.SetIndices( this->GetIndices( this->SelectRanges( group.GetSelection(), prepData.mAreas.size() ) ) );
+
+            // A filter can be prepared again, e.g. when it is added to a second observer
+            Geometry &geometry = mGeometries[i];
+            geometry = Geometry();
+            // Areas are numbered from 1 in the volumes, 0 marks an area that has not been chosen
+            std::vector< size_t > newAreaNumbers( prepData.mAreas.size(), 0 );
+            for ( size_t j = 0; j < group.GetIndices().size(); ++j )
+            {
+                geometry.mAreas.push_back( prepData.mAreas[group.GetIndices()[j]] );
+                newAreaNumbers[group.GetIndices()[j]] = j + 1;
+            }
+            for ( size_t j = 0; j < prepData.mVolumes.size(); ++j )
+            {
+                std::vector< size_t > volume;
+                BOOST_FOREACH ( size_t area, prepData.mVolumes[j] )
+                {
+                    if ( area > 0 && area <= newAreaNumbers.size() && newAreaNumbers[area - 1] )
+                        volume.push_back( newAreaNumbers[area - 1] );
+                }
+                if ( !volume.empty() )
+                {
+                    geometry.mVolumes.push_back( volume );
+                    geometry.mVolumeNames.push_back( prepData.mVolumeNames[j] );
+                }
+            }
+
+            ThermalPreperation groupPrepData( geometry.mAreas, geometry.mVolumes, geometry.mVolumeNames,
+                                              prepData.mVertices );
+            group.Prepare( groupPrepData );
+        }
+    }
+
+    private:
+    std::vector< Geometry > mGeometries;
+};
+
+template < typename T >
+using SelectFilterTwoPort = SelectFilterBase< T, electrical::TwoPort, PreparationType< T > >;
+
+template < typename T >
+using SelectFilterThermal = SelectFilterBase< T, thermal::ThermalElement, ThermalPreperation >;
+
+} /* END NAMESPACE */
+#endif /* _SELECT_FILTER_ */
@@ -31,6 +31,7 @@ _._._._._._._._._._._._._._._._._._._._._.*/
 #include "filter.h"
 
 #include "../../electrical/cellelement.h"
+#include "../../misc/format_buffer.h"
 
 namespace observer
 {
@@ -72,56 +73,51 @@ class StdoutFilterBase< T, electrical::TwoPort, PreparationType< T > >
 {
     private:
     electrical::TwoPort< T >* mRootPort;
+    misc::FormatBuffer mBuffer;
+
+    void PrintPort( electrical::TwoPort< T >* port )
+    {
+        mBuffer << " Voltage: " << port->GetVoltageValue();
+        mBuffer << " Current: " << port->GetCurrentValue();
+        mBuffer << " Power: " << port->GetPowerValue();
+
+        if ( port->IsCellelement() )
+        {
+            electrical::Cellelement< T >* cell = static_cast< electrical::Cellelement< T >* >( port );
+            mBuffer << " Soc: " << cell->GetSocStateValue();
+        }
+        mBuffer << "\n";
+    }
 
     public:
-    StdoutFilterBase()
-        : StdoutFilter< T, electrical::TwoPort, PreparationType< T > >(){};
+    /// \param significantDigits Digits of the printed values, 0 prints every value so that it can be read back exactly
+    StdoutFilterBase( size_t significantDigits = 6 )
+        : StdoutFilter< T, electrical::TwoPort, PreparationType< T > >()
+        , mRootPort( 0 )
+        , mBuffer( significantDigits ){};
 
     typedef Filter< T, electrical::TwoPort, PreparationType< T > > FilterT;
 
     virtual void PrepareFilter( PreparationType< T >& prePareData ) { mRootPort = prePareData.mRootPort; }
 
+    /// The output of one point of time is formatted without iostreams and written to std::cout at once
     virtual void ProcessData( const typename FilterT::Data_t& data, const double t )
     {
-        std::cout << "Time: " << t << "\n";
+        mBuffer << "Time: " << t << "\n";
 
         if ( mRootPort )
-        {
-            electrical::TwoPort< T >* port = mRootPort;
-            std::cout << " Voltage: " << port->GetVoltageValue();
-            std::cout << " Current: " << port->GetCurrentValue();
-            std::cout << " Power: " << port->GetPowerValue();
-
-            if ( port->IsCellelement() )
-            {
-                electrical::Cellelement< T >* cell = static_cast< electrical::Cellelement< T >* >( port );
-                std::cout << " Soc: " << cell->GetSocStateValue();
-            }
-            std::cout << "\n";
-        }
+            PrintPort( mRootPort );
         else
         {
-
             for ( size_t i = 0; i < data.size(); ++i )
             {
-                std::cout << " Element " << i + 1;
-
-                electrical::TwoPort< T >* port = data[i];
-                std::cout << " Voltage: " << port->GetVoltageValue();
-                std::cout << " Current: " << port->GetCurrentValue();
-                std::cout << " Power: " << port->GetPowerValue();
-
-                if ( port->IsCellelement() )
-                {
-                    electrical::Cellelement< T >* cell = static_cast< electrical::Cellelement< T >* >( port );
-                    std::cout << " Soc: " << cell->GetSocStateValue();
-                }
-
-                std::cout << "\n";
+                mBuffer << " Element " << i + 1;
+                PrintPort( data[i] );
             }
         }
 
-        std::cout << std::endl;
+        mBuffer << "\n";
+        mBuffer.WriteTo( std::cout );
 
         FilterT::ProcessData( data, t );
     }
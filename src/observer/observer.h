@@ -40,7 +40,7 @@ class Observer
 {
     public:
     Observer();
-    virtual ~Observer(){};
+    virtual ~Observer();
     virtual void operator()( double t );
     void AddFilter( Filter< T, TConcrete, ArgumentType >* filt );
     void AddFilter( boost::shared_ptr< Filter< T, TConcrete, ArgumentType > > filt );
@@ -53,6 +53,9 @@ class Observer
 
 
     protected:
+    /// Prepares filt with prepData after the filters before filt have adapted it
+    void PrepareFilterInChain( Filter< T, TConcrete, ArgumentType >* filt, ArgumentType& prepData );
+
     Filter< T, TConcrete, ArgumentType >* mBegin;
     Filter< T, TConcrete, ArgumentType >* mEnd;
 };
@@ -64,6 +67,14 @@ Observer< T, TConcrete, ArgumentType >::Observer()
 {
 }
 
+template < typename T, template < typename > class TConcrete, typename ArgumentType >
+Observer< T, TConcrete, ArgumentType >::~Observer()
+{
+    // Filters are destroyed from the first to the last one, as a filter may still pass data to the following filters
+    for ( size_t i = 0; i < mFilterChain.size(); ++i )
+        mFilterChain[i].reset();
+}
+
 template < typename T, template < typename > class TConcrete, typename ArgumentType >
 void Observer< T, TConcrete, ArgumentType >::AddFilter( boost::shared_ptr< Filter< T, TConcrete, ArgumentType > > filt )
 {
@@ -87,6 +98,15 @@ void Observer< T, TConcrete, ArgumentType >::AddFilter( Filter< T, TConcrete, Ar
     this->AddFilter( boost::shared_ptr< Filter< T, TConcrete, ArgumentType > >( filt ) );
 }
 
+template < typename T, template < typename > class TConcrete, typename ArgumentType >
+void Observer< T, TConcrete, ArgumentType >::PrepareFilterInChain( Filter< T, TConcrete, ArgumentType >* filt,
+                                                                  ArgumentType& prepData )
+{
+    for ( Filter< T, TConcrete, ArgumentType >* previous = mBegin; previous && previous != filt; previous = previous->GetNext() )
+        previous->PrepareFollowingFilter( prepData );
+    filt->PrepareFilter( prepData );
+}
+
 template < typename T, template < typename > class TConcrete, typename ArgumentType >
 void Observer< T, TConcrete, ArgumentType >::operator()( double t )
 {
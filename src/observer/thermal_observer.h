@@ -83,7 +83,7 @@ ThermalObserver< T >::ThermalObserver( vector< ThermalElement< T > * > thermalEl
 template < typename T >
 void ThermalObserver< T >::PrepareFilter( Filter< T, ThermalElement, ThermalPreperation > *filt )
 {
-    filt->PrepareFilter( mPrepareParameter );
+    this->PrepareFilterInChain( filt, mPrepareParameter );
 }
 
 
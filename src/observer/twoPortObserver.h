@@ -96,7 +96,7 @@ template < typename T >
 void TwoPortObserver< T >::PrepareFilter( Filter< T, electrical::TwoPort, PreparationType< T > >* filt )
 {
     PreparationType< T > prepType( mObservableTwoPorts.size(), mRootPort );
-    filt->PrepareFilter( prepType );
+    this->PrepareFilterInChain( filt, prepType );
 }
 
 template < typename T >
@@ -0,0 +1,104 @@
+/*
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see http://www.gnu.org/licenses/.
+*/
+/* -.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.
+* File Name : cachedSparseLu.cpp
+* Creation Date : 17-10-2026
+_._._._._._._._._._._._._._._._._._._._._.*/
+#include "cachedSparseLu.h"
+
+#if defined( _EIGEN_ ) || defined( USE_EIGEN )
+
+// STD
+#include <algorithm>
+#include <vector>
+#ifdef __EXCEPTIONS__
+#include <stdexcept>
+#endif /* __EXCEPTIONS__ */
+
+// ETC
+#include "../exceptions/error_proto.h"
+
+namespace systm
+{
+
+CachedSparseLU::CachedSparseLU()
+    : mIsFactorized( false )
+    , mAnalyzePatternCount( 0 )
+    , mFactorizationCount( 0 )
+{
+}
+
+void CachedSparseLU::Factorize( MatrixType matrix )
+{
+    matrix.makeCompressed();
+
+    const bool samePattern = mIsFactorized && HasSamePattern( matrix );
+    if ( samePattern && HasSameValues( matrix ) )
+        return;
+
+    mIsFactorized = false;
+
+    // Compute the ordering permutation vector from the structural pattern of A
+    if ( !samePattern )
+    {
+        mSolver.analyzePattern( matrix );
+        ++mAnalyzePatternCount;
+    }
+
+    // Compute the numerical factorization
+    mSolver.factorize( matrix );
+    ++mFactorizationCount;
+
+    if ( Eigen::Success != mSolver.info() )
+        ErrorFunction< std::runtime_error >( __FUNCTION__, __LINE__, __FILE__, "ErrorPassThrough",
+                                             mSolver.lastErrorMessage().c_str() );
+
+    mFactorizedMatrix.swap( matrix );
+    mIsFactorized = true;
+}
+
+#ifdef _ARMADILLO_
+void CachedSparseLU::Factorize( const arma::SpMat< double > &matrix )
+{
+    std::vector< Eigen::Triplet< double > > triplets;
+    triplets.reserve( matrix.n_nonzero );
+    for ( arma::SpMat< double >::const_iterator it = matrix.begin(); it != matrix.end(); ++it )
+        triplets.push_back( Eigen::Triplet< double >( it.row(), it.col(), *it ) );
+
+    MatrixType eigenMatrix( matrix.n_rows, matrix.n_cols );
+    eigenMatrix.setFromTriplets( triplets.begin(), triplets.end() );
+    Factorize( eigenMatrix );
+}
+#endif /* _ARMADILLO_ */
+
+bool CachedSparseLU::HasSamePattern( const MatrixType &matrix ) const
+{
+    if ( matrix.rows() != mFactorizedMatrix.rows() || matrix.cols() != mFactorizedMatrix.cols() ||
+         matrix.nonZeros() != mFactorizedMatrix.nonZeros() )
+        return false;
+
+    return std::equal( matrix.outerIndexPtr(), matrix.outerIndexPtr() + matrix.outerSize() + 1,
+                       mFactorizedMatrix.outerIndexPtr() ) &&
+           std::equal( matrix.innerIndexPtr(), matrix.innerIndexPtr() + matrix.nonZeros(), mFactorizedMatrix.innerIndexPtr() );
+}
+
+bool CachedSparseLU::HasSameValues( const MatrixType &matrix ) const
+{
+    return std::equal( matrix.valuePtr(), matrix.valuePtr() + matrix.nonZeros(), mFactorizedMatrix.valuePtr() );
+}
+
+} /* namespace systm */
+
+#endif /* defined( _EIGEN_ ) || defined( USE_EIGEN ) */
@@ -0,0 +1,81 @@
+/*
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see http://www.gnu.org/licenses/.
+*/
+/* -.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.
+* File Name : cachedSparseLu.h
+* Creation Date : 17-10-2026
+_._._._._._._._._._._._._._._._._._._._._.*/
+#ifndef _CACHEDSPARSELU_
+#define _CACHEDSPARSELU_
+
+#if defined( _EIGEN_ ) || defined( USE_EIGEN )
+
+// STD
+#include <cstddef>
+
+// ETC
+#include "../misc/matrixInclude.h"
+#include <eigen3/Eigen/Sparse>
+#include <eigen3/Eigen/SparseLU>
+
+namespace systm
+{
+
+/// Sparse LU factorization of a square matrix which is only recomputed if the matrix changes.
+/// The symbolic analysis is kept as long as the sparsity pattern stays the same, the numeric factorization as long as
+/// the coefficients stay the same.
+class CachedSparseLU
+{
+    public:
+    typedef Eigen::SparseMatrix< double, Eigen::ColMajor > MatrixType;
+
+    CachedSparseLU();
+    ~CachedSparseLU(){};
+
+    /// Factorize the matrix unless it is equal to the one that has been factorized last
+    void Factorize( MatrixType matrix );
+
+#ifdef _ARMADILLO_
+    /// Factorize an armadillo matrix unless it is equal to the one that has been factorized last
+    void Factorize( const arma::SpMat< double > &matrix );
+#endif /* _ARMADILLO_ */
+
+    /// Returns the solver holding the current factorization
+    const Eigen::SparseLU< MatrixType > &GetSolver() const { return mSolver; }
+
+    /// Returns true if a valid factorization is available
+    bool IsFactorized() const { return mIsFactorized; }
+
+    /// Number of symbolic analyses that have been done so far
+    size_t GetAnalyzePatternCount() const { return mAnalyzePatternCount; }
+
+    /// Number of numeric factorizations that have been done so far
+    size_t GetFactorizationCount() const { return mFactorizationCount; }
+
+    private:
+    bool HasSamePattern( const MatrixType &matrix ) const;
+    bool HasSameValues( const MatrixType &matrix ) const;
+
+    Eigen::SparseLU< MatrixType > mSolver;
+    MatrixType mFactorizedMatrix;    ///< Copy of the matrix mSolver currently holds
+    bool mIsFactorized;
+    size_t mAnalyzePatternCount;
+    size_t mFactorizationCount;
+};
+
+} /* namespace systm */
+
+#endif /* defined( _EIGEN_ ) || defined( USE_EIGEN ) */
+
+#endif /* _CACHEDSPARSELU_ */
@@ -35,10 +35,11 @@ double ConstantStepDglSystemSolver< SparseMatrix< double, RowMajor > >::Solve()
 
     size_t realStates = this->mStateVector.n_rows - 1;
 
-    SparseMatrix< double, RowMajor > dxdt( realStates, 1 );
-    daeSystem->operator()( this->mStateVector.topRows( realStates ), dxdt, 0 );
+    if ( mDxDt.rows() != static_cast< int >( realStates ) )
+        mDxDt.resize( realStates, 1 );
+    daeSystem->operator()( this->mStateVector.topRows( realStates ), mDxDt, 0 );
 
-    this->mStateVector.topRows( realStates ) += dxdt * this->mDt;
+    this->mStateVector.topRows( realStates ) += mDxDt * this->mDt;
     this->mStateVector( realStates, 0 ) = 1;
 
     this->mTime += this->mDt;
@@ -61,9 +62,10 @@ ConstantStepDglSystemSolver< arma::Mat< double > >::ConstantStepDglSystemSolver(
 double ConstantStepDglSystemSolver< arma::Mat< double > >::Solve()
 {
     daeSystem->PrepareEquationSystem();
-    arma::Mat< double > states = this->mStateVector.submat( 0, 0, this->mStateVector.n_rows - 2, 0 );
+
+    // The states without the trailing 1 are integrated in place
+    arma::Mat< double > states( this->mStateVector.memptr(), this->mStateVector.n_rows - 1, 1, false, true );
     mStepper.do_step( *daeSystem, states, 0, this->mDt );
-    this->mStateVector.submat( 0, 0, this->mStateVector.n_rows - 2, 0 ) = states;
 
     this->mTime += this->mDt;
 
@@ -20,6 +20,7 @@ along with this program.  If not, see http://www.gnu.org/licenses/.
 _._._._._._._._._._._._._._._._._._._._._.*/
 #include "dae_sys.h"
 #include <cstring>
+#include <vector>
 
 /// Namespace for system objects
 namespace systm
@@ -49,25 +50,114 @@ void DifferentialAlgebraicSystem< Mat< double > >::CopyDGLResultsToMatrixAndVect
 
 DifferentialAlgebraicSystem< arma::SpMat< double > >::DifferentialAlgebraicSystem( StateSystemGroup< arma::SpMat< double > > *stateSystemGroup )
     : GeneralizedSystem< arma::SpMat< double > >()
-    , mMatrixA( arma::Mat< double >() )
     , mStateSystemGroup( stateSystemGroup )
     , mDglStateSystem( &stateSystemGroup->mDglStateSystem )
     , mAlgStateSystem( &stateSystemGroup->mAlgStateSystem )
 {
     const size_t stateCount = mStateSystemGroup->GetStateCount();
-    mMatrixA.zeros( stateCount, stateCount );
-    mVectorC.zeros( stateCount, 1 );
+    const size_t algUIDCount = mAlgStateSystem->GetEquationCount();
+    const size_t dglUIDCount = mDglStateSystem->GetEquationCount();
+
+    mDglMatrixA.zeros( dglUIDCount, stateCount );
+    mDglVectorC.zeros( dglUIDCount, 1 );
+    mAlg1MatrixA.zeros( algUIDCount, dglUIDCount );
+    mDxdtDgl.zeros( dglUIDCount, 1 );
+    mAlgRhs.zeros( algUIDCount, 1 );
     CalculateInitialState();
 }
 
+/// The reduced matrix is only assembled on request. The integration itself works on the sparse blocks.
 const arma::SpMat< double > DifferentialAlgebraicSystem< arma::SpMat< double > >::GetA() const    ///< Get MatrixA
 {
-    return arma::SpMat< double >( mMatrixA );
+    const size_t stateCount = mStateSystemGroup->GetStateCount();
+    const size_t algUIDCount = mAlgStateSystem->GetEquationCount();
+    const size_t dglUIDCount = mDglStateSystem->GetEquationCount();
+
+    if ( algUIDCount == 0 )
+        return mDglMatrixA;
+
+    // The entries are collected as (row, col) pairs for the batch constructor. The algebraic rows are
+    // -alg2^-1 * alg1 * dglA, so only the columns with nonzeros in alg1 * dglA need a solve.
+    std::vector< arma::uword > locations;
+    std::vector< double > values;
+    locations.reserve( 2 * mDglMatrixA.n_nonzero );
+    values.reserve( mDglMatrixA.n_nonzero );
+    const arma::SpMat< double >::const_iterator dglEnd = mDglMatrixA.end();
+    for ( arma::SpMat< double >::const_iterator it = mDglMatrixA.begin(); it != dglEnd; ++it )
+    {
+        locations.push_back( it.row() );
+        locations.push_back( it.col() );
+        values.push_back( *it );
+    }
+
+    const arma::SpMat< double > alg1TimesDglA( mAlg1MatrixA * mDglMatrixA );
+    arma::Mat< double > rhs( algUIDCount, 1 );
+    arma::Mat< double > algColumn( algUIDCount, 1 );
+    for ( size_t col = 0; col < stateCount; ++col )
+    {
+        const arma::SpMat< double >::const_iterator colEnd = alg1TimesDglA.end_col( col );
+        arma::SpMat< double >::const_iterator it = alg1TimesDglA.begin_col( col );
+        if ( it == colEnd )
+            continue;
+
+        rhs.zeros();
+        for ( ; it != colEnd; ++it )
+            rhs( it.row(), 0 ) = *it;
+        SolveAlg2( rhs.memptr(), algColumn.memptr() );
+
+        for ( size_t i = 0; i < algUIDCount; ++i )
+        {
+            if ( algColumn( i, 0 ) == 0.0 )
+                continue;
+            locations.push_back( dglUIDCount + i );
+            locations.push_back( col );
+            values.push_back( algColumn( i, 0 ) );
+        }
+    }
+
+    if ( values.empty() )
+        return arma::SpMat< double >( stateCount, stateCount );
+    return arma::SpMat< double >( arma::umat( &locations[0], 2, values.size() ),
+                                  arma::Col< double >( &values[0], values.size() ), stateCount, stateCount );
 }
 
+/// The reduced vector is only assembled on request. The integration itself works on the sparse blocks.
 const arma::SpMat< double > DifferentialAlgebraicSystem< arma::SpMat< double > >::GetC() const    ///< Get VectorC
 {
-    return arma::SpMat< double >( mVectorC );
+    const size_t stateCount = mStateSystemGroup->GetStateCount();
+    const size_t algUIDCount = mAlgStateSystem->GetEquationCount();
+    const size_t dglUIDCount = mDglStateSystem->GetEquationCount();
+
+    std::vector< arma::uword > rows;
+    std::vector< double > values;
+    for ( size_t i = 0; i < dglUIDCount; ++i )
+    {
+        if ( mDglVectorC( i, 0 ) == 0.0 )
+            continue;
+        rows.push_back( i );
+        values.push_back( mDglVectorC( i, 0 ) );
+    }
+
+    if ( algUIDCount != 0 )
+    {
+        const arma::Mat< double > alg1TimesDglC( mAlg1MatrixA * mDglVectorC );
+        arma::Mat< double > algC( algUIDCount, 1 );
+        SolveAlg2( alg1TimesDglC.memptr(), algC.memptr() );
+        for ( size_t i = 0; i < algUIDCount; ++i )
+        {
+            if ( algC( i, 0 ) == 0.0 )
+                continue;
+            rows.push_back( dglUIDCount + i );
+            values.push_back( algC( i, 0 ) );
+        }
+    }
+
+    if ( values.empty() )
+        return arma::SpMat< double >( stateCount, 1 );
+    arma::umat locations( 2, values.size() );
+    locations.row( 0 ) = arma::urowvec( &rows[0], rows.size() );
+    locations.row( 1 ).zeros();
+    return arma::SpMat< double >( locations, arma::Col< double >( &values[0], values.size() ), stateCount, 1 );
 }
 
 void DifferentialAlgebraicSystem< arma::SpMat< double > >::PrepareEquationSystem()    ///<  make ode equations out of the linear ones (alg1,alg2)
@@ -78,55 +168,99 @@ void DifferentialAlgebraicSystem< arma::SpMat< double > >::PrepareEquationSystem
     if ( dglUIDCount == 0 )
         ErrorFunction< std::runtime_error >( __FUNCTION__, __LINE__, __FILE__, "DGLNotEnough" );
 
-    mMatrixA.zeros();
-    mVectorC.zeros();
-
-    const arma::SpMat< double > &dglMatrixA = mStateSystemGroup->mDglStateSystem.GetEquationSystemAMatrix();
-    const arma::SpMat< double > &dglVectorC = mDglStateSystem->GetEquationSystemCVector();
-
-    for ( arma::SpMat< double >::const_iterator it = dglMatrixA.begin(); it != dglMatrixA.end(); it++ )
-        mMatrixA( it.row(), it.col() ) = *it;
-
-    for ( arma::SpMat< double >::const_iterator it = dglVectorC.begin(); it != dglVectorC.end(); it++ )
-        mVectorC( it.row(), 0 ) = *it;
+    mDglMatrixA = mDglStateSystem->GetEquationSystemAMatrix();
+    mDglVectorC = arma::Mat< double >( mDglStateSystem->GetEquationSystemCVector() );
 
     if ( algUIDCount == 0 )
         return;
 
-    const arma::SpMat< double > &algVectorC = mAlgStateSystem->GetEquationSystemCVector();
-    const arma::SpMat< double > mAlg1MatrixA = mAlgStateSystem->GetEquationSystemAMatrix().cols( 0, dglUIDCount - 1 );
-    const arma::SpMat< double > mAlg2MatrixA =
-     mAlgStateSystem->GetEquationSystemAMatrix().cols( dglUIDCount, dglUIDCount + algUIDCount - 1 );
+    const arma::SpMat< double > &algMatrixA = mAlgStateSystem->GetEquationSystemAMatrix();
+    mAlg1MatrixA = algMatrixA.cols( 0, dglUIDCount - 1 );
+    FactorizeAlg2( arma::SpMat< double >( algMatrixA.cols( dglUIDCount, dglUIDCount + algUIDCount - 1 ) ) );
 
     // CalculateInitialStateFromCurrentState
     arma::SpMat< double > &stateVector = mStateSystemGroup->mStateVector;
-    arma::SpMat< double > invertedMat =
-     solve( mAlg2MatrixA, -1 * algVectorC - mAlg1MatrixA * ( stateVector.rows( 0, dglUIDCount - 1 ) ) );
-    for ( size_t i = 0; i < algUIDCount; ++i )
-        stateVector( dglUIDCount + i, 0 ) = invertedMat( i, 0 );
-    //.....................................
+    mAlgRhs = arma::Mat< double >( mAlgStateSystem->GetEquationSystemCVector() ) +
+              mAlg1MatrixA * arma::Mat< double >( stateVector.rows( 0, dglUIDCount - 1 ) );
 
-    const arma::SpMat< double > invAlg2MinusAlg1 = inv( mAlg2MatrixA ) * ( -1.0 * mAlg1MatrixA );
-    const arma::SpMat< double > DGLifiedA = invAlg2MinusAlg1 * dglMatrixA;
-    const arma::SpMat< double > DGLifiedC = invAlg2MinusAlg1 * dglVectorC;
-
-    for ( arma::SpMat< double >::const_iterator it = DGLifiedA.begin(); it != DGLifiedA.end(); it++ )
-        mMatrixA( it.row() + dglUIDCount, it.col() ) = *it;
-
-    for ( arma::SpMat< double >::const_iterator it = DGLifiedC.begin(); it != DGLifiedC.end(); it++ )
-        mVectorC( it.row() + dglUIDCount, 0 ) = *it;
+    arma::Mat< double > algStates( algUIDCount, 1 );
+    SolveAlg2( mAlgRhs.memptr(), algStates.memptr() );
+    for ( size_t i = 0; i < algUIDCount; ++i )
+        stateVector( dglUIDCount + i, 0 ) = algStates( i, 0 );
 }
 
 void DifferentialAlgebraicSystem< arma::SpMat< double > >::
 operator()( const arma::SpMat< double > &x, arma::SpMat< double > &dxdt, const double /* t */ )
 {
-    dxdt = mMatrixA * x + mVectorC;
+    const size_t algUIDCount = mAlgStateSystem->GetEquationCount();
+    const size_t dglUIDCount = mDglStateSystem->GetEquationCount();
+
+    // Only the columns of the differential block which belong to nonzero states contribute
+    mDxdtDgl = mDglVectorC;
+    const arma::SpMat< double >::const_iterator xEnd = x.end();
+    for ( arma::SpMat< double >::const_iterator xIt = x.begin(); xIt != xEnd; ++xIt )
+    {
+        const size_t col = xIt.row();
+        if ( col >= mDglMatrixA.n_cols )
+            continue;
+        const arma::SpMat< double >::const_iterator colEnd = mDglMatrixA.end_col( col );
+        for ( arma::SpMat< double >::const_iterator it = mDglMatrixA.begin_col( col ); it != colEnd; ++it )
+            mDxdtDgl( it.row(), 0 ) += ( *it ) * ( *xIt );
+    }
+
+    mDxdtLocations.clear();
+    mDxdtValues.clear();
+    for ( size_t i = 0; i < dglUIDCount; ++i )
+    {
+        if ( mDxdtDgl( i, 0 ) == 0.0 )
+            continue;
+        mDxdtLocations.push_back( i );
+        mDxdtLocations.push_back( 0 );
+        mDxdtValues.push_back( mDxdtDgl( i, 0 ) );
+    }
+
+    if ( algUIDCount != 0 )
+    {
+        mAlgRhs = mAlg1MatrixA * mDxdtDgl;
+        mDxdtAlg.set_size( algUIDCount, 1 );
+        SolveAlg2( mAlgRhs.memptr(), mDxdtAlg.memptr() );
+        for ( size_t i = 0; i < algUIDCount; ++i )
+        {
+            if ( mDxdtAlg( i, 0 ) == 0.0 )
+                continue;
+            mDxdtLocations.push_back( dglUIDCount + i );
+            mDxdtLocations.push_back( 0 );
+            mDxdtValues.push_back( mDxdtAlg( i, 0 ) );
+        }
+    }
+
+    if ( mDxdtValues.empty() )
+    {
+        dxdt.zeros( dglUIDCount + algUIDCount, 1 );
+        return;
+    }
+    dxdt = arma::SpMat< double >( arma::umat( &mDxdtLocations[0], 2, mDxdtValues.size(), false, true ),
+                                  arma::Col< double >( &mDxdtValues[0], mDxdtValues.size(), false, true ),
+                                  dglUIDCount + algUIDCount, 1 );
 }
 
 void DifferentialAlgebraicSystem< arma::SpMat< double > >::
 operator()( const arma::Mat< double > &x, arma::Mat< double > &dxdt, const double /* t */ )
 {
-    dxdt = mMatrixA * x + mVectorC;
+    const size_t algUIDCount = mAlgStateSystem->GetEquationCount();
+    const size_t dglUIDCount = mDglStateSystem->GetEquationCount();
+
+    mDxdtDgl = mDglMatrixA * x;
+    mDxdtDgl += mDglVectorC;
+
+    dxdt.set_size( dglUIDCount + algUIDCount, 1 );
+    dxdt.rows( 0, dglUIDCount - 1 ) = mDxdtDgl;
+
+    if ( algUIDCount == 0 )
+        return;
+
+    mAlgRhs = mAlg1MatrixA * mDxdtDgl;
+    SolveAlg2( mAlgRhs.memptr(), dxdt.memptr() + dglUIDCount );
 }
 
 void DifferentialAlgebraicSystem< arma::SpMat< double > >::
@@ -134,17 +268,12 @@ operator()( const std::vector< double > &x, std::vector< double > &dxdt, const d
 {
     const size_t stateCount = mStateSystemGroup->GetStateCount();
 
-    // Store x into temporary states
-    arma::SpMat< double > tmpX( stateCount, 1 );
-    misc::FastCopyMatrix( tmpX, &x[0], stateCount );
+    // Use x and dxdt as memory of the armadillo matrices
+    const arma::Mat< double > tmpX( const_cast< double * >( &x[0] ), stateCount, 1, false, true );
+    dxdt.resize( x.size() );
+    arma::Mat< double > tmpDxdt( &dxdt[0], stateCount, 1, false, true );
 
-    // Calculate dxdt
-    arma::SpMat< double > tmpDxdt( stateCount, 1 );
     operator()( tmpX, tmpDxdt, 0.0 );
-
-    // Store result back into dxdt
-    dxdt.resize( x.size() );
-    misc::FastCopyMatrix( &dxdt[0], tmpDxdt, stateCount );
 }
 
 void DifferentialAlgebraicSystem< arma::SpMat< double > >::CalculateInitialState()    ///< output x vector with all DGL values set to zero
@@ -155,18 +284,44 @@ void DifferentialAlgebraicSystem< arma::SpMat< double > >::CalculateInitialState
     if ( algUIDCount == 0 )
         return;
 
-    const arma::SpMat< double > &algVectorC = mAlgStateSystem->GetEquationSystemCVector();
-    const arma::SpMat< double > &mAlg2MatrixA =
+    const arma::SpMat< double > alg2MatrixA =
      mAlgStateSystem->GetEquationSystemAMatrix().cols( dglUIDCount, dglUIDCount + algUIDCount - 1 );
 
-    if ( mAlg2MatrixA.n_nonzero == 0 )
+    if ( alg2MatrixA.n_nonzero == 0 )
         ErrorFunction< std::runtime_error >( __FUNCTION__, __LINE__, __FILE__, "AlgNotInvertable" );
 
+    FactorizeAlg2( alg2MatrixA );
+
+    const arma::Mat< double > algVectorC( mAlgStateSystem->GetEquationSystemCVector() );
+    arma::Mat< double > algStates( algUIDCount, 1 );
+    SolveAlg2( algVectorC.memptr(), algStates.memptr() );
+
     arma::SpMat< double > &stateVector = mStateSystemGroup->mStateVector;
+    for ( size_t i = 0; i < algUIDCount; ++i )
+        stateVector( dglUIDCount + i, 0 ) = algStates( i, 0 );
+}
+
+void DifferentialAlgebraicSystem< arma::SpMat< double > >::FactorizeAlg2( const arma::SpMat< double > &alg2MatrixA )
+{
+#ifdef USE_EIGEN
+    mAlg2Solver.Factorize( alg2MatrixA );
+#else
+    mInvAlg2MatrixA = inv( arma::Mat< double >( alg2MatrixA ) );
+#endif
+}
+
+void DifferentialAlgebraicSystem< arma::SpMat< double > >::SolveAlg2( const double *rhs, double *result ) const
+{
+    const size_t algUIDCount = mAlgStateSystem->GetEquationCount();
 
-    arma::SpMat< double > invertedMat = solve( mAlg2MatrixA, algVectorC );    // -1 is beeing put later
-    for ( size_t i = 0; i < algUIDCount; ++i )                                // is faster than memcpy ...?
-        stateVector( dglUIDCount + i, 0 ) = -invertedMat( i, 0 );
+#ifdef USE_EIGEN
+    Eigen::Map< Eigen::VectorXd > solution( result, algUIDCount );
+    solution = mAlg2Solver.GetSolver().solve( Eigen::Map< const Eigen::VectorXd >( rhs, algUIDCount ) );
+    solution *= -1.0;
+#else
+    arma::Mat< double > solution( result, algUIDCount, 1, false, true );
+    solution = -1.0 * mInvAlg2MatrixA * arma::Mat< double >( const_cast< double * >( rhs ), algUIDCount, 1, false, true );
+#endif
 }
 
 const char *DifferentialAlgebraicSystem< arma::SpMat< double > >::GetName() const
@@ -187,6 +342,46 @@ DifferentialAlgebraicSystem< SparseMatrix< double, RowMajor > >::DifferentialAlg
     CalculateInitialState();
 }
 
+/// The reduced matrix is only assembled on request. The integration itself works on the sparse blocks.
+const SparseMatrix< double, RowMajor > DifferentialAlgebraicSystem< SparseMatrix< double, RowMajor > >::GetA() const    ///< Get MatrixA
+{
+    const size_t algUIDCount = mAlgStateSystem->GetEquationCount();
+    const size_t dglUIDCount = mDglStateSystem->GetEquationCount();
+    const MatrixType &dglMatrixA = mDglStateSystem->GetEquationSystemAMatrix();
+
+    MatrixType matrixA( dglUIDCount + algUIDCount, dglMatrixA.cols() );
+    matrixA.topRows( dglUIDCount ) = dglMatrixA;
+
+    if ( algUIDCount != 0 )
+    {
+        SparseMatrix< double, ColMajor > b = -mAlg1MatrixA * dglMatrixA;
+        b.makeCompressed();
+        SparseMatrix< double, ColMajor > ret = mAlg2Solver.GetSolver().solve( b );
+        matrixA.bottomRows( algUIDCount ) = MatrixType( ret );
+    }
+    return matrixA;
+}
+
+/// The reduced vector is only assembled on request. The integration itself works on the sparse blocks.
+const SparseMatrix< double, RowMajor > DifferentialAlgebraicSystem< SparseMatrix< double, RowMajor > >::GetC() const    ///< Get VectorC
+{
+    const size_t algUIDCount = mAlgStateSystem->GetEquationCount();
+    const size_t dglUIDCount = mDglStateSystem->GetEquationCount();
+    const MatrixType &dglVectorC = mDglStateSystem->GetEquationSystemCVector();
+
+    MatrixType vectorC( dglUIDCount + algUIDCount, 1 );
+    vectorC.topRows( dglUIDCount ) = dglVectorC;
+
+    if ( algUIDCount != 0 )
+    {
+        SparseMatrix< double, ColMajor > b = -mAlg1MatrixA * dglVectorC;
+        b.makeCompressed();
+        SparseMatrix< double, ColMajor > ret = mAlg2Solver.GetSolver().solve( b );
+        vectorC.bottomRows( algUIDCount ) = MatrixType( ret );
+    }
+    return vectorC;
+}
+
 void DifferentialAlgebraicSystem< SparseMatrix< double, RowMajor > >::PrepareEquationSystem()    ///<  make ode equations out of the linear ones (alg1,alg2)
 {
     const size_t algUIDCount = mAlgStateSystem->GetEquationCount();
@@ -208,22 +403,9 @@ void DifferentialAlgebraicSystem< SparseMatrix< double, RowMajor > >::PrepareEqu
     b *= -1;
 
     b.makeCompressed();
-    mAlg2MatrixA.makeCompressed();
-
-    SparseLU< SparseMatrix< double, ColMajor > > solver;
-
-    // Compute the ordering permutation vector from the structural pattern of A
-    solver.analyzePattern( mAlg2MatrixA );
-    // Compute the numerical factorization
-    solver.factorize( mAlg2MatrixA );
-    // Use the factors to solve the linear system
 
-    ComputationInfo o;
-    if ( Success != ( o = solver.info() ) )
-        ErrorFunction< std::runtime_error >( __FUNCTION__, __LINE__, __FILE__, "ErrorPassThrough",
-                                             solver.lastErrorMessage().c_str() );
-
-    SparseMatrix< double, ColMajor > ret = solver.solve( b );
+    mAlg2Solver.Factorize( SparseMatrix< double, ColMajor >( mAlg2MatrixA ) );
+    SparseMatrix< double, ColMajor > ret = mAlg2Solver.GetSolver().solve( b );
 
     mStateSystemGroup->mStateVector.middleRows( dglUIDCount, algUIDCount ) = ret;
 }
@@ -249,20 +431,8 @@ operator()( const MatrixType &x, MatrixType &dxdt, const double /* t */ )
     SparseMatrix< double, ColMajor > b = -mAlg1MatrixA * dxdt_dgl;
     b.makeCompressed();
 
-    SparseLU< SparseMatrix< double, ColMajor > > solver;
-
-    // Compute the ordering permutation vector from the structural pattern of A
-    solver.analyzePattern( mAlg2MatrixA );
-    // Compute the numerical factorization
-    solver.factorize( mAlg2MatrixA );
-    // Use the factors to solve the linear system
-
-    ComputationInfo o;
-    if ( Success != ( o = solver.info() ) )
-        ErrorFunction< std::runtime_error >( __FUNCTION__, __LINE__, __FILE__, "ErrorPassThrough",
-                                             solver.lastErrorMessage().c_str() );
-
-    SparseMatrix< double, ColMajor > ret = solver.solve( b );
+    // mAlg2MatrixA has already been factorized in PrepareEquationSystem, only the triangular solves are left
+    SparseMatrix< double, ColMajor > ret = mAlg2Solver.GetSolver().solve( b );
 
     dxdt.bottomRows( algUIDCount ) = ret;
 }
@@ -287,20 +457,8 @@ void DifferentialAlgebraicSystem< SparseMatrix< double, RowMajor > >::operator()
     SparseMatrix< double, ColMajor > b = -mAlg1MatrixA * dxdt_dgl;
     b.makeCompressed();
 
-    SparseLU< SparseMatrix< double, ColMajor > > solver;
-
-    // Compute the ordering permutation vector from the structural pattern of A
-    solver.analyzePattern( mAlg2MatrixA );
-    // Compute the numerical factorization
-    solver.factorize( mAlg2MatrixA );
-    // Use the factors to solve the linear system
-
-    ComputationInfo o;
-    if ( Success != ( o = solver.info() ) )
-        ErrorFunction< std::runtime_error >( __FUNCTION__, __LINE__, __FILE__, "ErrorPassThrough",
-                                             solver.lastErrorMessage().c_str() );
-
-    SparseMatrix< double, ColMajor > ret = solver.solve( b );
+    // mAlg2MatrixA has already been factorized in PrepareEquationSystem, only the triangular solves are left
+    SparseMatrix< double, ColMajor > ret = mAlg2Solver.GetSolver().solve( b );
 
     dxdt.bottomRows( algUIDCount ) = ret;
 }
@@ -309,39 +467,41 @@ void DifferentialAlgebraicSystem< SparseMatrix< double, RowMajor > >::operator()
 void DifferentialAlgebraicSystem< SparseMatrix< double, RowMajor > >::
 operator()( const arma::Mat< double > &x, arma::Mat< double > &dxdt, const double /* t */ )
 {
-    // Read from arma matrix
-    // TODO:Use memcpy in future
-    MatrixType x2( x.n_rows, x.n_cols );
-    for ( size_t i = 0; i < x.n_rows; ++i )
-        x2( i, 0 ) = x( i, 0 );
-
-    dxdt.resize( x.n_rows, x.n_cols );
-    MatrixXd dxdt2( dxdt.n_rows, dxdt.n_cols );
-
-    // Do the job
-    operator()( x2, dxdt2, 0 );
-
-    // Write back to arma matrix
-    for ( size_t i = 0; i < dxdt.n_rows; ++i )
-        dxdt( i, 0 ) = dxdt2( i, 0 );
+    dxdt.set_size( x.n_rows, x.n_cols );
+    Evaluate( x.memptr(), dxdt.memptr() );
 }
 
 void DifferentialAlgebraicSystem< SparseMatrix< double, RowMajor > >::
 operator()( const std::vector< double > &x, std::vector< double > &dxdt, const double /* t */ )
 {
-    const size_t stateCount = mStateSystemGroup->GetStateCount();
+    dxdt.resize( x.size() );
+    Evaluate( &x[0], &dxdt[0] );
+}
+
+void DifferentialAlgebraicSystem< SparseMatrix< double, RowMajor > >::Evaluate( const double *x, double *dxdt )
+{
+    const size_t algUIDCount = mAlgStateSystem->GetEquationCount();
+    const size_t dglUIDCount = mDglStateSystem->GetEquationCount();
+    const MatrixType &dglMatrixA = mDglStateSystem->GetEquationSystemAMatrix();
+    const MatrixType &dglVectorC = mDglStateSystem->GetEquationSystemCVector();
 
-    // Store x into temporary states
-    SparseMatrix< double, RowMajor > tmpX( stateCount, 1 );
-    misc::FastCopyMatrix( tmpX, &x[0], stateCount );
+    // The odeint states are used in place, without copying them into sparse matrices
+    Eigen::Map< const VectorXd > xMap( x, dglUIDCount + algUIDCount );
+    Eigen::Map< VectorXd > dxdtMap( dxdt, dglUIDCount + algUIDCount );
 
-    // Calculate dxdt
-    SparseMatrix< double, RowMajor > tmpDxdt( stateCount, 1 );
-    operator()( tmpX, tmpDxdt, 0.0 );
+    dxdtMap.head( dglUIDCount ).noalias() = dglMatrixA * xMap;
+    for ( size_t row = 0; row < dglUIDCount; ++row )
+        for ( MatrixType::InnerIterator it( dglVectorC, row ); it; ++it )
+            dxdtMap( row ) += it.value();
 
-    // Store result back into dxdt
-    dxdt.resize( x.size() );
-    misc::FastCopyMatrix( &dxdt[0], tmpDxdt, stateCount );
+    if ( algUIDCount == 0 )
+        return;
+
+    mAlgRhs.noalias() = mAlg1MatrixA * dxdtMap.head( dglUIDCount );
+    mAlgRhs = -mAlgRhs;
+
+    // mAlg2MatrixA has already been factorized in PrepareEquationSystem, only the triangular solves are left
+    dxdtMap.tail( algUIDCount ) = mAlg2Solver.GetSolver().solve( mAlgRhs );
 }
 
 void DifferentialAlgebraicSystem< SparseMatrix< double, RowMajor > >::CalculateInitialState()    ///< output x vector with all DGL values set to zero
@@ -359,19 +519,8 @@ void DifferentialAlgebraicSystem< SparseMatrix< double, RowMajor > >::CalculateI
     SparseMatrix< double, ColMajor > b = mAlgStateSystem->GetEquationSystemCVector();
     b.makeCompressed();
 
-    SparseLU< SparseMatrix< double, ColMajor > > solver;
-    // Compute the ordering permutation vector from the structural pattern of A
-    solver.analyzePattern( mAlg2MatrixA );
-    // Compute the numerical factorization
-    solver.factorize( mAlg2MatrixA );
-    // Use the factors to solve the linear system
-
-    ComputationInfo o;
-    if ( Success != ( o = solver.info() ) )
-        ErrorFunction< std::runtime_error >( __FUNCTION__, __LINE__, __FILE__, "ErrorPassThrough",
-                                             solver.lastErrorMessage().c_str() );
-
-    SparseMatrix< double, ColMajor > ret = solver.solve( b );
+    mAlg2Solver.Factorize( SparseMatrix< double, ColMajor >( mAlg2MatrixA ) );
+    SparseMatrix< double, ColMajor > ret = mAlg2Solver.GetSolver().solve( b );
 
     mStateSystemGroup->mStateVector.middleRows( dglUIDCount, algUIDCount ) = -ret;
 }
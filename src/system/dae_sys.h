@@ -34,6 +34,7 @@ _._._._._._._._._._._._._._._._._._._._._.*/
 #include "../misc/fast_copy_matrix.h"
 #include "stateSystemGroup.h"
 #include "generalizedsystem.h"
+#include "cachedSparseLu.h"
 
 /// Namespace for system objects
 namespace systm
@@ -268,8 +269,27 @@ class DifferentialAlgebraicSystem< arma::SpMat< double > > : public GeneralizedS
     void CalculateInitialState();    ///< output x vector with all DGL values set to zero
     //        void ODEifyEquations(); ///<  make ode equations out of the linear ones (alg1,alg2)
 
-    arma::Mat< double > mMatrixA;
-    arma::Mat< double > mVectorC;
+    /// Prepares SolveAlg2() for a new algebraic block
+    void FactorizeAlg2( const arma::SpMat< double >& alg2MatrixA );
+
+    /// Solves alg2MatrixA * result = -rhs with the factorization of FactorizeAlg2()
+    void SolveAlg2( const double* rhs, double* result ) const;
+
+    arma::SpMat< double > mDglMatrixA;
+    arma::Mat< double > mDglVectorC;
+    arma::SpMat< double > mAlg1MatrixA;
+#ifdef USE_EIGEN
+    CachedSparseLU mAlg2Solver;    ///< Factorization of the algebraic block, only recomputed if the coefficients change
+#else
+    arma::Mat< double > mInvAlg2MatrixA;    ///< Dense inverse of the algebraic block, if eigen3 is not available
+#endif
+
+    arma::Mat< double > mDxdtDgl;    ///< Buffer for the derivatives of the differential states
+    arma::Mat< double > mAlgRhs;     ///< Buffer for the right hand side of the algebraic block
+    arma::Mat< double > mDxdtAlg;    ///< Buffer for the derivatives of the algebraic states
+    std::vector< arma::uword > mDxdtLocations;    ///< (row, col) pairs of the sparse derivative for the batch constructor
+    std::vector< double > mDxdtValues;            ///< Values of the sparse derivative for the batch constructor
+
     StateSystemGroup< arma::SpMat< double > >* mStateSystemGroup;
     StateSystem< arma::SpMat< double > >* mDglStateSystem;
     StateSystem< arma::SpMat< double > >* mAlgStateSystem;
@@ -305,8 +325,13 @@ class DifferentialAlgebraicSystem< SparseMatrix< double, RowMajor > > : public G
     void CalculateInitialState();    ///< output x vector with all DGL values set to zero
                                      //        void PrepareStateVector();
 
+    /// Calculates dxdt for contiguous x and dxdt arrays of length GetStateCount()
+    void Evaluate( const double* x, double* dxdt );
+
     MatrixType mAlg1MatrixA;
     MatrixType mAlg2MatrixA;
+    CachedSparseLU mAlg2Solver;    ///< Factorization of mAlg2MatrixA, only recomputed if the coefficients change
+    VectorXd mAlgRhs;
 
     StateSystemGroup< MatrixType >* mStateSystemGroup;
     StateSystem< MatrixType >* mDglStateSystem;
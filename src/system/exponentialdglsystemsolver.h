@@ -0,0 +1,227 @@
+/*
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see http://www.gnu.org/licenses/.
+*/
+/* -.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.
+* File Name : exponentialdglsystemsolver.h
+* Creation Date : 17-10-2026
+_._._._._._._._._._._._._._._._._._._._._.*/
+#ifndef _EXPONENTIALDGLSYSTEMSOLVER_
+#define _EXPONENTIALDGLSYSTEMSOLVER_
+
+#if defined( _EIGEN_ ) || defined( USE_EIGEN )
+
+// STD
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#ifdef __EXCEPTIONS__
+#include <stdexcept>
+#endif /* __EXCEPTIONS__ */
+
+// BOOST
+#include <boost/scoped_ptr.hpp>
+#include <boost/ref.hpp>
+#include <boost/numeric/odeint.hpp>
+#include <boost/numeric/odeint/stepper/runge_kutta_cash_karp54.hpp>
+
+// EIGEN
+#include <eigen3/Eigen/Dense>
+#include <eigen3/unsupported/Eigen/MatrixFunctions>
+
+// ETC
+#include "systemSolver.h"
+#include "dae_sys.h"
+#include "implicitdglsystemsolver.h"
+#include "../misc/fast_copy_matrix.h"
+#include "../exceptions/error_proto.h"
+
+#ifndef EXPONENTIAL_SOLVER_MAX_STATES
+#define EXPONENTIAL_SOLVER_MAX_STATES 300
+#endif
+
+namespace systm
+{
+
+/// Solver with constant dt that advances the reduced system dx/dt = A * x + C exactly with its propagator:
+/// x(t + dt) = exp(A * dt) * x(t) + integral_0^dt exp(A * s) ds * C
+/// Both matrices are computed at once from the exponential of the block matrix [A I; 0 0] * dt and are reused as long as
+/// A and dt do not change. A new current only changes C and therefore costs two matrix-vector products.
+/// If A has also changed in the step before, e.g. because lookup values are moving, the step is integrated with the
+/// adaptive Runge-Kutta method instead, so systems whose A changes in every step do not pay for a matrix exponential per
+/// step. A single change of A, e.g. at the start of a new segment of the profile, directly computes a new propagator.
+/// The exponential of the dense 2n x 2n block matrix costs O(n^3) time and O(n^2) memory. Systems with more than
+/// maxPropagatorStateCount states are therefore always integrated with the Runge-Kutta method.
+template < typename T >
+class ExponentialDglSystemSolver : public SystemSolver< T >
+{
+    public:
+    ExponentialDglSystemSolver( StateSystemGroup< T >* stateSystemGroup, double dt,
+                                size_t maxPropagatorStateCount = EXPONENTIAL_SOLVER_MAX_STATES );
+
+    virtual ~ExponentialDglSystemSolver() {}
+
+    virtual double Solve();
+
+    /// Number of computed propagators
+    size_t GetPropagatorCount() const { return mPropagatorCount; }
+
+    /// Number of steps that have been integrated with the Runge-Kutta method
+    size_t GetRungeKuttaStepCount() const { return mRungeKuttaStepCount; }
+
+    /// Returns false if the system has too many states for the propagator and is always integrated with Runge-Kutta
+    bool UsesPropagator() const { return mUsesPropagator; }
+
+    private:
+    /// Computes mPropagator and mInputIntegral for the reduced A and mDt
+    void ComputePropagator();
+    void PropagatorStep();
+    void RungeKuttaStep();
+
+    boost::scoped_ptr< systm::DifferentialAlgebraicSystem< T > > mDaeSystem;
+
+    boost::numeric::odeint::result_of::make_controlled<
+     boost::numeric::odeint::runge_kutta_cash_karp54< std::vector< double > > >::type mRungeKuttaStepper;
+
+    CachedSparseLU::MatrixType mConvertedMatrix;
+    EquationSystemChangeDetector mEquationSystemChangeDetector;
+    bool mEquationSystemsAreSet;
+    bool mEquationSystemsHaveChangedLastStep;
+
+    Eigen::MatrixXd mPropagator;       ///< exp(A * dt)
+    Eigen::MatrixXd mInputIntegral;    ///< integral_0^dt exp(A * s) ds
+    Eigen::MatrixXd mBlockMatrix;
+    const bool mUsesPropagator;
+    bool mPropagatorIsValid;
+    double mPropagatorDt;
+
+    std::vector< double > mX;
+    Eigen::VectorXd mVectorC;
+    Eigen::VectorXd mXNext;
+
+    size_t mPropagatorCount;
+    size_t mRungeKuttaStepCount;
+};
+
+template < typename T >
+ExponentialDglSystemSolver< T >::ExponentialDglSystemSolver( StateSystemGroup< T >* stateSystemGroup, double dt,
+                                                             size_t maxPropagatorStateCount )
+    : SystemSolver< T >( stateSystemGroup, dt )
+    , mDaeSystem( new systm::DifferentialAlgebraicSystem< T >( stateSystemGroup ) )
+    , mRungeKuttaStepper( boost::numeric::odeint::make_controlled(
+       1.0e-10, 1.0e-10, boost::numeric::odeint::runge_kutta_cash_karp54< std::vector< double > >() ) )
+    , mEquationSystemsAreSet( false )
+    , mEquationSystemsHaveChangedLastStep( false )
+    , mUsesPropagator( stateSystemGroup->GetStateCount() <= maxPropagatorStateCount )
+    , mPropagatorIsValid( false )
+    , mPropagatorDt( 0.0 )
+    , mX( stateSystemGroup->GetStateCount(), 0.0 )
+    , mPropagatorCount( 0 )
+    , mRungeKuttaStepCount( 0 )
+{
+    if ( dt == 0 )
+        ErrorFunction< std::runtime_error >( __FUNCTION__, __LINE__, __FILE__, "DtIsZero" );
+
+    if ( !mUsesPropagator )
+        return;
+
+    const size_t stateCount = stateSystemGroup->GetStateCount();
+    mBlockMatrix.setZero( 2 * stateCount, 2 * stateCount );
+    mBlockMatrix.topRightCorner( stateCount, stateCount ).setIdentity();
+}
+
+template < typename T >
+double ExponentialDglSystemSolver< T >::Solve()
+{
+    mDaeSystem->PrepareEquationSystem();
+
+    misc::FastCopyMatrix( &mX[0], this->mStateVector, mX.size() );
+
+    const bool hasChanged = mEquationSystemChangeDetector.HaveChanged( *this->mStateSystemGroup ) && mEquationSystemsAreSet;
+    mEquationSystemsAreSet = true;
+    if ( hasChanged )
+        mPropagatorIsValid = false;
+
+    if ( !mUsesPropagator || ( hasChanged && mEquationSystemsHaveChangedLastStep ) )
+    {
+        RungeKuttaStep();
+    }
+    else
+    {
+        if ( !mPropagatorIsValid || mPropagatorDt != this->mDt )
+            ComputePropagator();
+        PropagatorStep();
+    }
+    mEquationSystemsHaveChangedLastStep = hasChanged;
+    this->mTime += this->mDt;
+
+    misc::FastCopyMatrix( this->mStateVector, &mX[0], mX.size() );
+
+    this->ResetStateSystemGroup();
+
+    return this->mTime;
+}
+
+template < typename T >
+void ExponentialDglSystemSolver< T >::ComputePropagator()
+{
+    const size_t stateCount = mX.size();
+    ConvertToEigenSparse( mDaeSystem->GetA(), mConvertedMatrix );
+    mBlockMatrix.topLeftCorner( stateCount, stateCount ) = mConvertedMatrix;
+
+    // The block matrix is only exponentiated for h = dt / 2^squarings with |A * h| <= 1. The squarings are done on the
+    // n x n blocks with exp(A * 2h) = exp(A * h)^2 and integral_0^2h = (I + exp(A * h)) * integral_0^h, which is
+    // cheaper than squaring the 2n x 2n block matrix.
+    const double norm = mBlockMatrix.topLeftCorner( stateCount, stateCount ).cwiseAbs().colwise().sum().maxCoeff() * this->mDt;
+    const int squarings = norm > 1.0 ? static_cast< int >( std::ceil( std::log( norm ) / std::log( 2.0 ) ) ) : 0;
+
+    const Eigen::MatrixXd blockExponential = ( mBlockMatrix * std::ldexp( static_cast< double >( this->mDt ), -squarings ) ).exp();
+    mPropagator = blockExponential.topLeftCorner( stateCount, stateCount );
+    mInputIntegral = blockExponential.topRightCorner( stateCount, stateCount );
+
+    for ( int i = 0; i < squarings; ++i )
+    {
+        mInputIntegral += mPropagator * mInputIntegral;
+        mPropagator = mPropagator * mPropagator;
+    }
+
+    mPropagatorIsValid = true;
+    mPropagatorDt = this->mDt;
+    ++mPropagatorCount;
+}
+
+template < typename T >
+void ExponentialDglSystemSolver< T >::PropagatorStep()
+{
+    mVectorC.resize( mX.size() );
+    misc::FastCopyMatrix( mVectorC.data(), mDaeSystem->GetC(), mVectorC.size() );
+
+    Eigen::Map< Eigen::VectorXd > x( &mX[0], mX.size() );
+    mXNext.noalias() = mPropagator * x;
+    mXNext.noalias() += mInputIntegral * mVectorC;
+    x = mXNext;
+}
+
+template < typename T >
+void ExponentialDglSystemSolver< T >::RungeKuttaStep()
+{
+    boost::numeric::odeint::integrate_adaptive( mRungeKuttaStepper, boost::ref( *mDaeSystem ), mX, 0.0,
+                                                static_cast< double >( this->mDt ), static_cast< double >( this->mDt ) );
+    ++mRungeKuttaStepCount;
+}
+
+} /* namespace systm */
+
+#endif /* defined( _EIGEN_ ) || defined( USE_EIGEN ) */
+
+#endif /* _EXPONENTIALDGLSYSTEMSOLVER_ */
@@ -0,0 +1,83 @@
+/*
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see http://www.gnu.org/licenses/.
+*/
+/* -.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.
+* File Name : implicitdglsystemsolver.cpp
+* Creation Date : 17-10-2026
+_._._._._._._._._._._._._._._._._._._._._.*/
+#include "implicitdglsystemsolver.h"
+
+#if defined( _EIGEN_ ) || defined( USE_EIGEN )
+
+// STD
+#include <vector>
+#include <algorithm>
+
+namespace systm
+{
+
+#ifdef _ARMADILLO_
+template <>
+void ConvertToEigenSparse< arma::Mat< double > >( const arma::Mat< double >& matrix, CachedSparseLU::MatrixType& result )
+{
+    std::vector< Eigen::Triplet< double > > triplets;
+    for ( size_t col = 0; col < matrix.n_cols; ++col )
+        for ( size_t row = 0; row < matrix.n_rows; ++row )
+            if ( matrix( row, col ) != 0.0 )
+                triplets.push_back( Eigen::Triplet< double >( row, col, matrix( row, col ) ) );
+
+    result.resize( matrix.n_rows, matrix.n_cols );
+    result.setFromTriplets( triplets.begin(), triplets.end() );
+}
+
+template <>
+void ConvertToEigenSparse< arma::SpMat< double > >( const arma::SpMat< double >& matrix, CachedSparseLU::MatrixType& result )
+{
+    std::vector< Eigen::Triplet< double > > triplets;
+    triplets.reserve( matrix.n_nonzero );
+    for ( arma::SpMat< double >::const_iterator it = matrix.begin(); it != matrix.end(); ++it )
+        triplets.push_back( Eigen::Triplet< double >( it.row(), it.col(), *it ) );
+
+    result.resize( matrix.n_rows, matrix.n_cols );
+    result.setFromTriplets( triplets.begin(), triplets.end() );
+}
+#endif /* _ARMADILLO_ */
+
+#ifdef _EIGEN_
+template <>
+void ConvertToEigenSparse< SparseMatrix< double, RowMajor > >( const SparseMatrix< double, RowMajor >& matrix,
+                                                               CachedSparseLU::MatrixType& result )
+{
+    result = matrix;
+}
+#endif /* _EIGEN_ */
+
+bool EquationSystemChangeDetector::StoreIfChanged( const CachedSparseLU::MatrixType& matrix, CachedSparseLU::MatrixType& storedMatrix )
+{
+    if ( matrix.rows() == storedMatrix.rows() && matrix.cols() == storedMatrix.cols() &&
+         matrix.nonZeros() == storedMatrix.nonZeros() &&
+         std::equal( matrix.outerIndexPtr(), matrix.outerIndexPtr() + matrix.outerSize() + 1, storedMatrix.outerIndexPtr() ) &&
+         std::equal( matrix.innerIndexPtr(), matrix.innerIndexPtr() + matrix.nonZeros(), storedMatrix.innerIndexPtr() ) &&
+         std::equal( matrix.valuePtr(), matrix.valuePtr() + matrix.nonZeros(), storedMatrix.valuePtr() ) )
+        return false;
+
+    storedMatrix = matrix;
+    return true;
+}
+
+template class ImplicitDglSystemSolver< myMatrixType >;
+
+} /* namespace systm */
+
+#endif /* defined( _EIGEN_ ) || defined( USE_EIGEN ) */
@@ -0,0 +1,271 @@
+/*
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see http://www.gnu.org/licenses/.
+*/
+/* -.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.
+* File Name : implicitdglsystemsolver.h
+* Creation Date : 17-10-2026
+_._._._._._._._._._._._._._._._._._._._._.*/
+#ifndef _IMPLICITDGLSYSTEMSOLVER_
+#define _IMPLICITDGLSYSTEMSOLVER_
+
+#if defined( _EIGEN_ ) || defined( USE_EIGEN )
+
+// STD
+#include <cmath>
+#include <algorithm>
+#ifdef __EXCEPTIONS__
+#include <stdexcept>
+#endif /* __EXCEPTIONS__ */
+
+// BOOST
+#include <boost/scoped_ptr.hpp>
+
+// ETC
+#include "systemSolver.h"
+#include "dae_sys.h"
+#include "cachedSparseLu.h"
+#include "../misc/fast_copy_matrix.h"
+#include "../exceptions/error_proto.h"
+
+#ifndef SOLVER_TRIES
+#define SOLVER_TRIES 10
+#endif
+
+namespace systm
+{
+
+/// Copies a matrix of the backend into a column major Eigen sparse matrix
+template < typename T >
+void ConvertToEigenSparse( const T& matrix, CachedSparseLU::MatrixType& result );
+
+/// Detects changes of the reduced A of a StateSystemGroup between steps.
+/// The reduced A only depends on the A matrices of the differential and the algebraic equations. Comparing them is much
+/// cheaper than assembling the reduced A.
+class EquationSystemChangeDetector
+{
+    public:
+    /// Returns true if the A matrices of the differential or the algebraic equations differ from the last call, which
+    /// includes the first call
+    template < typename T >
+    bool HaveChanged( StateSystemGroup< T >& stateSystemGroup );
+
+    private:
+    /// Stores matrix in storedMatrix and returns true if it differs from the stored one
+    static bool StoreIfChanged( const CachedSparseLU::MatrixType& matrix, CachedSparseLU::MatrixType& storedMatrix );
+
+    CachedSparseLU::MatrixType mConvertedMatrix;
+    CachedSparseLU::MatrixType mDglMatrixA;    ///< A of the differential equations of the last call
+    CachedSparseLU::MatrixType mAlgMatrixA;    ///< A of the algebraic equations of the last call
+};
+
+template < typename T >
+bool EquationSystemChangeDetector::HaveChanged( StateSystemGroup< T >& stateSystemGroup )
+{
+    ConvertToEigenSparse( stateSystemGroup.mDglStateSystem.GetEquationSystemAMatrix(), mConvertedMatrix );
+    bool hasChanged = StoreIfChanged( mConvertedMatrix, mDglMatrixA );
+
+    ConvertToEigenSparse( stateSystemGroup.mAlgStateSystem.GetEquationSystemAMatrix(), mConvertedMatrix );
+    hasChanged = StoreIfChanged( mConvertedMatrix, mAlgMatrixA ) || hasChanged;
+
+    return hasChanged;
+}
+
+/// A-stable solver using the TR-BDF2 scheme: a trapezoidal step to t + gamma * dt followed by a BDF2 step to t + dt.
+/// The scheme is L-stable and of second order, so stiff states like small RC time constants do not limit the step size.
+/// Between two calls of PrepareEquationSystem() the reduced system dx/dt = A * x + C is linear and A is the exact
+/// Jacobian. With gamma = 2 - sqrt(2), both stages use the same iteration matrix I - gamma / 2 * dt * A, which is only
+/// factorized again if dt or A have changed. The reduced A itself is only assembled again if the A matrices of the
+/// differential or the algebraic equations have changed.
+/// If dt == 0, the step size is adapted to the estimated local error, otherwise it is kept constant.
+template < typename T >
+class ImplicitDglSystemSolver : public SystemSolver< T >
+{
+    public:
+    ImplicitDglSystemSolver( StateSystemGroup< T >* stateSystemGroup, double dt, double absoluteTolerance = 1.0e-6,
+                             double relativeTolerance = 1.0e-6 );
+
+    virtual ~ImplicitDglSystemSolver() {}
+
+    virtual double Solve();
+
+    /// Number of numeric factorizations of the iteration matrix that have been done so far
+    size_t GetFactorizationCount() const { return mIterationMatrixSolver.GetFactorizationCount(); }
+
+    private:
+    /// Copies the reduced system of mDaeSystem into mMatrixA and mVectorC, mMatrixA only if it has changed
+    void LoadReducedSystem();
+    /// Advances mX by mDt. Returns false if the estimated error is too large, mDt is adapted in either case if the step
+    /// size is variable
+    bool TryStep();
+    /// Solves (I - gamma / 2 * dt * A) * result = rhs with the current factorization
+    void SolveIterationMatrix( const Eigen::VectorXd& rhs, Eigen::VectorXd& result ) const;
+
+    boost::scoped_ptr< systm::DifferentialAlgebraicSystem< T > > mDaeSystem;
+    const bool mIsVariableStep;
+    const double mAbsoluteTolerance;
+    const double mRelativeTolerance;
+
+    EquationSystemChangeDetector mEquationSystemChangeDetector;
+    CachedSparseLU::MatrixType mMatrixA;
+    CachedSparseLU::MatrixType mIdentity;
+    Eigen::VectorXd mVectorC;
+    CachedSparseLU mIterationMatrixSolver;
+    bool mIterationMatrixIsValid;    ///< False if mMatrixA has changed since the last factorization
+    double mIterationMatrixDt;       ///< dt of the last factorization
+
+    Eigen::VectorXd mX;
+    Eigen::VectorXd mXGamma;
+    Eigen::VectorXd mXNext;
+    Eigen::VectorXd mDxdt;
+    Eigen::VectorXd mDxdtGamma;
+    Eigen::VectorXd mRhs;
+    Eigen::VectorXd mError;
+};
+
+template < typename T >
+ImplicitDglSystemSolver< T >::ImplicitDglSystemSolver( StateSystemGroup< T >* stateSystemGroup, double dt,
+                                                       double absoluteTolerance, double relativeTolerance )
+    : SystemSolver< T >( stateSystemGroup, dt == 0 ? 0.0001 : dt )
+    , mDaeSystem( new systm::DifferentialAlgebraicSystem< T >( stateSystemGroup ) )
+    , mIsVariableStep( dt == 0 )
+    , mAbsoluteTolerance( absoluteTolerance )
+    , mRelativeTolerance( relativeTolerance )
+    , mIterationMatrixIsValid( false )
+    , mIterationMatrixDt( 0.0 )
+{
+    const size_t stateCount = stateSystemGroup->GetStateCount();
+    mIdentity.resize( stateCount, stateCount );
+    mIdentity.setIdentity();
+    mX.resize( stateCount );
+}
+
+template < typename T >
+double ImplicitDglSystemSolver< T >::Solve()
+{
+    mDaeSystem->PrepareEquationSystem();
+    LoadReducedSystem();
+
+    misc::FastCopyMatrix( mX.data(), this->mStateVector, mX.size() );
+
+    bool successfull = false;
+    for ( size_t tries = SOLVER_TRIES; tries > 0 && !successfull; --tries )
+        successfull = TryStep();
+
+    if ( !successfull )
+        ErrorFunction< std::runtime_error >( __FUNCTION__, __LINE__, __FILE__, "ErrorStep" );
+
+    misc::FastCopyMatrix( this->mStateVector, mX.data(), mX.size() );
+
+    this->ResetStateSystemGroup();
+
+    return this->mTime;
+}
+
+template < typename T >
+void ImplicitDglSystemSolver< T >::LoadReducedSystem()
+{
+    if ( mEquationSystemChangeDetector.HaveChanged( *this->mStateSystemGroup ) )
+    {
+        ConvertToEigenSparse( mDaeSystem->GetA(), mMatrixA );
+        mIterationMatrixIsValid = false;
+    }
+
+    const T& vectorC = mDaeSystem->GetC();
+    mVectorC.resize( mX.size() );
+    misc::FastCopyMatrix( mVectorC.data(), vectorC, mVectorC.size() );
+}
+
+template < typename T >
+bool ImplicitDglSystemSolver< T >::TryStep()
+{
+    const double gamma = 2.0 - std::sqrt( 2.0 );
+    const double d = gamma / 2.0;
+    const double dt = this->mDt;
+
+    if ( !mIterationMatrixIsValid || mIterationMatrixDt != dt )
+    {
+        mIterationMatrixSolver.Factorize( mIdentity - ( d * dt ) * mMatrixA );
+        mIterationMatrixIsValid = true;
+        mIterationMatrixDt = dt;
+    }
+
+    // Trapezoidal stage: (I - d*dt*A) * xGamma = x + d*dt * (A*x + C) + d*dt * C
+    mDxdt = mMatrixA * mX + mVectorC;
+    mRhs = mX + ( d * dt ) * ( mDxdt + mVectorC );
+    SolveIterationMatrix( mRhs, mXGamma );
+
+    // BDF2 stage: (I - d*dt*A) * xNext = (xGamma - (1 - gamma)^2 * x) / (gamma * (2 - gamma)) + d*dt * C
+    mRhs = ( mXGamma - ( ( 1.0 - gamma ) * ( 1.0 - gamma ) ) * mX ) / ( gamma * ( 2.0 - gamma ) ) + ( d * dt ) * mVectorC;
+    SolveIterationMatrix( mRhs, mXNext );
+
+    if ( !mIsVariableStep )
+    {
+        mX.swap( mXNext );
+        this->mTime += dt;
+        return true;
+    }
+
+    // Local error estimate from the derivatives at t, t + gamma * dt and t + dt (Bank et al., 1985). It is filtered
+    // by the iteration matrix to stay bounded for the stiff components.
+    const double k = ( -3.0 * gamma * gamma + 4.0 * gamma - 2.0 ) / ( 12.0 * ( 2.0 - gamma ) );
+    mDxdtGamma = mMatrixA * mXGamma + mVectorC;
+    mRhs = ( 2.0 * k * dt ) * ( mDxdt / gamma - mDxdtGamma / ( gamma * ( 1.0 - gamma ) ) +
+                                ( mMatrixA * mXNext + mVectorC ) / ( 1.0 - gamma ) );
+    SolveIterationMatrix( mRhs, mError );
+
+    double error = 0.0;
+    for ( size_t i = 0; i < static_cast< size_t >( mX.size() ); ++i )
+    {
+        const double scale = mAbsoluteTolerance + mRelativeTolerance * std::max( std::fabs( mX[i] ), std::fabs( mXNext[i] ) );
+        error = std::max( error, std::fabs( mError[i] ) / scale );
+    }
+
+    const double factor = 0.9 * std::pow( std::max( error, 1.0e-10 ), -1.0 / 3.0 );
+    if ( error > 1.0 )
+    {
+        this->mDt *= std::max( factor, 0.2 );
+        return false;
+    }
+
+    mX.swap( mXNext );
+    this->mTime += dt;
+    if ( error < 0.5 )
+        this->mDt *= std::min( factor, 5.0 );
+    return true;
+}
+
+template < typename T >
+void ImplicitDglSystemSolver< T >::SolveIterationMatrix( const Eigen::VectorXd& rhs, Eigen::VectorXd& result ) const
+{
+    result = mIterationMatrixSolver.GetSolver().solve( rhs );
+}
+
+#ifdef _ARMADILLO_
+template <>
+void ConvertToEigenSparse< arma::Mat< double > >( const arma::Mat< double >& matrix, CachedSparseLU::MatrixType& result );
+template <>
+void ConvertToEigenSparse< arma::SpMat< double > >( const arma::SpMat< double >& matrix, CachedSparseLU::MatrixType& result );
+#endif /* _ARMADILLO_ */
+
+#ifdef _EIGEN_
+template <>
+void ConvertToEigenSparse< SparseMatrix< double, RowMajor > >( const SparseMatrix< double, RowMajor >& matrix,
+                                                               CachedSparseLU::MatrixType& result );
+#endif /* _EIGEN_ */
+
+} /* namespace systm */
+
+#endif /* defined( _EIGEN_ ) || defined( USE_EIGEN ) */
+
+#endif /* _IMPLICITDGLSYSTEMSOLVER_ */
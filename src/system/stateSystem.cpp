@@ -45,11 +45,48 @@ void StateSystem< SparseMatrix< double, RowMajor > >::AddEquations( size_t equat
     mVectorC.middleRows( equationNumber, matrix.n_rows ) = vectorC;
 }
 
+template <>
+void StateSystem< SparseMatrix< double, RowMajor > >::SetEquation( size_t equationNumber, const std::vector< size_t > &columns,
+                                                                   const std::vector< double > &values )
+{
+    size_t stateColumns = columns.size();
+    if ( stateColumns && columns.back() == mStateCount )
+    {
+        --stateColumns;
+        mVectorC.coeffRef( equationNumber, 0 ) = values.back();
+    }
+
+    // As long as the sparsity pattern of the line is unchanged the values are overwritten in place
+    if ( mMatrixA.isCompressed() )
+    {
+        const int begin = mMatrixA.outerIndexPtr()[equationNumber];
+        const int end = mMatrixA.outerIndexPtr()[equationNumber + 1];
+        bool samePattern = static_cast< size_t >( end - begin ) == stateColumns;
+        for ( size_t i = 0; samePattern && i < stateColumns; ++i )
+            samePattern = static_cast< size_t >( mMatrixA.innerIndexPtr()[begin + i] ) == columns[i];
+
+        if ( samePattern )
+        {
+            std::copy( values.begin(), values.begin() + stateColumns, mMatrixA.valuePtr() + begin );
+            return;
+        }
+    }
+
+    SparseMatrix< double, RowMajor > row( 1, mStateCount );
+    row.reserve( stateColumns );
+    for ( size_t i = 0; i < stateColumns; ++i )
+        row.insert( 0, columns[i] ) = values[i];
+    mMatrixA.middleRows( equationNumber, 1 ) = row;
+}
+
+/// Reset the matrix to zeros. The sparsity pattern is kept, so that SetEquation can refill the lines in place.
 template <>
 void StateSystem< SparseMatrix< double, RowMajor > >::ResetSystem()
 {
-    mMatrixA.setZero();
-    mVectorC.setZero();
+    mMatrixA.makeCompressed();
+    std::fill( mMatrixA.valuePtr(), mMatrixA.valuePtr() + mMatrixA.nonZeros(), 0.0 );
+    mVectorC.makeCompressed();
+    std::fill( mVectorC.valuePtr(), mVectorC.valuePtr() + mVectorC.nonZeros(), 0.0 );
 }
 #endif /* _EIGEN_ */
 
@@ -149,6 +186,16 @@ void StateSystem< arma::SpMat< double > >::AddEquations( size_t equationNumber,
     mMatrixCNeedsUpdate = true;
 }
 
+/// Set the entries of one line in the matrix
+void StateSystem< arma::SpMat< double > >::SetEquation( size_t equationNumber, const std::vector< size_t > &columns,
+                                                        const std::vector< double > &values )
+{
+    arma::SpMat< double > row( 1, mStateCount + 1 );
+    for ( size_t i = 0; i < columns.size(); ++i )
+        row( 0, columns[i] ) = values[i];
+    AddEquations( equationNumber, row );
+}
+
 /// Reset the matrix to zeros (used for sparse only)
 void StateSystem< arma::SpMat< double > >::ResetSystem()
 {
@@ -25,6 +25,7 @@ along with this program.  If not, see http://www.gnu.org/licenses/.
 #include "../misc/matrixInclude.h"
 
 // STD
+#include <algorithm>
 #include <vector>
 
 // BOOST
@@ -56,6 +57,10 @@ class StateSystem
     /// Set one or more lines in the matrix
     void AddEquations( size_t equationNumber, const MatrixType &matrix, const MatrixType &vectorC );
 
+    /// Set the entries of one line in the matrix, all other entries of the line become zero. The column after the last
+    /// state is the constant part.
+    void SetEquation( size_t equationNumber, const std::vector< size_t > &columns, const std::vector< double > &values );
+
     /// Reset the matrix to zeros
     void ResetSystem();
 
@@ -78,13 +83,34 @@ class StateSystem
     void PartitionSystem( std::vector< std::pair< size_t, size_t > > /* partitions */ ) {}
 
     private:
+    /// Copies the nonzero entries of one line of matrix and records them as the new pattern of the line
+    void CopyEquation( size_t equationNumber, const MatrixType &matrix, size_t row, const MatrixType *vectorC );
+
+    /// Zeroes all entries of one line which are part of its pattern
+    void ClearEquation( size_t equationNumber );
+
+    /// Replaces the pattern of one line by the columns in mPatternBuffer
+    void StoreEquationPattern( size_t equationNumber );
+
     MatrixType mMatrixA;
     MatrixType mVectorC;
     size_t mEquationCount;
     size_t mStateCount;
     bool mIsInitialized;
+
+    /// CSR pattern of all entries which may be nonzero in mMatrixA and mVectorC, the latter being column mStateCount.
+    /// Writing and resetting lines only touches these entries instead of all columns.
+    std::vector< size_t > mPatternRowStarts;
+    std::vector< size_t > mPatternColumns;
+    std::vector< size_t > mPatternBuffer;
 };
 
+inline bool IsZeroEntry( double value ) { return value == 0.0; }
+
+#ifdef _SYMBOLIC_
+inline bool IsZeroEntry( const symbolic::Symbolic &value ) { return value.IsEmpty(); }
+#endif /* _SYMBOLIC_ */
+
 
 #ifdef _EIGEN_
 template <>
@@ -96,6 +122,10 @@ void StateSystem< SparseMatrix< double, RowMajor > >::AddEquations( size_t equat
                                                                     const SparseMatrix< double, RowMajor > &matrix,
                                                                     const SparseMatrix< double, RowMajor > &vectorC );
 
+template <>
+void StateSystem< SparseMatrix< double, RowMajor > >::SetEquation( size_t equationNumber, const std::vector< size_t > &columns,
+                                                                   const std::vector< double > &values );
+
 template <>
 void StateSystem< SparseMatrix< double, RowMajor > >::ResetSystem();
 #endif /* _EIGEN_ */
@@ -118,7 +148,10 @@ StateSystem< MatrixType >::StateSystem( const MatrixType &matrixA, const MatrixT
     , mEquationCount( matrixA.n_rows )
     , mStateCount( matrixA.n_cols )
     , mIsInitialized( true )
+    , mPatternRowStarts( matrixA.n_rows + 1, 0 )
 {
+    for ( size_t row = 0; row < mEquationCount; ++row )
+        CopyEquation( row, matrixA, row, &vectorC );
 }
 
 /// Set one or more lines in the matrix
@@ -126,12 +159,7 @@ template < typename MatrixType >
 void StateSystem< MatrixType >::AddEquations( size_t equationNumber, const MatrixType &matrix )
 {
     for ( size_t row = 0; row < matrix.n_rows; ++row )
-    {
-        for ( size_t col = 0; col < matrix.n_cols - 1; ++col )
-            mMatrixA( row + equationNumber, col ) = matrix( row, col );
-
-        mVectorC( row + equationNumber, 0 ) = matrix( row, matrix.n_cols - 1 );
-    }
+        CopyEquation( row + equationNumber, matrix, row, 0 );
 }
 
 /// Set one or more lines in the matrix
@@ -139,18 +167,92 @@ template < typename MatrixType >
 void StateSystem< MatrixType >::AddEquations( size_t equationNumber, const MatrixType &matrix, const MatrixType &vectorC )
 {
     for ( size_t row = 0; row < matrix.n_rows; ++row )
-    {
-        for ( size_t col = 0; col < matrix.n_cols; ++col )
-            mMatrixA( row + equationNumber, col ) = matrix( row, col );
+        CopyEquation( row + equationNumber, matrix, row, &vectorC );
+}
 
-        mVectorC( row + equationNumber, 0 ) = vectorC( row, 0 );
+/// Set the entries of one line in the matrix
+template < typename MatrixType >
+void StateSystem< MatrixType >::SetEquation( size_t equationNumber, const std::vector< size_t > &columns,
+                                             const std::vector< double > &values )
+{
+    ClearEquation( equationNumber );
+    for ( size_t i = 0; i < columns.size(); ++i )
+    {
+        if ( columns[i] == mStateCount )
+            mVectorC( equationNumber, 0 ) = values[i];
+        else
+            mMatrixA( equationNumber, columns[i] ) = values[i];
     }
+
+    mPatternBuffer.assign( columns.begin(), columns.end() );
+    StoreEquationPattern( equationNumber );
 }
 
-/// Reset the matrix to zeros (used for sparse only)
+/// Reset the matrix to zeros. Only the entries of the pattern can be nonzero.
 template < typename MatrixType >
 void StateSystem< MatrixType >::ResetSystem()
 {
+    for ( size_t equationNumber = 0; equationNumber + 1 < mPatternRowStarts.size(); ++equationNumber )
+        ClearEquation( equationNumber );
+}
+
+/// Copies the nonzero entries of one line of matrix. Without vectorC the last column of matrix is the constant part.
+template < typename MatrixType >
+void StateSystem< MatrixType >::CopyEquation( size_t equationNumber, const MatrixType &matrix, size_t row,
+                                              const MatrixType *vectorC )
+{
+    ClearEquation( equationNumber );
+    mPatternBuffer.clear();
+
+    const size_t stateColumns = vectorC ? matrix.n_cols : matrix.n_cols - 1;
+    for ( size_t col = 0; col < stateColumns; ++col )
+    {
+        if ( IsZeroEntry( matrix( row, col ) ) )
+            continue;
+        mMatrixA( equationNumber, col ) = matrix( row, col );
+        mPatternBuffer.push_back( col );
+    }
+
+    if ( vectorC ? !IsZeroEntry( ( *vectorC )( row, 0 ) ) : !IsZeroEntry( matrix( row, stateColumns ) ) )
+    {
+        mVectorC( equationNumber, 0 ) = vectorC ? ( *vectorC )( row, 0 ) : matrix( row, stateColumns );
+        mPatternBuffer.push_back( mStateCount );
+    }
+
+    StoreEquationPattern( equationNumber );
+}
+
+/// Zeroes all entries of one line which are part of its pattern
+template < typename MatrixType >
+void StateSystem< MatrixType >::ClearEquation( size_t equationNumber )
+{
+    for ( size_t i = mPatternRowStarts[equationNumber]; i < mPatternRowStarts[equationNumber + 1]; ++i )
+    {
+        if ( mPatternColumns[i] == mStateCount )
+            mVectorC( equationNumber, 0 ) = 0.0;
+        else
+            mMatrixA( equationNumber, mPatternColumns[i] ) = 0.0;
+    }
+}
+
+/// Replaces the pattern of one line by the columns in mPatternBuffer. As long as the number of entries of the line is
+/// unchanged, the pattern is overwritten in place.
+template < typename MatrixType >
+void StateSystem< MatrixType >::StoreEquationPattern( size_t equationNumber )
+{
+    const size_t begin = mPatternRowStarts[equationNumber];
+    const size_t end = mPatternRowStarts[equationNumber + 1];
+
+    if ( end - begin == mPatternBuffer.size() )
+    {
+        std::copy( mPatternBuffer.begin(), mPatternBuffer.end(), mPatternColumns.begin() + begin );
+        return;
+    }
+
+    mPatternColumns.erase( mPatternColumns.begin() + begin, mPatternColumns.begin() + end );
+    mPatternColumns.insert( mPatternColumns.begin() + begin, mPatternBuffer.begin(), mPatternBuffer.end() );
+    for ( size_t i = equationNumber + 1; i < mPatternRowStarts.size(); ++i )
+        mPatternRowStarts[i] = mPatternRowStarts[i] + mPatternBuffer.size() - ( end - begin );
 }
 
 /// After all equations have been registered, this method will set the data sizes and calls itself the reset method
@@ -163,6 +265,8 @@ void StateSystem< MatrixType >::Initialize( size_t stateCount )
     mStateCount = stateCount;
     mMatrixA.zeros( mEquationCount, mStateCount );
     mVectorC.zeros( mEquationCount, 1 );
+    mPatternRowStarts.assign( mEquationCount + 1, 0 );
+    mPatternColumns.clear();
 
     mIsInitialized = true;
 }
@@ -223,6 +327,10 @@ class StateSystem< arma::SpMat< double > >
     /// Set one or more lines in the matrix
     void AddEquations( size_t equationNumber, const arma::SpMat< double > &matrix, const arma::SpMat< double > &vectorC );
 
+    /// Set the entries of one line in the matrix. The column after the last state is the constant part. All entries
+    /// outside of columns have to be zero already.
+    void SetEquation( size_t equationNumber, const std::vector< size_t > &columns, const std::vector< double > &values );
+
     /// Reset the matrix to zeros
     void ResetSystem();
 
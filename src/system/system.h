@@ -25,17 +25,28 @@ along with this program.  If not, see http://www.gnu.org/licenses/.
 #include "linearsystemsolver.h"
 #include "constantstepdglsystemsolver.h"
 #include "variablestepdglsystemsolver.h"
+#include "implicitdglsystemsolver.h"
+#include "exponentialdglsystemsolver.h"
+#include "../exceptions/error_proto.h"
 
 namespace systm
 {
 
+/// Integration scheme for the differential part of the system
+enum IntegratorType
+{
+    EXPLICIT_RUNGE_KUTTA,    ///< ConstantStepDglSystemSolver or VariableStepDglSystemSolver
+    IMPLICIT_TR_BDF2,        ///< ImplicitDglSystemSolver, A-stable for stiff electrical networks
+    EXACT_EXPONENTIAL        ///< ExponentialDglSystemSolver, exact for long phases with constant A, needs dt != 0
+};
+
 /// Class for solving any System with constant or variable stepsize
 template < typename T >
 class System
 {
     public:
     /// Constructor: dt is the initial timestep. If dt==0 then a variable step solver is used.
-    System( StateSystemGroup< T >* stateSystemGroup, double dt = 0 );
+    System( StateSystemGroup< T >* stateSystemGroup, double dt = 0, IntegratorType integrator = EXPLICIT_RUNGE_KUTTA );
 
     virtual ~System() {}
 
@@ -52,13 +63,29 @@ class System
 };
 
 template < typename T >
-System< T >::System( StateSystemGroup< T >* stateSystemGroup, double dt )
+System< T >::System( StateSystemGroup< T >* stateSystemGroup, double dt, IntegratorType integrator )
     : mStateSystemGroup( stateSystemGroup )
     , mTime( 0 )
 {
     if ( stateSystemGroup->mDglStateSystem.GetEquationCount() > 0 )    // IsDGLSystem
     {
-        if ( dt == 0 )    // UseSolver
+        if ( integrator == IMPLICIT_TR_BDF2 )
+        {
+#if defined( _EIGEN_ ) || defined( USE_EIGEN )
+            mSystemSolver.reset( new ImplicitDglSystemSolver< T >( stateSystemGroup, dt ) );
+#else
+            ErrorFunction< std::runtime_error >( __FUNCTION__, __LINE__, __FILE__, "ImplicitSolverNotAvailable" );
+#endif
+        }
+        else if ( integrator == EXACT_EXPONENTIAL )
+        {
+#if defined( _EIGEN_ ) || defined( USE_EIGEN )
+            mSystemSolver.reset( new ExponentialDglSystemSolver< T >( stateSystemGroup, dt ) );
+#else
+            ErrorFunction< std::runtime_error >( __FUNCTION__, __LINE__, __FILE__, "ExponentialSolverNotAvailable" );
+#endif
+        }
+        else if ( dt == 0 )    // UseSolver
         {
             mSystemSolver.reset( new VariableStepDglSystemSolver< T >( stateSystemGroup ) );
         }
@@ -20,6 +20,7 @@ along with this program.  If not, see http://www.gnu.org/licenses/.
  */
 
 // STD
+#include <algorithm>
 #ifdef __EXCEPTIONS__
 #include <stdexcept>
 #include <string>
@@ -27,6 +28,7 @@ along with this program.  If not, see http://www.gnu.org/licenses/.
 
 // ETC
 #include "variablestepdglsystemsolver.h"
+#include "../misc/fast_copy_matrix.h"
 #include "../exceptions/error_proto.h"
 namespace systm
 {
@@ -45,11 +47,11 @@ double VariableStepDglSystemSolver< arma::Mat< double > >::Solve()
 
     daeSystem->PrepareEquationSystem();
 
+    // The states without the trailing 1 are integrated in place
+    arma::Mat< double > states( this->mStateVector.memptr(), this->mStateVector.n_rows - 1, 1, false, true );
     for ( size_t tries = SOLVER_TRIES; tries > 0 && !successfull; --tries )
     {
-        arma::Mat< double > states = this->mStateVector.submat( 0, 0, this->mStateVector.n_rows - 2, 0 );
         successfull = ( mStepper.try_step( boost::ref( *daeSystem ), states, mTime, mDt ) == boost::numeric::odeint::success );
-        this->mStateVector.submat( 0, 0, this->mStateVector.n_rows - 2, 0 ) = states;
     }
 
     if ( !successfull )
@@ -65,7 +67,12 @@ VariableStepDglSystemSolver< arma::SpMat< double > >::VariableStepDglSystemSolve
     , daeSystem( new systm::DifferentialAlgebraicSystem< arma::SpMat< double > >( stateSystemGroup ) )
     , mStepper( make_controlled( 1.0e-10, 1.0e-10, boost::numeric::odeint::runge_kutta_cash_karp54< arma::Mat< double > >() ) )
 {
-    mDenseStateVector.zeros( stateSystemGroup->GetStateCount(), 1 );
+    const size_t stateCount = stateSystemGroup->GetStateCount();
+    mDenseStateVector.zeros( stateCount, 1 );
+    mStateLocations.zeros( 2, stateCount + 1 );
+    for ( size_t row = 0; row <= stateCount; ++row )
+        mStateLocations( 0, row ) = row;
+    mStateValues.zeros( stateCount + 1 );
 }
 
 double VariableStepDglSystemSolver< arma::SpMat< double > >::Solve()
@@ -74,8 +81,11 @@ double VariableStepDglSystemSolver< arma::SpMat< double > >::Solve()
 
     daeSystem->PrepareEquationSystem();
 
-    for ( size_t row = 0; row < mDenseStateVector.n_rows; ++row )
-        mDenseStateVector( row, 0 ) = this->mStateVector( row, 0 );
+    mDenseStateVector.zeros();
+    const arma::SpMat< double >::const_iterator itEnd = this->mStateVector.end();
+    for ( arma::SpMat< double >::const_iterator it = this->mStateVector.begin(); it != itEnd; ++it )
+        if ( it.row() < mDenseStateVector.n_rows )
+            mDenseStateVector( it.row(), 0 ) = *it;
 
     for ( size_t tries = SOLVER_TRIES; tries > 0 && !successfull; --tries )
     {
@@ -83,8 +93,9 @@ double VariableStepDglSystemSolver< arma::SpMat< double > >::Solve()
          ( mStepper.try_step( boost::ref( *daeSystem ), mDenseStateVector, mTime, mDt ) == boost::numeric::odeint::success );
     }
 
-    for ( size_t row = 0; row < mDenseStateVector.n_rows; ++row )
-        this->mStateVector( row, 0 ) = mDenseStateVector( row, 0 );
+    std::copy( mDenseStateVector.begin(), mDenseStateVector.end(), mStateValues.begin() );
+    mStateValues( mDenseStateVector.n_rows ) = 1;
+    this->mStateVector = arma::SpMat< double >( mStateLocations, mStateValues, mStateValues.n_rows, 1 );
 
     if ( !successfull )
         ErrorFunction< std::runtime_error >( __FUNCTION__, __LINE__, __FILE__, "ErrorStep" );
@@ -104,6 +115,7 @@ VariableStepDglSystemSolver< SparseMatrix< double, RowMajor > >::VariableStepDgl
     , daeSystem( new systm::DifferentialAlgebraicSystem< SparseMatrix< double, RowMajor > >( stateSystemGroup ) )
     , mStepper( make_controlled( 1.0e-10, 1.0e-10, boost::numeric::odeint::runge_kutta_cash_karp54< arma::Mat< double > >() ) )
 {
+    mDenseStateVector.zeros( stateSystemGroup->GetStateCount(), 1 );
 }
 
 double VariableStepDglSystemSolver< SparseMatrix< double, RowMajor > >::Solve()
@@ -114,18 +126,15 @@ double VariableStepDglSystemSolver< SparseMatrix< double, RowMajor > >::Solve()
 
     size_t realStates = this->mStateVector.rows() - 1;    // TODO: Uncomment when one is concatenated to state vector
 
-    //    MatrixXd x = this->mStateVector.topRows(realStates);
-    arma::Mat< double > x( realStates, 1 );
-    for ( size_t i = 0; i < realStates; ++i )
-        x( i, 0 ) = this->mStateVector.coeff( i, 0 );
+    misc::FastCopyMatrix( mDenseStateVector.memptr(), this->mStateVector, realStates );
 
     for ( size_t tries = SOLVER_TRIES; tries > 0 && !successfull; --tries )
     {
-        successfull = ( mStepper.try_step( boost::ref( *daeSystem ), x, mTime, mDt ) == boost::numeric::odeint::success );
+        successfull =
+         ( mStepper.try_step( boost::ref( *daeSystem ), mDenseStateVector, mTime, mDt ) == boost::numeric::odeint::success );
     }
 
-    for ( size_t i = 0; i < realStates; ++i )
-        this->mStateVector.coeffRef( i, 0 ) = x( i, 0 );
+    misc::FastCopyMatrix( this->mStateVector, mDenseStateVector.memptr(), realStates );
 
     this->mStateVector.coeffRef( realStates, 0 ) = 1;    // TODO: Uncomment when one is concatenated to state vector
 
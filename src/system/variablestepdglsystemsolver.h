@@ -98,6 +98,8 @@ class VariableStepDglSystemSolver< arma::SpMat< double > > : public SystemSolver
     boost::scoped_ptr< systm::DifferentialAlgebraicSystem< arma::SpMat< double > > > daeSystem;
     boost::numeric::odeint::result_of::make_controlled< boost::numeric::odeint::runge_kutta_cash_karp54< arma::Mat< double > > >::type mStepper;
     arma::Mat< double > mDenseStateVector;
+    arma::umat mStateLocations;    ///< Locations of all entries of the state vector for writing it back in one batch
+    arma::Col< double > mStateValues;
 };
 
 #endif /* _ARMADILLO_ */
@@ -116,6 +118,7 @@ class VariableStepDglSystemSolver< SparseMatrix< double, RowMajor > > : public S
     private:
     boost::scoped_ptr< systm::DifferentialAlgebraicSystem< SparseMatrix< double, RowMajor > > > daeSystem;
     boost::numeric::odeint::result_of::make_controlled< boost::numeric::odeint::runge_kutta_cash_karp54< arma::Mat< double > > >::type mStepper;
+    arma::Mat< double > mDenseStateVector;
 };
 #endif /* _EIGEN_ */
 
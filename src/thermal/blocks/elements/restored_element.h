@@ -0,0 +1,49 @@
+/*
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see http://www.gnu.org/licenses/.
+*/
+#ifndef _RESTORED_ELEMENT_
+#define _RESTORED_ELEMENT_
+
+#include "thermal_element.h"
+
+
+namespace thermal
+{
+using namespace geometry;
+
+/// RestoredElement is a ThermalElement whose grid vertex and volume have been read from the thermal model cache instead
+/// of being calculated from its shape
+template < typename T = double >
+class RestoredElement : public ThermalElement< T >
+{
+    public:
+    RestoredElement( const Cartesian< T > &gridVertex, T volume, T initialTemperatureValue, const Material< T > *material,
+                     ::state::ThermalState< T > *thermalState = 0, T thermalStateFactor = 1.0 );
+    virtual ~RestoredElement();
+};
+
+
+template < typename T >
+RestoredElement< T >::RestoredElement( const Cartesian< T > &gridVertex, T volume, T initialTemperatureValue,
+                                       const Material< T > *material, ::state::ThermalState< T > *thermalState, T thermalStateFactor )
+{
+    ThermalElement< T >::SetElement( initialTemperatureValue, material, gridVertex, volume, thermalState, thermalStateFactor );
+}
+
+template < typename T >
+RestoredElement< T >::~RestoredElement()
+{
+}
+}
+#endif
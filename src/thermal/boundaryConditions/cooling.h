@@ -36,6 +36,8 @@ class Cooling
     /// Returns offset and slope for first order Taylor approximation of cooling power per area
     virtual Linearization< T > GetOffsetSlope( T surfaceTemperature, T airTemperature ) const = 0;
     virtual bool IsDirichletBoundaryCondition() const = 0;
+    /// Returns false if GetOffsetSlope() must not be called from several threads at the same time
+    virtual bool IsThreadSafe() const { return true; };
 
     private:
 };
@@ -103,8 +105,12 @@ Linearization< T > Radiation< T >::GetOffsetSlope( T surfaceTemperature, T airTe
     surfaceTemperature -= mAbsoluteZeroInC;
     airTemperature -= mAbsoluteZeroInC;
 
-    return Linearization< T >( mHelp_Factor * ( pow( surfaceTemperature, 4.0 ) - pow( airTemperature, 4.0 ) ),
-                               mHelp_Factor * 4.0 * pow( surfaceTemperature, 3.0 ) );
+    // Integer powers are multiplied out instead of calling pow()
+    const T surfaceTemperatureCubed = surfaceTemperature * surfaceTemperature * surfaceTemperature;
+    const T airTemperatureSquared = airTemperature * airTemperature;
+    return Linearization< T >( mHelp_Factor * ( surfaceTemperatureCubed * surfaceTemperature -
+                                                airTemperatureSquared * airTemperatureSquared ),
+                               mHelp_Factor * 4.0 * surfaceTemperatureCubed );
 }
 
 
@@ -118,6 +124,8 @@ class CoolingByLookUp : public Cooling< T >
     virtual ~CoolingByLookUp(){};
     virtual Linearization< T > GetOffsetSlope( T surfaceTemperature, T airTemperature ) const;
     bool IsDirichletBoundaryCondition() const { return false; };
+    /// The lookup objects store the last looked up value
+    bool IsThreadSafe() const { return false; };
     const shared_ptr< object::Object< T > >& GetOffsetLookUp() const;
     const shared_ptr< object::Object< T > >& GetSlopeLookUp() const;
 
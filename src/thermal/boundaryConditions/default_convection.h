@@ -15,6 +15,8 @@ along with this program.  If not, see http://www.gnu.org/licenses/.
 #ifndef _DEFAULT_CONVECTION_
 #define _DEFAULT_CONVECTION_
 
+#include <cmath>
+#include <limits>
 #include <boost/shared_ptr.hpp>
 #include "../thermal_structs.h"
 #include "../../object/lookup_obj2d.h"
@@ -34,6 +36,24 @@ class DefaultConvection
     virtual ~DefaultConvection(){};
     /// Returns offset and slope for first order Taylor approximation of power per area cooled
     virtual Linearization< T > GetOffsetSlope( T surfaceTemperature, T characteristicLength, T airTemperature ) = 0;
+    /// Same as GetOffsetSlope(), lengthFactor is LengthFactor( characteristicLength ) and is precomputed once per cooled
+    /// area by the caller
+    virtual Linearization< T > GetOffsetSlopeWithLengthFactor( T surfaceTemperature, T characteristicLength,
+                                                               T /* lengthFactor */, T airTemperature )
+    {
+        return GetOffsetSlope( surfaceTemperature, characteristicLength, airTemperature );
+    }
+    /// Returns characteristicLength^-0.25 or 0 for areas without a characteristic length, which are not cooled by the
+    /// default convection. OdeSystemThermal rejects non-positive lengths of areas that are.
+    static T LengthFactor( T characteristicLength )
+    {
+        return ( characteristicLength > 0.0 ) ? 1.0 / std::sqrt( std::sqrt( characteristicLength ) ) : 0.0;
+    }
+    /// Precomputes terms that only depend on the air temperature, needs to be called whenever the air temperature
+    /// changes and not concurrently with GetOffsetSlope()
+    virtual void SetAirTemperature( T /* airTemperature */ ){};
+    /// Returns false if GetOffsetSlope() must not be called from several threads at the same time
+    virtual bool IsThreadSafe() const { return true; };
 };
 
 
@@ -45,16 +65,24 @@ class ConvectionByFormula : public DefaultConvection< T >
     explicit ConvectionByFormula( T preFactor );
     virtual ~ConvectionByFormula(){};
     Linearization< T > GetOffsetSlope( T surfaceTemperature, T characteristicLength, T airTemperature );
+    Linearization< T > GetOffsetSlopeWithLengthFactor( T surfaceTemperature, T characteristicLength, T lengthFactor,
+                                                       T airTemperature );
+    void SetAirTemperature( T airTemperature );
 
     private:
+    T HelpAirTemperature( T airTemperature ) const;
     T mHelp_SameForAll;
     T mAbsoluteZeroInC;
+    T mAirTemperature;         ///< Air temperature mHelp_AirTemperature has been calculated for
+    T mHelp_AirTemperature;    ///< Factor of the air temperature, is reused as long as it does not change
 };
 
 
 template < typename T >
 ConvectionByFormula< T >::ConvectionByFormula( T preFactor )
     : mAbsoluteZeroInC( -273.15 )
+    , mAirTemperature( std::numeric_limits< T >::quiet_NaN() )
+    , mHelp_AirTemperature( 0.0 )
 {
     if ( preFactor <= 0.0 )
         ErrorFunction< std::runtime_error >( __FUNCTION__, __LINE__, __FILE__, "preFactorNegative" );
@@ -68,15 +96,39 @@ ConvectionByFormula< T >::ConvectionByFormula( T preFactor )
 
 template < typename T >
 Linearization< T > ConvectionByFormula< T >::GetOffsetSlope( T surfaceTemperature, T characteristicLength, T airTemperature )
+{
+    return GetOffsetSlopeWithLengthFactor( surfaceTemperature, characteristicLength,
+                                           DefaultConvection< T >::LengthFactor( characteristicLength ), airTemperature );
+}
+
+template < typename T >
+Linearization< T > ConvectionByFormula< T >::GetOffsetSlopeWithLengthFactor( T surfaceTemperature, T /* characteristicLength */,
+                                                                             T lengthFactor, T airTemperature )
 {
     const T deltaTemperature = surfaceTemperature - airTemperature;
     if ( deltaTemperature < 0.0 )
         return Linearization< T >( 0.0, 0.0 );
 
-    const T help_SameForOffsetSlope =
-     mHelp_SameForAll * pow( ( airTemperature - mAbsoluteZeroInC ) * characteristicLength, -0.25 );
-    return Linearization< T >( help_SameForOffsetSlope * pow( deltaTemperature, 1.25 ),
-                               help_SameForOffsetSlope * 1.25 * pow( deltaTemperature, 0.25 ) );
+    // x^0.25 is evaluated as sqrt(sqrt(x)), which is far cheaper than pow()
+    const T help_AirTemperature =
+     ( airTemperature == mAirTemperature ) ? mHelp_AirTemperature : HelpAirTemperature( airTemperature );
+    const T help_SameForOffsetSlope = help_AirTemperature * lengthFactor;
+    const T deltaTemperatureQuarterPower = std::sqrt( std::sqrt( deltaTemperature ) );
+    return Linearization< T >( help_SameForOffsetSlope * deltaTemperature * deltaTemperatureQuarterPower,
+                               help_SameForOffsetSlope * 1.25 * deltaTemperatureQuarterPower );
+}
+
+template < typename T >
+void ConvectionByFormula< T >::SetAirTemperature( T airTemperature )
+{
+    mHelp_AirTemperature = HelpAirTemperature( airTemperature );
+    mAirTemperature = airTemperature;
+}
+
+template < typename T >
+T ConvectionByFormula< T >::HelpAirTemperature( T airTemperature ) const
+{
+    return mHelp_SameForAll / std::sqrt( std::sqrt( airTemperature - mAbsoluteZeroInC ) );
 }
 
 
@@ -88,6 +140,8 @@ class ConvectionByLookUp : public DefaultConvection< T >
     ConvectionByLookUp( shared_ptr< object::Object< T > > offsetLookUp, shared_ptr< object::Object< T > > slopeLookUp );
     virtual ~ConvectionByLookUp(){};
     virtual Linearization< T > GetOffsetSlope( T surfaceTemperature, T characteristicLength, T airTemperature );
+    /// The lookup objects store the last looked up value
+    bool IsThreadSafe() const { return false; };
 
     private:
     const boost::shared_ptr< object::Object< T > > mOffsetLookUp;
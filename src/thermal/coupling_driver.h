@@ -0,0 +1,207 @@
+/*
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see http://www.gnu.org/licenses/.
+*/
+#ifndef _COUPLING_DRIVER_
+#define _COUPLING_DRIVER_
+
+#include <boost/scoped_ptr.hpp>
+
+#include "coupling_scheduler.h"
+#include "../exceptions/error_proto.h"
+
+
+namespace simulation
+{
+
+/**
+ * CouplingDriver runs the loop of the thermal electrical simulation.
+ * The electrical simulation runs for one coupling interval, then the thermal simulation catches up. If the thermal stop
+ * criterion is met before, the electrical simulation is reset to that point of time. Either simulation may be missing,
+ * then the other one runs alone.
+ * The equation solvers are passed as ElectricalStepperT and ThermalStepperT, see simulation_steppers.h. They are
+ * constructed from a pointer to their simulation, define its type as SimulationType and run one step of it with
+ * operator(), such that the loop is independent of the matrix type and the equation solvers.
+ */
+template < typename ElectricalStepperT, typename ThermalStepperT, typename T = double >
+class CouplingDriver
+{
+    public:
+    typedef typename ElectricalStepperT::SimulationType ElectricalSimulationType;
+    typedef typename ThermalStepperT::SimulationType ThermalSimulationType;
+
+    /**
+     * @param[in] electricalSimulation Electrical simulation or 0 if the thermal simulation runs alone
+     * @param[in] thermalSimulation Thermal simulation or 0 if the electrical simulation runs alone
+     * @param[in] couplingScheduler Chooses the coupling intervals, if it is 0 the step time of the electrical simulation is used
+     */
+    CouplingDriver( ElectricalSimulationType *electricalSimulation, ThermalSimulationType *thermalSimulation,
+                    CouplingScheduler< T > *couplingScheduler = 0 );
+    /**
+     * Runs the simulation until its end
+     * @param[in] input Called with the point of time whenever the input has to be updated, sets the current or power
+     * dissipation and returns the point of time of its next change
+     * @param[in] observer Called with the point of time after each thermal step, or after each step of the electrical
+     * simulation if it runs alone
+     */
+    template < typename InputT, typename ObserverT >
+    void Run( InputT &input, ObserverT &observer );
+    /**
+     * Same as Run( input, observer )
+     * @param[in] resetObserver Called with the point of time whenever the thermal stop criterion resets the electrical
+     * simulation
+     */
+    template < typename InputT, typename ObserverT, typename ResetObserverT >
+    void Run( InputT &input, ObserverT &observer, ResetObserverT &resetObserver );
+
+    private:
+    /// Reset observer of Run( input, observer )
+    struct IgnoreReset
+    {
+        void operator()( T /* time */ ) const {}
+    };
+
+    /// Runs the electrical simulation until currentChangeTime, the end of the coupling interval or its stop criterion
+    void RunElectricalStep( T currentChangeTime );
+    /// Runs the thermal simulation until endTime and returns true if its stop criterion has reset the electrical simulation
+    template < typename ObserverT, typename ResetObserverT >
+    bool RunThermalStep( T endTime, ObserverT &observer, ResetObserverT &resetObserver );
+
+    ElectricalSimulationType *const mElectricalSimulation;
+    ThermalSimulationType *const mThermalSimulation;
+    CouplingScheduler< T > *const mCouplingScheduler;
+    boost::scoped_ptr< ElectricalStepperT > mElectricalStepper;
+    boost::scoped_ptr< ThermalStepperT > mThermalStepper;
+};
+
+
+template < typename ElectricalStepperT, typename ThermalStepperT, typename T >
+CouplingDriver< ElectricalStepperT, ThermalStepperT, T >::CouplingDriver( ElectricalSimulationType *electricalSimulation,
+                                                                          ThermalSimulationType *thermalSimulation,
+                                                                          CouplingScheduler< T > *couplingScheduler )
+    : mElectricalSimulation( electricalSimulation )
+    , mThermalSimulation( thermalSimulation )
+    , mCouplingScheduler( couplingScheduler )
+{
+    if ( !mElectricalSimulation && !mThermalSimulation )
+        ErrorFunction< std::runtime_error >( __FUNCTION__, __LINE__, __FILE__, "CouplingDriverWithoutSimulation" );
+    if ( mElectricalSimulation )
+        mElectricalStepper.reset( new ElectricalStepperT( mElectricalSimulation ) );
+    if ( mThermalSimulation )
+        mThermalStepper.reset( new ThermalStepperT( mThermalSimulation ) );
+}
+
+template < typename ElectricalStepperT, typename ThermalStepperT, typename T >
+template < typename InputT, typename ObserverT >
+void CouplingDriver< ElectricalStepperT, ThermalStepperT, T >::Run( InputT &input, ObserverT &observer )
+{
+    IgnoreReset ignoreReset;
+    Run( input, observer, ignoreReset );
+}
+
+template < typename ElectricalStepperT, typename ThermalStepperT, typename T >
+template < typename InputT, typename ObserverT, typename ResetObserverT >
+void CouplingDriver< ElectricalStepperT, ThermalStepperT, T >::Run( InputT &input, ObserverT &observer,
+                                                                    ResetObserverT &resetObserver )
+{
+    if ( mElectricalSimulation )
+    {
+        mElectricalSimulation->mRootTwoPort->SetCurrent( 0.0 );
+        mElectricalSimulation->UpdateSystem();
+        mElectricalSimulation->UpdateSystemValues();
+        ( *mElectricalSimulation->mObserver )( mElectricalSimulation->mTime );
+    }
+
+    T inputChangeTime = 0.0;
+    while ( mElectricalSimulation ? mElectricalSimulation->CheckIfSumlationTimeHasNotEndedAndSetStepStartTime() :
+                                    mThermalSimulation->CheckIfSumlationTimeHasNotEnded() )
+    {
+        const T time = mElectricalSimulation ? mElectricalSimulation->mTime : mThermalSimulation->mTime;
+        if ( time >= inputChangeTime )
+            inputChangeTime = input( time );
+
+        if ( !mElectricalSimulation )
+        {
+            RunThermalStep( inputChangeTime, observer, resetObserver );
+            continue;
+        }
+
+        RunElectricalStep( inputChangeTime );
+        bool isReset = false;
+        if ( mThermalSimulation )
+            isReset = RunThermalStep( mElectricalSimulation->mTime, observer, resetObserver );
+        else
+            observer( mElectricalSimulation->mTime );
+
+        if ( mCouplingScheduler )
+            mCouplingScheduler->FinishInterval( mElectricalSimulation->mTime, isReset );
+        mElectricalSimulation->FinshStep();
+    }
+}
+
+template < typename ElectricalStepperT, typename ThermalStepperT, typename T >
+void CouplingDriver< ElectricalStepperT, ThermalStepperT, T >::RunElectricalStep( T currentChangeTime )
+{
+    if ( mCouplingScheduler )
+    {
+        mElectricalSimulation->SetMaxSimulationStepDuration( mCouplingScheduler->GetInterval() );
+        mCouplingScheduler->StartInterval( mElectricalSimulation->mTime );
+    }
+    if ( mThermalSimulation )
+        mElectricalSimulation->ResetAllThermalStatesPowerDissipation();
+
+    mElectricalSimulation->InitializeStopCriterion();
+    while ( mElectricalSimulation->CheckLoopConditionAndSetDeltaTime( currentChangeTime ) &&
+            !mElectricalSimulation->IsStopCriterionFulfilled() )
+    {
+        mElectricalSimulation->UpdateSystem();
+        ( *mElectricalStepper )();
+        mElectricalSimulation->UpdateSystemValues();
+        if ( mThermalSimulation )
+            mElectricalSimulation->UpdateAllThermalStatesPowerDissipation();
+        ( *mElectricalSimulation->mObserver )( mElectricalSimulation->mTime );
+        mElectricalSimulation->SaveStatesForLaterReset();
+    }
+}
+
+template < typename ElectricalStepperT, typename ThermalStepperT, typename T >
+template < typename ObserverT, typename ResetObserverT >
+bool CouplingDriver< ElectricalStepperT, ThermalStepperT, T >::RunThermalStep( T endTime, ObserverT &observer,
+                                                                               ResetObserverT &resetObserver )
+{
+    mThermalSimulation->InitializeStopCriterion();
+    while ( mThermalSimulation->CheckLoopConditionAndSetDeltaTime( endTime ) )
+    {
+        // Without an electrical simulation the stop criterion only updates the thermal states and starts the next step
+        if ( mThermalSimulation->IsStopCriterionFulfilled() )
+        {
+            if ( !mElectricalSimulation )
+            {
+                mThermalSimulation->UpdateSystem();
+                mThermalSimulation->UpdateAllThermalStatesTemperatures();
+                return false;
+            }
+            mElectricalSimulation->ResetStatesToPointOfTime( mThermalSimulation->mTime );
+            resetObserver( mThermalSimulation->mTime );
+            return true;
+        }
+
+        ( *mThermalStepper )();
+        mThermalSimulation->UpdateSystem();
+        observer( mThermalSimulation->mTime );
+        mThermalSimulation->UpdateAllThermalStatesTemperatures();
+    }
+    return false;
+}
+}
+#endif
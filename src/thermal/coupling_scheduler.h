@@ -0,0 +1,195 @@
+/*
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see http://www.gnu.org/licenses/.
+*/
+#ifndef _COUPLING_SCHEDULER_
+#define _COUPLING_SCHEDULER_
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+#include <boost/shared_ptr.hpp>
+
+#include "../states/thermal_state.h"
+#include "../exceptions/error_proto.h"
+
+
+class TestCouplingScheduler;
+
+namespace simulation
+{
+
+/**
+ * CouplingScheduler chooses the length of the coupling intervals of the thermal electrical simulation.
+ * The electrical simulation runs for one coupling interval, then the thermal simulation catches up. If the thermal stop
+ * criterion is met before, the electrical simulation is reset to that point of time and its work after it is lost.
+ * Therefore the next interval is predicted from the temperature and power dissipation rates of the thermal states
+ * during the last interval, such that the temperature change is expected to stay below the stop criterion.
+ */
+template < typename T = double >
+class CouplingScheduler
+{
+    friend class ::TestCouplingScheduler;
+
+    public:
+    /**
+     * @param[in] thermalStates Thermal states shared by the electrical and the thermal simulation
+     * @param[in] thermalStateStopCriterion Change of temperature in degree C that ends a thermal simulation step
+     * @param[in] minInterval Lower limit for the coupling interval in sec
+     * @param[in] maxInterval Upper limit for the coupling interval in sec, which is also the first interval
+     * @param[in] safetyFactor Fraction of thermalStateStopCriterion that the predicted temperature change may use up
+     */
+    CouplingScheduler( const std::vector< boost::shared_ptr< ::state::ThermalState< T > > > &thermalStates,
+                       T thermalStateStopCriterion, T minInterval, T maxInterval, T safetyFactor = 0.8 );
+    /// Saves temperatures of the thermal states at the start of a coupling interval
+    void StartInterval( T time );
+    /**
+     * Evaluates the rates of the finished coupling interval and predicts the next one
+     * @param[in] time Point of time both simulations have reached, which is the reset time if the electrical simulation has been reset
+     * @param[in] isReset True if the thermal stop criterion has reset the electrical simulation
+     */
+    void FinishInterval( T time, bool isReset );
+    /// Returns the length of the next coupling interval
+    T GetInterval() const;
+    size_t GetNumberOfIntervals() const;
+    size_t GetNumberOfResets() const;
+
+    private:
+    /// Longest interval for which temperature change with rate and relative power rate stays below budget
+    T PredictInterval( T rate, T relativePowerRate, T budget ) const;
+
+    const std::vector< boost::shared_ptr< ::state::ThermalState< T > > > mThermalStates;
+    const T mThermalStateStopCriterion;
+    const T mMinInterval;
+    const T mMaxInterval;
+    const T mSafetyFactor;
+    T mInterval;
+    T mStartTime;
+    T mLastIntervalLength;
+    std::vector< T > mStartTemperatures;
+    std::vector< T > mPowerDissipations;
+    size_t mNumberOfIntervals;
+    size_t mNumberOfResets;
+};
+
+
+template < typename T >
+CouplingScheduler< T >::CouplingScheduler( const std::vector< boost::shared_ptr< ::state::ThermalState< T > > > &thermalStates,
+                                           T thermalStateStopCriterion, T minInterval, T maxInterval, T safetyFactor )
+    : mThermalStates( thermalStates )
+    , mThermalStateStopCriterion( thermalStateStopCriterion )
+    , mMinInterval( minInterval )
+    , mMaxInterval( maxInterval )
+    , mSafetyFactor( safetyFactor )
+    , mInterval( maxInterval )
+    , mStartTime( 0.0 )
+    , mLastIntervalLength( 0.0 )
+    , mStartTemperatures( thermalStates.size(), 0.0 )
+    , mNumberOfIntervals( 0 )
+    , mNumberOfResets( 0 )
+{
+    if ( mMinInterval <= 0.0 || mMaxInterval < mMinInterval )
+        ErrorFunction< std::runtime_error >( __FUNCTION__, __LINE__, __FILE__, "CouplingIntervalLimitsInvalid" );
+    if ( mSafetyFactor <= 0.0 || mSafetyFactor > 1.0 )
+        ErrorFunction< std::runtime_error >( __FUNCTION__, __LINE__, __FILE__, "CouplingSafetyFactorInvalid" );
+}
+
+template < typename T >
+void CouplingScheduler< T >::StartInterval( T time )
+{
+    mStartTime = time;
+    for ( size_t i = 0; i < mThermalStates.size(); ++i )
+        mStartTemperatures[i] = mThermalStates[i]->GetValue();
+}
+
+template < typename T >
+void CouplingScheduler< T >::FinishInterval( T time, bool isReset )
+{
+    ++mNumberOfIntervals;
+    if ( isReset )
+        ++mNumberOfResets;
+
+    const T intervalLength = time - mStartTime;
+    if ( intervalLength <= 0.0 )
+    {
+        mInterval = mMinInterval;
+        return;
+    }
+
+    // The power dissipation of the last interval is only known as mean value, so its rate is the change between the mean
+    // values of two consecutive intervals divided by the distance of their centers
+    const bool hasLastPowers = mPowerDissipations.size() == mThermalStates.size();
+    const T powerDistance = 0.5 * ( intervalLength + mLastIntervalLength );
+    const T budget = mSafetyFactor * mThermalStateStopCriterion;
+
+    T nextInterval = mMaxInterval;
+    for ( size_t i = 0; i < mThermalStates.size(); ++i )
+    {
+        const T rate = fabs( mThermalStates[i]->GetValue() - mStartTemperatures[i] ) / intervalLength;
+        const T power = mThermalStates[i]->GetPowerDissipation( time, intervalLength );
+
+        T relativePowerRate = 0.0;
+        if ( hasLastPowers )
+        {
+            const T referencePower = std::max( fabs( power ), fabs( mPowerDissipations[i] ) );
+            if ( referencePower > 0.0 )
+                relativePowerRate = fabs( power - mPowerDissipations[i] ) / ( referencePower * powerDistance );
+        }
+
+        nextInterval = std::min( nextInterval, PredictInterval( rate, relativePowerRate, budget ) );
+        if ( hasLastPowers )
+            mPowerDissipations[i] = power;
+        else
+            mPowerDissipations.push_back( power );
+    }
+
+    // Grow at most by factor 2 to stay close to the interval the rates have been measured on, after a reset the
+    // interval must stay below the one that has been reached
+    nextInterval = std::min( nextInterval, 2.0 * intervalLength );
+    if ( isReset )
+        nextInterval = std::min( nextInterval, mSafetyFactor * intervalLength );
+
+    mInterval = std::max( mMinInterval, std::min( mMaxInterval, nextInterval ) );
+    mLastIntervalLength = intervalLength;
+}
+
+template < typename T >
+T CouplingScheduler< T >::PredictInterval( T rate, T relativePowerRate, T budget ) const
+{
+    // The temperature rate is taken to grow with the power dissipation, so the temperature change after h is
+    // rate * h + 0.5 * rate * relativePowerRate * h^2. This is solved for h in a form that is stable for small rates.
+    if ( rate <= 0.0 )
+        return std::numeric_limits< T >::max();
+    return 2.0 * budget / ( rate + sqrt( rate * rate + 2.0 * rate * relativePowerRate * budget ) );
+}
+
+template < typename T >
+T CouplingScheduler< T >::GetInterval() const
+{
+    return mInterval;
+}
+
+template < typename T >
+size_t CouplingScheduler< T >::GetNumberOfIntervals() const
+{
+    return mNumberOfIntervals;
+}
+
+template < typename T >
+size_t CouplingScheduler< T >::GetNumberOfResets() const
+{
+    return mNumberOfResets;
+}
+}
+#endif
@@ -32,6 +32,7 @@ along with this program.  If not, see http://www.gnu.org/licenses/.
 #include "../observer/filter/filter.h"
 #include "../observer/filter/csvfilter.h"
 #include "../exceptions/error_proto.h"
+#include "../thermal/state_history.h"
 
 namespace thermal
 {
@@ -72,6 +73,8 @@ class ElectricalSimulation
     bool CheckIfSumlationTimeHasNotEndedAndSetStepStartTime();
     /// Gets the time passed since mLoopStartTime (mLoopStartTime is the start time of this simulation step)
     T GetCurrentSimulationStepTime() const;
+    /// Sets the duration after which a simulation step ends, e.g. the coupling interval chosen by CouplingScheduler
+    void SetMaxSimulationStepDuration( T maxSimulationStepDuration );
     /// Executes actions needed at the end of a simulation step
     void FinshStep();
     /// Saves power and time of all cell elements into their thermal states
@@ -88,6 +91,9 @@ class ElectricalSimulation
     void SaveStatesForLaterReset();
     /// Resets states and SoCs to states saved at a certain point of time
     void ResetStatesToPointOfTime( T time );
+    /// Returns false if a TwoPort of the network does not support the compiled stamp, so the equations of the network
+    /// are assembled by the TwoPorts in each update instead
+    bool IsStateSystemStampCompiled() const;
 
     void LoadCapacityForLaterReset();
     void SaveCapacityForLaterReset();
@@ -114,11 +120,9 @@ class ElectricalSimulation
     T mStepStartTime;
     // Soc stop criterion
     T mSocStopCriterion;
-    std::vector< std::vector< T > > mSocValuesSteps;
-    // If electrical is supposed to be resettable
-    std::vector< Matrix > mStatesSteps;
-    std::vector< T > mTimeSteps;
-    size_t mNumberOfSteps;
+    bool mIsStateSystemStampCompiled;
+    // If electrical is supposed to be resettable, the first entry holds the SoC values for the stop criterion
+    boost::scoped_ptr< StateHistory< Matrix, T > > mStateHistory;
     // CurrentVoltageProfiles
 };
 
@@ -134,7 +138,7 @@ ElectricalSimulation< Matrix, T, matlabFilterOutput >::ElectricalSimulation(
     , mMaxSimulationStepDuration( maxSimulationStepDuration )
     , mStepStartTime( 0.0 )
     , mSocStopCriterion( 5.0 )
-    , mNumberOfSteps( 0 )
+    , mIsStateSystemStampCompiled( false )
 {
     // Build Factories
     boost::scoped_ptr< factory::Factory< ::state::Dgl_state, factory::ArgumentTypeState > > stateFactory;
@@ -187,6 +191,7 @@ ElectricalSimulation< Matrix, T, matlabFilterOutput >::ElectricalSimulation(
     mStateSystemGroup.Initialize();
 #ifndef _SYMBOLIC_
     mRootTwoPort->SetInitialCurrent( 0.0 );
+    mIsStateSystemStampCompiled = mRootTwoPort->CompileStateSystemStamp();
 #else
     mRootTwoPort->SetInitialCurrent( symbolic::Symbolic( "InputCurrent" ) );
 #endif
@@ -239,6 +244,16 @@ ElectricalSimulation< Matrix, T, matlabFilterOutput >::ElectricalSimulation(
                                                      "SocStopCriterionInPercentNegative" );
         }
     }
+    // RollbackHistorySize
+    size_t rollbackHistorySize = 128;
+    if ( optionsNode->HasElement( "RollbackHistorySize" ) )
+    {
+        const int historySize = optionsNode->GetElementIntValue( "RollbackHistorySize" );
+        if ( historySize < 2 )
+            ErrorFunction< std::runtime_error >( __FUNCTION__, __LINE__, __FILE__, "RollbackHistorySizeTooSmall" );
+        rollbackHistorySize = historySize;
+    }
+    mStateHistory.reset( new StateHistory< Matrix, T >( rollbackHistorySize ) );
 
     // Give out cells if wanted
     if ( cells )
@@ -296,6 +311,12 @@ T ElectricalSimulation< Matrix, T, matlabFilterOutput >::GetCurrentSimulationSte
     return mTime - mStepStartTime;
 }
 
+template < typename Matrix, typename T, bool matlabFilterOutput >
+void ElectricalSimulation< Matrix, T, matlabFilterOutput >::SetMaxSimulationStepDuration( T maxSimulationStepDuration )
+{
+    mMaxSimulationStepDuration = maxSimulationStepDuration;
+}
+
 template < typename Matrix, typename T, bool matlabFilterOutput >
 void ElectricalSimulation< Matrix, T, matlabFilterOutput >::FinshStep()
 {
@@ -325,7 +346,7 @@ void ElectricalSimulation< Matrix, T, matlabFilterOutput >::ResetAllThermalState
 template < typename Matrix, typename T, bool matlabFilterOutput >
 void ElectricalSimulation< Matrix, T, matlabFilterOutput >::InitializeStopCriterion()
 {
-    mNumberOfSteps = 0;
+    mStateHistory->Clear();
     SaveStatesForLaterReset();
 }
 
@@ -333,9 +354,10 @@ template < typename Matrix, typename T, bool matlabFilterOutput >
 bool ElectricalSimulation< Matrix, T, matlabFilterOutput >::IsStopCriterionFulfilled() const
 {
     bool isStop = false;
+    const T *firstSocValues = mStateHistory->GetSocValues( 0 );
     for ( size_t i = 0; i < mSocStates.size(); ++i )
     {
-        if ( fabs( mSocValuesSteps[0][i] - mSocStates[i]->GetValue() ) > mSocStopCriterion )
+        if ( fabs( firstSocValues[i] - mSocStates[i]->GetValue() ) > mSocStopCriterion )
         {
             isStop = true;
             break;
@@ -348,56 +370,39 @@ bool ElectricalSimulation< Matrix, T, matlabFilterOutput >::IsStopCriterionFulfi
 template < typename Matrix, typename T, bool matlabFilterOutput >
 void ElectricalSimulation< Matrix, T, matlabFilterOutput >::SaveStatesForLaterReset()
 {
-    if ( mTimeSteps.size() == mNumberOfSteps )
-        mTimeSteps.resize( mNumberOfSteps + 1 );
-    if ( mStatesSteps.size() == mNumberOfSteps )
-        mStatesSteps.resize( mNumberOfSteps + 1 );
-    if ( mSocValuesSteps.size() == mNumberOfSteps )
-    {
-        mSocValuesSteps.resize( mNumberOfSteps + 1 );
-        mSocValuesSteps[mNumberOfSteps].resize( mSocStates.size() );
-    }
-
-    mTimeSteps[mNumberOfSteps] = mTime;
-    mStatesSteps[mNumberOfSteps] = mStateSystemGroup.mStateVector;
-    for ( size_t i = 0; i < mSocStates.size(); ++i )
-        mSocValuesSteps[mNumberOfSteps][i] = mSocStates[i]->GetValue();
-
-    mNumberOfSteps++;
+    mStateHistory->Add( mTime, mStateSystemGroup.mStateVector, mSocStates );
 }
 
 template < typename Matrix, typename T, bool matlabFilterOutput >
 void ElectricalSimulation< Matrix, T, matlabFilterOutput >::ResetStatesToPointOfTime( T time )
 {
-    if ( time <= mTimeSteps[0] || time > mTimeSteps[mNumberOfSteps - 1] || mNumberOfSteps < 2 )
+    const size_t numberOfSteps = mStateHistory->GetSize();
+    if ( numberOfSteps < 2 || time <= mStateHistory->GetTime( 0 ) || time > mStateHistory->GetTime( numberOfSteps - 1 ) )
         ErrorFunction< std::runtime_error >( __FUNCTION__, __LINE__, __FILE__,
                                              "errorResetStatesToPointOfTimeExecution" );
-    if ( time == mTimeSteps[mNumberOfSteps - 1] )    // No need to reset if thermal stop criterion is triggered after
-                                                     // full step time time has been simulated
+    if ( time == mStateHistory->GetTime( numberOfSteps - 1 ) )    // No need to reset if thermal stop criterion is
+                                                                    // triggered after full step time has been simulated
         return;
 
-    // Get index, which is the index for the vectors mStateSystemGroup and mSocValuesSteps before time
-    size_t index = 0;
-    for ( size_t i = 1; i < mNumberOfSteps; ++i )
-        if ( mTimeSteps[i] > time )
-        {
-            index = i - 1;
-            break;
-        }
+    // Get index, which is the index of the last saved step before time
+    const size_t index = mStateHistory->FindIndex( time );
 
     // Calculate factor1 and factor2, which are used to scale linearly between the point of time for index and (index+1)
-    const T deltaTime = mTimeSteps[index + 1] - mTimeSteps[index];
-    const T factor1 = ( mTimeSteps[index + 1] - time ) / deltaTime;
-    const T factor2 = ( time - mTimeSteps[index] ) / deltaTime;
+    const T deltaTime = mStateHistory->GetTime( index + 1 ) - mStateHistory->GetTime( index );
+    const T factor1 = ( mStateHistory->GetTime( index + 1 ) - time ) / deltaTime;
+    const T factor2 = ( time - mStateHistory->GetTime( index ) ) / deltaTime;
 
     // Reset time, states and SoCs
     mTime = time;
-    mStateSystemGroup.mStateVector = mStatesSteps[index] * factor1 + mStatesSteps[index] * factor2;
+    mStateSystemGroup.mStateVector =
+     mStateHistory->GetStates( index ) * factor1 + mStateHistory->GetStates( index + 1 ) * factor2;
+    const T *socValuesBefore = mStateHistory->GetSocValues( index );
+    const T *socValuesAfter = mStateHistory->GetSocValues( index + 1 );
+    const T *socValuesLast = mStateHistory->GetSocValues( numberOfSteps - 1 );
     for ( size_t i = 0; i < mSocStates.size(); ++i )
     {
-        const T newSocValue = mSocValuesSteps[index][i] * factor1 + mSocValuesSteps[index + 1][i] * factor2;
-        const T deltaCapacityASec =
-         ( newSocValue - mSocValuesSteps[mNumberOfSteps - 1][i] ) / 100.0 * mSocStates[i]->GetMaxCapacity();
+        const T newSocValue = socValuesBefore[i] * factor1 + socValuesAfter[i] * factor2;
+        const T deltaCapacityASec = ( newSocValue - socValuesLast[i] ) / 100.0 * mSocStates[i]->GetMaxCapacity();
         mSocStates[i]->UpdateCapacity( deltaCapacityASec );
     }
     UpdateSystemValues();
@@ -406,6 +411,12 @@ void ElectricalSimulation< Matrix, T, matlabFilterOutput >::ResetStatesToPointOf
         thermalState->ResetPowerDissipationToTime( time );
 }
 
+template < typename Matrix, typename T, bool matlabFilterOutput >
+bool ElectricalSimulation< Matrix, T, matlabFilterOutput >::IsStateSystemStampCompiled() const
+{
+    return mIsStateSystemStampCompiled;
+}
+
 template < typename Matrix, typename T, bool matlabFilterOutput >
 void ElectricalSimulation< Matrix, T, matlabFilterOutput >::SaveCapacityForLaterReset()
 {
@@ -37,6 +37,8 @@ class JaggedArray
      * index - -arrayIndex
      */
     inline Elem *Begin( size_t arrayIndex ) const;
+    /// End returns the pointer behind the last element of the array with index arrayIndex
+    inline Elem *End( size_t arrayIndex ) const;
     inline size_t GetNumberOfArrays() const;
 
     private:
@@ -79,6 +81,12 @@ Elem *JaggedArray< Elem >::Begin( size_t arrayIndex ) const
     return mPointers[arrayIndex];
 }
 
+template < typename Elem >
+Elem *JaggedArray< Elem >::End( size_t arrayIndex ) const
+{
+    return mPointers[arrayIndex + 1];
+}
+
 template < typename Elem >
 size_t JaggedArray< Elem >::GetNumberOfArrays() const
 {
@@ -24,8 +24,16 @@ along with this program.  If not, see http://www.gnu.org/licenses/.
 #include "boundaryConditions/default_convection.h"
 #include "boundaryConditions/cooling.h"
 #include "thermal_structs.h"
+#include "jagged_array.h"
 #include "../exceptions/error_proto.h"
 
+#ifdef BOOST_THREAD
+#include <boost/scoped_ptr.hpp>
+#include <boost/exception_ptr.hpp>
+#include <boost/thread/mutex.hpp>
+#include "../threading/threaded_for_loop.h"
+#endif
+
 class TestOdeSystemThermal;
 class TestSimulation;
 
@@ -44,10 +52,16 @@ class OdeSystemThermal
     friend class ::TestSimulation;
 
     public:
+    /// Slopes and offsets of all thermal elements, stored as separate arrays to be traversed linearly
     struct BoundarySourceData
     {
-        ALIGNED_TO_64_BYTE T mA_th;    // Slope
-        ALIGNED_TO_64_BYTE T mC_th;    // Offset
+        explicit BoundarySourceData( size_t size = 0 )
+            : mA_th( size )
+            , mC_th( size )
+        {
+        }
+        vector< T > mA_th;    // Slope
+        vector< T > mC_th;    // Offset
     };
     /**
      * @param[in] dirichletDataVector Vector containing the data for all dirichlet boundary conditions
@@ -76,31 +90,58 @@ class OdeSystemThermal
     void UpdateLoop( size_t i, T time, T dt );
     /// One iteration of loop used in operator()
     void DxdtLoop( size_t i, const vector< T > &x, vector< T > &dxdt );
+#ifdef BOOST_THREAD
+    /// Distributes the loops of Update() and operator() over numberOfThreads threads. Every thread works on a fixed
+    /// range of thermal elements, so the results do not depend on the number of threads. 0 and 1 switch back to
+    /// sequential loops. Update() stays sequential if a cooling or convection is not thread safe, e.g. a lookup.
+    void SetNumberOfThreads( size_t numberOfThreads );
+#endif
     void GetTemperatureVector( vector< T > &temperatureVector ) const;
     void SetTemperatureVector( const vector< T > &temperatureVector );
     void ResetAirTemperature( T newAirTemperature );
     inline size_t GetOdeSystemSize() const;
     const vector< shared_ptr< ThermalElement< T > > > &GetThermalElements() const;
-    const vector< vector< IndexedValue< T > > > &GetA_th_Conductivity() const;
+    const JaggedArray< IndexedValue< T > > &GetA_th_Conductivity() const;
     const vector< T > &GetThermalElementFactors() const;
     const vector< shared_ptr< DefaultConvection< T > > > &GetConvection() const;
     const shared_ptr< Radiation< T > > &GetRadiation() const;
-    const vector< BoundarySourceData > &GetMatrixDirichlet() const;
-    const vector< vector< TaylorData< T > > > &GetCoolingDataVector() const;
+    const BoundarySourceData &GetMatrixDirichlet() const;
+    const BoundarySourceData &GetMatrixBoundarySource() const;
+    const JaggedArray< TaylorData< T > > &GetCoolingDataVector() const;
     double GetAirTemperature() const { return mAirTemperature; };
     // Provisional Hack
     void SetDirichletBoundaryCondition( vector< size_t > dirichletIndices, T dirichletTemperature, T dirichletConductivity );
 
     private:
     vector< shared_ptr< ThermalElement< T > > > mThermalElements;
-    vector< vector< IndexedValue< T > > > mA_th_Conductivity;
-    vector< vector< TaylorData< T > > > mCoolingDataVector;
+    JaggedArray< IndexedValue< T > > mA_th_Conductivity;    ///< Rows of the conductivity matrix stored contiguously
+    /// Cooling data of all thermal elements stored contiguously. UpdateLoop() does not read it, but mCoolingFaces and
+    /// mSurfaceTemperatures, which have one entry per cooling data entry in the same order.
+    JaggedArray< TaylorData< T > > mCoolingDataVector;
     const vector< shared_ptr< DefaultConvection< T > > > mConvection;
     const shared_ptr< Radiation< T > > mRadiation;
     T mAirTemperature;
 
-    vector< BoundarySourceData > mMatrixBoundarySource;    ///<Stores values for heat generation and cooling created by Update()
-    vector< BoundarySourceData > mMatrixDirichlet;    ///<Stores values for dirichlet boundary condition
+    /// Terms of a cooling data entry that do not change during simulation
+    struct CoolingFace
+    {
+        T mConductance;             ///< mConductivity / mDistanceToGridVertex
+        T mAreaConductance;         ///< mA_cool * mConductivity / mDistanceToGridVertex
+        T mLengthFactor;            ///< mCharacteristicLength^-0.25 for the default convection
+        T mCharacteristicLength;
+        Cooling< T > *mCooling;
+        Location mLocation;
+    };
+    vector< CoolingFace > mCoolingFaces;
+    vector< T > mSurfaceTemperatures;    ///< Surface temperatures of the last Update(), the only cooling data that changes
+
+    /// Temperatures of the thermal elements, written through to the thermal elements by SetTemperatureVector()
+    vector< T > mTemperatures;
+    vector< const ::state::ThermalState< T > * > mElementThermalStates;    ///< Thermal state of every thermal element or 0
+    vector< T > mElementThermalStateFactors;    ///< Share of every thermal element in the power of its thermal state
+
+    BoundarySourceData mMatrixBoundarySource;    ///<Stores values for heat generation and cooling created by Update()
+    BoundarySourceData mMatrixDirichlet;         ///<Stores values for dirichlet boundary condition
     vector< T > mThermalElementFactors;               ///<Stores reciprocals of the total capacity of thermal elements
     const size_t mOdeSystemSize;
 
@@ -108,6 +149,49 @@ class OdeSystemThermal
     vector< shared_ptr< ::state::ThermalState< T > > > mUnconnectedThermalStates;
     vector< shared_ptr< Material< T > > > mMaterials;
     vector< shared_ptr< Cooling< T > > > mCoolings;
+
+#ifdef BOOST_THREAD
+    bool mIsBoundaryUpdateThreadSafe;    ///< Can the loop of Update() be distributed over threads?
+
+    /// Base of the loop functors, errors thrown in the threads are rethrown in the calling thread
+    struct LoopFunctor : public threading::ThreadedForLoop::LoopFunctorInterface
+    {
+#ifdef __EXCEPTIONS__
+        LoopFunctor()
+            : mExceptionIndex( 0 )
+        {
+        }
+        /// Stores the current exception if it has been thrown by the lowest index so far
+        void StoreException( size_t i );
+        /// Rethrows the stored exception, if any, and clears it
+        void RethrowException();
+
+        boost::mutex mExceptionMutex;
+        boost::exception_ptr mException;
+        size_t mExceptionIndex;
+#endif
+    };
+
+    struct UpdateLoopFunctor : public LoopFunctor
+    {
+        virtual void Iterate( size_t i );
+        OdeSystemThermal< T > *mOdeSystem;
+        T mTime;
+        T mDt;
+    };
+
+    struct DxdtLoopFunctor : public LoopFunctor
+    {
+        virtual void Iterate( size_t i );
+        OdeSystemThermal< T > *mOdeSystem;
+        const vector< T > *mX;
+        vector< T > *mDxdt;
+    };
+
+    boost::scoped_ptr< threading::ThreadedForLoop > mThreadedForLoop;    ///< Only created if more than one thread is used
+    UpdateLoopFunctor mUpdateLoopFunctor;
+    DxdtLoopFunctor mDxdtLoopFunctor;
+#endif
 };
 
 
@@ -122,7 +206,9 @@ OdeSystemThermal< T >::OdeSystemThermal( vector< shared_ptr< ThermalElement< T >
                                          vector< shared_ptr< ::state::ThermalState< T > > > unconnectedThermalStates,
                                          vector< shared_ptr< Material< T > > > materials,
                                          vector< shared_ptr< Cooling< T > > > coolings )
-    : mConvection( defaultConvection )
+    : mA_th_Conductivity( conductivityMatrix )
+    , mCoolingDataVector( coolingDataVector )
+    , mConvection( defaultConvection )
     , mRadiation( defaultRadiation )
     , mAirTemperature( airTemperature )
     , mMatrixBoundarySource( thermalElements.size() )
@@ -132,26 +218,29 @@ OdeSystemThermal< T >::OdeSystemThermal( vector< shared_ptr< ThermalElement< T >
     , mUnconnectedThermalStates( unconnectedThermalStates )
     , mMaterials( materials )
     , mCoolings( coolings )
+#ifdef BOOST_THREAD
+    , mIsBoundaryUpdateThreadSafe( true )
+#endif
 {
     if ( thermalElements.size() != conductivityMatrix.size() || thermalElements.size() != coolingDataVector.size() ||
          thermalElements.size() != dirichletDataVector.size() )
         ErrorFunction< std::runtime_error >( __FUNCTION__, __LINE__, __FILE__, "thermalElementEqualSize" );
 
     mThermalElements.swap( thermalElements );
-    mA_th_Conductivity.swap( conductivityMatrix );
-    mCoolingDataVector.swap( coolingDataVector );
+    vector< vector< IndexedValue< T > > >().swap( conductivityMatrix );
+    vector< vector< TaylorData< T > > >().swap( coolingDataVector );
 
-    for ( size_t i = 0; i < mMatrixDirichlet.size(); ++i )
+    for ( size_t i = 0; i < mOdeSystemSize; ++i )
     {
-        mMatrixDirichlet.at( i ).mA_th = 0.0;
-        mMatrixDirichlet.at( i ).mC_th = 0.0;
+        mMatrixDirichlet.mA_th.at( i ) = 0.0;
+        mMatrixDirichlet.mC_th.at( i ) = 0.0;
         if ( !dirichletDataVector.at( i ).empty() )
         {
             BOOST_FOREACH ( const TaylorData< T > &data, dirichletDataVector.at( i ) )
             {
                 const T conductivity = data.mConductivity * data.mA_cool / data.mDistanceToGridVertex;
-                mMatrixDirichlet.at( i ).mA_th += -conductivity;
-                mMatrixDirichlet.at( i ).mC_th += data.mTempSurfLastStep * conductivity;
+                mMatrixDirichlet.mA_th.at( i ) += -conductivity;
+                mMatrixDirichlet.mC_th.at( i ) += data.mTempSurfLastStep * conductivity;
             }
         }
     }
@@ -162,10 +251,49 @@ OdeSystemThermal< T >::OdeSystemThermal( vector< shared_ptr< ThermalElement< T >
          1.0 / ( mThermalElements.at( i )->GetVolume() * mThermalElements.at( i )->GetMaterial()->GetDensity() *
                  mThermalElements.at( i )->GetMaterial()->GetSpecificCapacity() );
 
-    for ( size_t i = 0; i < mCoolingDataVector.size(); ++i )
-        for ( typename vector< TaylorData< T > >::iterator it = mCoolingDataVector.at( i ).begin();
-              it != mCoolingDataVector.at( i ).end(); ++it )
-            it->mTempSurfLastStep = airTemperature;
+    mTemperatures.resize( mOdeSystemSize );
+    mElementThermalStates.resize( mOdeSystemSize );
+    mElementThermalStateFactors.resize( mOdeSystemSize );
+    for ( size_t i = 0; i < mOdeSystemSize; ++i )
+    {
+        mTemperatures[i] = mThermalElements[i]->GetTemperature();
+        mElementThermalStates[i] = mThermalElements[i]->GetThermalState();
+        mElementThermalStateFactors[i] = mThermalElements[i]->GetThermalStateFactor();
+    }
+
+    const size_t coolingDataCount =
+     mCoolingDataVector.Begin( mCoolingDataVector.GetNumberOfArrays() ) - mCoolingDataVector.Begin( 0 );
+    mCoolingFaces.reserve( coolingDataCount );
+    mSurfaceTemperatures.assign( coolingDataCount, airTemperature );
+    for ( size_t i = 0; i < mCoolingDataVector.GetNumberOfArrays(); ++i )
+        for ( const TaylorData< T > *it = mCoolingDataVector.Begin( i ); it != mCoolingDataVector.End( i ); ++it )
+        {
+            CoolingFace face;
+            face.mConductance = it->mConductivity / it->mDistanceToGridVertex;
+            face.mAreaConductance = it->mA_cool * face.mConductance;
+            face.mLengthFactor = DefaultConvection< T >::LengthFactor( it->mCharacteristicLength );
+            face.mCharacteristicLength = it->mCharacteristicLength;
+            face.mCooling = it->mCooling;
+            face.mLocation = it->mLocation;
+            if ( !face.mCooling && mConvection[face.mLocation] && face.mCharacteristicLength <= 0.0 )
+                ErrorFunction< std::runtime_error >( __FUNCTION__, __LINE__, __FILE__, "CharacteristicLengthNotPositive" );
+            mCoolingFaces.push_back( face );
+        }
+
+    for ( size_t i = 0; i < mConvection.size(); ++i )
+        if ( mConvection[i] )
+            mConvection[i]->SetAirTemperature( mAirTemperature );
+
+#ifdef BOOST_THREAD
+    for ( size_t k = 0; k < mCoolingFaces.size(); ++k )
+        if ( mCoolingFaces[k].mCooling && !mCoolingFaces[k].mCooling->IsThreadSafe() )
+            mIsBoundaryUpdateThreadSafe = false;
+    for ( size_t i = 0; i < mConvection.size(); ++i )
+        if ( mConvection[i] && !mConvection[i]->IsThreadSafe() )
+            mIsBoundaryUpdateThreadSafe = false;
+    if ( mRadiation && !mRadiation->IsThreadSafe() )
+        mIsBoundaryUpdateThreadSafe = false;
+#endif
 
     Update( 0.0, 0.0 );
 }
@@ -178,6 +306,18 @@ OdeSystemThermal< T >::~OdeSystemThermal()
 template < typename T >
 void OdeSystemThermal< T >::Update( T time, T dt )
 {
+#ifdef BOOST_THREAD
+    if ( mThreadedForLoop && mIsBoundaryUpdateThreadSafe )
+    {
+        mUpdateLoopFunctor.mTime = time;
+        mUpdateLoopFunctor.mDt = dt;
+        mThreadedForLoop->DoLoop( mUpdateLoopFunctor, mOdeSystemSize );
+#ifdef __EXCEPTIONS__
+        mUpdateLoopFunctor.RethrowException();
+#endif
+        return;
+    }
+#endif
     for ( size_t i = 0; i < mOdeSystemSize; ++i )
         UpdateLoop( i, time, dt );
 }
@@ -185,84 +325,176 @@ void OdeSystemThermal< T >::Update( T time, T dt )
 template < typename T >
 void OdeSystemThermal< T >::operator()( const vector< T > &x, vector< T > &dxdt, const double /* t */ )
 {
+#ifdef BOOST_THREAD
+    if ( mThreadedForLoop )
+    {
+        mDxdtLoopFunctor.mX = &x;
+        mDxdtLoopFunctor.mDxdt = &dxdt;
+        mThreadedForLoop->DoLoop( mDxdtLoopFunctor, mOdeSystemSize );
+#ifdef __EXCEPTIONS__
+        mDxdtLoopFunctor.RethrowException();
+#endif
+        return;
+    }
+#endif
     for ( size_t i = 0; i < mOdeSystemSize; ++i )
         DxdtLoop( i, x, dxdt );
 }
 
+#ifdef BOOST_THREAD
 template < typename T >
-void OdeSystemThermal< T >::UpdateLoop( size_t i, T time, T dt )
+void OdeSystemThermal< T >::SetNumberOfThreads( size_t numberOfThreads )
 {
-    mMatrixBoundarySource[i].mA_th = mMatrixDirichlet[i].mA_th;
-    mMatrixBoundarySource[i].mC_th = mMatrixDirichlet[i].mC_th + mThermalElements[i]->GetPowerDissipation( time, dt );
-    const T temperature = mThermalElements[i]->GetTemperature();
+    mThreadedForLoop.reset();
+    if ( numberOfThreads <= 1 )
+        return;
 
+    mUpdateLoopFunctor.mOdeSystem = this;
+    mDxdtLoopFunctor.mOdeSystem = this;
+    mThreadedForLoop.reset( new threading::ThreadedForLoop( numberOfThreads ) );
+}
 
-    for ( typename vector< TaylorData< T > >::iterator it = mCoolingDataVector[i].begin(); it != mCoolingDataVector[i].end(); ++it )
+#ifdef __EXCEPTIONS__
+template < typename T >
+void OdeSystemThermal< T >::LoopFunctor::StoreException( size_t i )
+{
+    boost::mutex::scoped_lock lock( mExceptionMutex );
+    if ( !mException || i < mExceptionIndex )
     {
+        mException = boost::current_exception();
+        mExceptionIndex = i;
+    }
+}
+
+template < typename T >
+void OdeSystemThermal< T >::LoopFunctor::RethrowException()
+{
+    if ( !mException )
+        return;
+    const boost::exception_ptr exception = mException;
+    mException = boost::exception_ptr();
+    boost::rethrow_exception( exception );
+}
+#endif
+
+template < typename T >
+void OdeSystemThermal< T >::UpdateLoopFunctor::Iterate( size_t i )
+{
+#ifdef __EXCEPTIONS__
+    try
+    {
+#endif
+        mOdeSystem->UpdateLoop( i, mTime, mDt );
+#ifdef __EXCEPTIONS__
+    }
+    catch ( ... )
+    {
+        this->StoreException( i );
+    }
+#endif
+}
+
+template < typename T >
+void OdeSystemThermal< T >::DxdtLoopFunctor::Iterate( size_t i )
+{
+#ifdef __EXCEPTIONS__
+    try
+    {
+#endif
+        mOdeSystem->DxdtLoop( i, *mX, *mDxdt );
+#ifdef __EXCEPTIONS__
+    }
+    catch ( ... )
+    {
+        this->StoreException( i );
+    }
+#endif
+}
+#endif
+
+template < typename T >
+void OdeSystemThermal< T >::UpdateLoop( size_t i, T time, T dt )
+{
+    T boundarySlope = mMatrixDirichlet.mA_th[i];
+    T boundaryOffset = mMatrixDirichlet.mC_th[i];
+    if ( mElementThermalStates[i] )
+        boundaryOffset += mElementThermalStates[i]->GetPowerDissipation( time, dt ) * mElementThermalStateFactors[i];
+    const T temperature = mTemperatures[i];
+
+    const size_t end = mCoolingDataVector.End( i ) - mCoolingDataVector.Begin( 0 );
+    for ( size_t k = mCoolingDataVector.Begin( i ) - mCoolingDataVector.Begin( 0 ); k < end; ++k )
+    {
+        const CoolingFace &face = mCoolingFaces[k];
+        T &surfaceTemperature = mSurfaceTemperatures[k];
         Linearization< T > offsetSlope( 0.0, 0.0 );
-        if ( it->mCooling )
-            offsetSlope.Add( it->mCooling->GetOffsetSlope( it->mTempSurfLastStep, mAirTemperature ) );
+        if ( face.mCooling )
+            offsetSlope.Add( face.mCooling->GetOffsetSlope( surfaceTemperature, mAirTemperature ) );
         else
         {
             if ( temperature > mAirTemperature )
             {
                 if ( mRadiation )
-                    offsetSlope.Add( mRadiation->GetOffsetSlope( it->mTempSurfLastStep, mAirTemperature ) );
-                if ( mConvection[it->mLocation] )
-                    offsetSlope.Add( mConvection[it->mLocation]->GetOffsetSlope( it->mTempSurfLastStep, it->mCharacteristicLength,
-                                                                                 mAirTemperature ) );
+                    offsetSlope.Add( mRadiation->GetOffsetSlope( surfaceTemperature, mAirTemperature ) );
+                if ( mConvection[face.mLocation] )
+                    offsetSlope.Add( mConvection[face.mLocation]->GetOffsetSlopeWithLengthFactor(
+                     surfaceTemperature, face.mCharacteristicLength, face.mLengthFactor, mAirTemperature ) );
             }
         }
 
-        const T helpFactor =
-         it->mA_cool * it->mConductivity / ( it->mDistanceToGridVertex * offsetSlope.mSlope + it->mConductivity );
+        const T helpFactor = face.mAreaConductance / ( offsetSlope.mSlope + face.mConductance );
         const T slope = helpFactor * offsetSlope.mSlope;
-        const T offset = helpFactor * ( offsetSlope.mOffset - offsetSlope.mSlope * it->mTempSurfLastStep );
-        mMatrixBoundarySource[i].mA_th -= slope;
-        mMatrixBoundarySource[i].mC_th -= offset;
+        const T offset = helpFactor * ( offsetSlope.mOffset - offsetSlope.mSlope * surfaceTemperature );
+        boundarySlope -= slope;
+        boundaryOffset -= offset;
 
-        it->mTempSurfLastStep =
-         ( it->mConductivity / it->mDistanceToGridVertex * temperature + slope * it->mTempSurfLastStep - offset ) /
-         ( slope + it->mConductivity / it->mDistanceToGridVertex );
+        surfaceTemperature =
+         ( face.mConductance * temperature + slope * surfaceTemperature - offset ) / ( slope + face.mConductance );
     }
+
+    mMatrixBoundarySource.mA_th[i] = boundarySlope;
+    mMatrixBoundarySource.mC_th[i] = boundaryOffset;
 }
 
 template < typename T >
 void OdeSystemThermal< T >::DxdtLoop( size_t i, const vector< T > &x, vector< T > &dxdt )
 {
-    dxdt[i] = 0.0;
-
-    for ( typename vector< IndexedValue< T > >::const_iterator it = mA_th_Conductivity[i].begin();
-          it != mA_th_Conductivity[i].end(); ++it )
-    {
-        // TODO: Given that mA_th_Conductivity is a symmetric matrix, consider making it a half matrix and optimize its
-        // evaluation here
-        dxdt[i] += it->mValue * x[it->mIndex];
-    }
-
-    dxdt[i] += mMatrixBoundarySource[i].mA_th * x[i] + mMatrixBoundarySource[i].mC_th;
-    dxdt[i] *= mThermalElementFactors[i];
+    // mA_th_Conductivity is symmetric, but every row is stored in full, so that each row is evaluated independently of
+    // the others and the loop can be distributed over threads
+    const IndexedValue< T > *const end = mA_th_Conductivity.End( i );
+    T sum = 0.0;
+    for ( const IndexedValue< T > *it = mA_th_Conductivity.Begin( i ); it != end; ++it )
+        sum += it->mValue * x[it->mIndex];
+
+    sum += mMatrixBoundarySource.mA_th[i] * x[i] + mMatrixBoundarySource.mC_th[i];
+    dxdt[i] = sum * mThermalElementFactors[i];
 }
 
 template < typename T >
 void OdeSystemThermal< T >::GetTemperatureVector( vector< T > &temperatureVector ) const
 {
-    temperatureVector.resize( mOdeSystemSize );
-    for ( size_t i = 0; i < mThermalElements.size(); ++i )
-        temperatureVector[i] = mThermalElements[i]->GetTemperature();
+    temperatureVector = mTemperatures;
 }
 
 template < typename T >
 void OdeSystemThermal< T >::SetTemperatureVector( const vector< T > &temperatureVector )
 {
     for ( size_t i = 0; i < mOdeSystemSize; ++i )
+    {
+        mTemperatures[i] = temperatureVector[i];
         mThermalElements[i]->SetTemperature( temperatureVector[i] );
+    }
 }
 
 template < typename T >
 void OdeSystemThermal< T >::ResetAirTemperature( T newAirTemperature )
 {
+    if ( newAirTemperature == mAirTemperature )
+        return;
+
     mAirTemperature = newAirTemperature;
+    for ( size_t i = 0; i < mConvection.size(); ++i )
+        if ( mConvection[i] )
+            mConvection[i]->SetAirTemperature( mAirTemperature );
 }
 
 template < typename T >
@@ -278,7 +510,7 @@ const vector< shared_ptr< ThermalElement< T > > > &OdeSystemThermal< T >::GetThe
 }
 
 template < typename T >
-const vector< vector< IndexedValue< T > > > &OdeSystemThermal< T >::GetA_th_Conductivity() const
+const JaggedArray< IndexedValue< T > > &OdeSystemThermal< T >::GetA_th_Conductivity() const
 {
     return mA_th_Conductivity;
 }
@@ -302,13 +534,19 @@ const shared_ptr< Radiation< T > > &OdeSystemThermal< T >::GetRadiation() const
 }
 
 template < typename T >
-const vector< typename OdeSystemThermal< T >::BoundarySourceData > &OdeSystemThermal< T >::GetMatrixDirichlet() const
+const typename OdeSystemThermal< T >::BoundarySourceData &OdeSystemThermal< T >::GetMatrixDirichlet() const
 {
     return mMatrixDirichlet;
 }
 
 template < typename T >
-const vector< vector< TaylorData< T > > > &OdeSystemThermal< T >::GetCoolingDataVector() const
+const typename OdeSystemThermal< T >::BoundarySourceData &OdeSystemThermal< T >::GetMatrixBoundarySource() const
+{
+    return mMatrixBoundarySource;
+}
+
+template < typename T >
+const JaggedArray< TaylorData< T > > &OdeSystemThermal< T >::GetCoolingDataVector() const
 {
     return mCoolingDataVector;
 }
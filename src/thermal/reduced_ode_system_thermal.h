@@ -0,0 +1,351 @@
+/*
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see http://www.gnu.org/licenses/.
+*/
+/* -.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.
+* File Name : reduced_ode_system_thermal.h
+* Creation Date : 17-10-2026
+_._._._._._._._._._._._._._._._._._._._._.*/
+#ifndef _REDUCED_ODE_SYSTEM_THERMAL_
+#define _REDUCED_ODE_SYSTEM_THERMAL_
+
+#if defined( _EIGEN_ ) || defined( USE_EIGEN )
+
+#include <vector>
+#include <map>
+#include <cmath>
+#include <algorithm>
+#include <eigen3/Eigen/Sparse>
+
+#include "ode_system_thermal.h"
+#include "../exceptions/error_proto.h"
+
+class TestOdeSystemThermal;
+
+namespace thermal
+{
+using std::vector;
+
+/// ReducedOdeSystemThermal is a reduced-order model of OdeSystemThermal for real time simulation.
+/// With the capacity matrix M and the conduction matrix K, the full system is M * dx/dt = K * x + b. It is projected
+/// onto a block Krylov subspace of (sigma * M - K)^-1 * M, which is started with the heat sources, the boundary
+/// conditions and the output elements. The basis V is M-orthonormal, so the reduced system is
+/// dx_r/dt = V^T * K * V * x_r + V^T * b and x = V * x_r.
+/// The full system is still used to linearize the boundary conditions in Update(), only the rows with coolings are
+/// projected again. The interface is the one of OdeSystemThermal used by the equation solvers.
+template < typename T = double >
+class ReducedOdeSystemThermal
+{
+    friend class ::TestOdeSystemThermal;
+
+    public:
+    /**
+     * @param[in] system Full thermal system, which must outlive this instance. It has to be updated and keeps
+     * providing the thermal elements.
+     * @param[in] outputIndices Indices of thermal elements whose temperatures are outputs of the reduced model, e.g.
+     * those of thermal probes and those connected to the electrical model
+     * @param[in] maxOrder Maximum number of basis vectors
+     * @param[in] expansionPoint Frequency sigma in 1/s around which the transfer behaviour is matched, must be positive
+     */
+    ReducedOdeSystemThermal( OdeSystemThermal< T > &system, const vector< size_t > &outputIndices, size_t maxOrder,
+                             T expansionPoint );
+    /// Updates the full system and projects its linearized boundary conditions and heat sources
+    void Update( T time, T dt );
+    /// Equation solver interface function, works on the reduced state
+    void operator()( const vector< T > &x, vector< T > &dxdt, const double /* t */ );
+    /// Projects the temperatures of the thermal elements onto the reduced basis
+    void GetTemperatureVector( vector< T > &temperatureVector ) const;
+    /// Reconstructs the temperatures of all thermal elements from the reduced state
+    void SetTemperatureVector( const vector< T > &temperatureVector );
+    size_t GetOrder() const { return mOrder; }
+
+    private:
+    void CreateBasis( const vector< size_t > &outputIndices, size_t maxOrder, T expansionPoint );
+    /// Orthogonalizes vec against the basis with respect to M and appends it, unless it is linearly dependent on it
+    bool AppendToBasis( vector< T > &vec, vector< vector< T > > &basisVectors ) const;
+    T InnerProduct( const vector< T > &lhs, const vector< T > &rhs ) const;
+    void ProjectConductionMatrix();
+    void ProjectBoundaryConditions();
+
+    OdeSystemThermal< T > &mSystem;
+    const size_t mSize;
+    size_t mOrder;
+    vector< T > mCapacities;          ///< Diagonal of M
+    vector< T > mBasis;               ///< V, row-major with mSize rows and mOrder columns
+    vector< T > mConductionMatrix;    ///< V^T * (conductivity + dirichlet boundary conditions) * V, row-major
+    vector< T > mSystemMatrix;        ///< mConductionMatrix plus the current linearized coolings, row-major
+    vector< T > mSource;              ///< V^T * (heat sources + boundary condition offsets)
+    vector< size_t > mCooledRows;     ///< Thermal elements with coolings, whose slopes change in Update()
+    mutable vector< T > mFullTemperatures;
+};
+
+
+template < typename T >
+ReducedOdeSystemThermal< T >::ReducedOdeSystemThermal( OdeSystemThermal< T > &system, const vector< size_t > &outputIndices,
+                                                       size_t maxOrder, T expansionPoint )
+    : mSystem( system )
+    , mSize( system.GetOdeSystemSize() )
+    , mOrder( 0 )
+    , mCapacities( system.GetOdeSystemSize() )
+    , mFullTemperatures( system.GetOdeSystemSize() )
+{
+    if ( maxOrder == 0 )
+        ErrorFunction< std::runtime_error >( __FUNCTION__, __LINE__, __FILE__, "ReducedThermalOrderNotPositive" );
+    if ( expansionPoint <= 0.0 )
+        ErrorFunction< std::runtime_error >( __FUNCTION__, __LINE__, __FILE__, "ReducedThermalExpansionPointNotPositive" );
+
+    for ( size_t i = 0; i < mSize; ++i )
+        mCapacities[i] = 1.0 / mSystem.GetThermalElementFactors()[i];
+    for ( size_t i = 0; i < mSize; ++i )
+        if ( mSystem.GetCoolingDataVector().Begin( i ) != mSystem.GetCoolingDataVector().End( i ) )
+            mCooledRows.push_back( i );
+
+    CreateBasis( outputIndices, maxOrder, expansionPoint );
+    ProjectConductionMatrix();
+    ProjectBoundaryConditions();
+}
+
+template < typename T >
+void ReducedOdeSystemThermal< T >::Update( T time, T dt )
+{
+    mSystem.Update( time, dt );
+    ProjectBoundaryConditions();
+}
+
+template < typename T >
+void ReducedOdeSystemThermal< T >::operator()( const vector< T > &x, vector< T > &dxdt, const double /* t */ )
+{
+    for ( size_t k = 0; k < mOrder; ++k )
+    {
+        const T *row = &mSystemMatrix[k * mOrder];
+        T sum = mSource[k];
+        for ( size_t l = 0; l < mOrder; ++l )
+            sum += row[l] * x[l];
+        dxdt[k] = sum;
+    }
+}
+
+template < typename T >
+void ReducedOdeSystemThermal< T >::GetTemperatureVector( vector< T > &temperatureVector ) const
+{
+    mSystem.GetTemperatureVector( mFullTemperatures );
+    temperatureVector.assign( mOrder, 0.0 );
+    for ( size_t i = 0; i < mSize; ++i )
+    {
+        const T *basisRow = &mBasis[i * mOrder];
+        const T weightedTemperature = mCapacities[i] * mFullTemperatures[i];
+        for ( size_t k = 0; k < mOrder; ++k )
+            temperatureVector[k] += basisRow[k] * weightedTemperature;
+    }
+}
+
+template < typename T >
+void ReducedOdeSystemThermal< T >::SetTemperatureVector( const vector< T > &temperatureVector )
+{
+    for ( size_t i = 0; i < mSize; ++i )
+    {
+        const T *basisRow = &mBasis[i * mOrder];
+        T temperature = 0.0;
+        for ( size_t k = 0; k < mOrder; ++k )
+            temperature += basisRow[k] * temperatureVector[k];
+        mFullTemperatures[i] = temperature;
+    }
+    mSystem.SetTemperatureVector( mFullTemperatures );
+}
+
+template < typename T >
+void ReducedOdeSystemThermal< T >::CreateBasis( const vector< size_t > &outputIndices, size_t maxOrder, T expansionPoint )
+{
+    const JaggedArray< IndexedValue< T > > &conductivity = mSystem.GetA_th_Conductivity();
+    const vector< T > &boundarySlopes = mSystem.GetMatrixBoundarySource().mA_th;
+    const vector< T > &dirichletSlopes = mSystem.GetMatrixDirichlet().mA_th;
+
+    // sigma * M - K is symmetric and positive definite for sigma > 0
+    vector< Eigen::Triplet< double > > triplets;
+    for ( size_t i = 0; i < mSize; ++i )
+    {
+        triplets.push_back( Eigen::Triplet< double >( i, i, expansionPoint * mCapacities[i] - boundarySlopes[i] ) );
+        for ( const IndexedValue< T > *it = conductivity.Begin( i ); it != conductivity.End( i ); ++it )
+            triplets.push_back( Eigen::Triplet< double >( i, it->mIndex, -it->mValue ) );
+    }
+    Eigen::SparseMatrix< double > shiftedMatrix( mSize, mSize );
+    shiftedMatrix.setFromTriplets( triplets.begin(), triplets.end() );
+    Eigen::SimplicialLDLT< Eigen::SparseMatrix< double > > solver( shiftedMatrix );
+    if ( solver.info() != Eigen::Success )
+        ErrorFunction< std::runtime_error >( __FUNCTION__, __LINE__, __FILE__, "ReducedThermalFactorizationFailed" );
+
+    // Start block: uniform heating, the heat sources of every thermal state, coolings, dirichlet boundary conditions
+    // and the output elements
+    vector< vector< T > > block;
+    block.push_back( mCapacities );
+    // One column per thermal state in the order of their first thermal element, so that the basis does not depend on
+    // where the states have been allocated
+    std::map< const ::state::ThermalState< T > *, size_t > stateColumns;
+    for ( size_t i = 0; i < mSize; ++i )
+    {
+        if ( !mSystem.GetThermalElements()[i]->HasThermalState() )
+            continue;
+        const ::state::ThermalState< T > *state = mSystem.GetThermalElements()[i]->GetThermalState();
+        typename std::map< const ::state::ThermalState< T > *, size_t >::const_iterator column = stateColumns.find( state );
+        if ( column == stateColumns.end() )
+        {
+            column = stateColumns.insert( std::make_pair( state, block.size() ) ).first;
+            block.push_back( vector< T >( mSize, 0.0 ) );
+        }
+        block[column->second][i] = mSystem.GetThermalElements()[i]->GetThermalStateFactor();
+    }
+    block.push_back( vector< T >( mSize, 0.0 ) );
+    for ( size_t i = 0; i < mSize; ++i )
+        block.back()[i] = dirichletSlopes[i] - boundarySlopes[i];
+    block.push_back( vector< T >( mSize, 0.0 ) );
+    for ( size_t i = 0; i < mSize; ++i )
+        block.back()[i] = -dirichletSlopes[i];
+    for ( size_t j = 0; j < outputIndices.size(); ++j )
+    {
+        block.push_back( vector< T >( mSize, 0.0 ) );
+        block.back()[outputIndices[j]] = 1.0;
+    }
+
+    // Block Arnoldi, the next block is (sigma * M - K)^-1 * M applied to the basis vectors added from the last block
+    vector< vector< T > > basisVectors;
+    Eigen::VectorXd rhs( mSize );
+    Eigen::VectorXd solution( mSize );
+    while ( !block.empty() && basisVectors.size() < maxOrder )
+    {
+        vector< vector< T > > nextBlock;
+        for ( size_t j = 0; j < block.size() && basisVectors.size() < maxOrder; ++j )
+        {
+            for ( size_t i = 0; i < mSize; ++i )
+                rhs[i] = block[j][i];
+            solution = solver.solve( rhs );
+            vector< T > vec( solution.data(), solution.data() + mSize );
+            if ( !AppendToBasis( vec, basisVectors ) )
+                continue;
+
+            nextBlock.push_back( basisVectors.back() );
+            for ( size_t i = 0; i < mSize; ++i )
+                nextBlock.back()[i] *= mCapacities[i];
+        }
+        block.swap( nextBlock );
+    }
+
+    mOrder = basisVectors.size();
+    mBasis.resize( mSize * mOrder );
+    for ( size_t i = 0; i < mSize; ++i )
+        for ( size_t k = 0; k < mOrder; ++k )
+            mBasis[i * mOrder + k] = basisVectors[k][i];
+}
+
+template < typename T >
+bool ReducedOdeSystemThermal< T >::AppendToBasis( vector< T > &vec, vector< vector< T > > &basisVectors ) const
+{
+    const T initialNorm = std::sqrt( InnerProduct( vec, vec ) );
+    if ( initialNorm == 0.0 )
+        return false;
+
+    // Modified Gram-Schmidt is done twice to keep the basis orthonormal to machine precision
+    for ( size_t pass = 0; pass < 2; ++pass )
+        for ( size_t k = 0; k < basisVectors.size(); ++k )
+        {
+            const T projection = InnerProduct( basisVectors[k], vec );
+            for ( size_t i = 0; i < mSize; ++i )
+                vec[i] -= projection * basisVectors[k][i];
+        }
+
+    const T norm = std::sqrt( InnerProduct( vec, vec ) );
+    if ( norm <= 1.0e-10 * initialNorm )
+        return false;
+
+    for ( size_t i = 0; i < mSize; ++i )
+        vec[i] /= norm;
+    basisVectors.push_back( vector< T >() );
+    basisVectors.back().swap( vec );
+    return true;
+}
+
+template < typename T >
+T ReducedOdeSystemThermal< T >::InnerProduct( const vector< T > &lhs, const vector< T > &rhs ) const
+{
+    T sum = 0.0;
+    for ( size_t i = 0; i < mSize; ++i )
+        sum += lhs[i] * mCapacities[i] * rhs[i];
+    return sum;
+}
+
+template < typename T >
+void ReducedOdeSystemThermal< T >::ProjectConductionMatrix()
+{
+    const JaggedArray< IndexedValue< T > > &conductivity = mSystem.GetA_th_Conductivity();
+    const vector< T > &dirichletSlopes = mSystem.GetMatrixDirichlet().mA_th;
+
+    mConductionMatrix.assign( mOrder * mOrder, 0.0 );
+    vector< T > rowTimesBasis( mOrder );
+    for ( size_t i = 0; i < mSize; ++i )
+    {
+        const T *basisRow = &mBasis[i * mOrder];
+        for ( size_t l = 0; l < mOrder; ++l )
+            rowTimesBasis[l] = dirichletSlopes[i] * basisRow[l];
+        for ( const IndexedValue< T > *it = conductivity.Begin( i ); it != conductivity.End( i ); ++it )
+        {
+            const T *otherBasisRow = &mBasis[it->mIndex * mOrder];
+            for ( size_t l = 0; l < mOrder; ++l )
+                rowTimesBasis[l] += it->mValue * otherBasisRow[l];
+        }
+
+        for ( size_t k = 0; k < mOrder; ++k )
+            for ( size_t l = 0; l < mOrder; ++l )
+                mConductionMatrix[k * mOrder + l] += basisRow[k] * rowTimesBasis[l];
+    }
+}
+
+template < typename T >
+void ReducedOdeSystemThermal< T >::ProjectBoundaryConditions()
+{
+    const typename OdeSystemThermal< T >::BoundarySourceData &boundarySource = mSystem.GetMatrixBoundarySource();
+    const vector< T > &dirichletSlopes = mSystem.GetMatrixDirichlet().mA_th;
+
+    mSystemMatrix = mConductionMatrix;
+    for ( size_t j = 0; j < mCooledRows.size(); ++j )
+    {
+        const size_t i = mCooledRows[j];
+        const T coolingSlope = boundarySource.mA_th[i] - dirichletSlopes[i];
+        if ( coolingSlope == 0.0 )
+            continue;
+
+        const T *basisRow = &mBasis[i * mOrder];
+        for ( size_t k = 0; k < mOrder; ++k )
+        {
+            const T factor = coolingSlope * basisRow[k];
+            for ( size_t l = 0; l < mOrder; ++l )
+                mSystemMatrix[k * mOrder + l] += factor * basisRow[l];
+        }
+    }
+
+    mSource.assign( mOrder, 0.0 );
+    for ( size_t i = 0; i < mSize; ++i )
+    {
+        const T offset = boundarySource.mC_th[i];
+        if ( offset == 0.0 )
+            continue;
+
+        const T *basisRow = &mBasis[i * mOrder];
+        for ( size_t k = 0; k < mOrder; ++k )
+            mSource[k] += basisRow[k] * offset;
+    }
+}
+
+}    // namespace thermal
+
+#endif /* defined( _EIGEN_ ) || defined( USE_EIGEN ) */
+
+#endif /* _REDUCED_ODE_SYSTEM_THERMAL_ */
@@ -0,0 +1,167 @@
+/*
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see http://www.gnu.org/licenses/.
+*/
+/* -.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.
+* File Name : rosenbrock_stepper_thermal.h
+* Creation Date : 17-10-2026
+_._._._._._._._._._._._._._._._._._._._._.*/
+#ifndef _ROSENBROCK_STEPPER_THERMAL_
+#define _ROSENBROCK_STEPPER_THERMAL_
+
+#if defined( _EIGEN_ ) || defined( USE_EIGEN )
+
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include <boost/ref.hpp>
+#include <boost/numeric/odeint/stepper/controlled_step_result.hpp>
+
+#include "ode_system_thermal.h"
+#include "../system/cachedSparseLu.h"
+
+class TestOdeSystemThermal;
+
+namespace thermal
+{
+using std::vector;
+
+/// Linearly implicit two stage Rosenbrock method (ROS2, L-stable, order 2) with step size control for
+/// OdeSystemThermal.
+/// Between two calls of OdeSystemThermal::Update() the thermal system is linear, so the Jacobian built from the
+/// conductivity matrix and the linearized boundary conditions is exact. In contrast to explicit steppers, the step size
+/// is only limited by accuracy and not by the smallest thermal element of the mesh.
+/// The interface resembles the controlled steppers of boost::odeint.
+template < typename T = double >
+class RosenbrockStepperThermal
+{
+    friend class ::TestOdeSystemThermal;
+
+    public:
+    RosenbrockStepperThermal( T absoluteTolerance = 1.0e-6, T relativeTolerance = 1.0e-6 );
+
+    /// Tries to advance x by dt. On success, x and t are updated. In both cases, dt is adapted to the estimated error.
+    boost::numeric::odeint::controlled_step_result try_step( OdeSystemThermal< T > &system, vector< T > &x, T &t, T &dt );
+    boost::numeric::odeint::controlled_step_result
+    try_step( boost::reference_wrapper< OdeSystemThermal< T > > system, vector< T > &x, T &t, T &dt )
+    {
+        return try_step( system.get(), x, t, dt );
+    }
+
+    private:
+    /// Assembles and factorizes I - gamma * dt * J with J = diag(factors) * (conductivity + diag(boundary slopes))
+    void FactorizeIterationMatrix( const OdeSystemThermal< T > &system, T gammaDt );
+    void Solve( const vector< T > &rhs, vector< T > &result ) const;
+
+    const T mAbsoluteTolerance;
+    const T mRelativeTolerance;
+
+    systm::CachedSparseLU mIterationMatrixSolver;
+    vector< Eigen::Triplet< double > > mTriplets;
+    vector< T > mDxdt;
+    vector< T > mK1;
+    vector< T > mK2;
+    vector< T > mXStage;
+};
+
+template < typename T >
+RosenbrockStepperThermal< T >::RosenbrockStepperThermal( T absoluteTolerance, T relativeTolerance )
+    : mAbsoluteTolerance( absoluteTolerance )
+    , mRelativeTolerance( relativeTolerance )
+{
+}
+
+template < typename T >
+boost::numeric::odeint::controlled_step_result
+RosenbrockStepperThermal< T >::try_step( OdeSystemThermal< T > &system, vector< T > &x, T &t, T &dt )
+{
+    const T gamma = 1.0 + 1.0 / std::sqrt( 2.0 );
+    const size_t size = x.size();
+    mDxdt.resize( size );
+    mK1.resize( size );
+    mK2.resize( size );
+    mXStage.resize( size );
+
+    FactorizeIterationMatrix( system, gamma * dt );
+
+    // (I - gamma*dt*J) * k1 = f(x)
+    system( x, mDxdt, t );
+    Solve( mDxdt, mK1 );
+
+    // (I - gamma*dt*J) * k2 = f(x + dt*k1) - 2*k1
+    for ( size_t i = 0; i < size; ++i )
+        mXStage[i] = x[i] + dt * mK1[i];
+    system( mXStage, mDxdt, t + dt );
+    for ( size_t i = 0; i < size; ++i )
+        mDxdt[i] -= 2.0 * mK1[i];
+    Solve( mDxdt, mK2 );
+
+    // The difference to the embedded first order solution x + dt*k1 is used as error estimate
+    T error = 0.0;
+    for ( size_t i = 0; i < size; ++i )
+    {
+        mXStage[i] = x[i] + dt * ( 1.5 * mK1[i] + 0.5 * mK2[i] );
+        const T scale = mAbsoluteTolerance + mRelativeTolerance * std::max( std::fabs( x[i] ), std::fabs( mXStage[i] ) );
+        error = std::max( error, std::fabs( 0.5 * dt * ( mK1[i] + mK2[i] ) ) / scale );
+    }
+
+    const T factor = 0.9 * std::pow( std::max( error, static_cast< T >( 1.0e-10 ) ), -0.5 );
+    if ( error > 1.0 )
+    {
+        dt *= std::max( factor, static_cast< T >( 0.2 ) );
+        return boost::numeric::odeint::fail;
+    }
+
+    x.swap( mXStage );
+    t += dt;
+    if ( error < 0.5 )
+        dt *= std::min( factor, static_cast< T >( 5.0 ) );
+    return boost::numeric::odeint::success;
+}
+
+template < typename T >
+void RosenbrockStepperThermal< T >::FactorizeIterationMatrix( const OdeSystemThermal< T > &system, T gammaDt )
+{
+    const JaggedArray< IndexedValue< T > > &conductivity = system.GetA_th_Conductivity();
+    const typename OdeSystemThermal< T >::BoundarySourceData &boundarySource = system.GetMatrixBoundarySource();
+    const vector< T > &factors = system.GetThermalElementFactors();
+    const size_t size = conductivity.GetNumberOfArrays();
+
+    mTriplets.clear();
+    for ( size_t i = 0; i < size; ++i )
+    {
+        const T rowFactor = -gammaDt * factors[i];
+        // The diagonal is always inserted to keep the sparsity pattern independent of the boundary conditions
+        mTriplets.push_back( Eigen::Triplet< double >( i, i, 1.0 + rowFactor * boundarySource.mA_th[i] ) );
+        for ( const IndexedValue< T > *it = conductivity.Begin( i ); it != conductivity.End( i ); ++it )
+            mTriplets.push_back( Eigen::Triplet< double >( i, it->mIndex, rowFactor * it->mValue ) );
+    }
+
+    systm::CachedSparseLU::MatrixType iterationMatrix( size, size );
+    iterationMatrix.setFromTriplets( mTriplets.begin(), mTriplets.end() );
+    mIterationMatrixSolver.Factorize( iterationMatrix );
+}
+
+template < typename T >
+void RosenbrockStepperThermal< T >::Solve( const vector< T > &rhs, vector< T > &result ) const
+{
+    Eigen::Map< const Eigen::VectorXd > rhsMap( &rhs[0], rhs.size() );
+    Eigen::Map< Eigen::VectorXd > resultMap( &result[0], result.size() );
+    resultMap = mIterationMatrixSolver.GetSolver().solve( rhsMap );
+}
+
+}    // namespace thermal
+
+#endif /* defined( _EIGEN_ ) || defined( USE_EIGEN ) */
+
+#endif /* _ROSENBROCK_STEPPER_THERMAL_ */
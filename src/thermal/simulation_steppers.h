@@ -0,0 +1,181 @@
+/*
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see http://www.gnu.org/licenses/.
+*/
+#ifndef _SIMULATION_STEPPERS_
+#define _SIMULATION_STEPPERS_
+
+#include <vector>
+#include <boost/numeric/odeint.hpp>
+#include <boost/ref.hpp>
+
+#include "../misc/fast_copy_matrix.h"
+#include "../misc/matrixInclude.h"
+#include "../time_series/time_series.h"
+#include "electrical_simulation.h"
+#include "thermal_simulation.h"
+
+
+namespace simulation
+{
+
+/// ElectricalStepper runs one step of the electrical simulation with a controlled Runge-Kutta stepper for CouplingDriver
+template < typename Matrix, typename T = double, bool matlabFilterOutput = true >
+class ElectricalStepper
+{
+    public:
+    typedef ElectricalSimulation< Matrix, T, matlabFilterOutput > SimulationType;
+
+    ElectricalStepper( SimulationType *electricalSimulation );
+    /// Runs one step from mTime, mDeltaTime is shortened until the step is accepted
+    void operator()();
+
+    private:
+    SimulationType *const mElectricalSimulation;
+#if defined( _ARMADILLO_ ) && !defined( SPARSE_MATRIX_FORMAT )
+    typedef boost::numeric::odeint::runge_kutta_cash_karp54< myMatrixType > ErrorStepper;
+#else
+    typedef boost::numeric::odeint::runge_kutta_cash_karp54< std::vector< T > > ErrorStepper;
+    std::vector< T > mTmpStateVector;
+#endif
+    typename boost::numeric::odeint::result_of::make_controlled< ErrorStepper >::type mStepper;
+};
+
+/// ThermalStepper runs one step of the thermal simulation with its equation solver for CouplingDriver
+template < typename Matrix, typename T = double, bool FilterTypeChoice = true >
+class ThermalStepper
+{
+    public:
+    typedef ThermalSimulation< Matrix, T, FilterTypeChoice > SimulationType;
+
+    ThermalStepper( SimulationType *thermalSimulation );
+    /// Runs one step from mTime, mDeltaTime is shortened until the step is accepted
+    void operator()();
+
+    private:
+    SimulationType *const mThermalSimulation;
+};
+
+/// CurrentProfileInput sets the current of the electrical simulation from a current profile for CouplingDriver
+template < typename Matrix, typename T = double, bool matlabFilterOutput = true >
+class CurrentProfileInput
+{
+    public:
+    CurrentProfileInput( ElectricalSimulation< Matrix, T, matlabFilterOutput > *electricalSimulation,
+                         electrical::TimeSeries< T, electrical::EvalNoInterpolation > *currentProfile );
+    /// Sets the current at time and returns the point of time of its next change
+    T operator()( T time );
+
+    private:
+    ElectricalSimulation< Matrix, T, matlabFilterOutput > *const mElectricalSimulation;
+    electrical::TimeSeries< T, electrical::EvalNoInterpolation > *const mCurrentProfile;
+};
+
+/// PowerProfileInput sets the power dissipation of the first thermal state from a power profile for CouplingDriver
+template < typename Matrix, typename T = double, bool FilterTypeChoice = true >
+class PowerProfileInput
+{
+    public:
+    PowerProfileInput( ThermalSimulation< Matrix, T, FilterTypeChoice > *thermalSimulation,
+                       electrical::TimeSeries< T, electrical::EvalNoInterpolation > *powerProfile );
+    /// Sets the power dissipation at time and returns the point of time of its next change
+    T operator()( T time );
+
+    private:
+    ThermalSimulation< Matrix, T, FilterTypeChoice > *const mThermalSimulation;
+    electrical::TimeSeries< T, electrical::EvalNoInterpolation > *const mPowerProfile;
+};
+
+
+template < typename Matrix, typename T, bool matlabFilterOutput >
+ElectricalStepper< Matrix, T, matlabFilterOutput >::ElectricalStepper( SimulationType *electricalSimulation )
+    : mElectricalSimulation( electricalSimulation )
+#if !defined( _ARMADILLO_ ) || defined( SPARSE_MATRIX_FORMAT )
+    , mTmpStateVector( electricalSimulation->mStateSystemGroup.mStateVector.n_rows, 0.0 )
+#endif
+    , mStepper( boost::numeric::odeint::make_controlled( 1.0e-10, 1.0e-10, ErrorStepper() ) )
+{
+}
+
+template < typename Matrix, typename T, bool matlabFilterOutput >
+void ElectricalStepper< Matrix, T, matlabFilterOutput >::operator()()
+{
+    SimulationType &sim = *mElectricalSimulation;
+#if defined( _ARMADILLO_ ) && !defined( SPARSE_MATRIX_FORMAT )
+    myMatrixType state = sim.mStateSystemGroup.mStateVector.submat( 0, 0, sim.mStateSystemGroup.mStateVector.n_rows - 2, 0 );
+    sim.mStateSystemGroup.mDt = sim.mDeltaTime;
+    while ( mStepper.try_step( boost::ref( *sim.mEqSystem ), state, sim.mTime, sim.mDeltaTime ) != boost::numeric::odeint::success )
+    {
+        sim.mStateSystemGroup.mStateVector.submat( 0, 0, sim.mStateSystemGroup.mStateVector.n_rows - 2, 0 ) = state;
+        sim.mStateSystemGroup.mDt = sim.mDeltaTime;
+    }
+#else
+    misc::FastCopyMatrix( &mTmpStateVector[0], sim.mStateSystemGroup.mStateVector, mTmpStateVector.size() );
+    sim.mStateSystemGroup.mDt = sim.mDeltaTime;
+    while ( mStepper.try_step( boost::ref( *sim.mEqSystem ), mTmpStateVector, sim.mTime, sim.mDeltaTime ) !=
+            boost::numeric::odeint::success )
+    {
+        sim.mStateSystemGroup.mDt = sim.mDeltaTime;
+    }
+    misc::FastCopyMatrix( sim.mStateSystemGroup.mStateVector, &mTmpStateVector[0], mTmpStateVector.size() );
+#endif
+}
+
+template < typename Matrix, typename T, bool FilterTypeChoice >
+ThermalStepper< Matrix, T, FilterTypeChoice >::ThermalStepper( SimulationType *thermalSimulation )
+    : mThermalSimulation( thermalSimulation )
+{
+}
+
+template < typename Matrix, typename T, bool FilterTypeChoice >
+void ThermalStepper< Matrix, T, FilterTypeChoice >::operator()()
+{
+    while ( !mThermalSimulation->TryThermalStep() )
+    {
+    }
+}
+
+template < typename Matrix, typename T, bool matlabFilterOutput >
+CurrentProfileInput< Matrix, T, matlabFilterOutput >::CurrentProfileInput(
+ ElectricalSimulation< Matrix, T, matlabFilterOutput > *electricalSimulation,
+ electrical::TimeSeries< T, electrical::EvalNoInterpolation > *currentProfile )
+    : mElectricalSimulation( electricalSimulation )
+    , mCurrentProfile( currentProfile )
+{
+}
+
+template < typename Matrix, typename T, bool matlabFilterOutput >
+T CurrentProfileInput< Matrix, T, matlabFilterOutput >::operator()( T time )
+{
+    mCurrentProfile->SetTimeAndTriggerEvaluation( time );
+    mElectricalSimulation->mRootTwoPort->SetCurrent( mCurrentProfile->GetValue() );
+    return mCurrentProfile->GetTimeUntilMaxValueDeviation( 0.0 );
+}
+
+template < typename Matrix, typename T, bool FilterTypeChoice >
+PowerProfileInput< Matrix, T, FilterTypeChoice >::PowerProfileInput( ThermalSimulation< Matrix, T, FilterTypeChoice > *thermalSimulation,
+                                                                      electrical::TimeSeries< T, electrical::EvalNoInterpolation > *powerProfile )
+    : mThermalSimulation( thermalSimulation )
+    , mPowerProfile( powerProfile )
+{
+}
+
+template < typename Matrix, typename T, bool FilterTypeChoice >
+T PowerProfileInput< Matrix, T, FilterTypeChoice >::operator()( T time )
+{
+    mPowerProfile->SetTimeAndTriggerEvaluation( time );
+    mThermalSimulation->mThermalStates.at( 0 )->SetFixedPowerDissipation( mPowerProfile->GetValue() );
+    return mPowerProfile->GetTimeUntilMaxValueDeviation( 0.0 );
+}
+}
+#endif
@@ -0,0 +1,181 @@
+/*
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see http://www.gnu.org/licenses/.
+*/
+#ifndef _STATE_HISTORY_
+#define _STATE_HISTORY_
+
+#include <algorithm>
+#include <vector>
+
+#include "../exceptions/error_proto.h"
+
+
+class TestStateHistory;
+
+namespace simulation
+{
+
+/**
+ * StateHistory stores time, states and SoC values during a simulation step of the electrical simulation, so that they
+ * can be reset to an earlier point of time if the thermal stop criterion is met.
+ * The number of entries is bounded by the capacity. Only every mStride-th added step is kept permanently, the latest
+ * step is always available as last entry. If all slots are used, every second permanent entry is dropped and the stride
+ * is doubled. This halves the time resolution, but the whole simulation step stays evenly covered.
+ */
+template < typename Matrix, typename T = double >
+class StateHistory
+{
+    friend class ::TestStateHistory;
+
+    public:
+    ///@param[in] capacity Maximum number of stored entries, must be at least 2
+    explicit StateHistory( size_t capacity );
+    /// Removes all entries, the allocated slots are kept for reuse
+    void Clear();
+    /// Appends an entry, time must not be smaller than the time of the last entry
+    template < typename SocContainer >
+    void Add( T time, const Matrix &states, const SocContainer &socStates );
+    size_t GetSize() const;
+    size_t GetCapacity() const;
+    T GetTime( size_t index ) const;
+    const Matrix &GetStates( size_t index ) const;
+    /// Returns the SoC values of entry index in the order of the SoC states passed to Add
+    const T *GetSocValues( size_t index ) const;
+    /// Returns the index of the last entry whose time is not greater than time, found by binary search
+    size_t FindIndex( T time ) const;
+
+    private:
+    /// Drops every second entry, keeping the first one
+    void Thin();
+
+    const size_t mCapacity;
+    size_t mSize;
+    size_t mStride;
+    size_t mNumberOfAddedSteps;
+    // True if the last entry is the latest step, which is replaced by the next one
+    bool mHasTemporaryEntry;
+    size_t mNumberOfSocValues;
+    std::vector< T > mTimes;
+    std::vector< Matrix > mStates;
+    std::vector< T > mSocValues;
+};
+
+
+template < typename Matrix, typename T >
+StateHistory< Matrix, T >::StateHistory( size_t capacity )
+    : mCapacity( capacity )
+    , mSize( 0 )
+    , mStride( 1 )
+    , mNumberOfAddedSteps( 0 )
+    , mHasTemporaryEntry( false )
+    , mNumberOfSocValues( 0 )
+{
+    if ( mCapacity < 2 )
+        ErrorFunction< std::runtime_error >( __FUNCTION__, __LINE__, __FILE__, "RollbackHistorySizeTooSmall" );
+
+    mTimes.resize( mCapacity );
+    mStates.resize( mCapacity );
+}
+
+template < typename Matrix, typename T >
+void StateHistory< Matrix, T >::Clear()
+{
+    mSize = 0;
+    mStride = 1;
+    mNumberOfAddedSteps = 0;
+    mHasTemporaryEntry = false;
+}
+
+template < typename Matrix, typename T >
+template < typename SocContainer >
+void StateHistory< Matrix, T >::Add( T time, const Matrix &states, const SocContainer &socStates )
+{
+    if ( mNumberOfSocValues != socStates.size() )
+    {
+        mNumberOfSocValues = socStates.size();
+        mSocValues.resize( mCapacity * mNumberOfSocValues );
+    }
+    if ( mHasTemporaryEntry )
+        --mSize;
+    if ( mSize == mCapacity )
+        Thin();
+    mHasTemporaryEntry = mNumberOfAddedSteps % mStride != 0;
+    ++mNumberOfAddedSteps;
+
+    mTimes[mSize] = time;
+    mStates[mSize] = states;
+    for ( size_t i = 0; i < mNumberOfSocValues; ++i )
+        mSocValues[mSize * mNumberOfSocValues + i] = socStates[i]->GetValue();
+
+    ++mSize;
+}
+
+template < typename Matrix, typename T >
+void StateHistory< Matrix, T >::Thin()
+{
+    // Entry 2*i is moved to i, swapping keeps the memory of the dropped states for reuse
+    size_t newSize = 1;
+    for ( size_t i = 2; i < mSize; i += 2, ++newSize )
+    {
+        mTimes[newSize] = mTimes[i];
+        std::swap( mStates[newSize], mStates[i] );
+        std::copy( mSocValues.begin() + i * mNumberOfSocValues, mSocValues.begin() + ( i + 1 ) * mNumberOfSocValues,
+                   mSocValues.begin() + newSize * mNumberOfSocValues );
+    }
+    mSize = newSize;
+    mStride *= 2;
+}
+
+template < typename Matrix, typename T >
+size_t StateHistory< Matrix, T >::GetSize() const
+{
+    return mSize;
+}
+
+template < typename Matrix, typename T >
+size_t StateHistory< Matrix, T >::GetCapacity() const
+{
+    return mCapacity;
+}
+
+template < typename Matrix, typename T >
+T StateHistory< Matrix, T >::GetTime( size_t index ) const
+{
+    return mTimes[index];
+}
+
+template < typename Matrix, typename T >
+const Matrix &StateHistory< Matrix, T >::GetStates( size_t index ) const
+{
+    return mStates[index];
+}
+
+template < typename Matrix, typename T >
+const T *StateHistory< Matrix, T >::GetSocValues( size_t index ) const
+{
+    if ( mSocValues.empty() )
+        return 0;
+    return &mSocValues[index * mNumberOfSocValues];
+}
+
+template < typename Matrix, typename T >
+size_t StateHistory< Matrix, T >::FindIndex( T time ) const
+{
+    const typename std::vector< T >::const_iterator it = std::upper_bound( mTimes.begin(), mTimes.begin() + mSize, time );
+    if ( it == mTimes.begin() )
+        return 0;
+    return static_cast< size_t >( it - mTimes.begin() ) - 1;
+}
+}
+#endif
@@ -152,6 +152,15 @@ class ThermalModel
                                             const AreaStruct &actualArea ) const;
     void CreateAdjacencyMatrices( vector< vector< IndexedAdjacency > > &adjacencyMatrix,
                                   vector< vector< IndexedAdjacency > > &adjacencyMatrixCoolings ) const;
+    /**
+     * Finds the pairs of thermal blocks and cooling blocks whose bounding boxes touch each other. All other pairs can
+     * neither collide nor be adjacent. The pairs are sorted in ascending order with the smaller index first.
+     * @param[out] blockPairs Pairs of indices of two thermal blocks
+     * @param[out] blockCoolingPairs Pairs of the index of a thermal block and the index of a cooling block
+     * @param[out] coolingPairs Pairs of indices of two cooling blocks
+     */
+    void FindCandidatePairs( vector< pair< size_t, size_t > > &blockPairs, vector< pair< size_t, size_t > > &blockCoolingPairs,
+                             vector< pair< size_t, size_t > > &coolingPairs ) const;
     size_t DetermineOdeSystemSize() const;
     void CreateThermalElementVector( size_t odeSystemSize, vector< shared_ptr< ThermalElement< T > > > &thermalElementVector ) const;
     void CreateBlockStartIndices( vector< size_t > &blockStartIndices ) const;
@@ -384,34 +393,40 @@ void ThermalModel< T >::BlocksDimensionTest() const
 template < typename T >
 void ThermalModel< T >::BlocksCollisionTest() const
 {
+    vector< pair< size_t, size_t > > blockPairs;
+    vector< pair< size_t, size_t > > blockCoolingPairs;
+    vector< pair< size_t, size_t > > coolingPairs;
+    FindCandidatePairs( blockPairs, blockCoolingPairs, coolingPairs );
+
+    vector< pair< size_t, size_t > >::const_iterator blockPair = blockPairs.begin();
+    vector< pair< size_t, size_t > >::const_iterator blockCoolingPair = blockCoolingPairs.begin();
     for ( size_t i = 0; i < mBlocks.size(); ++i )
     {
-        for ( size_t j = i + 1; j < mBlocks.size(); ++j )
-            if ( mBlocks[i].mBlockGeometry->CollidesWith( *mBlocks[j].mBlockGeometry, mTolerance ) )
+        for ( ; blockPair != blockPairs.end() && blockPair->first == i; ++blockPair )
+            if ( mBlocks[i].mBlockGeometry->CollidesWith( *mBlocks[blockPair->second].mBlockGeometry, mTolerance ) )
             {
                 ErrorFunction< std::runtime_error >( __FUNCTION__, __LINE__, __FILE__, "CollisionThermalBlocks",
                                                      mBlocks[i].mBlockGeometry->GetDescription(),
-                                                     mBlocks[j].mBlockGeometry->GetDescription() );
+                                                     mBlocks[blockPair->second].mBlockGeometry->GetDescription() );
             }
 
 
-        for ( size_t j = 0; j < mCoolings.size(); ++j )
-            if ( mBlocks[i].mBlockGeometry->CollidesWith( *mCoolings[j].mBlockGeometry, mTolerance ) )
+        for ( ; blockCoolingPair != blockCoolingPairs.end() && blockCoolingPair->first == i; ++blockCoolingPair )
+            if ( mBlocks[i].mBlockGeometry->CollidesWith( *mCoolings[blockCoolingPair->second].mBlockGeometry, mTolerance ) )
             {
                 ErrorFunction< std::runtime_error >( __FUNCTION__, __LINE__, __FILE__, "CollisionThermalCoolingBlocks",
                                                      mBlocks[i].mBlockGeometry->GetDescription(),
-                                                     mCoolings[j].mBlockGeometry->GetDescription() );
+                                                     mCoolings[blockCoolingPair->second].mBlockGeometry->GetDescription() );
             }
     }
 
-    for ( size_t i = 0; i < mCoolings.size(); ++i )
-        for ( size_t j = i + 1; j < mCoolings.size(); ++j )
-            if ( mCoolings[i].mBlockGeometry->CollidesWith( *mCoolings[j].mBlockGeometry, mTolerance ) )
-            {
-                ErrorFunction< std::runtime_error >( __FUNCTION__, __LINE__, __FILE__, "CollisionCoolingBlocks",
-                                                     mCoolings[i].mBlockGeometry->GetDescription(),
-                                                     mCoolings[j].mBlockGeometry->GetDescription() );
-            }
+    for ( size_t k = 0; k < coolingPairs.size(); ++k )
+        if ( mCoolings[coolingPairs[k].first].mBlockGeometry->CollidesWith( *mCoolings[coolingPairs[k].second].mBlockGeometry, mTolerance ) )
+        {
+            ErrorFunction< std::runtime_error >( __FUNCTION__, __LINE__, __FILE__, "CollisionCoolingBlocks",
+                                                 mCoolings[coolingPairs[k].first].mBlockGeometry->GetDescription(),
+                                                 mCoolings[coolingPairs[k].second].mBlockGeometry->GetDescription() );
+        }
 }
 
 template < typename T >
@@ -421,22 +436,62 @@ void ThermalModel< T >::CreateAdjacencyMatrices( vector< vector< IndexedAdjacenc
     adjacencyMatrix.resize( mBlocks.size() );
     adjacencyMatrixCoolings.resize( mBlocks.size() );
 
+    vector< pair< size_t, size_t > > blockPairs;
+    vector< pair< size_t, size_t > > blockCoolingPairs;
+    vector< pair< size_t, size_t > > coolingPairs;
+    FindCandidatePairs( blockPairs, blockCoolingPairs, coolingPairs );
 
-    for ( size_t i = 0; i < mBlocks.size(); ++i )
+    for ( size_t k = 0; k < blockPairs.size(); ++k )
     {
-        for ( size_t j = i + 1; j < mBlocks.size(); ++j )
-        {
-            AdjacencyType adjacencyType = mBlocks[i].mBlockGeometry->IsAdjacentTo( *mBlocks[j].mBlockGeometry, mTolerance );
-            if ( adjacencyType != NOT_ADJACENT )
-                adjacencyMatrix[i].push_back( pair< size_t, AdjacencyType >( j, adjacencyType ) );
-        }
+        const size_t i = blockPairs[k].first;
+        const size_t j = blockPairs[k].second;
+        AdjacencyType adjacencyType = mBlocks[i].mBlockGeometry->IsAdjacentTo( *mBlocks[j].mBlockGeometry, mTolerance );
+        if ( adjacencyType != NOT_ADJACENT )
+            adjacencyMatrix[i].push_back( pair< size_t, AdjacencyType >( j, adjacencyType ) );
+    }
 
-        for ( size_t j = 0; j < mCoolings.size(); ++j )
-        {
-            AdjacencyType adjacencyType = mBlocks[i].mBlockGeometry->IsAdjacentTo( *mCoolings[j].mBlockGeometry, mTolerance );
-            if ( adjacencyType != NOT_ADJACENT )
-                adjacencyMatrixCoolings[i].push_back( pair< size_t, AdjacencyType >( j, adjacencyType ) );
-        }
+    for ( size_t k = 0; k < blockCoolingPairs.size(); ++k )
+    {
+        const size_t i = blockCoolingPairs[k].first;
+        const size_t j = blockCoolingPairs[k].second;
+        AdjacencyType adjacencyType = mBlocks[i].mBlockGeometry->IsAdjacentTo( *mCoolings[j].mBlockGeometry, mTolerance );
+        if ( adjacencyType != NOT_ADJACENT )
+            adjacencyMatrixCoolings[i].push_back( pair< size_t, AdjacencyType >( j, adjacencyType ) );
+    }
+}
+
+template < typename T >
+void ThermalModel< T >::FindCandidatePairs( vector< pair< size_t, size_t > > &blockPairs,
+                                            vector< pair< size_t, size_t > > &blockCoolingPairs,
+                                            vector< pair< size_t, size_t > > &coolingPairs ) const
+{
+    blockPairs.clear();
+    blockCoolingPairs.clear();
+    coolingPairs.clear();
+
+    // Thermal blocks come first, cooling blocks are appended
+    vector< const BlockGeometry< T > * > blockGeometries;
+    blockGeometries.reserve( mBlocks.size() + mCoolings.size() );
+    for ( size_t i = 0; i < mBlocks.size(); ++i )
+        blockGeometries.push_back( mBlocks[i].mBlockGeometry.get() );
+    for ( size_t i = 0; i < mCoolings.size(); ++i )
+        blockGeometries.push_back( mCoolings[i].mBlockGeometry.get() );
+
+    // Adjacency is detected up to the tolerance, so bounding boxes that close are kept as well
+    vector< pair< size_t, size_t > > candidatePairs;
+    FindBoundingBoxCandidatePairs( blockGeometries, 2.0 * mTolerance.mLength, candidatePairs );
+
+    const size_t blockCount = mBlocks.size();
+    for ( size_t k = 0; k < candidatePairs.size(); ++k )
+    {
+        const size_t i = candidatePairs[k].first;
+        const size_t j = candidatePairs[k].second;
+        if ( j < blockCount )
+            blockPairs.push_back( candidatePairs[k] );
+        else if ( i < blockCount )
+            blockCoolingPairs.push_back( pair< size_t, size_t >( i, j - blockCount ) );
+        else
+            coolingPairs.push_back( pair< size_t, size_t >( i - blockCount, j - blockCount ) );
     }
 }
 
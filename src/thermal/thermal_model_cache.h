@@ -0,0 +1,638 @@
+/*
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see http://www.gnu.org/licenses/.
+*/
+#ifndef _THERMAL_MODEL_CACHE_
+#define _THERMAL_MODEL_CACHE_
+
+// STD
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// BOOST
+#include <boost/cstdint.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+// ETC
+#include "thermal_structs.h"
+#include "blocks/elements/restored_element.h"
+#include "boundaryConditions/cooling.h"
+
+#include "../geometry/cartesian.h"
+#include "../misc/StrCont.h"
+#include "../probes/thermal_probe.h"
+#include "../states/thermal_state.h"
+#include "../exceptions/error_proto.h"
+
+
+class TestThermalModelCache;
+
+namespace thermal
+{
+
+/**
+ * ThermalModelCache saves the fused thermal model into a binary file and loads it again, so that runs with an unchanged
+ * thermal part of the xml-file skip the discretization of the thermal blocks and ThermalModel, i.e. the adjacency and
+ * collision tests of the blocks, the fusing of the conductivity matrix, the aggregation of the surface areas for cooling
+ * and the search of the probes.
+ * The file holds the grid vertex, volume, initial temperature, material and thermal state of every thermal element, so
+ * that they are restored as RestoredElement, the conductivity matrix in CSR format, the cooling and Dirichlet data of
+ * every element, the topology for the thermal visualizer and the thermal elements of the probes. Pointers are stored as
+ * indices, materials and thermal states as indices into the materials and thermal states of the thermal blocks.
+ * The file starts with a header and the description of the thermal model, all following arrays are aligned to 8 bytes,
+ * so the file is memory mapped and read in place when it is loaded. The description is compared on loading, so a
+ * collision of the keys of two descriptions does not load the wrong model.
+ */
+template < typename T = double >
+class ThermalModelCache
+{
+    friend class ::TestThermalModelCache;
+
+    public:
+    /// Returns the key of the thermal model described by description, which is its 64 bit FNV-1a hash
+    static boost::uint64_t CreateKey( const std::string &description );
+    /// Returns the name of the cache file for key inside directory
+    static std::string CreateFileName( const std::string &directory, boost::uint64_t key );
+    /**
+     * Writes the fused thermal model into fileName. The file is written under a temporary name and renamed afterwards,
+     * so that runs in parallel never load a partly written file. Nothing is written if a thermal element refers to a
+     * material or thermal state that is not part of materials or thermalStates.
+     * @param[in] description Description of the thermal model, which is stored with its key
+     * @param[in] materials Materials that the thermal elements refer to
+     * @param[in] thermalStates Thermal states that the thermal elements refer to
+     * @param[in] coolings Coolings that mCooling of coolingDataVector and dirichletDataVector points to
+     * @param[in] thermalProbes Probes that have been connected to thermal elements
+     */
+    static void Save( const std::string &fileName, const std::string &description,
+                      const std::vector< const Material< T > * > &materials,
+                      const std::vector< ::state::ThermalState< T > * > &thermalStates,
+                      const std::vector< boost::shared_ptr< ThermalElement< T > > > &thermalElements,
+                      const std::vector< std::vector< IndexedValue< T > > > &conductivityMatrix,
+                      const std::vector< std::vector< TaylorData< T > > > &coolingDataVector,
+                      const std::vector< std::vector< TaylorData< T > > > &dirichletDataVector,
+                      const std::vector< Cooling< T > * > &coolings, const std::vector< ThermalElement< T > * > &thermalElementsOfAreas,
+                      const std::vector< std::vector< size_t > > &areas, const std::vector< std::vector< size_t > > &volumes,
+                      const std::vector< misc::StrCont > &volumeNames, const std::vector< geometry::Cartesian< T > > &vertices,
+                      const std::vector< ::probe::ThermalProbe > &thermalProbes );
+    /**
+     * Reads the fused thermal model from fileName and restores the thermal elements
+     * @param[in] description Description of the thermal model, which has to be equal to the one passed to Save
+     * @param[in] materials Materials in the same order as they have been passed to Save
+     * @param[in] thermalStates Thermal states in the same order as they have been passed to Save, the restored thermal
+     * elements add their temperature to them
+     * @param[out] thermalElements Restored thermal elements in the order of ThermalModel::CreateDataByFusingBlocks
+     * @param[in] coolings Coolings in the same order as they have been passed to Save
+     * @param[in,out] thermalProbes Probes that are connected to thermal elements
+     * @return False if the file does not exist, has been written for another description or format or does not fit
+     * materials, thermalStates or coolings. In this case no output parameter is changed.
+     */
+    static bool Load( const std::string &fileName, const std::string &description,
+                      const std::vector< const Material< T > * > &materials,
+                      const std::vector< ::state::ThermalState< T > * > &thermalStates,
+                      std::vector< boost::shared_ptr< ThermalElement< T > > > &thermalElements,
+                      std::vector< std::vector< IndexedValue< T > > > &conductivityMatrix,
+                      std::vector< std::vector< TaylorData< T > > > &coolingDataVector,
+                      std::vector< std::vector< TaylorData< T > > > &dirichletDataVector,
+                      const std::vector< Cooling< T > * > &coolings, std::vector< ThermalElement< T > * > &thermalElementsOfAreas,
+                      std::vector< std::vector< size_t > > &areas, std::vector< std::vector< size_t > > &volumes,
+                      std::vector< misc::StrCont > &volumeNames, std::vector< geometry::Cartesian< T > > &vertices,
+                      std::vector< ::probe::ThermalProbe > &thermalProbes );
+
+    private:
+    static const boost::uint64_t MAGIC_NUMBER = 0x45484341434d5449ULL;    // "ITMCACHE"
+    static const boost::uint64_t FORMAT_VERSION = 3;
+    static const boost::uint64_t NO_INDEX = ~static_cast< boost::uint64_t >( 0 );
+
+    struct Header
+    {
+        boost::uint64_t mMagicNumber;
+        boost::uint64_t mFormatVersion;
+        boost::uint64_t mSizeOfValue;
+        boost::uint64_t mKey;
+        boost::uint64_t mNumberOfThermalElements;
+        boost::uint64_t mNumberOfMaterials;
+        boost::uint64_t mNumberOfThermalStates;
+    };
+    /// ThermalElement with its material and thermal state as indices
+    struct ElementRecord
+    {
+        T mGridVertex[3];
+        T mVolume;
+        T mInitialTemperature;
+        T mThermalStateFactor;
+        boost::uint64_t mMaterialIndex;
+        boost::uint64_t mThermalStateIndex;
+    };
+    /// TaylorData without pointer
+    struct BoundaryRecord
+    {
+        T mCharacteristicLength;
+        T mA_cool;
+        T mTempSurfLastStep;
+        T mConductivity;
+        T mDistanceToGridVertex;
+        boost::uint64_t mLocation;
+        boost::uint64_t mCoolingIndex;
+    };
+    /// Array inside the mapped file
+    template < typename U >
+    struct ArrayView
+    {
+        const U *mData;
+        size_t mSize;
+    };
+
+    template < typename U >
+    static void WriteArray( std::ofstream &file, const std::vector< U > &array );
+    /// Returns false if the array does not fit between position and end
+    template < typename U >
+    static bool ReadArray( const char *&position, const char *end, ArrayView< U > &array );
+    /// Appends each vector of values as one row in CSR format
+    template < typename U >
+    static void AppendRows( const std::vector< std::vector< U > > &rows, std::vector< boost::uint64_t > &offsets );
+    static void WriteBoundaryData( std::ofstream &file, const std::vector< std::vector< TaylorData< T > > > &boundaryDataVector,
+                                   const std::map< const Cooling< T > *, boost::uint64_t > &coolingIndices, bool isDirichlet );
+    /// Returns true if offsets describe numberOfRows rows of numberOfEntries entries
+    static bool IsValidCsr( const ArrayView< boost::uint64_t > &offsets, size_t numberOfRows, size_t numberOfEntries );
+    /// Returns true if all indices are smaller than limit
+    static bool AreValidIndices( const ArrayView< boost::uint64_t > &indices, boost::uint64_t limit );
+    static bool AreValidRecords( const ArrayView< BoundaryRecord > &records, size_t numberOfCoolings );
+    static bool AreValidRecords( const ArrayView< ElementRecord > &records, size_t numberOfMaterials, size_t numberOfThermalStates );
+    /// Returns the index of every pointer, a pointer that occurs more than once gets its first index
+    template < typename U >
+    static std::map< const U *, boost::uint64_t > CreateIndices( const std::vector< U * > &pointers );
+};
+
+
+template < typename T >
+const boost::uint64_t ThermalModelCache< T >::MAGIC_NUMBER;
+template < typename T >
+const boost::uint64_t ThermalModelCache< T >::FORMAT_VERSION;
+template < typename T >
+const boost::uint64_t ThermalModelCache< T >::NO_INDEX;
+
+template < typename T >
+boost::uint64_t ThermalModelCache< T >::CreateKey( const std::string &description )
+{
+    boost::uint64_t key = 14695981039346656037ULL;
+    for ( size_t i = 0; i < description.size(); ++i )
+    {
+        key ^= static_cast< unsigned char >( description[i] );
+        key *= 1099511628211ULL;
+    }
+    return key;
+}
+
+template < typename T >
+std::string ThermalModelCache< T >::CreateFileName( const std::string &directory, boost::uint64_t key )
+{
+    std::ostringstream fileName;
+    fileName << directory;
+    if ( !directory.empty() && directory[directory.size() - 1] != '/' && directory[directory.size() - 1] != '\\' )
+        fileName << '/';
+    fileName << "thermalModel_" << std::hex;
+    fileName.width( 16 );
+    fileName.fill( '0' );
+    fileName << key << ".bin";
+    return fileName.str();
+}
+
+template < typename T >
+void ThermalModelCache< T >::Save( const std::string &fileName, const std::string &description,
+                                   const std::vector< const Material< T > * > &materials,
+                                   const std::vector< ::state::ThermalState< T > * > &thermalStates,
+                                   const std::vector< boost::shared_ptr< ThermalElement< T > > > &thermalElements,
+                                   const std::vector< std::vector< IndexedValue< T > > > &conductivityMatrix,
+                                   const std::vector< std::vector< TaylorData< T > > > &coolingDataVector,
+                                   const std::vector< std::vector< TaylorData< T > > > &dirichletDataVector,
+                                   const std::vector< Cooling< T > * > &coolings,
+                                   const std::vector< ThermalElement< T > * > &thermalElementsOfAreas,
+                                   const std::vector< std::vector< size_t > > &areas,
+                                   const std::vector< std::vector< size_t > > &volumes,
+                                   const std::vector< misc::StrCont > &volumeNames,
+                                   const std::vector< geometry::Cartesian< T > > &vertices,
+                                   const std::vector< ::probe::ThermalProbe > &thermalProbes )
+{
+    // Thermal elements
+    const std::map< const Material< T > *, boost::uint64_t > materialIndices = CreateIndices( materials );
+    const std::map< const ::state::ThermalState< T > *, boost::uint64_t > thermalStateIndices = CreateIndices( thermalStates );
+    std::map< const ThermalElement< T > *, boost::uint64_t > elementIndices;
+    std::vector< ElementRecord > elementRecords;
+    elementRecords.reserve( thermalElements.size() );
+    for ( size_t i = 0; i < thermalElements.size(); ++i )
+    {
+        const ThermalElement< T > &thermalElement = *thermalElements[i];
+        typename std::map< const Material< T > *, boost::uint64_t >::const_iterator material =
+         materialIndices.find( thermalElement.GetMaterial() );
+        typename std::map< const ::state::ThermalState< T > *, boost::uint64_t >::const_iterator thermalState =
+         thermalStateIndices.find( thermalElement.GetThermalState() );
+        if ( material == materialIndices.end() ||
+             ( thermalElement.HasThermalState() && thermalState == thermalStateIndices.end() ) )
+            return;
+
+        elementIndices[&thermalElement] = i;
+        const ElementRecord record = {{thermalElement.GetGridVertex().GetX(), thermalElement.GetGridVertex().GetY(),
+                                       thermalElement.GetGridVertex().GetZ()},
+                                      thermalElement.GetVolume(),
+                                      thermalElement.GetTemperature(),
+                                      thermalElement.GetThermalStateFactor(),
+                                      material->second,
+                                      thermalElement.HasThermalState() ? thermalState->second : NO_INDEX};
+        elementRecords.push_back( record );
+    }
+
+    const std::string temporaryFileName = fileName + ".tmp";
+    std::ofstream file( temporaryFileName.c_str(), std::ios::out | std::ios::binary | std::ios::trunc );
+    if ( !file )
+        ErrorFunction< std::runtime_error >( __FUNCTION__, __LINE__, __FILE__, "ThermalModelCacheNotWritable", fileName.c_str() );
+
+    const Header header = {MAGIC_NUMBER, FORMAT_VERSION, sizeof( T ), CreateKey( description ), thermalElements.size(),
+                           materials.size(), thermalStates.size()};
+    file.write( reinterpret_cast< const char * >( &header ), sizeof( header ) );
+    WriteArray( file, std::vector< char >( description.begin(), description.end() ) );
+    WriteArray( file, elementRecords );
+
+    // Conductivity matrix
+    std::vector< boost::uint64_t > offsets;
+    AppendRows( conductivityMatrix, offsets );
+    std::vector< boost::uint64_t > indices;
+    std::vector< T > values;
+    indices.reserve( offsets.back() );
+    values.reserve( offsets.back() );
+    for ( size_t i = 0; i < conductivityMatrix.size(); ++i )
+        for ( size_t j = 0; j < conductivityMatrix[i].size(); ++j )
+        {
+            indices.push_back( conductivityMatrix[i][j].mIndex );
+            values.push_back( conductivityMatrix[i][j].mValue );
+        }
+    WriteArray( file, offsets );
+    WriteArray( file, indices );
+    WriteArray( file, values );
+
+    // Cooling and Dirichlet data
+    const std::map< const Cooling< T > *, boost::uint64_t > coolingIndices = CreateIndices( coolings );
+    WriteBoundaryData( file, coolingDataVector, coolingIndices, false );
+    WriteBoundaryData( file, dirichletDataVector, coolingIndices, true );
+
+    // Visualization
+    indices.clear();
+    for ( size_t i = 0; i < thermalElementsOfAreas.size(); ++i )
+        indices.push_back( elementIndices.find( thermalElementsOfAreas[i] )->second );
+    WriteArray( file, indices );
+    offsets.clear();
+    AppendRows( areas, offsets );
+    WriteArray( file, offsets );
+    indices.clear();
+    for ( size_t i = 0; i < areas.size(); ++i )
+        indices.insert( indices.end(), areas[i].begin(), areas[i].end() );
+    WriteArray( file, indices );
+    offsets.clear();
+    AppendRows( volumes, offsets );
+    WriteArray( file, offsets );
+    indices.clear();
+    for ( size_t i = 0; i < volumes.size(); ++i )
+        indices.insert( indices.end(), volumes[i].begin(), volumes[i].end() );
+    WriteArray( file, indices );
+    offsets.assign( 1, 0 );
+    std::vector< char > names;
+    for ( size_t i = 0; i < volumeNames.size(); ++i )
+    {
+        const char *name = volumeNames[i];
+        names.insert( names.end(), name, name + strlen( name ) );
+        offsets.push_back( names.size() );
+    }
+    WriteArray( file, offsets );
+    WriteArray( file, names );
+    values.clear();
+    for ( size_t i = 0; i < vertices.size(); ++i )
+    {
+        values.push_back( vertices[i].GetX() );
+        values.push_back( vertices[i].GetY() );
+        values.push_back( vertices[i].GetZ() );
+    }
+    WriteArray( file, values );
+
+    // Probes
+    indices.clear();
+    for ( size_t i = 0; i < thermalProbes.size(); ++i )
+        indices.push_back( elementIndices.find( thermalProbes[i].GetCorrespondingThermalElement() )->second );
+    WriteArray( file, indices );
+
+    file.close();
+    if ( file.fail() )
+        ErrorFunction< std::runtime_error >( __FUNCTION__, __LINE__, __FILE__, "ThermalModelCacheNotWritable", fileName.c_str() );
+    std::remove( fileName.c_str() );
+    if ( std::rename( temporaryFileName.c_str(), fileName.c_str() ) != 0 )
+        ErrorFunction< std::runtime_error >( __FUNCTION__, __LINE__, __FILE__, "ThermalModelCacheNotWritable", fileName.c_str() );
+}
+
+template < typename T >
+bool ThermalModelCache< T >::Load( const std::string &fileName, const std::string &description,
+                                   const std::vector< const Material< T > * > &materials,
+                                   const std::vector< ::state::ThermalState< T > * > &thermalStates,
+                                   std::vector< boost::shared_ptr< ThermalElement< T > > > &thermalElements,
+                                   std::vector< std::vector< IndexedValue< T > > > &conductivityMatrix,
+                                   std::vector< std::vector< TaylorData< T > > > &coolingDataVector,
+                                   std::vector< std::vector< TaylorData< T > > > &dirichletDataVector,
+                                   const std::vector< Cooling< T > * > &coolings,
+                                   std::vector< ThermalElement< T > * > &thermalElementsOfAreas,
+                                   std::vector< std::vector< size_t > > &areas, std::vector< std::vector< size_t > > &volumes,
+                                   std::vector< misc::StrCont > &volumeNames, std::vector< geometry::Cartesian< T > > &vertices,
+                                   std::vector< ::probe::ThermalProbe > &thermalProbes )
+{
+    // Mapping an empty or missing file throws, so both are checked before
+    {
+        std::ifstream file( fileName.c_str(), std::ios::in | std::ios::binary | std::ios::ate );
+        if ( !file || file.tellg() < static_cast< std::streamoff >( sizeof( Header ) ) )
+            return false;
+    }
+
+    boost::interprocess::file_mapping mapping( fileName.c_str(), boost::interprocess::read_only );
+    boost::interprocess::mapped_region region( mapping, boost::interprocess::read_only );
+    const char *position = static_cast< const char * >( region.get_address() );
+    const char *end = position + region.get_size();
+
+    const Header &header = *reinterpret_cast< const Header * >( position );
+    position += sizeof( Header );
+    if ( header.mMagicNumber != MAGIC_NUMBER || header.mFormatVersion != FORMAT_VERSION ||
+         header.mSizeOfValue != sizeof( T ) || header.mKey != CreateKey( description ) ||
+         header.mNumberOfMaterials != materials.size() || header.mNumberOfThermalStates != thermalStates.size() )
+        return false;
+    ArrayView< char > storedDescription;
+    if ( !ReadArray( position, end, storedDescription ) || storedDescription.mSize != description.size() ||
+         !std::equal( description.begin(), description.end(), storedDescription.mData ) )
+        return false;
+    const size_t numberOfElements = header.mNumberOfThermalElements;
+
+    ArrayView< ElementRecord > elementRecords;
+    ArrayView< boost::uint64_t > conductivityOffsets, conductivityIndices, coolingOffsets, dirichletOffsets;
+    ArrayView< T > conductivityValues;
+    ArrayView< BoundaryRecord > coolingRecords, dirichletRecords;
+    ArrayView< boost::uint64_t > areaElements, areaOffsets, areaVertices, volumeOffsets, volumeAreas, nameOffsets, probeElements;
+    ArrayView< char > names;
+    ArrayView< T > vertexData;
+    if ( !ReadArray( position, end, elementRecords ) || !ReadArray( position, end, conductivityOffsets ) ||
+         !ReadArray( position, end, conductivityIndices ) || !ReadArray( position, end, conductivityValues ) ||
+         !ReadArray( position, end, coolingOffsets ) || !ReadArray( position, end, coolingRecords ) ||
+         !ReadArray( position, end, dirichletOffsets ) || !ReadArray( position, end, dirichletRecords ) ||
+         !ReadArray( position, end, areaElements ) || !ReadArray( position, end, areaOffsets ) ||
+         !ReadArray( position, end, areaVertices ) || !ReadArray( position, end, volumeOffsets ) ||
+         !ReadArray( position, end, volumeAreas ) || !ReadArray( position, end, nameOffsets ) ||
+         !ReadArray( position, end, names ) || !ReadArray( position, end, vertexData ) ||
+         !ReadArray( position, end, probeElements ) )
+        return false;
+
+    // The whole file is checked before any output parameter is touched
+    if ( elementRecords.mSize != numberOfElements ||
+         !AreValidRecords( elementRecords, materials.size(), thermalStates.size() ) || conductivityIndices.mSize != conductivityValues.mSize ||
+         !IsValidCsr( conductivityOffsets, numberOfElements, conductivityIndices.mSize ) ||
+         !AreValidIndices( conductivityIndices, numberOfElements ) ||
+         !IsValidCsr( coolingOffsets, numberOfElements, coolingRecords.mSize ) ||
+         !AreValidRecords( coolingRecords, coolings.size() ) ||
+         !IsValidCsr( dirichletOffsets, numberOfElements, dirichletRecords.mSize ) ||
+         !AreValidRecords( dirichletRecords, coolings.size() ) || !AreValidIndices( areaElements, numberOfElements ) ||
+         !IsValidCsr( areaOffsets, areaElements.mSize, areaVertices.mSize ) || vertexData.mSize % 3 != 0 ||
+         !IsValidCsr( volumeOffsets, volumeOffsets.mSize ? volumeOffsets.mSize - 1 : 0, volumeAreas.mSize ) ||
+         !IsValidCsr( nameOffsets, volumeOffsets.mSize ? volumeOffsets.mSize - 1 : 0, names.mSize ) ||
+         probeElements.mSize != thermalProbes.size() || !AreValidIndices( probeElements, numberOfElements ) )
+        return false;
+    // Vertices and areas are counted from one by the thermal visualizer
+    for ( size_t i = 0; i < areaVertices.mSize; ++i )
+        if ( areaVertices.mData[i] == 0 || areaVertices.mData[i] > vertexData.mSize / 3 )
+            return false;
+    for ( size_t i = 0; i < volumeAreas.mSize; ++i )
+        if ( volumeAreas.mData[i] == 0 || volumeAreas.mData[i] > areaElements.mSize )
+            return false;
+
+    // Thermal elements
+    thermalElements.clear();
+    thermalElements.reserve( numberOfElements );
+    for ( size_t i = 0; i < numberOfElements; ++i )
+    {
+        const ElementRecord &record = elementRecords.mData[i];
+        thermalElements.push_back( boost::shared_ptr< ThermalElement< T > >( new RestoredElement< T >(
+         geometry::Cartesian< T >( record.mGridVertex[0], record.mGridVertex[1], record.mGridVertex[2] ), record.mVolume,
+         record.mInitialTemperature, materials[record.mMaterialIndex],
+         record.mThermalStateIndex == NO_INDEX ? 0 : thermalStates[record.mThermalStateIndex], record.mThermalStateFactor ) ) );
+    }
+
+    // Conductivity matrix
+    conductivityMatrix.clear();
+    conductivityMatrix.resize( numberOfElements );
+    for ( size_t i = 0; i < numberOfElements; ++i )
+    {
+        conductivityMatrix[i].reserve( conductivityOffsets.mData[i + 1] - conductivityOffsets.mData[i] );
+        for ( size_t j = conductivityOffsets.mData[i]; j < conductivityOffsets.mData[i + 1]; ++j )
+            conductivityMatrix[i].push_back( MakeIndexedValue< T >( conductivityIndices.mData[j], conductivityValues.mData[j] ) );
+    }
+
+    // Cooling and Dirichlet data
+    const ArrayView< boost::uint64_t > *boundaryOffsets[] = {&coolingOffsets, &dirichletOffsets};
+    const ArrayView< BoundaryRecord > *boundaryRecords[] = {&coolingRecords, &dirichletRecords};
+    std::vector< std::vector< TaylorData< T > > > *boundaryDataVectors[] = {&coolingDataVector, &dirichletDataVector};
+    for ( size_t k = 0; k < 2; ++k )
+    {
+        std::vector< std::vector< TaylorData< T > > > &boundaryDataVector = *boundaryDataVectors[k];
+        boundaryDataVector.clear();
+        boundaryDataVector.resize( numberOfElements );
+        for ( size_t i = 0; i < numberOfElements; ++i )
+        {
+            boundaryDataVector[i].reserve( boundaryOffsets[k]->mData[i + 1] - boundaryOffsets[k]->mData[i] );
+            for ( size_t j = boundaryOffsets[k]->mData[i]; j < boundaryOffsets[k]->mData[i + 1]; ++j )
+            {
+                const BoundaryRecord &record = boundaryRecords[k]->mData[j];
+                TaylorData< T > data;
+                data.mCharacteristicLength = record.mCharacteristicLength;
+                data.mA_cool = record.mA_cool;
+                data.mTempSurfLastStep = record.mTempSurfLastStep;
+                data.mLocation = static_cast< geometry::Location >( record.mLocation );
+                data.mConductivity = record.mConductivity;
+                data.mDistanceToGridVertex = record.mDistanceToGridVertex;
+                data.mCooling = record.mCoolingIndex == NO_INDEX ? 0 : coolings[record.mCoolingIndex];
+                boundaryDataVector[i].push_back( data );
+            }
+        }
+    }
+
+    // Visualization
+    thermalElementsOfAreas.clear();
+    thermalElementsOfAreas.reserve( areaElements.mSize );
+    for ( size_t i = 0; i < areaElements.mSize; ++i )
+        thermalElementsOfAreas.push_back( thermalElements[areaElements.mData[i]].get() );
+    areas.clear();
+    areas.resize( areaElements.mSize );
+    for ( size_t i = 0; i < areas.size(); ++i )
+        areas[i].assign( areaVertices.mData + areaOffsets.mData[i], areaVertices.mData + areaOffsets.mData[i + 1] );
+    volumes.clear();
+    volumes.resize( volumeOffsets.mSize - 1 );
+    volumeNames.clear();
+    volumeNames.reserve( volumes.size() );
+    for ( size_t i = 0; i < volumes.size(); ++i )
+    {
+        volumes[i].assign( volumeAreas.mData + volumeOffsets.mData[i], volumeAreas.mData + volumeOffsets.mData[i + 1] );
+        const std::string name( names.mData + nameOffsets.mData[i], names.mData + nameOffsets.mData[i + 1] );
+        volumeNames.push_back( misc::StrCont( name.c_str() ) );
+    }
+    vertices.clear();
+    vertices.reserve( vertexData.mSize / 3 );
+    for ( size_t i = 0; i < vertexData.mSize; i += 3 )
+        vertices.push_back( geometry::Cartesian< T >( vertexData.mData[i], vertexData.mData[i + 1], vertexData.mData[i + 2] ) );
+
+    // Probes
+    for ( size_t i = 0; i < thermalProbes.size(); ++i )
+        thermalProbes[i].SetCorrespondingThermalElement( thermalElements[probeElements.mData[i]] );
+
+    return true;
+}
+
+template < typename T >
+template < typename U >
+void ThermalModelCache< T >::WriteArray( std::ofstream &file, const std::vector< U > &array )
+{
+    const boost::uint64_t size = array.size();
+    file.write( reinterpret_cast< const char * >( &size ), sizeof( size ) );
+    if ( !array.empty() )
+        file.write( reinterpret_cast< const char * >( &array[0] ), array.size() * sizeof( U ) );
+
+    const char padding[8] = {0};
+    const size_t remainder = ( array.size() * sizeof( U ) ) % 8;
+    if ( remainder )
+        file.write( padding, 8 - remainder );
+}
+
+template < typename T >
+template < typename U >
+bool ThermalModelCache< T >::ReadArray( const char *&position, const char *end, ArrayView< U > &array )
+{
+    if ( static_cast< size_t >( end - position ) < sizeof( boost::uint64_t ) )
+        return false;
+    const boost::uint64_t size = *reinterpret_cast< const boost::uint64_t * >( position );
+    position += sizeof( boost::uint64_t );
+
+    const size_t available = static_cast< size_t >( end - position );
+    if ( size > available / sizeof( U ) )
+        return false;
+    array.mData = reinterpret_cast< const U * >( position );
+    array.mSize = size;
+
+    const size_t bytes = ( ( size * sizeof( U ) + 7 ) / 8 ) * 8;
+    if ( bytes > available )
+        return false;
+    position += bytes;
+    return true;
+}
+
+template < typename T >
+template < typename U >
+void ThermalModelCache< T >::AppendRows( const std::vector< std::vector< U > > &rows, std::vector< boost::uint64_t > &offsets )
+{
+    offsets.reserve( offsets.size() + rows.size() + 1 );
+    offsets.push_back( 0 );
+    for ( size_t i = 0; i < rows.size(); ++i )
+        offsets.push_back( offsets.back() + rows[i].size() );
+}
+
+template < typename T >
+void ThermalModelCache< T >::WriteBoundaryData( std::ofstream &file, const std::vector< std::vector< TaylorData< T > > > &boundaryDataVector,
+                                                const std::map< const Cooling< T > *, boost::uint64_t > &coolingIndices,
+                                                bool isDirichlet )
+{
+    std::vector< boost::uint64_t > offsets;
+    AppendRows( boundaryDataVector, offsets );
+    std::vector< BoundaryRecord > records;
+    records.reserve( offsets.back() );
+    for ( size_t i = 0; i < boundaryDataVector.size(); ++i )
+        for ( size_t j = 0; j < boundaryDataVector[i].size(); ++j )
+        {
+            const TaylorData< T > &data = boundaryDataVector[i][j];
+            // mTempSurfLastStep is only set for Dirichlet boundary conditions at this point
+            const BoundaryRecord record = {data.mCharacteristicLength,
+                                           data.mA_cool,
+                                           isDirichlet ? data.mTempSurfLastStep : 0.0,
+                                           data.mConductivity,
+                                           data.mDistanceToGridVertex,
+                                           static_cast< boost::uint64_t >( data.mLocation ),
+                                           data.mCooling ? coolingIndices.find( data.mCooling )->second : NO_INDEX};
+            records.push_back( record );
+        }
+    WriteArray( file, offsets );
+    WriteArray( file, records );
+}
+
+template < typename T >
+bool ThermalModelCache< T >::IsValidCsr( const ArrayView< boost::uint64_t > &offsets, size_t numberOfRows, size_t numberOfEntries )
+{
+    if ( offsets.mSize != numberOfRows + 1 || offsets.mData[0] != 0 || offsets.mData[numberOfRows] != numberOfEntries )
+        return false;
+    for ( size_t i = 0; i < numberOfRows; ++i )
+        if ( offsets.mData[i] > offsets.mData[i + 1] )
+            return false;
+    return true;
+}
+
+template < typename T >
+bool ThermalModelCache< T >::AreValidIndices( const ArrayView< boost::uint64_t > &indices, boost::uint64_t limit )
+{
+    for ( size_t i = 0; i < indices.mSize; ++i )
+        if ( indices.mData[i] >= limit )
+            return false;
+    return true;
+}
+
+template < typename T >
+bool ThermalModelCache< T >::AreValidRecords( const ArrayView< BoundaryRecord > &records, size_t numberOfCoolings )
+{
+    for ( size_t i = 0; i < records.mSize; ++i )
+        if ( records.mData[i].mLocation > geometry::BOTTOM ||
+             ( records.mData[i].mCoolingIndex >= numberOfCoolings && records.mData[i].mCoolingIndex != NO_INDEX ) )
+            return false;
+    return true;
+}
+
+template < typename T >
+bool ThermalModelCache< T >::AreValidRecords( const ArrayView< ElementRecord > &records, size_t numberOfMaterials,
+                                              size_t numberOfThermalStates )
+{
+    // The checks of ThermalElement::SetElement() and ThermalState::AddTemperature() are done here, so that restoring
+    // the thermal elements does not throw
+    for ( size_t i = 0; i < records.mSize; ++i )
+    {
+        const ElementRecord &record = records.mData[i];
+        if ( record.mMaterialIndex >= numberOfMaterials ||
+             ( record.mThermalStateIndex >= numberOfThermalStates && record.mThermalStateIndex != NO_INDEX ) ||
+             !( record.mVolume >= 0.0 ) || !( record.mThermalStateFactor > 0.0 ) || record.mThermalStateFactor > 1.0 )
+            return false;
+    }
+    return true;
+}
+
+template < typename T >
+template < typename U >
+std::map< const U *, boost::uint64_t > ThermalModelCache< T >::CreateIndices( const std::vector< U * > &pointers )
+{
+    std::map< const U *, boost::uint64_t > indices;
+    for ( size_t i = pointers.size(); i > 0; --i )
+        indices[pointers[i - 1]] = i - 1;
+    return indices;
+}
+}
+#endif
@@ -16,9 +16,24 @@ along with this program.  If not, see http://www.gnu.org/licenses/.
 #define _THERMAL_SIMULATION_
 
 
+#include <set>
+#include <sstream>
 #include <boost/scoped_ptr.hpp>
 #include <boost/shared_ptr.hpp>
 #include <boost/pointer_cast.hpp>
+#ifdef __EXCEPTIONS__
+#include <boost/exception_ptr.hpp>
+#endif
+
+#ifdef _MSC_VER
+#pragma warning( push )
+#pragma warning( disable : 4018 )
+#endif
+#include <boost/numeric/odeint.hpp>
+#include <boost/ref.hpp>
+#ifdef _MSC_VER
+#pragma warning( pop )
+#endif
 
 #include "../factory/thermal/thermal_factory.h"
 #include "../factory/thermal/materialfactorybuilder.h"
@@ -30,13 +45,19 @@ along with this program.  If not, see http://www.gnu.org/licenses/.
 #include "../factory/state/statefactorybuilder.h"
 
 #include "../exceptions/error_proto.h"
+#include "../misc/macros.h"
 
 #include "../thermal/blocks/thermal_block.h"
 #include "../thermal/ode_system_thermal.h"
+#include "../thermal/reduced_ode_system_thermal.h"
+#include "../thermal/rosenbrock_stepper_thermal.h"
 #include "../thermal/thermal_model.h"
+#include "../thermal/thermal_model_cache.h"
+#include "../threading/threaded_for_loop.h"
 #include "../time_series/time_series.h"
 
 class TestSimulation;
+class TestThermalSimulation;
 
 namespace simulation
 {
@@ -45,6 +66,7 @@ template < typename Matrix, typename T, bool FilterTypeChoice >
 class ThermalSimulation
 {
     friend class ::TestSimulation;
+    friend class ::TestThermalSimulation;
 
     public:
     /**
@@ -75,6 +97,11 @@ class ThermalSimulation
     void InitializeStopCriterion();
     /// Returns true if thermal state stop criterion is met
     bool IsStopCriterionFulfilled() const;
+    /// Returns the temperature change in degree C that ends a simulation step
+    T GetThermalStateStopCriterion() const;
+    /// Tries one step of the thermal equation solver chosen in Options/ThermalSolver, returns true if the step has been
+    /// accepted. mTemperatures, mTime and mDeltaTime are updated like by the odeint steppers.
+    bool TryThermalStep();
 
     // Internal data
     std::vector< boost::shared_ptr< ThermalState< T > > > mThermalStates;
@@ -85,6 +112,10 @@ class ThermalSimulation
     std::vector< ::probe::ThermalProbe > mThermalProbes;
     // Thermal system with states
     boost::scoped_ptr< thermal::OdeSystemThermal< T > > mThermalSystem;
+#if defined( _EIGEN_ ) || defined( USE_EIGEN )
+    // Only created if ReducedThermalOrder has been set in the options, mTemperatures is its reduced state then
+    boost::scoped_ptr< thermal::ReducedOdeSystemThermal< T > > mReducedThermalSystem;
+#endif
     vector< T > mTemperatures;
     // Simulation times
     T mTime;
@@ -92,6 +123,34 @@ class ThermalSimulation
     T mDeltaTime;
 
     private:
+    /// Discretized data of a thermal block, which is created independently of the other blocks
+    struct ThermalBlockData
+    {
+        std::vector< boost::shared_ptr< thermal::ThermalElement< T > > > mThermalElements;
+        std::vector< std::vector< thermal::IndexedValue< T > > > mConductivityMatrix;
+        std::vector< thermal::IndexedArea< T > > mSurfaceElements;
+        std::vector< thermal::IndexedInnerArea< T > > mInnerSurfaceElements;
+        boost::shared_ptr< thermal::BlockGeometry< T > > mBlockGeometry;
+        misc::StrCont mDescription;
+    };
+    /// Discretizes blocks into blockData, on numberOfThreads threads if there is more than one
+    static void CreateThermalBlockData( const std::vector< thermal::ThermalBlock< T > * > &blocks, bool showLateralSurfaces,
+                                        size_t numberOfThreads, std::vector< ThermalBlockData > &blockData );
+    static void CreateThermalBlockData( thermal::ThermalBlock< T > &block, bool showLateralSurfaces, ThermalBlockData &blockData );
+#ifdef BOOST_THREAD
+    struct ThermalBlockDataFunctor : public threading::ThreadedForLoop::LoopFunctorInterface
+    {
+        virtual void Iterate( size_t i );
+        const std::vector< thermal::ThermalBlock< T > * > *mBlocks;
+        std::vector< ThermalBlockData > *mBlockData;
+        bool mShowLateralSurfaces;
+#ifdef __EXCEPTIONS__
+        // Errors are rethrown in the calling thread, the one of the first block in case of several
+        std::vector< boost::exception_ptr > mExceptions;
+#endif
+    };
+#endif
+
     T mLastUnconstrainedDeltaTime;
     T mSimulationDuration;
     // Thermal state stop criterion
@@ -100,6 +159,12 @@ class ThermalSimulation
     geometry::Tolerance< T > mTolerance;
     // TemperatureHeatProfiles
     boost::scoped_ptr< electrical::TimeSeries< T, electrical::EvalLinearInterpolation > > mAirTemperaturesData;
+    // Equation solvers, mRosenbrockStepper is only created if it has been chosen in the options
+    typename boost::numeric::odeint::result_of::make_controlled<
+     boost::numeric::odeint::runge_kutta_cash_karp54< vector< T > > >::type mRungeKuttaStepper;
+#if defined( _EIGEN_ ) || defined( USE_EIGEN )
+    boost::scoped_ptr< thermal::RosenbrockStepperThermal< T > > mRosenbrockStepper;
+#endif
 };
 
 
@@ -116,6 +181,8 @@ ThermalSimulation< Matrix, T, FilterTypeChoice >::ThermalSimulation(
     , mSimulationDuration( simulationDuration )
     , mThermalStateStopCriterion( 5.0 )
     , mTolerance(geometry::Tolerance< T >( 0.000001, geometry::Angle<>::Deg( 0.001 ), 0.1 ))
+    , mRungeKuttaStepper( boost::numeric::odeint::make_controlled( 1.0e-10, 1.0e-10,
+                                                                   boost::numeric::odeint::runge_kutta_cash_karp54< vector< T > >() ) )
 {
     // Evaluate Options node
     boost::shared_ptr< xmlparser::XmlParameter > optionsNode = rootXmlNode->GetElementChild( "Options" );
@@ -191,6 +258,59 @@ ThermalSimulation< Matrix, T, FilterTypeChoice >::ThermalSimulation(
                                    geometricalToleranceNode->GetElementAttributeDoubleValue( "percentOfQuantity" ) );
     }
 
+    // Thermal solver
+    if ( optionsNode->HasElement( "ThermalSolver" ) )
+    {
+        boost::shared_ptr< xmlparser::XmlParameter > thermalSolverNode = optionsNode->GetElementChild( "ThermalSolver" );
+        const std::string thermalSolver = optionsNode->GetElementStringValue( "ThermalSolver" );
+        if ( thermalSolver == "Rosenbrock" )
+        {
+#if defined( _EIGEN_ ) || defined( USE_EIGEN )
+            mRosenbrockStepper.reset( new thermal::RosenbrockStepperThermal< T >(
+             thermalSolverNode->GetElementAttributeDoubleValue( "absoluteTolerance", 1.0e-6 ),
+             thermalSolverNode->GetElementAttributeDoubleValue( "relativeTolerance", 1.0e-6 ) ) );
+#else
+            ErrorFunction< std::runtime_error >( __FUNCTION__, __LINE__, __FILE__, "UnknownThermalSolver", thermalSolver.c_str() );
+#endif
+        }
+        else if ( thermalSolver != "RungeKutta" )
+            ErrorFunction< std::runtime_error >( __FUNCTION__, __LINE__, __FILE__, "UnknownThermalSolver", thermalSolver.c_str() );
+    }
+
+#ifdef BOOST_THREAD
+    // Threads for the right-hand side of the thermal model
+    size_t thermalThreads = 1;
+    if ( optionsNode->HasElement( "ThermalThreads" ) )
+    {
+        const int threads = optionsNode->GetElementIntValue( "ThermalThreads" );
+        if ( threads < 1 )
+            ErrorFunction< std::runtime_error >( __FUNCTION__, __LINE__, __FILE__, "ThermalThreadsNotPositive" );
+        thermalThreads = threads;
+    }
+#endif
+
+    // Reduced-order thermal model
+#if defined( _EIGEN_ ) || defined( USE_EIGEN )
+    size_t reducedThermalOrder = 0;
+    T reducedThermalExpansionPoint = 0.0;
+#endif
+    if ( optionsNode->HasElement( "ReducedThermalOrder" ) )
+    {
+#if defined( _EIGEN_ ) || defined( USE_EIGEN )
+        const int order = optionsNode->GetElementIntValue( "ReducedThermalOrder" );
+        if ( order < 1 )
+            ErrorFunction< std::runtime_error >( __FUNCTION__, __LINE__, __FILE__, "ReducedThermalOrderNotPositive" );
+        // The reduced system is solved with the Runge-Kutta stepper only
+        if ( mRosenbrockStepper )
+            ErrorFunction< std::runtime_error >( __FUNCTION__, __LINE__, __FILE__, "ReducedThermalOrderWithRosenbrock" );
+        reducedThermalOrder = order;
+        reducedThermalExpansionPoint =
+         optionsNode->GetElementChild( "ReducedThermalOrder" )->GetElementAttributeDoubleValue( "expansionPoint", 1.0e-3 );
+#else
+        ErrorFunction< std::runtime_error >( __FUNCTION__, __LINE__, __FILE__, "ReducedThermalOrderNotSupported" );
+#endif
+    }
+
     bool showLateralSurfaces = false;
     if ( optionsNode->HasElement( "ThermalObserver" ) &&
          optionsNode->GetElementChild( "ThermalObserver" )->HasElement( "ShowLateralSurfaces" ) )
@@ -216,6 +336,27 @@ ThermalSimulation< Matrix, T, FilterTypeChoice >::ThermalSimulation(
     thermalFactory.reset( new thermal::ThermalFactory< T >( materialFactory.get(), blockFactory.get(),
                                                             coolingFactory.get(), coolingBlockFactory.get() ) );
 
+    // Thermal model cache, the description comprises the thermal part of the xml-file and the options used by
+    // ThermalModel. Its key names the cache file.
+    std::string thermalModelCacheFileName;
+    std::string thermalModelDescription;
+    if ( optionsNode->HasElement( "ThermalModelCache" ) )
+    {
+#ifndef __NO_STRING__
+        thermalFactory->GetThermalModelDescription( rootXmlNode, thermalModelDescription );
+        std::ostringstream options;
+        options.precision( 17 );
+        options << mTolerance.mLength << ' ' << mTolerance.mAngle.GetRad() << ' ' << mTolerance.mPercentOfQuantity << ' '
+                << aggregateAreasForConvection << ' ' << showLateralSurfaces;
+        thermalModelDescription += options.str();
+        const boost::uint64_t key = thermal::ThermalModelCache< T >::CreateKey( thermalModelDescription );
+        thermalModelCacheFileName =
+         thermal::ThermalModelCache< T >::CreateFileName( optionsNode->GetElementStringValue( "ThermalModelCache" ), key );
+#else
+        ErrorFunction< std::runtime_error >( __FUNCTION__, __LINE__, __FILE__, "ThermalModelCacheNotSupported" );
+#endif
+    }
+
     // Temporary variables to process creation of thermal system
     std::vector< boost::shared_ptr< thermal::ThermalBlock< T > > > heatedBlocks;
     std::vector< boost::shared_ptr< thermal::ThermalBlock< T > > > unheatedBlocks;
@@ -223,44 +364,28 @@ ThermalSimulation< Matrix, T, FilterTypeChoice >::ThermalSimulation(
     std::vector< boost::shared_ptr< thermal::ThermalElement< T > > > thermalElements;
 
     std::vector< std::vector< thermal::IndexedValue< T > > > conductivityMatrix;
-    std::vector< thermal::IndexedArea< T > > surfaceElements;
-    std::vector< thermal::IndexedInnerArea< T > > innerSurfaceElements;
     boost::shared_ptr< thermal::BlockGeometry< T > > blockGeometry;
     std::vector< geometry::Area< T > > coolingAreas;
     boost::shared_ptr< thermal::Cooling< T > > cooling;
     std::vector< std::vector< thermal::TaylorData< T > > > coolingDataVector;
     std::vector< std::vector< thermal::TaylorData< T > > > dirichletDataVector;
 
-    misc::StrCont description;
-
     // Create thermal model
     thermalFactory->CreateThermalModel( rootXmlNode, heatedBlocks, unheatedBlocks, coolingBlocks, thermalStates,
                                         thermalStatesOfCellBlocks, &mThermalProbes );
-    thermal::ThermalModel< T > thermalModel( mTolerance, aggregateAreasForConvection );
-    thermalModel.ClearAndSetNumberOfBlocksAndCoolings( heatedBlocks.size() + unheatedBlocks.size(), coolingBlocks.size() );
+
+    // The blocks are discretized independently of each other, but added to the thermal model in the same order as
+    // they have been created, so the thermal model does not depend on the number of threads
+    std::vector< thermal::ThermalBlock< T > * > blocks;
+    blocks.reserve( heatedBlocks.size() + unheatedBlocks.size() );
     BOOST_FOREACH ( boost::shared_ptr< thermal::ThermalBlock< T > > &block, heatedBlocks )
-    {
-        block->CreateData( thermalElements, conductivityMatrix, surfaceElements, blockGeometry );
-        block->GetDescription( description );
-        if ( showLateralSurfaces )
-            block->GetInnerSurfaceAreas( innerSurfaceElements );
-        thermalModel.AddBlock( thermalElements, conductivityMatrix, surfaceElements, blockGeometry, innerSurfaceElements, description );
-    }
+        blocks.push_back( block.get() );
     BOOST_FOREACH ( boost::shared_ptr< thermal::ThermalBlock< T > > &block, unheatedBlocks )
-    {
-        block->CreateData( thermalElements, conductivityMatrix, surfaceElements, blockGeometry );
-        block->GetDescription( description );
-        if ( showLateralSurfaces )
-            block->GetInnerSurfaceAreas( innerSurfaceElements );
-        thermalModel.AddBlock( thermalElements, conductivityMatrix, surfaceElements, blockGeometry, innerSurfaceElements, description );
-    }
+        blocks.push_back( block.get() );
+    std::vector< thermal::Cooling< T > * > coolingsOfCoolingBlocks;
+    coolingsOfCoolingBlocks.reserve( coolingBlocks.size() );
     BOOST_FOREACH ( boost::shared_ptr< thermal::CoolingBlock< T > > &coolingBlock, coolingBlocks )
-    {
-        cooling = coolingBlock->GetCooling();
-        coolingBlock->GetCoolingAreas( coolingAreas );
-        coolingBlock->GetBlockGeometry( blockGeometry );
-        thermalModel.AddCooling( coolingAreas, blockGeometry, cooling );
-    }
+        coolingsOfCoolingBlocks.push_back( coolingBlock->GetCooling().get() );
 
     // Get thermal states
     if ( thermalStates )
@@ -277,9 +402,68 @@ ThermalSimulation< Matrix, T, FilterTypeChoice >::ThermalSimulation(
     BOOST_FOREACH ( boost::shared_ptr< thermal::ThermalBlock< T > > &block, unheatedBlocks )
         mUnconnectedThermalStates.push_back( block->GetThermalStates().at( 0 ) );
 
-    // Create thermal system
-    thermalModel.CreateDataByFusingBlocks( thermalElements, conductivityMatrix, coolingDataVector, dirichletDataVector );
+    // Materials and thermal states the thermal elements refer to, they are stored as indices in the thermal model cache
     materialFactory->GetObjects( mMaterials );
+    std::vector< const thermal::Material< T > * > materialsOfThermalElements;
+    materialsOfThermalElements.reserve( mMaterials.size() );
+    BOOST_FOREACH ( const boost::shared_ptr< thermal::Material< T > > &material, mMaterials )
+        materialsOfThermalElements.push_back( material.get() );
+    std::vector< ::state::ThermalState< T > * > thermalStatesOfThermalElements;
+    BOOST_FOREACH ( thermal::ThermalBlock< T > *block, blocks )
+        BOOST_FOREACH ( const boost::shared_ptr< ::state::ThermalState< T > > &thermalState, block->GetThermalStates() )
+            thermalStatesOfThermalElements.push_back( thermalState.get() );
+
+    // Create thermal system, the discretization of the blocks and ThermalModel are skipped if the fused data has been
+    // found in the thermal model cache
+    vector< thermal::ThermalElement< double > * > thermalElementsOfAreas;
+    vector< vector< size_t > > areas;
+    vector< vector< size_t > > volumes;
+    vector< misc::StrCont > volumeNames;
+    vector< geometry::Cartesian< double > > vertices;
+    bool isThermalModelCached = false;
+    if ( !thermalModelCacheFileName.empty() )
+        isThermalModelCached =
+         thermal::ThermalModelCache< T >::Load( thermalModelCacheFileName, thermalModelDescription, materialsOfThermalElements,
+                                                thermalStatesOfThermalElements, thermalElements, conductivityMatrix,
+                                                coolingDataVector, dirichletDataVector, coolingsOfCoolingBlocks,
+                                                thermalElementsOfAreas, areas, volumes, volumeNames, vertices, mThermalProbes );
+    if ( !isThermalModelCached )
+    {
+        std::vector< ThermalBlockData > blockData;
+#ifdef BOOST_THREAD
+        CreateThermalBlockData( blocks, showLateralSurfaces, thermalThreads, blockData );
+#else
+        CreateThermalBlockData( blocks, showLateralSurfaces, 1, blockData );
+#endif
+        thermal::ThermalModel< T > thermalModel( mTolerance, aggregateAreasForConvection );
+        thermalModel.ClearAndSetNumberOfBlocksAndCoolings( blockData.size(), coolingBlocks.size() );
+        BOOST_FOREACH ( ThermalBlockData &data, blockData )
+        {
+            thermalModel.AddBlock( data.mThermalElements, data.mConductivityMatrix, data.mSurfaceElements,
+                                   data.mBlockGeometry, data.mInnerSurfaceElements, data.mDescription );
+            data = ThermalBlockData();
+        }
+        BOOST_FOREACH ( boost::shared_ptr< thermal::CoolingBlock< T > > &coolingBlock, coolingBlocks )
+        {
+            cooling = coolingBlock->GetCooling();
+            coolingBlock->GetCoolingAreas( coolingAreas );
+            coolingBlock->GetBlockGeometry( blockGeometry );
+            thermalModel.AddCooling( coolingAreas, blockGeometry, cooling );
+        }
+
+        thermalModel.CreateDataByFusingBlocks( thermalElements, conductivityMatrix, coolingDataVector, dirichletDataVector );
+        thermalModel.CreateDataForVisualization( thermalElementsOfAreas, areas, volumes, volumeNames, vertices,
+                                                 showLateralSurfaces );
+        thermalModel.ProbeThermalElemnts( mThermalProbes );
+
+        if ( !thermalModelCacheFileName.empty() )
+            thermal::ThermalModelCache< T >::Save( thermalModelCacheFileName, thermalModelDescription, materialsOfThermalElements,
+                                                   thermalStatesOfThermalElements, thermalElements, conductivityMatrix,
+                                                   coolingDataVector, dirichletDataVector, coolingsOfCoolingBlocks,
+                                                   thermalElementsOfAreas, areas, volumes, volumeNames, vertices,
+                                                   mThermalProbes );
+    }
+
     coolingFactory->GetObjects( mCoolings );
     BOOST_FOREACH ( const boost::shared_ptr< thermal::ThermalElement< T > > &elem, thermalElements )
         if ( elem->HasThermalState() )    // Get connected thermal elements (that have a thermal state) before
@@ -287,22 +471,102 @@ ThermalSimulation< Matrix, T, FilterTypeChoice >::ThermalSimulation(
             mConnectedThermalElements.push_back( elem.get() );
     mThermalSystem.reset( new thermal::OdeSystemThermal< T >( thermalElements, conductivityMatrix, coolingDataVector, dirichletDataVector,
                                                               convection, radiation, airTemperature, mThermalStates ) );
+#ifdef BOOST_THREAD
+    mThermalSystem->SetNumberOfThreads( thermalThreads );
+#endif
     mThermalSystem->GetTemperatureVector( mTemperatures );
 
     // Create thermal visualizer if desired
-    vector< thermal::ThermalElement< double > * > thermalElementsOfAreas;
-    vector< vector< size_t > > areas;
-    vector< vector< size_t > > volumes;
-    vector< misc::StrCont > volumeNames;
-    vector< geometry::Cartesian< double > > vertices;
-    thermalModel.CreateDataForVisualization( thermalElementsOfAreas, areas, volumes, volumeNames, vertices, showLateralSurfaces );
-
     if ( thermalVisualizer )
         thermalVisualizer->reset( CreateThermalObserver< double, FilterTypeChoice >( rootXmlNode.get(), thermalElementsOfAreas,
                                                                                      areas, volumes, volumeNames, vertices ) );
-    thermalModel.ProbeThermalElemnts( mThermalProbes );
+
+#if defined( _EIGEN_ ) || defined( USE_EIGEN )
+    if ( reducedThermalOrder > 0 )
+    {
+        // Thermal elements of the probes and those connected to the electrical model are the outputs
+        std::set< const thermal::ThermalElement< T > * > outputElements( mConnectedThermalElements.begin(),
+                                                                        mConnectedThermalElements.end() );
+        BOOST_FOREACH ( const ::probe::ThermalProbe &probe, mThermalProbes )
+            outputElements.insert( probe.GetCorrespondingThermalElement() );
+        std::vector< size_t > outputIndices;
+        for ( size_t i = 0; i < mThermalSystem->GetThermalElements().size(); ++i )
+            if ( outputElements.count( mThermalSystem->GetThermalElements()[i].get() ) )
+                outputIndices.push_back( i );
+
+        mReducedThermalSystem.reset( new thermal::ReducedOdeSystemThermal< T >( *mThermalSystem, outputIndices, reducedThermalOrder,
+                                                                                reducedThermalExpansionPoint ) );
+        mReducedThermalSystem->GetTemperatureVector( mTemperatures );
+    }
+#endif
 }
 
+template < typename Matrix, typename T, bool FilterTypeChoice >
+void ThermalSimulation< Matrix, T, FilterTypeChoice >::CreateThermalBlockData( const std::vector< thermal::ThermalBlock< T > * > &blocks,
+                                                                               bool showLateralSurfaces, size_t numberOfThreads,
+                                                                               std::vector< ThermalBlockData > &blockData )
+{
+    blockData.clear();
+    blockData.resize( blocks.size() );
+
+#ifdef BOOST_THREAD
+    if ( numberOfThreads > 1 && blocks.size() > 1 )
+    {
+        ThermalBlockDataFunctor functor;
+        functor.mBlocks = &blocks;
+        functor.mBlockData = &blockData;
+        functor.mShowLateralSurfaces = showLateralSurfaces;
+#ifdef __EXCEPTIONS__
+        functor.mExceptions.resize( blocks.size() );
+#endif
+        {
+            threading::ThreadedForLoop threadedForLoop( std::min( numberOfThreads, blocks.size() ) );
+            threadedForLoop.DoLoop( functor, blocks.size() );
+        }
+#ifdef __EXCEPTIONS__
+        BOOST_FOREACH ( const boost::exception_ptr &exception, functor.mExceptions )
+            if ( exception )
+                boost::rethrow_exception( exception );
+#endif
+        return;
+    }
+#endif
+
+    UNUSED( numberOfThreads );
+    for ( size_t i = 0; i < blocks.size(); ++i )
+        CreateThermalBlockData( *blocks[i], showLateralSurfaces, blockData[i] );
+}
+
+template < typename Matrix, typename T, bool FilterTypeChoice >
+void ThermalSimulation< Matrix, T, FilterTypeChoice >::CreateThermalBlockData( thermal::ThermalBlock< T > &block, bool showLateralSurfaces,
+                                                                               ThermalBlockData &blockData )
+{
+    block.CreateData( blockData.mThermalElements, blockData.mConductivityMatrix, blockData.mSurfaceElements,
+                      blockData.mBlockGeometry );
+    block.GetDescription( blockData.mDescription );
+    if ( showLateralSurfaces )
+        block.GetInnerSurfaceAreas( blockData.mInnerSurfaceElements );
+}
+
+#ifdef BOOST_THREAD
+template < typename Matrix, typename T, bool FilterTypeChoice >
+void ThermalSimulation< Matrix, T, FilterTypeChoice >::ThermalBlockDataFunctor::Iterate( size_t i )
+{
+#ifdef __EXCEPTIONS__
+    try
+    {
+#endif
+        CreateThermalBlockData( *( *mBlocks )[i], mShowLateralSurfaces, ( *mBlockData )[i] );
+#ifdef __EXCEPTIONS__
+    }
+    catch ( ... )
+    {
+        mExceptions[i] = boost::current_exception();
+    }
+#endif
+}
+#endif
+
 template < typename Matrix, typename T, bool FilterTypeChoice >
 void ThermalSimulation< Matrix, T, FilterTypeChoice >::UpdateSystem()
 {
@@ -312,6 +576,16 @@ void ThermalSimulation< Matrix, T, FilterTypeChoice >::UpdateSystem()
         mThermalSystem->ResetAirTemperature( mAirTemperaturesData->GetValue() );
     }
 
+#if defined( _EIGEN_ ) || defined( USE_EIGEN )
+    if ( mReducedThermalSystem )
+    {
+        mReducedThermalSystem->Update( mTime, mTime - mLastTime );
+        mLastTime = mTime;
+        mReducedThermalSystem->SetTemperatureVector( mTemperatures );
+        return;
+    }
+#endif
+
     mThermalSystem->Update( mTime, mTime - mLastTime );
     mLastTime = mTime;
     mThermalSystem->SetTemperatureVector( mTemperatures );
@@ -367,5 +641,27 @@ bool ThermalSimulation< Matrix, T, FilterTypeChoice >::IsStopCriterionFulfilled(
 
     return isStop;
 }
+
+template < typename Matrix, typename T, bool FilterTypeChoice >
+T ThermalSimulation< Matrix, T, FilterTypeChoice >::GetThermalStateStopCriterion() const
+{
+    return mThermalStateStopCriterion;
+}
+
+template < typename Matrix, typename T, bool FilterTypeChoice >
+bool ThermalSimulation< Matrix, T, FilterTypeChoice >::TryThermalStep()
+{
+#if defined( _EIGEN_ ) || defined( USE_EIGEN )
+    // The reduced system is small and dense, so it is always solved explicitly
+    if ( mReducedThermalSystem )
+        return mRungeKuttaStepper.try_step( boost::ref( *mReducedThermalSystem ), mTemperatures, mTime, mDeltaTime ) ==
+               boost::numeric::odeint::success;
+    if ( mRosenbrockStepper )
+        return mRosenbrockStepper->try_step( *mThermalSystem, mTemperatures, mTime, mDeltaTime ) ==
+               boost::numeric::odeint::success;
+#endif
+    return mRungeKuttaStepper.try_step( boost::ref( *mThermalSystem ), mTemperatures, mTime, mDeltaTime ) ==
+           boost::numeric::odeint::success;
+}
 }
 #endif
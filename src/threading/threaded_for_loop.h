@@ -17,6 +17,7 @@ along with this program.  If not, see http://www.gnu.org/licenses/.
 #ifdef BOOST_THREAD
 
 #include <boost/atomic.hpp>
+#include <boost/noncopyable.hpp>
 #include <boost/thread.hpp>
 #include "../misc/aligned_to_cache_line.h"
 
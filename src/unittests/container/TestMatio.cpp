@@ -21,6 +21,7 @@ _._._._._._._._._._._._._._._._._._._._._.*/
 
 #include "../../container/matio_file.h"
 #include "../../container/matio_data.h"
+#include "../../container/matio_chunked_data.h"
 #include "../../misc/macros.h"
 #include "TestMatio.h"
 
@@ -353,3 +354,49 @@ void TestMatio::TestMatFileWriteAndRead()
         TS_ASSERT_DELTA( static_cast< double >( y + 1 ), a( 0, y ), 0.0001 );
     }
 }
+
+void TestMatio::TestMatFileWriteChunkedAndRead()
+{
+    std::string fileName = "selfWrittenChunkedStruct.mat";
+
+    {
+        // The variables have to outlive the write of the file
+        MatioChunkedData strom( "diga.daten.Strom", fileName + ".Strom.tmp", 3, 4 );
+        MatioChunkedData time( "diga.daten.Programmdauer", fileName + ".Programmdauer.tmp", 1, 4 );
+        MatFile matfileRW( fileName.c_str(), MAT_ACC_RDWR );
+
+        for ( size_t y = 0; y < 9; ++y )
+        {
+            time.Append( static_cast< double >( y + 1 ) );
+            for ( size_t x = 0; x < 3; ++x )
+            {
+                strom.Append( static_cast< double >( 10 * x + y ) );
+            }
+        }
+        // incomplete column is left out
+        strom.Append( 1.0 );
+
+        TS_ASSERT_EQUALS( strom.GetNumberOfColumns(), 9 );
+        matfileRW << time.GetMatioData();
+        matfileRW << strom.GetMatioData();
+    }
+
+    MatFile matfileRO( fileName.c_str(), MAT_ACC_RDONLY );
+
+    MatioData &z = matfileRO["diga.daten.Strom"];
+    TS_ASSERT_EQUALS( z.mMatlabVar->dims[0], 3 );
+    TS_ASSERT_EQUALS( z.mMatlabVar->dims[1], 9 );
+    for ( size_t x = 0; x < 3; ++x )
+    {
+        for ( size_t y = 0; y < 9; ++y )
+        {
+            TS_ASSERT_DELTA( static_cast< double >( 10 * x + y ), z( x, y ), 0.0001 );
+        }
+    }
+
+    MatioData &a = matfileRO["diga.daten.Programmdauer"];
+    for ( size_t y = 0; y < 9; ++y )
+    {
+        TS_ASSERT_DELTA( static_cast< double >( y + 1 ), a( 0, y ), 0.0001 );
+    }
+}
@@ -36,6 +36,7 @@ class TestMatio : public CxxTest::TestSuite
     void TestMadioDataCreationFromVector1D();
     void TestMadioDataCreationFromVector2D();
     void TestMatFileWriteAndRead();
+    void TestMatFileWriteChunkedAndRead();
 
 
     private:
@@ -0,0 +1,350 @@
+/*
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see http://www.gnu.org/licenses/.
+*/
+/* -.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.
+* File Name : TestTwoPortStamp.cpp
+* Creation Date : 17-10-2026
+_._._._._._._._._._._._._._._._._._._._._.*/
+#include "TestTwoPortStamp.h"
+#include "../../misc/matrixInclude.h"
+
+// BOOST
+#include <boost/shared_ptr.hpp>
+
+// STD
+#include <stdexcept>
+#include <vector>
+
+#include "../../electrical/capacity.h"
+#include "../../electrical/inductance.h"
+#include "../../electrical/ohmicresistance.h"
+#include "../../electrical/parallelRCAlg.h"
+#include "../../electrical/parallelrc.h"
+#include "../../electrical/paralleltwoport.h"
+#include "../../electrical/rmphn.h"
+#include "../../electrical/serialtwoport.h"
+#include "../../electrical/sphericalDiffusion.h"
+#include "../../electrical/voltagesource.h"
+#include "../../electrical/warburgTanh.h"
+#include "../../electrical/zarc.h"
+#include "../../object/const_obj.h"
+#include "../../system/stateSystemGroup.h"
+
+#ifndef _SYMBOLIC_
+namespace
+{
+/// Constant object whose value can be changed from outside, e.g. to imitate a moving lookup
+class VariableObj : public object::ConstObj< double >
+{
+    public:
+    VariableObj( double value )
+        : object::ConstObj< double >( value )
+    {
+    }
+    void SetValue( double value ) { this->mLastValue = value; }
+};
+
+/// Mixed network of the serial and parallel ports and the basic elements
+struct StampNetwork
+{
+    StampNetwork()
+        : mResistance( new VariableObj( 0.01 ) )
+        , mCapacity( new VariableObj( 100.0 ) )
+        , mTau( new VariableObj( 0.6 ) )
+        , mVoltage( new VariableObj( 2.5 ) )
+        , mRoot( new electrical::SerialTwoPort<>() )
+        , mLeaf( new electrical::ParallelRC<>( new object::ConstObj< double >( 0.5 ), new object::ConstObj< double >( 1.0 ), true ) )
+    {
+        mRoot->AddChild( new electrical::OhmicResistance<>( mResistance ) );
+
+        boost::shared_ptr< electrical::ParallelTwoPort<> > parallel( new electrical::ParallelTwoPort<>() );
+        mRoot->AddChild( parallel );
+
+        boost::shared_ptr< electrical::SerialTwoPort<> > s1( new electrical::SerialTwoPort<>() );
+        s1->AddChild( new electrical::Capacity<>( mCapacity ) );
+        s1->AddChild( new electrical::OhmicResistance<>( new object::ConstObj< double >( 2.0 ) ) );
+        parallel->AddChild( s1 );
+
+        boost::shared_ptr< electrical::SerialTwoPort<> > s2( new electrical::SerialTwoPort<>() );
+        s2->AddChild( new electrical::ParallelRC<>( boost::shared_ptr< object::Object< double > >(
+                                                     new object::ConstObj< double >( 0.3 ) ),
+                                                    mTau ) );
+        s2->AddChild( new electrical::VoltageSource<>( mVoltage ) );
+        parallel->AddChild( s2 );
+        parallel->AddChild( mLeaf );
+
+        boost::shared_ptr< electrical::Rmphn<> > rmphn(
+         new electrical::Rmphn<>( boost::shared_ptr< object::Object< double > >( new object::ConstObj< double >( 0.01 ) ),
+                                  boost::shared_ptr< object::Object< double > >( new object::ConstObj< double >( 0.02 ) ) ) );
+        rmphn->AddChild( new electrical::Capacity<>( new object::ConstObj< double >( 1000.0 ) ) );
+        mRoot->AddChild( rmphn );
+
+        mRoot->SetSystem( &mStateSystemGroup );
+        mStateSystemGroup.Initialize();
+        mRoot->SetInitialCurrent( 1.5 );
+    }
+
+    void ChangeValues( size_t step )
+    {
+        mResistance->SetValue( 0.01 * ( step + 2 ) );
+        mCapacity->SetValue( 100.0 / ( step + 2 ) );
+        mTau->SetValue( 0.6 + 0.1 * step );
+        mVoltage->SetValue( 2.5 + 0.2 * step );
+    }
+
+    boost::shared_ptr< VariableObj > mResistance;
+    boost::shared_ptr< VariableObj > mCapacity;
+    boost::shared_ptr< VariableObj > mTau;
+    boost::shared_ptr< VariableObj > mVoltage;
+    boost::shared_ptr< electrical::SerialTwoPort<> > mRoot;
+    boost::shared_ptr< electrical::ParallelRC<> > mLeaf;
+    systm::StateSystemGroup< myMatrixType > mStateSystemGroup;
+};
+
+/// Network of the diffusion and charge transfer elements of a cell model
+struct CellNetwork
+{
+    CellNetwork()
+        : mResistance( new VariableObj( 0.002 ) )
+        , mTau( new VariableObj( 1.0 ) )
+        , mPhi( new VariableObj( 0.6 ) )
+        , mRoot( new electrical::SerialTwoPort<>() )
+    {
+        // The sample rates leave three, two and one RC elements of the Zarc element
+        const double sampleRates[] = {0.01, 0.1, 0.5};
+        for ( size_t i = 0; i < 3; ++i )
+            mRoot->AddChild( new electrical::Zarc<>( mTau, mResistance, mPhi, sampleRates[i] ) );
+        mRoot->AddChild( new electrical::SphericalDiffusion<>( mResistance, mTau, 4 ) );
+
+        boost::shared_ptr< electrical::ParallelTwoPort<> > parallel( new electrical::ParallelTwoPort<>() );
+        boost::shared_ptr< electrical::WarburgTanh<> > warburg( new electrical::WarburgTanh<>() );
+        warburg->AddChild( new electrical::ParallelRC<>( mResistance, mTau ) );
+        warburg->AddChild( new electrical::ParallelRC<>( mResistance, boost::shared_ptr< object::Object< double > >(
+                                                                       new object::ConstObj< double >( 0.2 ) ) ) );
+        warburg->AddChild( new electrical::OhmicResistance<>( mResistance ) );
+        parallel->AddChild( warburg );
+        parallel->AddChild( new electrical::SphericalDiffusion<>( mResistance, mTau, 3, 0 ) );
+        mRoot->AddChild( parallel );
+
+        mRoot->SetSystem( &mStateSystemGroup );
+        mStateSystemGroup.Initialize();
+        mRoot->SetInitialCurrent( 3.0 );
+    }
+
+    void ChangeValues( size_t step )
+    {
+        mResistance->SetValue( 0.002 * ( step + 1 ) );
+        mTau->SetValue( 1.0 + 0.2 * step );
+        mPhi->SetValue( 0.6 + 0.05 * step );
+    }
+
+    boost::shared_ptr< VariableObj > mResistance;
+    boost::shared_ptr< VariableObj > mTau;
+    boost::shared_ptr< VariableObj > mPhi;
+    boost::shared_ptr< electrical::SerialTwoPort<> > mRoot;
+    systm::StateSystemGroup< myMatrixType > mStateSystemGroup;
+};
+
+void CompareStateSystems( systm::StateSystem< myMatrixType > &compiled, systm::StateSystem< myMatrixType > &reference )
+{
+    const myMatrixType &compiledA = compiled.GetEquationSystemAMatrix();
+    const myMatrixType &referenceA = reference.GetEquationSystemAMatrix();
+    const myMatrixType &compiledC = compiled.GetEquationSystemCVector();
+    const myMatrixType &referenceC = reference.GetEquationSystemCVector();
+
+    TS_ASSERT_EQUALS( compiledA.n_rows, referenceA.n_rows );
+    TS_ASSERT_EQUALS( compiledA.n_cols, referenceA.n_cols );
+    for ( size_t i = 0; i < referenceA.n_rows; ++i )
+    {
+        for ( size_t j = 0; j < referenceA.n_cols; ++j )
+            TS_ASSERT_DELTA( compiledA( i, j ), referenceA( i, j ), 1.0e-12 );
+        TS_ASSERT_DELTA( compiledC( i, 0 ), referenceC( i, 0 ), 1.0e-12 );
+    }
+}
+
+void CollectTwoPorts( electrical::TwoPort<> *twoPort, std::vector< electrical::TwoPort<> * > &twoPorts )
+{
+    twoPorts.push_back( twoPort );
+    electrical::TwoPortWithChild<> *withChild = dynamic_cast< electrical::TwoPortWithChild<> * >( twoPort );
+    if ( withChild )
+        for ( size_t i = 0; i < withChild->size(); ++i )
+            CollectTwoPorts( withChild->at( i ), twoPorts );
+}
+}
+#endif
+
+void TestTwoPortStamp::testCompiledStampMatchesTwoPortEquations()
+{
+#ifndef _SYMBOLIC_
+    StampNetwork compiled;
+    StampNetwork reference;
+    TS_ASSERT( compiled.mRoot->CompileStateSystemStamp() );
+    TS_ASSERT( compiled.mLeaf->HasStamp() );
+    TS_ASSERT( !reference.mLeaf->HasStamp() );
+
+    const size_t stateCount = compiled.mStateSystemGroup.GetStateCount();
+    for ( size_t step = 0; step < 4; ++step )
+    {
+        for ( size_t i = 0; i < stateCount; ++i )
+        {
+            compiled.mStateSystemGroup.mStateVector( i, 0 ) = 0.1 * ( i + 1 ) + step;
+            reference.mStateSystemGroup.mStateVector( i, 0 ) = 0.1 * ( i + 1 ) + step;
+        }
+
+        compiled.mRoot->UpdateStateSystemGroup();
+        reference.mRoot->UpdateStateSystemGroup();
+        CompareStateSystems( compiled.mStateSystemGroup.mDglStateSystem, reference.mStateSystemGroup.mDglStateSystem );
+        CompareStateSystems( compiled.mStateSystemGroup.mAlgStateSystem, reference.mStateSystemGroup.mAlgStateSystem );
+
+        compiled.mRoot->CalculateStateDependentValues();
+        reference.mRoot->CalculateStateDependentValues();
+        TS_ASSERT_DELTA( compiled.mRoot->GetVoltageValue(), reference.mRoot->GetVoltageValue(), 1.0e-12 );
+        TS_ASSERT_DELTA( compiled.mRoot->GetCurrentValue(), reference.mRoot->GetCurrentValue(), 1.0e-12 );
+        TS_ASSERT_DELTA( compiled.mLeaf->GetVoltageValue(), reference.mLeaf->GetVoltageValue(), 1.0e-12 );
+        TS_ASSERT_DELTA( compiled.mLeaf->GetCurrentValue(), reference.mLeaf->GetCurrentValue(), 1.0e-12 );
+
+        // Only the values change, the topology stays the same
+        const double current = -2.0 + step;
+        compiled.mRoot->SetCurrent( current );
+        reference.mRoot->SetCurrent( current );
+        compiled.ChangeValues( step );
+        reference.ChangeValues( step );
+    }
+#endif
+}
+
+void TestTwoPortStamp::testCompiledStampObservesAllTwoPorts()
+{
+#ifndef _SYMBOLIC_
+    StampNetwork compiled;
+    StampNetwork reference;
+    std::vector< electrical::TwoPort<> * > compiledTwoPorts;
+    std::vector< electrical::TwoPort<> * > referenceTwoPorts;
+    CollectTwoPorts( compiled.mRoot.get(), compiledTwoPorts );
+    CollectTwoPorts( reference.mRoot.get(), referenceTwoPorts );
+    TS_ASSERT_EQUALS( compiledTwoPorts.size(), referenceTwoPorts.size() );
+    for ( size_t i = 0; i < compiledTwoPorts.size(); ++i )
+    {
+        compiledTwoPorts[i]->mObservable = true;
+        referenceTwoPorts[i]->mObservable = true;
+    }
+    TS_ASSERT( compiled.mRoot->CompileStateSystemStamp() );
+
+    const size_t stateCount = compiled.mStateSystemGroup.GetStateCount();
+    for ( size_t step = 0; step < 3; ++step )
+    {
+        compiled.mRoot->SetCurrent( 0.5 - step );
+        reference.mRoot->SetCurrent( 0.5 - step );
+        compiled.mRoot->UpdateStateSystemGroup();
+        reference.mRoot->UpdateStateSystemGroup();
+
+        // The observation uses the state vector after the step, not the one of the update
+        for ( size_t i = 0; i < stateCount; ++i )
+        {
+            compiled.mStateSystemGroup.mStateVector( i, 0 ) = 0.2 * ( i + 1 ) - step;
+            reference.mStateSystemGroup.mStateVector( i, 0 ) = 0.2 * ( i + 1 ) - step;
+        }
+        compiled.mRoot->CalculateStateDependentValues();
+        reference.mRoot->CalculateStateDependentValues();
+
+        for ( size_t i = 0; i < compiledTwoPorts.size(); ++i )
+        {
+            TS_ASSERT( compiledTwoPorts[i]->HasStamp() );
+            TS_ASSERT_DELTA( compiledTwoPorts[i]->GetCurrentValue(), referenceTwoPorts[i]->GetCurrentValue(), 1.0e-12 );
+            TS_ASSERT_DELTA( compiledTwoPorts[i]->GetVoltageValue(), referenceTwoPorts[i]->GetVoltageValue(), 1.0e-12 );
+            TS_ASSERT_DELTA( compiledTwoPorts[i]->GetPowerValue(), referenceTwoPorts[i]->GetPowerValue(), 1.0e-12 );
+        }
+    }
+#endif
+}
+
+void TestTwoPortStamp::testCompiledStampOfCellElements()
+{
+#ifndef _SYMBOLIC_
+    CellNetwork compiled;
+    CellNetwork reference;
+    std::vector< electrical::TwoPort<> * > compiledTwoPorts;
+    std::vector< electrical::TwoPort<> * > referenceTwoPorts;
+    CollectTwoPorts( compiled.mRoot.get(), compiledTwoPorts );
+    CollectTwoPorts( reference.mRoot.get(), referenceTwoPorts );
+    TS_ASSERT_EQUALS( compiledTwoPorts.size(), referenceTwoPorts.size() );
+    for ( size_t i = 0; i < compiledTwoPorts.size(); ++i )
+    {
+        compiledTwoPorts[i]->mObservable = true;
+        referenceTwoPorts[i]->mObservable = true;
+    }
+    TS_ASSERT( compiled.mRoot->CompileStateSystemStamp() );
+
+    const size_t stateCount = compiled.mStateSystemGroup.GetStateCount();
+    for ( size_t step = 0; step < 4; ++step )
+    {
+        compiled.mRoot->UpdateStateSystemGroup();
+        reference.mRoot->UpdateStateSystemGroup();
+        CompareStateSystems( compiled.mStateSystemGroup.mDglStateSystem, reference.mStateSystemGroup.mDglStateSystem );
+        CompareStateSystems( compiled.mStateSystemGroup.mAlgStateSystem, reference.mStateSystemGroup.mAlgStateSystem );
+
+        for ( size_t i = 0; i < stateCount; ++i )
+        {
+            compiled.mStateSystemGroup.mStateVector( i, 0 ) = 0.05 * ( i + 1 ) - 0.1 * step;
+            reference.mStateSystemGroup.mStateVector( i, 0 ) = 0.05 * ( i + 1 ) - 0.1 * step;
+        }
+        compiled.mRoot->CalculateStateDependentValues();
+        reference.mRoot->CalculateStateDependentValues();
+
+        for ( size_t i = 0; i < compiledTwoPorts.size(); ++i )
+        {
+            TS_ASSERT( compiledTwoPorts[i]->HasStamp() );
+            TS_ASSERT_DELTA( compiledTwoPorts[i]->GetCurrentValue(), referenceTwoPorts[i]->GetCurrentValue(), 1.0e-12 );
+            TS_ASSERT_DELTA( compiledTwoPorts[i]->GetVoltageValue(), referenceTwoPorts[i]->GetVoltageValue(), 1.0e-12 );
+            TS_ASSERT_DELTA( compiledTwoPorts[i]->GetPowerValue(), referenceTwoPorts[i]->GetPowerValue(), 1.0e-12 );
+        }
+
+        const double current = 3.0 - 2.0 * step;
+        compiled.mRoot->SetCurrent( current );
+        reference.mRoot->SetCurrent( current );
+        compiled.ChangeValues( step );
+        reference.ChangeValues( step );
+    }
+#endif
+}
+
+void TestTwoPortStamp::testTwoPortsWithoutStamp()
+{
+#ifndef _SYMBOLIC_
+    // A network with a TwoPort that can not be compiled keeps the uncompiled equations
+    boost::shared_ptr< electrical::SerialTwoPort<> > serial( new electrical::SerialTwoPort<>() );
+    boost::shared_ptr< electrical::OhmicResistance<> > resistance(
+     new electrical::OhmicResistance<>( new object::ConstObj< double >( 1.0 ) ) );
+    serial->AddChild( resistance );
+    serial->AddChild( new electrical::ParallelRCAlg<>( new object::ConstObj< double >( 1.0 ), new object::ConstObj< double >( 1.0 ) ) );
+
+    systm::StateSystemGroup< myMatrixType > stateSystemGroup;
+    serial->SetSystem( &stateSystemGroup );
+    stateSystemGroup.Initialize();
+    serial->SetInitialCurrent( 1.0 );
+    TS_ASSERT( !serial->CompileStateSystemStamp() );
+    TS_ASSERT( !resistance->HasStamp() );
+
+    // Elements that can not be simulated at all abort already while compiling
+    boost::shared_ptr< electrical::SerialTwoPort<> > inductive( new electrical::SerialTwoPort<>() );
+    inductive->AddChild( new electrical::OhmicResistance<>( new object::ConstObj< double >( 1.0 ) ) );
+    inductive->AddChild( new electrical::Inductance<>( new object::ConstObj< double >( 1.0 ) ) );
+
+    systm::StateSystemGroup< myMatrixType > inductiveStateSystemGroup;
+    inductive->SetSystem( &inductiveStateSystemGroup );
+    inductiveStateSystemGroup.Initialize();
+    inductive->SetInitialCurrent( 1.0 );
+    TS_ASSERT_THROWS( inductive->CompileStateSystemStamp(), std::runtime_error );
+#endif
+}
@@ -0,0 +1,31 @@
+/*
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see http://www.gnu.org/licenses/.
+*/
+/* -.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.
+* File Name : TestTwoPortStamp.h
+* Creation Date : 17-10-2026
+_._._._._._._._._._._._._._._._._._._._._.*/
+#ifndef _TESTTWOPORTSTAMP_
+#define _TESTTWOPORTSTAMP_
+#include <cxxtest/TestSuite.h>
+
+class TestTwoPortStamp : public CxxTest::TestSuite
+{
+    public:
+    void testCompiledStampMatchesTwoPortEquations();
+    void testCompiledStampObservesAllTwoPorts();
+    void testCompiledStampOfCellElements();
+    void testTwoPortsWithoutStamp();
+};
+#endif /* _TESTTWOPORTSTAMP_ */
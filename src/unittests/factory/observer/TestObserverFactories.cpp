@@ -110,3 +110,65 @@ void TestObserverFactories::TestObserverFactoryMatlabFilterCreation()
     TS_ASSERT_EQUALS( strcmp( children.at( 0 )->GetElementName(), "Filter1" ), 0 );
     boost::shared_ptr< FilterT > filt = fact->CreateInstance( children.at( 0 ) );
 }
+
+void TestObserverFactories::TestObserverFactorySelectFilterCreation()
+{
+    boost::scoped_ptr< fac_ob > fact( factory::BuildObserverFactoryTwoPort< myMatrixType, true >() );
+    const char *xmlConfig =
+     "<?xml version='1.0'?>\
+            <Configuration>\
+                <Observer>\
+                    <Filter1 class=\"SelectFilter\">\
+                        <Groups>\
+                            <Group1>\
+                                <Elements> 1-10, 15 </Elements>\
+                                <Names> Cellelement, ParallelTwoPort </Names>\
+                                <TimeDelay> 0.5 </TimeDelay>\
+                                <Filters>\
+                                    <Filter1 class=\"DecimateFilter\">\
+                                        <TimeDelay> 0.1 </TimeDelay>\
+                                    </Filter1>\
+                                </Filters>\
+                            </Group1>\
+                            <Group2>\
+                                <Elements> 2 </Elements>\
+                            </Group2>\
+                        </Groups>\
+                    </Filter1>\
+                    <Filter2 class=\"SelectFilter\">\
+                        <Groups>\
+                            <Group1>\
+                                <Elements> 1-10, 15-x </Elements>\
+                            </Group1>\
+                        </Groups>\
+                    </Filter2>\
+                </Observer>\
+             </Configuration>";
+    boost::scoped_ptr< xmlparser::XmlParser > parser( new xmlparser::tinyxml2::XmlParserImpl() );
+    parser->ReadFromMem( xmlConfig );
+    std::vector< boost::shared_ptr< xmlparser::XmlParameter > > children =
+     parser->GetRoot()->GetElementChildren( "Observer" );
+    TS_ASSERT_EQUALS( children.size(), 2 );
+    boost::shared_ptr< FilterT > filt = fact->CreateInstance( children.at( 0 ) );
+
+    boost::shared_ptr< xmlparser::XmlParameter > group = children.at( 0 )->GetElementChildren( "Groups" ).at( 0 );
+    observer::ElementSelection selection = factory::GetElementSelection( group.get(), true );
+    TS_ASSERT_EQUALS( selection.mRanges.size(), 2 );
+    TS_ASSERT_EQUALS( selection.mRanges.at( 0 ).first, 1 );
+    TS_ASSERT_EQUALS( selection.mRanges.at( 0 ).second, 10 );
+    TS_ASSERT_EQUALS( selection.mRanges.at( 1 ).first, 15 );
+    TS_ASSERT_EQUALS( selection.mRanges.at( 1 ).second, 15 );
+    TS_ASSERT_EQUALS( selection.mNames.size(), 2 );
+    TS_ASSERT_EQUALS( selection.mNames.at( 0 ), "Cellelement" );
+    TS_ASSERT_EQUALS( selection.mNames.at( 1 ), "ParallelTwoPort" );
+    TS_ASSERT_EQUALS( selection.mTimeDelay, 0.5 );
+    // Thermal elements have no names
+    TS_ASSERT( factory::GetElementSelection( group.get(), false ).mNames.empty() );
+    // Without TimeDelay every point of time is passed
+    group = children.at( 0 )->GetElementChildren( "Groups" ).at( 1 );
+    TS_ASSERT_EQUALS( factory::GetElementSelection( group.get(), true ).mTimeDelay, 0.0 );
+
+#ifdef __EXCEPTIONS__
+    TS_ASSERT_THROWS( fact->CreateInstance( children.at( 1 ) ), std::runtime_error );
+#endif
+}
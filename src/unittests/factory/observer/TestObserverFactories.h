@@ -30,5 +30,6 @@ class TestObserverFactories : public CxxTest::TestSuite
     void TestObserverFactorySTDCreation();
     void TestObserverFactoryDecimationFilterCreation();
     void TestObserverFactoryMatlabFilterCreation();
+    void TestObserverFactorySelectFilterCreation();
 };
 #endif /* _TESTOBSERVERFACTORIES_ */
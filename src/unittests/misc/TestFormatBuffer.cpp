@@ -0,0 +1,91 @@
+/*
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see http://www.gnu.org/licenses/.
+*/
+/* -.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.
+* File Name : TestFormatBuffer.cpp
+* Creation Date : 17-10-2026
+_._._._._._._._._._._._._._._._._._._._._.*/
+#include "TestFormatBuffer.h"
+#include "../../misc/format_buffer.h"
+
+#include <cstdlib>
+#include <sstream>
+#include <string>
+
+namespace
+{
+std::string ToString( double value, size_t significantDigits = 0 )
+{
+    char buffer[misc::MAX_DOUBLE_CHARS];
+    return std::string( buffer, misc::DoubleToChars( buffer, value, significantDigits ) );
+}
+}
+
+void TestFormatBuffer::TestDoubleToCharsShortest()
+{
+    TS_ASSERT_EQUALS( ToString( 0.0 ), "0" );
+    TS_ASSERT_EQUALS( ToString( -273.0 ), "-273" );
+    TS_ASSERT_EQUALS( ToString( 0.1 ), "0.1" );
+    TS_ASSERT_EQUALS( ToString( 3.7 ), "3.7" );
+    TS_ASSERT_EQUALS( ToString( 0.1 + 0.2 ), "0.30000000000000004" );
+    TS_ASSERT_EQUALS( ToString( 1e-5 ), "0.00001" );
+    TS_ASSERT_EQUALS( ToString( 1e22 ), "1e+22" );
+
+    // Every text is read back as the same value
+    double value = 1.0 / 3.0;
+    for ( size_t i = 0; i < 100; ++i, value *= -1.37 )
+        TS_ASSERT_EQUALS( strtod( ToString( value ).c_str(), 0 ), value );
+}
+
+void TestFormatBuffer::TestDoubleToCharsShortestWithManyDigits()
+{
+    // The mantissas of 16 and 17 digits exceed 2^53
+    TS_ASSERT_EQUALS( ToString( 0.099113477257976534 ), "0.09911347725797653" );
+    TS_ASSERT_EQUALS( ToString( 9529026114026.1719 ), "9529026114026.172" );
+    TS_ASSERT_EQUALS( ToString( 0.30000000000000004 ), "0.30000000000000004" );
+    TS_ASSERT_EQUALS( ToString( 9007199254740993.0 ), "9007199254740992" );
+
+    // Subnormal values have fewer significant digits
+    TS_ASSERT_EQUALS( ToString( 5e-324 ), "5e-324" );
+    TS_ASSERT_EQUALS( ToString( -2.5e-320 ), "-2.5e-320" );
+
+    // The correctly rounded 16 digits of 2^122 and 2^-1017 are not read back as the same value, but their neighbours
+    TS_ASSERT_EQUALS( ToString( 5.316911983139664e+36 ), "5.316911983139664e+36" );
+    TS_ASSERT_EQUALS( ToString( 7.120236347223045e-307 ), "7.120236347223045e-307" );
+}
+
+void TestFormatBuffer::TestDoubleToCharsSignificantDigits()
+{
+    TS_ASSERT_EQUALS( ToString( 3.14159, 3 ), "3.14" );
+    TS_ASSERT_EQUALS( ToString( 9.9999, 3 ), "10" );
+    TS_ASSERT_EQUALS( ToString( 0.000123456, 2 ), "0.00012" );
+    // 2.675 is stored as 2.67499999999999982236431605997495353221893310546875
+    TS_ASSERT_EQUALS( ToString( 2.675, 3 ), "2.67" );
+    TS_ASSERT_EQUALS( ToString( 123456.0, 2 ), "1.2e+05" );
+}
+
+void TestFormatBuffer::TestFormatBufferWrite()
+{
+    misc::FormatBuffer buffer( 0, 8 );
+    buffer << 1.5 << ", " << -1 << ", " << static_cast< size_t >( 42 ) << "\n";
+    TS_ASSERT( buffer.IsFull() );
+
+    std::ostringstream stream;
+    buffer.WriteTo( stream );
+    TS_ASSERT_EQUALS( stream.str(), "1.5, -1, 42\n" );
+    TS_ASSERT( !buffer.IsFull() );
+
+    buffer.WriteTo( stream );
+    TS_ASSERT_EQUALS( stream.str(), "1.5, -1, 42\n" );
+}
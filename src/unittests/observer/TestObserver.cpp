@@ -20,6 +20,11 @@ along with this program.  If not, see http://www.gnu.org/licenses/.
 _._._._._._._._._._._._._._._._._._._._._.*/
 #include "TestObserver.h"
 
+#include <algorithm>
+#include <iostream>
+#include <sstream>
+#include <string>
+
 #include "../../misc/matrixInclude.h"
 
 #include "../../electrical/zarc.h"
@@ -30,11 +35,129 @@ _._._._._._._._._._._._._._._._._._._._._.*/
 #include "../../system/system.h"
 
 #include "../../observer/twoPortObserver.h"
+#include "../../observer/filter/asyncFilter.h"
+#include "../../observer/filter/binaryFilter.h"
 #include "../../observer/filter/csvfilter.h"
 #include "../../observer/filter/decimatefilter.h"
+#include "../../observer/filter/selectFilter.h"
 #include "../../observer/filter/stdoutfilter.h"
 
 
+namespace
+{
+/// Stores the values it receives, so they can be checked after the observer has been destroyed
+class RecordFilter : public observer::Filter< myMatrixType, electrical::TwoPort, observer::PreparationType< myMatrixType > >
+{
+    public:
+    RecordFilter( std::vector< double > &values, electrical::TwoPort< myMatrixType > *&rootPort )
+        : mValues( values )
+        , mRootPort( rootPort ){};
+
+    virtual void PrepareFilter( observer::PreparationType< myMatrixType > &prepData ) { mRootPort = prepData.mRootPort; }
+
+    virtual void ProcessData( const Data_t &data, const double t )
+    {
+        mValues.push_back( t );
+        for ( size_t i = 0; i < data.size(); ++i )
+        {
+            mValues.push_back( data[i]->GetVoltageValue() );
+            mValues.push_back( data[i]->GetCurrentValue() );
+            mValues.push_back( data[i]->GetPowerValue() );
+            if ( data[i]->IsCellelement() )
+            {
+                electrical::Cellelement< myMatrixType > *cell = static_cast< electrical::Cellelement< myMatrixType > * >( data[i] );
+                mValues.push_back( cell->GetSocStateValue() );
+                mValues.push_back( cell->GetThermalState()->GetValue() );
+            }
+        }
+        mValues.push_back( mRootPort->GetVoltageValue() );
+    }
+
+    private:
+    std::vector< double > &mValues;
+    electrical::TwoPort< myMatrixType > *&mRootPort;
+};
+
+/// ThermalElement that can be created without a geometry
+class TestThermalElement : public thermal::ThermalElement< double >
+{
+    public:
+    TestThermalElement()
+        : thermal::ThermalElement< double >(){};
+};
+
+/// Stores the geometry it is prepared with and the times, the temperatures and the elements it receives
+class ThermalRecordFilter : public observer::Filter< double, thermal::ThermalElement, observer::ThermalPreperation >
+{
+    public:
+    virtual void PrepareFilter( observer::ThermalPreperation &prepData )
+    {
+        mAreas = prepData.mAreas;
+        mVolumes = prepData.mVolumes;
+        mVolumeNames.clear();
+        for ( size_t i = 0; i < prepData.mVolumeNames.size(); ++i )
+            mVolumeNames.push_back( static_cast< const char * >( prepData.mVolumeNames[i] ) );
+    }
+
+    virtual void ProcessData( const Data_t &data, const double t )
+    {
+        mTimes.push_back( t );
+        for ( size_t i = 0; i < data.size(); ++i )
+        {
+            mTemperatures.push_back( data[i]->GetTemperature() );
+            mElements.push_back( data[i] );
+        }
+    }
+
+    std::vector< std::vector< size_t > > mAreas;
+    std::vector< std::vector< size_t > > mVolumes;
+    std::vector< std::string > mVolumeNames;
+    std::vector< double > mTimes;
+    std::vector< double > mTemperatures;
+    std::vector< thermal::ThermalElement< double > * > mElements;
+};
+
+#ifdef BOOST_THREAD
+/// Blocks in the first call of ProcessData until Open() is called and stores the times it receives, so the writer
+/// thread of an AsyncFilter falls behind in a defined way
+class GateFilter : public observer::Filter< myMatrixType, electrical::TwoPort, observer::PreparationType< myMatrixType > >
+{
+    public:
+    GateFilter()
+        : mIsOpen( false ){};
+
+    void Open() { mIsOpen.store( true, boost::memory_order_release ); }
+
+    virtual void ProcessData( const Data_t &data, const double t )
+    {
+        UNUSED( data );
+        while ( !mIsOpen.load( boost::memory_order_acquire ) )
+            boost::this_thread::sleep( boost::posix_time::milliseconds( 1 ) );
+        mTimes.push_back( t );
+    }
+
+    std::vector< double > mTimes;
+
+    private:
+    boost::atomic< bool > mIsOpen;
+};
+#endif
+
+#ifdef __EXCEPTIONS__
+/// Throws in every call of ProcessData
+class ThrowFilter : public observer::Filter< myMatrixType, electrical::TwoPort, observer::PreparationType< myMatrixType > >
+{
+    public:
+    virtual void ProcessData( const Data_t &data, const double t )
+    {
+        UNUSED( data );
+        UNUSED( t );
+        throw std::runtime_error( "ThrowFilter" );
+    }
+};
+#endif
+}
+
 std::vector< std::vector< double > > TestObserver::CopyToVector( const double data[7][4] )
 {
     std::vector< std::vector< double > > returnvector( 7, std::vector< double >( 4, 0 ) );
@@ -199,3 +322,494 @@ void TestObserver::testObserverOperationsSingleCell()
         k( t );
     }
 }
+
+void TestObserver::testAsyncFilter()
+{
+    boost::shared_ptr< ::state::ThermalState< double > > tempState( new ::state::ThermalState< double >( 23 ) );
+    boost::shared_ptr< electrical::state::Soc > socState( new electrical::state::Soc( 2.05, 20, std::vector< double >() ) );
+    electrical::TwoPort< myMatrixType >::DataType cellValues( new ElectricalDataStruct< electrical::ScalarUnit > );
+    electrical::TwoPort< myMatrixType >::DataType portValues( new ElectricalDataStruct< electrical::ScalarUnit > );
+
+    std::vector< boost::shared_ptr< electrical::TwoPort< myMatrixType > > > twoPorts;
+    twoPorts.push_back( boost::shared_ptr< electrical::TwoPort< myMatrixType > >(
+     new electrical::Cellelement< myMatrixType >( tempState, socState, true, cellValues ) ) );
+    twoPorts.push_back( boost::shared_ptr< electrical::TwoPort< myMatrixType > >(
+     new electrical::TwoPort< myMatrixType >( true, portValues ) ) );
+
+    std::vector< double > expectedValues;
+    std::vector< double > values;
+    electrical::TwoPort< myMatrixType > *recordedRootPort = 0;
+    {
+        observer::TwoPortObserver< myMatrixType > k( twoPorts, twoPorts[0].get() );
+        observer::AsyncFilterTwoPort< myMatrixType > *asyncFilter = new observer::AsyncFilterTwoPort< myMatrixType >( 2 );
+        k.AddFilter( asyncFilter );
+        k.AddFilter( new RecordFilter( values, recordedRootPort ) );
+
+        TS_ASSERT( recordedRootPort );
+#ifdef BOOST_THREAD
+        // The following filters get a copy of the root port, which is not changed by the simulation thread
+        TS_ASSERT_DIFFERS( recordedRootPort, twoPorts[0].get() );
+#endif
+
+        for ( size_t i = 0; i < 200; ++i )
+        {
+            const double t = 0.1 * i;
+            cellValues->mVoltageValue = 3.0 + 0.001 * i;
+            cellValues->mCurrentValue = -2.0 * i;
+            cellValues->mPowerValue = 0.5 * i;
+            socState->UpdateCapacity( -1.0 );
+            tempState->ResetTemperature();
+            tempState->AddTemperature( 23.0 + 0.01 * i, 1.0 );
+            portValues->mVoltageValue = 1.0 + i;
+            portValues->mCurrentValue = 2.0 + i;
+            portValues->mPowerValue = 3.0 + i;
+
+            const double stepValues[] = {t,
+                                         cellValues->mVoltageValue,
+                                         cellValues->mCurrentValue,
+                                         cellValues->mPowerValue,
+                                         socState->GetValue(),
+                                         tempState->GetValue(),
+                                         portValues->mVoltageValue,
+                                         portValues->mCurrentValue,
+                                         portValues->mPowerValue,
+                                         cellValues->mVoltageValue};
+            expectedValues.insert( expectedValues.end(), stepValues, stepValues + 10 );
+            k( t );
+        }
+        TS_ASSERT_EQUALS( asyncFilter->GetNumberOfDroppedSnapshots(), 0 );
+    }
+
+    // The observer passes all queued snapshots to the following filters before they are destroyed
+    TS_ASSERT_EQUALS( values.size(), expectedValues.size() );
+    for ( size_t i = 0; i < values.size() && i < expectedValues.size(); ++i )
+        TS_ASSERT_EQUALS( values[i], expectedValues[i] );
+}
+
+void TestObserver::testAsyncFilterDrop()
+{
+#ifdef BOOST_THREAD
+    electrical::TwoPort< myMatrixType > twoPort( true, electrical::TwoPort< myMatrixType >::DataType(
+                                                        new ElectricalDataStruct< electrical::ScalarUnit > ) );
+    const std::vector< electrical::TwoPort< myMatrixType > * > data( 1, &twoPort );
+
+    GateFilter gateFilter;
+    {
+        observer::AsyncFilterTwoPort< myMatrixType > asyncFilter( 2, observer::ASYNC_DROP );
+        asyncFilter.SetNext( &gateFilter );
+
+        // The writer thread is stuck in the first snapshot, so only the first two snapshots fit into the queue
+        for ( size_t i = 0; i < 10; ++i )
+            asyncFilter.ProcessData( data, i );
+        TS_ASSERT_EQUALS( asyncFilter.GetNumberOfDroppedSnapshots(), 8 );
+
+        gateFilter.Open();
+    }
+
+    TS_ASSERT_EQUALS( gateFilter.mTimes.size(), 2 );
+    for ( size_t i = 0; i < gateFilter.mTimes.size(); ++i )
+        TS_ASSERT_EQUALS( gateFilter.mTimes[i], i );
+#endif
+}
+
+void TestObserver::testAsyncFilterDecimate()
+{
+#ifdef BOOST_THREAD
+    electrical::TwoPort< myMatrixType > twoPort( true, electrical::TwoPort< myMatrixType >::DataType(
+                                                        new ElectricalDataStruct< electrical::ScalarUnit > ) );
+    const std::vector< electrical::TwoPort< myMatrixType > * > data( 1, &twoPort );
+
+    GateFilter gateFilter;
+    {
+        observer::AsyncFilterTwoPort< myMatrixType > asyncFilter( 4, observer::ASYNC_DECIMATE );
+        asyncFilter.SetNext( &gateFilter );
+
+        // The writer thread is stuck in the first snapshot. Until the queue is half full every snapshot is queued,
+        // then every second one until the queue is full and none afterwards
+        for ( size_t i = 0; i < 10; ++i )
+            asyncFilter.ProcessData( data, i );
+        TS_ASSERT_EQUALS( asyncFilter.GetNumberOfDroppedSnapshots(), 6 );
+
+        gateFilter.Open();
+    }
+
+    const double expectedTimes[] = {0.0, 1.0, 3.0, 5.0};
+    TS_ASSERT_EQUALS( gateFilter.mTimes.size(), 4 );
+    for ( size_t i = 0; i < gateFilter.mTimes.size() && i < 4; ++i )
+        TS_ASSERT_EQUALS( gateFilter.mTimes[i], expectedTimes[i] );
+#endif
+}
+
+void TestObserver::testAsyncFilterThermal()
+{
+    std::vector< TestThermalElement > elements( 3 );
+    std::vector< thermal::ThermalElement< double > * > data;
+    for ( size_t i = 0; i < elements.size(); ++i )
+        data.push_back( &elements[i] );
+
+    std::vector< double > expectedTemperatures;
+    ThermalRecordFilter recordFilter;
+    {
+        observer::AsyncFilterThermal< double > asyncFilter( 2 );
+        asyncFilter.SetNext( &recordFilter );
+
+        for ( size_t i = 0; i < 50; ++i )
+        {
+            for ( size_t j = 0; j < elements.size(); ++j )
+            {
+                elements[j].SetTemperature( 20.0 + i + 0.1 * j );
+                expectedTemperatures.push_back( elements[j].GetTemperature() );
+            }
+            asyncFilter.ProcessData( data, 0.5 * i );
+        }
+        TS_ASSERT_EQUALS( asyncFilter.GetNumberOfDroppedSnapshots(), 0 );
+    }
+
+    TS_ASSERT_EQUALS( recordFilter.mTimes.size(), 50 );
+    for ( size_t i = 0; i < recordFilter.mTimes.size(); ++i )
+        TS_ASSERT_EQUALS( recordFilter.mTimes[i], 0.5 * i );
+    TS_ASSERT_EQUALS( recordFilter.mTemperatures.size(), expectedTemperatures.size() );
+    for ( size_t i = 0; i < recordFilter.mTemperatures.size() && i < expectedTemperatures.size(); ++i )
+        TS_ASSERT_EQUALS( recordFilter.mTemperatures[i], expectedTemperatures[i] );
+#ifdef BOOST_THREAD
+    // The following filters get copies of the elements, which are not changed by the simulation thread
+    for ( size_t i = 0; i < recordFilter.mElements.size(); ++i )
+        TS_ASSERT( std::find( data.begin(), data.end(), recordFilter.mElements[i] ) == data.end() );
+#endif
+}
+
+void TestObserver::testAsyncFilterRethrowsWriterError()
+{
+#if defined( BOOST_THREAD ) && defined( __EXCEPTIONS__ )
+    electrical::TwoPort< myMatrixType > twoPort( true, electrical::TwoPort< myMatrixType >::DataType(
+                                                        new ElectricalDataStruct< electrical::ScalarUnit > ) );
+    const std::vector< electrical::TwoPort< myMatrixType > * > data( 1, &twoPort );
+
+    ThrowFilter throwFilter;
+    observer::AsyncFilterTwoPort< myMatrixType > asyncFilter( 1 );
+    asyncFilter.SetNext( &throwFilter );
+
+    // With a single slot, the third call has to wait until the writer thread has handled the first snapshot, so the
+    // error is thrown on the simulation thread at the latest by this call
+    std::string message;
+    for ( size_t i = 0; i < 3 && message.empty(); ++i )
+    {
+        try
+        {
+            asyncFilter.ProcessData( data, i );
+        }
+        catch ( const std::runtime_error &e )
+        {
+            message = e.what();
+        }
+    }
+    TS_ASSERT_EQUALS( message, "ThrowFilter" );
+
+    // The error is only thrown once, afterwards the snapshots are discarded without blocking the simulation
+    for ( size_t i = 0; i < 10; ++i )
+        TS_ASSERT_THROWS_NOTHING( asyncFilter.ProcessData( data, i ) );
+
+    // An error of the last snapshot is printed by the destructor
+    std::ostringstream errorOutput;
+    std::streambuf *errorBuffer = std::cerr.rdbuf( errorOutput.rdbuf() );
+    {
+        ThrowFilter lastThrowFilter;
+        observer::AsyncFilterTwoPort< myMatrixType > lastAsyncFilter( 1 );
+        lastAsyncFilter.SetNext( &lastThrowFilter );
+        lastAsyncFilter.ProcessData( data, 0.0 );
+    }
+    std::cerr.rdbuf( errorBuffer );
+    TS_ASSERT_EQUALS( errorOutput.str(), "AsyncFilter could not write all snapshots: ThrowFilter\n" );
+#endif
+}
+
+void TestObserver::testBinaryFilter()
+{
+    boost::shared_ptr< ::state::ThermalState< double > > tempState( new ::state::ThermalState< double >( 23 ) );
+    boost::shared_ptr< electrical::state::Soc > socState( new electrical::state::Soc( 2.05, 20, std::vector< double >() ) );
+    electrical::TwoPort< myMatrixType >::DataType cellValues( new ElectricalDataStruct< electrical::ScalarUnit > );
+    electrical::TwoPort< myMatrixType >::DataType portValues( new ElectricalDataStruct< electrical::ScalarUnit > );
+
+    std::vector< boost::shared_ptr< electrical::TwoPort< myMatrixType > > > twoPorts;
+    twoPorts.push_back( boost::shared_ptr< electrical::TwoPort< myMatrixType > >(
+     new electrical::Cellelement< myMatrixType >( tempState, socState, true, cellValues ) ) );
+    twoPorts.push_back( boost::shared_ptr< electrical::TwoPort< myMatrixType > >(
+     new electrical::TwoPort< myMatrixType >( true, portValues ) ) );
+
+    {
+        observer::TwoPortObserver< myMatrixType > k( twoPorts, twoPorts[0].get() );
+        k.AddFilter( new observer::BinaryFilterTwoPort< myMatrixType >( "binaryfiltertest.bin" ) );
+        for ( size_t i = 0; i < 10; ++i )
+        {
+            cellValues->mVoltageValue = 3.0 + 0.001 * i;
+            cellValues->mCurrentValue = -2.0 * i;
+            portValues->mVoltageValue = 1.0 + i;
+            k( 0.1 * i );
+        }
+    }
+
+    observer::BinaryResultReader reader( "binaryfiltertest.bin" );
+    TS_ASSERT_EQUALS( reader.GetNumberOfRecords(), 10 );
+    TS_ASSERT_EQUALS( reader.GetNumberOfQuantities(), 5 );
+    TS_ASSERT_EQUALS( reader.GetName( 1 ), "Current" );
+    TS_ASSERT_EQUALS( reader.GetUnit( 1 ), "A" );
+
+    // Both two ports and the root port
+    TS_ASSERT_EQUALS( reader.GetNumberOfElements(), 3 );
+    TS_ASSERT_EQUALS( reader.GetElementId( 0 ), 1 );
+    TS_ASSERT_EQUALS( reader.GetElementId( 1 ), 2 );
+    TS_ASSERT_EQUALS( reader.GetElementId( 2 ), -1 );
+
+    for ( size_t i = 0; i < reader.GetNumberOfRecords(); ++i )
+    {
+        TS_ASSERT_EQUALS( reader.GetTime( i ), 0.1 * i );
+        TS_ASSERT_EQUALS( reader.GetValue( i, 0, 0 ), 3.0 + 0.001 * i );
+        TS_ASSERT_EQUALS( reader.GetValue( i, 1, 0 ), -2.0 * i );
+        TS_ASSERT_EQUALS( reader.GetValue( i, 0, 1 ), 1.0 + i );
+        TS_ASSERT_EQUALS( reader.GetValue( i, 0, 2 ), 3.0 + 0.001 * i );
+        TS_ASSERT_EQUALS( reader.GetValue( i, 3, 1 ), -1.0 );
+    }
+}
+
+void TestObserver::testBinaryResultFileSinglePrecision()
+{
+    const std::vector< std::string > names( 1, "Temperature" );
+    const std::vector< std::string > units( 1, "°C" );
+    const std::vector< boost::int64_t > elementIds( 3, 7 );
+    {
+        // A buffer smaller than a point of time gives chunks of one point of time
+        observer::BinaryResultWriter writer( "binaryresultsingle.bin", names, units, elementIds, sizeof( float ), 1 );
+        for ( size_t i = 0; i < 5; ++i )
+            writer.Write( 0.5 * i, std::vector< double >( 3, 20.1 + i ) );
+        TS_ASSERT_THROWS( writer.Write( 3.0, std::vector< double >( 2, 0.0 ) ), std::runtime_error );
+    }
+
+    {
+        observer::BinaryResultReader reader( "binaryresultsingle.bin" );
+        TS_ASSERT_EQUALS( reader.GetSizeOfValue(), sizeof( float ) );
+        TS_ASSERT_EQUALS( reader.GetNumberOfRecords(), 5 );
+        TS_ASSERT_EQUALS( reader.GetUnit( 0 ), "°C" );
+        TS_ASSERT_EQUALS( reader.GetElementId( 2 ), 7 );
+        for ( size_t i = 0; i < 5; ++i )
+        {
+            TS_ASSERT_EQUALS( reader.GetTime( i ), 0.5 * i );
+            TS_ASSERT_EQUALS( reader.GetValue( i, 0, 2 ), static_cast< float >( 20.1 + i ) );
+        }
+        TS_ASSERT_THROWS( reader.GetTime( 5 ), std::out_of_range );
+    }
+
+    // A record cut by a crash is left out
+    {
+        std::ofstream file( "binaryresultsingle.bin", std::ios::out | std::ios::binary | std::ios::app );
+        file.write( "\0\0\0", 3 );
+    }
+    observer::BinaryResultReader reader( "binaryresultsingle.bin" );
+    TS_ASSERT_EQUALS( reader.GetNumberOfRecords(), 5 );
+
+    TS_ASSERT_THROWS( observer::BinaryResultReader( "binaryresultmissing.bin" ), std::runtime_error );
+}
+
+void TestObserver::testBinaryResultFileChunks()
+{
+    std::vector< std::string > names;
+    names.push_back( "Voltage" );
+    names.push_back( "Current" );
+    const std::vector< std::string > units( 2, "V" );
+    std::vector< boost::int64_t > elementIds;
+    for ( size_t i = 0; i < 3; ++i )
+        elementIds.push_back( 10 + i );
+
+    // A point of time takes 8 bytes for the time and 6 values of 8 bytes, so that a chunk holds 4 of them
+    const size_t bufferSize = 4 * ( sizeof( double ) + 6 * sizeof( double ) );
+    const size_t numberOfRecords = 11;
+    {
+        observer::BinaryResultWriter writer( "binaryresultchunks.bin", names, units, elementIds, sizeof( double ), bufferSize );
+        for ( size_t i = 0; i < numberOfRecords; ++i )
+        {
+            std::vector< double > values;
+            for ( size_t quantity = 0; quantity < 2; ++quantity )
+                for ( size_t element = 0; element < 3; ++element )
+                    values.push_back( 100.0 * quantity + 10.0 * element + i );
+            writer.Write( 0.25 * i, values );
+
+            // Gives chunks of 4, 2, 4 and 1 points of time
+            if ( i == 5 )
+                writer.Flush();
+        }
+    }
+
+    observer::BinaryResultReader reader( "binaryresultchunks.bin" );
+    TS_ASSERT_EQUALS( reader.GetNumberOfRecords(), numberOfRecords );
+    TS_ASSERT_EQUALS( reader.GetName( 1 ), "Current" );
+    TS_ASSERT_EQUALS( reader.GetElementId( 2 ), 12 );
+    for ( size_t i = 0; i < numberOfRecords; ++i )
+    {
+        TS_ASSERT_EQUALS( reader.GetTime( i ), 0.25 * i );
+        for ( size_t quantity = 0; quantity < 2; ++quantity )
+            for ( size_t element = 0; element < 3; ++element )
+                TS_ASSERT_EQUALS( reader.GetValue( i, quantity, element ), 100.0 * quantity + 10.0 * element + i );
+    }
+
+    std::vector< double > values;
+    for ( size_t quantity = 0; quantity < 2; ++quantity )
+        for ( size_t element = 0; element < 3; ++element )
+        {
+            reader.GetValues( quantity, element, values );
+            TS_ASSERT_EQUALS( values.size(), numberOfRecords );
+            for ( size_t i = 0; i < values.size(); ++i )
+                TS_ASSERT_EQUALS( values[i], 100.0 * quantity + 10.0 * element + i );
+        }
+    TS_ASSERT_THROWS( reader.GetValues( 2, 0, values ), std::out_of_range );
+
+    // All chunks have the same size, also the flushed one and the last one
+    const size_t sizeOfChunk = observer::BinaryResultFormat::GetSizeOfChunk( sizeof( double ), 2, 3, 4 );
+    TS_ASSERT_EQUALS( sizeOfChunk, sizeof( boost::uint64_t ) + 4 * sizeof( double ) + 2 * 3 * 4 * sizeof( double ) );
+    std::ifstream file( "binaryresultchunks.bin", std::ios::in | std::ios::binary | std::ios::ate );
+    observer::BinaryResultFormat::Header header;
+    const std::streamoff fileSize = file.tellg();
+    file.seekg( 0 );
+    file.read( reinterpret_cast< char * >( &header ), sizeof( header ) );
+    TS_ASSERT_EQUALS( header.mRecordsPerChunk, 4 );
+    TS_ASSERT_EQUALS( header.mSizeOfChunk, sizeOfChunk );
+    TS_ASSERT_EQUALS( static_cast< size_t >( fileSize ), header.mSizeOfHeader + 4 * sizeOfChunk );
+
+    // The column block of a quantity holds the time series of one element after the other
+    std::vector< boost::uint64_t > columnBlockIndex( 2 );
+    file.seekg( sizeof( header ) + 3 * sizeof( boost::int64_t ) );
+    file.read( reinterpret_cast< char * >( &columnBlockIndex[0] ), 2 * sizeof( boost::uint64_t ) );
+    TS_ASSERT_EQUALS( columnBlockIndex[1], observer::BinaryResultFormat::GetColumnBlockOffset( sizeof( double ), 3, 4, 1 ) );
+    std::vector< double > firstColumn( 4 );
+    file.seekg( header.mSizeOfHeader + columnBlockIndex[1] + 4 * sizeof( double ) );
+    file.read( reinterpret_cast< char * >( &firstColumn[0] ), 4 * sizeof( double ) );
+    for ( size_t i = 0; i < firstColumn.size(); ++i )
+        TS_ASSERT_EQUALS( firstColumn[i], 110.0 + i );
+}
+
+void TestObserver::testSelectFilter()
+{
+    boost::shared_ptr< ::state::ThermalState< double > > tempState( new ::state::ThermalState< double >( 23 ) );
+    boost::shared_ptr< electrical::state::Soc > socState( new electrical::state::Soc( 2.05, 20, std::vector< double >() ) );
+    electrical::TwoPort< myMatrixType >::DataType cellValues( new ElectricalDataStruct< electrical::ScalarUnit > );
+    electrical::TwoPort< myMatrixType >::DataType portValues( new ElectricalDataStruct< electrical::ScalarUnit > );
+
+    std::vector< boost::shared_ptr< electrical::TwoPort< myMatrixType > > > twoPorts;
+    twoPorts.push_back( boost::shared_ptr< electrical::TwoPort< myMatrixType > >(
+     new electrical::Cellelement< myMatrixType >( tempState, socState, true, cellValues ) ) );
+    twoPorts.push_back( boost::shared_ptr< electrical::TwoPort< myMatrixType > >(
+     new electrical::TwoPort< myMatrixType >( true, portValues ) ) );
+    twoPorts.push_back( boost::shared_ptr< electrical::TwoPort< myMatrixType > >(
+     new electrical::Cellelement< myMatrixType >( tempState, socState, true, cellValues ) ) );
+
+    {
+        observer::TwoPortObserver< myMatrixType > k( twoPorts, twoPorts[0].get() );
+        observer::SelectFilterTwoPort< myMatrixType > *selectFilter = new observer::SelectFilterTwoPort< myMatrixType >();
+
+        observer::ElementSelection portSelection;
+        portSelection.mRanges.push_back( std::make_pair( 2, 2 ) );
+        selectFilter->AddGroup( portSelection )
+         .AddFilter( boost::shared_ptr< observer::Filter< myMatrixType, electrical::TwoPort, observer::PreparationType< myMatrixType > > >(
+          new observer::BinaryFilterTwoPort< myMatrixType >( "selectfilterport.bin" ) ) );
+
+        observer::ElementSelection cellSelection;
+        cellSelection.mNames.push_back( "Cellelement" );
+        cellSelection.mTimeDelay = 0.25;
+        selectFilter->AddGroup( cellSelection )
+         .AddFilter( boost::shared_ptr< observer::Filter< myMatrixType, electrical::TwoPort, observer::PreparationType< myMatrixType > > >(
+          new observer::BinaryFilterTwoPort< myMatrixType >( "selectfiltercells.bin" ) ) );
+
+        k.AddFilter( selectFilter );
+        for ( size_t i = 0; i < 10; ++i )
+        {
+            cellValues->mVoltageValue = 3.0 + 0.001 * i;
+            portValues->mVoltageValue = 1.0 + i;
+            k( 0.1 * i );
+        }
+    }
+
+    // The selected elements are numbered from 1, the root port is passed as well
+    observer::BinaryResultReader portReader( "selectfilterport.bin" );
+    TS_ASSERT_EQUALS( portReader.GetNumberOfRecords(), 10 );
+    TS_ASSERT_EQUALS( portReader.GetNumberOfElements(), 2 );
+    TS_ASSERT_EQUALS( portReader.GetElementId( 1 ), -1 );
+    for ( size_t i = 0; i < portReader.GetNumberOfRecords(); ++i )
+        TS_ASSERT_EQUALS( portReader.GetValue( i, 0, 0 ), 1.0 + i );
+
+    observer::BinaryResultReader cellReader( "selectfiltercells.bin" );
+    TS_ASSERT_EQUALS( cellReader.GetNumberOfRecords(), 4 );
+    TS_ASSERT_EQUALS( cellReader.GetNumberOfElements(), 3 );
+    for ( size_t i = 0; i < cellReader.GetNumberOfRecords(); ++i )
+    {
+        TS_ASSERT_EQUALS( cellReader.GetTime( i ), 0.1 * ( 3 * i ) );
+        TS_ASSERT_EQUALS( cellReader.GetValue( i, 0, 0 ), 3.0 + 0.001 * ( 3 * i ) );
+        TS_ASSERT_EQUALS( cellReader.GetValue( i, 0, 1 ), 3.0 + 0.001 * ( 3 * i ) );
+    }
+
+    observer::TwoPortObserver< myMatrixType > k( twoPorts );
+    boost::shared_ptr< observer::SelectFilterTwoPort< myMatrixType > > outOfRange(
+     new observer::SelectFilterTwoPort< myMatrixType >() );
+    observer::ElementSelection selection;
+    selection.mRanges.push_back( std::make_pair( 3, 4 ) );
+    outOfRange->AddGroup( selection );
+    TS_ASSERT_THROWS( k.AddFilter( outOfRange ), std::out_of_range );
+}
+
+void TestObserver::testSelectFilterThermal()
+{
+    std::vector< TestThermalElement > elements( 4 );
+    std::vector< thermal::ThermalElement< double > * > data;
+    for ( size_t i = 0; i < elements.size(); ++i )
+    {
+        elements[i].SetTemperature( 20.0 + i );
+        data.push_back( &elements[i] );
+    }
+
+    std::vector< std::vector< size_t > > areas;
+    for ( size_t i = 0; i < elements.size(); ++i )
+        areas.push_back( std::vector< size_t >( 3, 10 * i ) );
+    // The volumes hold area numbers counted from 1
+    std::vector< std::vector< size_t > > volumes( 3 );
+    volumes[0].push_back( 1 );
+    volumes[0].push_back( 2 );
+    volumes[1].push_back( 3 );
+    volumes[1].push_back( 4 );
+    volumes[2].push_back( 2 );
+    volumes[2].push_back( 3 );
+    std::vector< misc::StrCont > volumeNames;
+    volumeNames.push_back( "first" );
+    volumeNames.push_back( "second" );
+    volumeNames.push_back( "middle" );
+    std::vector< geometry::Cartesian< double > > vertices;
+    observer::ThermalPreperation prepData( areas, volumes, volumeNames, vertices );
+
+    // The group owns its filters
+    ThermalRecordFilter *recordFilter = new ThermalRecordFilter;
+    observer::SelectFilterThermal< double > selectFilter;
+    observer::ElementSelection selection;
+    selection.mRanges.push_back( std::make_pair( 1, 1 ) );
+    selection.mRanges.push_back( std::make_pair( 4, 4 ) );
+    selectFilter.AddGroup( selection )
+     .AddFilter( boost::shared_ptr< observer::Filter< double, thermal::ThermalElement, observer::ThermalPreperation > >(
+      recordFilter ) );
+
+    // Preparing twice must give the same geometry
+    for ( size_t i = 0; i < 2; ++i )
+    {
+        selectFilter.PrepareFilter( prepData );
+
+        // Areas 1 and 4 become areas 1 and 2, the volume made only of areas 2 and 3 is dropped
+        TS_ASSERT_EQUALS( recordFilter->mAreas.size(), 2 );
+        TS_ASSERT( recordFilter->mAreas.size() == 2 && recordFilter->mAreas[0] == areas[0] && recordFilter->mAreas[1] == areas[3] );
+        TS_ASSERT_EQUALS( recordFilter->mVolumes.size(), 2 );
+        TS_ASSERT( recordFilter->mVolumes.size() == 2 && recordFilter->mVolumes[0] == std::vector< size_t >( 1, 1 ) &&
+                   recordFilter->mVolumes[1] == std::vector< size_t >( 1, 2 ) );
+        TS_ASSERT_EQUALS( recordFilter->mVolumeNames.size(), 2 );
+        TS_ASSERT( recordFilter->mVolumeNames.size() == 2 && recordFilter->mVolumeNames[0] == "first" &&
+                   recordFilter->mVolumeNames[1] == "second" );
+    }
+
+    selectFilter.ProcessData( data, 0.5 );
+    TS_ASSERT_EQUALS( recordFilter->mTimes.size(), 1 );
+    TS_ASSERT_EQUALS( recordFilter->mTemperatures.size(), 2 );
+    TS_ASSERT_EQUALS( recordFilter->mElements.size(), 2 );
+    TS_ASSERT( recordFilter->mElements.size() == 2 && recordFilter->mElements[0] == data[0] && recordFilter->mElements[1] == data[3] );
+}
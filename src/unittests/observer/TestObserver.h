@@ -26,6 +26,16 @@ class TestObserver : public CxxTest::TestSuite
 
     public:
     void testObserverOperationsSingleCell();
+    void testAsyncFilter();
+    void testAsyncFilterDrop();
+    void testAsyncFilterDecimate();
+    void testAsyncFilterThermal();
+    void testAsyncFilterRethrowsWriterError();
+    void testBinaryFilter();
+    void testBinaryResultFileSinglePrecision();
+    void testBinaryResultFileChunks();
+    void testSelectFilter();
+    void testSelectFilterThermal();
 
     private:
     std::vector< std::vector< double > > CopyToVector( const double data[7][4] );
@@ -0,0 +1,90 @@
+/*
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see http://www.gnu.org/licenses/.
+*/
+/* -.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.
+* File Name : TestCachedSparseLu.cpp
+* Creation Date : 17-10-2026
+_._._._._._._._._._._._._._._._._._._._._.*/
+#include "TestCachedSparseLu.h"
+#include "../../system/cachedSparseLu.h"
+
+#if defined( _EIGEN_ ) || defined( USE_EIGEN )
+static systm::CachedSparseLU::MatrixType CreateMatrix( double a00, double a01, double a10, double a11 )
+{
+    systm::CachedSparseLU::MatrixType matrix( 2, 2 );
+    if ( a00 != 0.0 )
+        matrix.insert( 0, 0 ) = a00;
+    if ( a01 != 0.0 )
+        matrix.insert( 0, 1 ) = a01;
+    if ( a10 != 0.0 )
+        matrix.insert( 1, 0 ) = a10;
+    if ( a11 != 0.0 )
+        matrix.insert( 1, 1 ) = a11;
+    return matrix;
+}
+#endif
+
+void TestCachedSparseLu::testFactorizationIsReused()
+{
+#if defined( _EIGEN_ ) || defined( USE_EIGEN )
+    systm::CachedSparseLU solver;
+    TS_ASSERT( !solver.IsFactorized() );
+
+    solver.Factorize( CreateMatrix( 4.0, 2.0, -2.0, 3.0 ) );
+    solver.Factorize( CreateMatrix( 4.0, 2.0, -2.0, 3.0 ) );
+    TS_ASSERT( solver.IsFactorized() );
+    TS_ASSERT_EQUALS( solver.GetAnalyzePatternCount(), 1 );
+    TS_ASSERT_EQUALS( solver.GetFactorizationCount(), 1 );
+
+    Eigen::VectorXd b( 2 );
+    b << 8.0, 1.0;
+    Eigen::VectorXd x = solver.GetSolver().solve( b );
+    TS_ASSERT_DELTA( x( 0 ), 1.375, 0.000001 );
+    TS_ASSERT_DELTA( x( 1 ), 1.25, 0.000001 );
+#endif
+}
+
+void TestCachedSparseLu::testRefactorizationOnNewValues()
+{
+#if defined( _EIGEN_ ) || defined( USE_EIGEN )
+    systm::CachedSparseLU solver;
+    solver.Factorize( CreateMatrix( 4.0, 2.0, -2.0, 3.0 ) );
+    solver.Factorize( CreateMatrix( 5.0, 2.0, -2.0, 3.0 ) );
+    TS_ASSERT_EQUALS( solver.GetAnalyzePatternCount(), 1 );
+    TS_ASSERT_EQUALS( solver.GetFactorizationCount(), 2 );
+
+    Eigen::VectorXd b( 2 );
+    b << 1.0, 0.0;
+    Eigen::VectorXd x = solver.GetSolver().solve( b );
+    TS_ASSERT_DELTA( x( 0 ), 3.0 / 19.0, 0.000001 );
+    TS_ASSERT_DELTA( x( 1 ), 2.0 / 19.0, 0.000001 );
+#endif
+}
+
+void TestCachedSparseLu::testNewAnalysisOnNewPattern()
+{
+#if defined( _EIGEN_ ) || defined( USE_EIGEN )
+    systm::CachedSparseLU solver;
+    solver.Factorize( CreateMatrix( 4.0, 2.0, -2.0, 3.0 ) );
+    solver.Factorize( CreateMatrix( 4.0, 0.0, 0.0, 3.0 ) );
+    TS_ASSERT_EQUALS( solver.GetAnalyzePatternCount(), 2 );
+    TS_ASSERT_EQUALS( solver.GetFactorizationCount(), 2 );
+
+    Eigen::VectorXd b( 2 );
+    b << 8.0, 6.0;
+    Eigen::VectorXd x = solver.GetSolver().solve( b );
+    TS_ASSERT_DELTA( x( 0 ), 2.0, 0.000001 );
+    TS_ASSERT_DELTA( x( 1 ), 2.0, 0.000001 );
+#endif
+}
@@ -0,0 +1,31 @@
+/*
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see http://www.gnu.org/licenses/.
+*/
+/* -.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.
+* File Name : TestCachedSparseLu.h
+* Creation Date : 17-10-2026
+_._._._._._._._._._._._._._._._._._._._._.*/
+#ifndef _TESTCACHEDSPARSELU_
+#define _TESTCACHEDSPARSELU_
+#include <cxxtest/TestSuite.h>
+
+/// Tests that the LU factorization is only recomputed if the matrix changes
+class TestCachedSparseLu : public CxxTest::TestSuite
+{
+    public:
+    void testFactorizationIsReused();
+    void testRefactorizationOnNewValues();
+    void testNewAnalysisOnNewPattern();
+};
+#endif /* _TESTCACHEDSPARSELU_ */
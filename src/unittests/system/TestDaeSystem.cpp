@@ -245,6 +245,74 @@ void TestDaeSystem::testDaeSystemMixedSystemCurrentSolveableIntegrate()
     }
 }
 
+void TestDaeSystem::testDaeSystemRepeatedEvaluationAfterCurrentChange()
+{
+    boost::scoped_ptr< electrical::ParallelTwoPort<> > parallel( new electrical::ParallelTwoPort<>() );
+
+    boost::shared_ptr< electrical::ParallelTwoPort<> > p1( new electrical::ParallelTwoPort<>() );
+    parallel->AddChild( p1 );
+
+    boost::shared_ptr< electrical::SerialTwoPort<> > s11( new electrical::SerialTwoPort<>() );
+    boost::shared_ptr< electrical::SerialTwoPort<> > s12( new electrical::SerialTwoPort<>() );
+    p1->AddChild( s11 );
+    p1->AddChild( s12 );
+
+    s11->AddChild( new electrical::Capacity<>( new object::ConstObj< double >( 10 ) ) );
+    s11->AddChild( new electrical::OhmicResistance<>( new object::ConstObj< double >( 2 ) ) );
+    s12->AddChild( new electrical::Capacity<>( new object::ConstObj< double >( 5 ) ) );
+    s12->AddChild( new electrical::OhmicResistance<>( new object::ConstObj< double >( 2 ) ) );
+
+    boost::shared_ptr< electrical::SerialTwoPort<> > s2( new electrical::SerialTwoPort<>() );
+    parallel->AddChild( s2 );
+
+    s2->AddChild( new electrical::OhmicResistance<>( new object::ConstObj< double >( 3 ) ) );
+    s2->AddChild( new electrical::VoltageSource<>( new object::ConstObj< double >( 2.5 ) ) );
+
+    systm::StateSystemGroup< myMatrixType > stateSystemGroup;
+    parallel->SetSystem( &stateSystemGroup );
+    stateSystemGroup.Initialize();
+    parallel->SetInitialCurrent( 4.0 );
+    parallel->UpdateStateSystemGroup();
+
+    systm::DifferentialAlgebraicSystem< myMatrixType > test( &stateSystemGroup );
+    test.PrepareEquationSystem();
+
+    const double xData[] = {1.0, 2.0, 3.0, 4.0};
+    std::vector< double > x( xData, xData + 4 );
+    std::vector< double > dxdtFirst;
+    std::vector< double > dxdtSecond;
+
+    // The algebraic part must yield the same result on every evaluation of the same system
+    test( x, dxdtFirst, 0.0 );
+    test( x, dxdtSecond, 0.0 );
+    for ( size_t i = 0; i < x.size(); ++i )
+        TS_ASSERT_DELTA( dxdtFirst.at( i ), dxdtSecond.at( i ), 0.000001 );
+
+    // ODEIFIED
+    // 0 0 -0.1 -0.1 0.4
+    // 0 0 0.2 0 0
+    // 0 0 -0.08125 -0.01875 0.075
+    // 0 0 0.0125 -0.0125 0.05
+    TS_ASSERT_DELTA( dxdtFirst.at( 0 ), -0.3, 0.000001 );
+    TS_ASSERT_DELTA( dxdtFirst.at( 1 ), 0.6, 0.000001 );
+    TS_ASSERT_DELTA( dxdtFirst.at( 2 ), -0.24375, 0.000001 );
+    TS_ASSERT_DELTA( dxdtFirst.at( 3 ), 0.0375, 0.000001 );
+
+    // A new current changes the constant part, a freshly built system has to agree with the reused one
+    parallel->SetCurrent( 8.0 );
+    parallel->UpdateStateSystemGroup();
+    test.PrepareEquationSystem();
+    test( x, dxdtFirst, 0.0 );
+
+    systm::DifferentialAlgebraicSystem< myMatrixType > reference( &stateSystemGroup );
+    reference.PrepareEquationSystem();
+    reference( x, dxdtSecond, 0.0 );
+
+    TS_ASSERT_DELTA( dxdtFirst.at( 0 ), 0.1, 0.000001 );
+    for ( size_t i = 0; i < x.size(); ++i )
+        TS_ASSERT_DELTA( dxdtFirst.at( i ), dxdtSecond.at( i ), 0.000001 );
+}
+
 void TestDaeSystem::testRC()
 {
     boost::shared_ptr< electrical::ParallelTwoPort<> > parallel( new electrical::ParallelTwoPort<>() );
@@ -994,3 +1062,211 @@ void TestDaeSystem::testVariableStepSolverWithParallelRCMindingResults()
     }
 #endif
 }
+
+void TestDaeSystem::testImplicitSolverWithParallelRCMindingResults()
+{
+#if defined( _EIGEN_ ) || defined( USE_EIGEN )
+    boost::shared_ptr< electrical::SerialTwoPort<> > serial( new electrical::SerialTwoPort<>() );
+
+    boost::shared_ptr< object::Object< double > > objR( new object::ConstObj< double >( 0.6 ) );
+    boost::shared_ptr< object::Object< double > > objTau( new object::ConstObj< double >( 0.6 * 0.5 ) );
+    boost::shared_ptr< electrical::ParallelRC<> > parallelRC( new electrical::ParallelRC<>( objR, objTau, true ) );
+
+    serial->AddChild( parallelRC );
+
+    double t = 0.0;
+
+    systm::StateSystemGroup< myMatrixType > stateSystemGroup;
+    serial->SetSystem( &stateSystemGroup );
+    stateSystemGroup.Initialize();
+    serial->SetInitialCurrent( 2.0 );
+    serial->UpdateStateSystemGroup();
+
+    systm::ImplicitDglSystemSolver< myMatrixType > solver( &stateSystemGroup, 0.0 );
+
+    while ( t < 1.0 )
+    {
+        serial->UpdateStateSystemGroup();
+        t = solver.Solve();
+        serial->CalculateStateDependentValues();
+        TS_ASSERT_DELTA( serial->GetVoltageValue(), 2.0 * 0.6 * ( 1 - exp( -( t - 0.0 ) / 0.3 ) ), 0.01 );
+    }
+    double lastCurrentSwitchTime = t;
+    double lastVoltageValue = serial->GetVoltageValue();
+
+    serial->SetCurrent( -0.4 );
+    while ( t < 3.0 )
+    {
+        serial->UpdateStateSystemGroup();
+        t = solver.Solve();
+        serial->CalculateStateDependentValues();
+        TS_ASSERT_DELTA( serial->GetVoltageValue(),
+                         ( lastVoltageValue + 0.4 * 0.6 ) * exp( -( t - lastCurrentSwitchTime ) / 0.3 ) - 0.4 * 0.6, 0.01 );
+    }
+#endif
+}
+
+void TestDaeSystem::testImplicitSolverStiffParallelRC()
+{
+#if defined( _EIGEN_ ) || defined( USE_EIGEN )
+    // tau = 1e-5 s with dt = 0.1 s: the explicit solvers diverge or need 1e4 times more steps
+    boost::shared_ptr< electrical::SerialTwoPort<> > serial( new electrical::SerialTwoPort<>() );
+
+    boost::shared_ptr< object::Object< double > > objR( new object::ConstObj< double >( 0.6 ) );
+    boost::shared_ptr< object::Object< double > > objTau( new object::ConstObj< double >( 1e-5 ) );
+    boost::shared_ptr< electrical::ParallelRC<> > parallelRC( new electrical::ParallelRC<>( objR, objTau, true ) );
+
+    serial->AddChild( parallelRC );
+
+    systm::StateSystemGroup< myMatrixType > stateSystemGroup;
+    serial->SetSystem( &stateSystemGroup );
+    stateSystemGroup.Initialize();
+    serial->SetInitialCurrent( 2.0 );
+    serial->UpdateStateSystemGroup();
+
+    systm::ImplicitDglSystemSolver< myMatrixType > solver( &stateSystemGroup, 0.1 );
+
+    double t = 0.0;
+    for ( size_t i = 0; i < 10; ++i )
+    {
+        serial->UpdateStateSystemGroup();
+        t = solver.Solve();
+        serial->CalculateStateDependentValues();
+        if ( t > 0.25 )
+            TS_ASSERT_DELTA( serial->GetVoltageValue(), 2.0 * 0.6, 0.001 );
+    }
+    TS_ASSERT_DELTA( t, 1.0, 1e-9 );
+    // the linear system does not change between the steps, the iteration matrix is factorized only once
+    TS_ASSERT_EQUALS( solver.GetFactorizationCount(), 1 );
+
+    // the same problem selected through systm::System
+    boost::shared_ptr< electrical::SerialTwoPort<> > otherSerial( new electrical::SerialTwoPort<>() );
+    otherSerial->AddChild( boost::shared_ptr< electrical::ParallelRC<> >( new electrical::ParallelRC<>( objR, objTau, true ) ) );
+
+    systm::StateSystemGroup< myMatrixType > otherStateSystemGroup;
+    otherSerial->SetSystem( &otherStateSystemGroup );
+    otherStateSystemGroup.Initialize();
+    otherSerial->SetInitialCurrent( 2.0 );
+    otherSerial->UpdateStateSystemGroup();
+
+    systm::System< myMatrixType > system( &otherStateSystemGroup, 0.1, systm::IMPLICIT_TR_BDF2 );
+    for ( size_t i = 0; i < 10; ++i )
+    {
+        otherSerial->UpdateStateSystemGroup();
+        system.Solve();
+        otherSerial->CalculateStateDependentValues();
+    }
+    TS_ASSERT_DELTA( otherSerial->GetVoltageValue(), 2.0 * 0.6, 0.001 );
+#endif
+}
+
+namespace
+{
+/// Constant object whose value can be changed from outside, e.g. to imitate a moving lookup
+class VariableObj : public object::ConstObj< double >
+{
+    public:
+    VariableObj( double value )
+        : object::ConstObj< double >( value )
+    {
+    }
+    void SetValue( double value ) { this->mLastValue = value; }
+};
+}
+
+void TestDaeSystem::testExponentialSolverWithParallelRCMindingResults()
+{
+#if defined( _EIGEN_ ) || defined( USE_EIGEN )
+    boost::shared_ptr< electrical::SerialTwoPort<> > serial( new electrical::SerialTwoPort<>() );
+
+    boost::shared_ptr< object::Object< double > > objR( new object::ConstObj< double >( 0.6 ) );
+    boost::shared_ptr< VariableObj > objTau( new VariableObj( 0.6 * 0.5 ) );
+    boost::shared_ptr< electrical::ParallelRC<> > parallelRC( new electrical::ParallelRC<>( objR, objTau, true ) );
+
+    serial->AddChild( parallelRC );
+
+    systm::StateSystemGroup< myMatrixType > stateSystemGroup;
+    serial->SetSystem( &stateSystemGroup );
+    stateSystemGroup.Initialize();
+    serial->SetInitialCurrent( 2.0 );
+    serial->UpdateStateSystemGroup();
+
+    systm::ExponentialDglSystemSolver< myMatrixType > solver( &stateSystemGroup, 0.1 );
+
+    double t = 0.0;
+    for ( size_t i = 0; i < 10; ++i )
+    {
+        serial->UpdateStateSystemGroup();
+        t = solver.Solve();
+        serial->CalculateStateDependentValues();
+        TS_ASSERT_DELTA( serial->GetVoltageValue(), 2.0 * 0.6 * ( 1 - exp( -t / 0.3 ) ), 1.0e-8 );
+    }
+    const double lastCurrentSwitchTime = t;
+    const double lastVoltageValue = serial->GetVoltageValue();
+
+    // a new current only changes C, the propagator is kept
+    serial->SetCurrent( -0.4 );
+    for ( size_t i = 0; i < 20; ++i )
+    {
+        serial->UpdateStateSystemGroup();
+        t = solver.Solve();
+        serial->CalculateStateDependentValues();
+        TS_ASSERT_DELTA( serial->GetVoltageValue(),
+                         ( lastVoltageValue + 0.4 * 0.6 ) * exp( -( t - lastCurrentSwitchTime ) / 0.3 ) - 0.4 * 0.6, 1.0e-8 );
+    }
+
+    TS_ASSERT_EQUALS( solver.GetRungeKuttaStepCount(), 0 );
+    TS_ASSERT_EQUALS( solver.GetPropagatorCount(), 1 );
+
+    // a moving tau changes A in every step: one new propagator, then Runge-Kutta until tau stays constant again
+    for ( size_t i = 0; i < 5; ++i )
+    {
+        objTau->SetValue( 0.3 + 0.01 * ( i + 1 ) );
+        serial->UpdateStateSystemGroup();
+        solver.Solve();
+        serial->CalculateStateDependentValues();
+    }
+    TS_ASSERT_EQUALS( solver.GetPropagatorCount(), 2 );
+    TS_ASSERT_EQUALS( solver.GetRungeKuttaStepCount(), 4 );
+
+    serial->UpdateStateSystemGroup();
+    solver.Solve();
+    serial->CalculateStateDependentValues();
+    TS_ASSERT_EQUALS( solver.GetPropagatorCount(), 3 );
+    TS_ASSERT_EQUALS( solver.GetRungeKuttaStepCount(), 4 );
+
+    TS_ASSERT_THROWS( systm::ExponentialDglSystemSolver< myMatrixType >( &stateSystemGroup, 0.0 ), std::runtime_error );
+#endif
+}
+
+void TestDaeSystem::testExponentialSolverFallsBackForManyStates()
+{
+#if defined( _EIGEN_ ) || defined( USE_EIGEN )
+    boost::shared_ptr< electrical::SerialTwoPort<> > serial( new electrical::SerialTwoPort<>() );
+
+    boost::shared_ptr< object::Object< double > > objR( new object::ConstObj< double >( 0.6 ) );
+    boost::shared_ptr< object::Object< double > > objTau( new object::ConstObj< double >( 0.6 * 0.5 ) );
+    serial->AddChild( boost::shared_ptr< electrical::ParallelRC<> >( new electrical::ParallelRC<>( objR, objTau, true ) ) );
+
+    systm::StateSystemGroup< myMatrixType > stateSystemGroup;
+    serial->SetSystem( &stateSystemGroup );
+    stateSystemGroup.Initialize();
+    serial->SetInitialCurrent( 2.0 );
+    serial->UpdateStateSystemGroup();
+
+    TS_ASSERT( systm::ExponentialDglSystemSolver< myMatrixType >( &stateSystemGroup, 0.1 ).UsesPropagator() );
+
+    // No state is allowed for the propagator, so every step is integrated with Runge-Kutta
+    systm::ExponentialDglSystemSolver< myMatrixType > solver( &stateSystemGroup, 0.1, 0 );
+    TS_ASSERT( !solver.UsesPropagator() );
+    for ( size_t i = 0; i < 10; ++i )
+    {
+        serial->UpdateStateSystemGroup();
+        const double t = solver.Solve();
+        serial->CalculateStateDependentValues();
+        TS_ASSERT_DELTA( serial->GetVoltageValue(), 2.0 * 0.6 * ( 1 - exp( -t / 0.3 ) ), 1.0e-8 );
+    }
+    TS_ASSERT_EQUALS( solver.GetPropagatorCount(), 0 );
+    TS_ASSERT_EQUALS( solver.GetRungeKuttaStepCount(), 10 );
+#endif
+}
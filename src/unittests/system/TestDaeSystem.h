@@ -29,6 +29,7 @@ class TestDaeSystem : public CxxTest::TestSuite
     void testDaeSystemMixedSystemCurrentUnsolveable();
     void testDaeSystemMixedSystemCurrentSolveable();
     void testDaeSystemMixedSystemCurrentSolveableIntegrate();
+    void testDaeSystemRepeatedEvaluationAfterCurrentChange();
     void testRC();
     void testRCParallel();
     void testRCSerial();
@@ -39,6 +40,10 @@ class TestDaeSystem : public CxxTest::TestSuite
     void testSingleCellellementBalancing();
     void testMultiCellellementBalancing();
     void testVariableStepSolverWithParallelRCMindingResults();
+    void testImplicitSolverWithParallelRCMindingResults();
+    void testImplicitSolverStiffParallelRC();
+    void testExponentialSolverWithParallelRCMindingResults();
+    void testExponentialSolverFallsBackForManyStates();
 
     private:
     std::vector< std::vector< double > > CopyToVector( const double data[7][4] );
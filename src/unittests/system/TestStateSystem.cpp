@@ -349,4 +349,58 @@ void TestStateSystem::TestMixedSystem()
     TS_ASSERT_EQUALS(algMat(0,3), symbolic::Symbolic("NEG(MUL(-1.000000,ID4_ObjBase))") );
     TS_ASSERT_EQUALS(algMat(1,3), symbolic::Symbolic("ID9_ObjBase") );
 #endif
-}
\ No newline at end of file
+}
+
+void TestStateSystem::testRewrittenEquationsClearStaleEntries()
+{
+#ifndef _SYMBOLIC_
+    systm::StateSystem< myMatrixType > stateSystem;
+    stateSystem.GetNewEquation();
+    stateSystem.GetNewEquation();
+    stateSystem.Initialize( 3 );
+
+    myMatrixType equation;
+    equation.zeros( 1, 4 );
+    equation( 0, 0 ) = 1.0;
+    equation( 0, 1 ) = 2.0;
+    equation( 0, 3 ) = 5.0;
+    stateSystem.AddEquations( 0, equation );
+
+    myMatrixType otherEquation;
+    otherEquation.zeros( 1, 4 );
+    otherEquation( 0, 2 ) = 3.0;
+    stateSystem.AddEquations( 1, equation );
+    stateSystem.AddEquations( 0, otherEquation );
+
+    const myMatrixType &matrixA = stateSystem.GetEquationSystemAMatrix();
+    const myMatrixType &vectorC = stateSystem.GetEquationSystemCVector();
+    TS_ASSERT_EQUALS( matrixA( 0, 0 ), 0.0 );
+    TS_ASSERT_EQUALS( matrixA( 0, 1 ), 0.0 );
+    TS_ASSERT_EQUALS( matrixA( 0, 2 ), 3.0 );
+    TS_ASSERT_EQUALS( vectorC( 0, 0 ), 0.0 );
+    TS_ASSERT_EQUALS( matrixA( 1, 0 ), 1.0 );
+    TS_ASSERT_EQUALS( matrixA( 1, 1 ), 2.0 );
+    TS_ASSERT_EQUALS( vectorC( 1, 0 ), 5.0 );
+
+    std::vector< size_t > columns( 2, 1 );
+    columns[1] = 3;
+    std::vector< double > values( 2, 4.0 );
+    values[1] = 6.0;
+    stateSystem.SetEquation( 1, columns, values );
+    TS_ASSERT_EQUALS( matrixA( 1, 0 ), 0.0 );
+    TS_ASSERT_EQUALS( matrixA( 1, 1 ), 4.0 );
+    TS_ASSERT_EQUALS( vectorC( 1, 0 ), 6.0 );
+
+    stateSystem.ResetSystem();
+    for ( size_t row = 0; row < 2; ++row )
+    {
+        for ( size_t col = 0; col < 3; ++col )
+            TS_ASSERT_EQUALS( matrixA( row, col ), 0.0 );
+        TS_ASSERT_EQUALS( vectorC( row, 0 ), 0.0 );
+    }
+
+    stateSystem.SetEquation( 1, columns, values );
+    TS_ASSERT_EQUALS( matrixA( 1, 1 ), 4.0 );
+    TS_ASSERT_EQUALS( vectorC( 1, 0 ), 6.0 );
+#endif
+}
@@ -79,5 +79,6 @@ class TestStateSystem : public CxxTest::TestSuite
     void testDaeSystemWithParallelPortCurrentCapacity();
     void testDaeSystemWithParallelPortCurrentVoltage();
     void TestMixedSystem();
+    void testRewrittenEquationsClearStaleEntries();
 };
 #endif /* _TESTSTATESYSTEM_ */
@@ -67,6 +67,24 @@ void TestCoolingFunctions::TestConvectionByFormula()
     offsetSlope = side.GetOffsetSlope( 27.0, 0.1, 25.0 );
     TS_ASSERT_DELTA( offsetSlope.mOffset, 0.548 * offset, sDelta );
     TS_ASSERT_DELTA( offsetSlope.mSlope, 0.548 * slope, sDelta );
+
+    // The precomputed air temperature term must only be used for the air temperature it was calculated for
+    top.SetAirTemperature( 25.0 );
+    offsetSlope = top.GetOffsetSlope( 27.0, 0.1, 25.0 );
+    TS_ASSERT_DELTA( offsetSlope.mOffset, 0.71 * offset, sDelta );
+    TS_ASSERT_DELTA( offsetSlope.mSlope, 0.71 * slope, sDelta );
+
+    top.SetAirTemperature( 40.0 );
+    offsetSlope = top.GetOffsetSlope( 27.0, 0.1, 25.0 );
+    TS_ASSERT_DELTA( offsetSlope.mOffset, 0.71 * offset, sDelta );
+    TS_ASSERT_DELTA( offsetSlope.mSlope, 0.71 * slope, sDelta );
+
+    // The characteristic length term can be precomputed once per cooled area
+    TS_ASSERT_DELTA( DefaultConvection<>::LengthFactor( 0.1 ), pow( 0.1, -0.25 ), sDelta );
+    TS_ASSERT_EQUALS( DefaultConvection<>::LengthFactor( -1.0 ), 0.0 );
+    offsetSlope = side.GetOffsetSlopeWithLengthFactor( 27.0, 0.1, DefaultConvection<>::LengthFactor( 0.1 ), 25.0 );
+    TS_ASSERT_DELTA( offsetSlope.mOffset, 0.548 * offset, sDelta );
+    TS_ASSERT_DELTA( offsetSlope.mSlope, 0.548 * slope, sDelta );
 }
 
 void TestCoolingFunctions::TestConvectionByLookUp()
@@ -0,0 +1,268 @@
+/*
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see http://www.gnu.org/licenses/.
+*/
+#include "TestCouplingDriver.h"
+#include "../../thermal/coupling_driver.h"
+#include "exception_tester.h"
+#include <algorithm>
+#include <cstring>
+
+using namespace simulation;
+static const double sDelta = 0.000001;
+
+// The simulations and steppers below replace the electrical and thermal simulation in the loop of CouplingDriver. The
+// electrical steps have a length of 1 sec, the thermal steps a length of 0.5 sec.
+namespace
+{
+struct FakeTwoPort
+{
+    FakeTwoPort()
+        : mCurrent( -1.0 )
+    {
+    }
+    void SetCurrent( double current ) { mCurrent = current; }
+    double mCurrent;
+};
+
+struct TimeRecorder
+{
+    void operator()( double time ) { mTimes.push_back( time ); }
+    std::vector< double > mTimes;
+};
+
+/// Returns the points of time of input changes one after the other and records when it has been called
+struct FakeInput
+{
+    FakeInput( double firstChangeTime, double secondChangeTime )
+        : mIndex( 0 )
+    {
+        mChangeTimes[0] = firstChangeTime;
+        mChangeTimes[1] = secondChangeTime;
+    }
+    double operator()( double time )
+    {
+        mTimes.push_back( time );
+        return mChangeTimes[std::min< size_t >( mIndex++, 1 )];
+    }
+    double mChangeTimes[2];
+    size_t mIndex;
+    std::vector< double > mTimes;
+};
+
+class FakeElectricalSimulation
+{
+    public:
+    FakeElectricalSimulation( double stepTime, double simulationDuration )
+        : mRootTwoPort( new FakeTwoPort )
+        , mObserver( new TimeRecorder )
+        , mTime( 0.0 )
+        , mDeltaTime( 0.0 )
+        , mSimulationDuration( simulationDuration )
+        , mMaxSimulationStepDuration( stepTime )
+        , mStepStartTime( 0.0 )
+        , mNumberOfSteps( 0 )
+        , mResetTime( -1.0 )
+    {
+    }
+    void UpdateSystem() {}
+    void UpdateSystemValues() {}
+    bool CheckIfSumlationTimeHasNotEndedAndSetStepStartTime()
+    {
+        mStepStartTime = mTime;
+        return mTime < mSimulationDuration;
+    }
+    bool CheckLoopConditionAndSetDeltaTime( double currentChangeTime )
+    {
+        const double endTime = std::min( std::min( mStepStartTime + mMaxSimulationStepDuration, currentChangeTime ), mSimulationDuration );
+        mDeltaTime = std::min( 1.0, endTime - mTime );
+        return mTime < endTime;
+    }
+    void SetMaxSimulationStepDuration( double maxSimulationStepDuration ) { mMaxSimulationStepDuration = maxSimulationStepDuration; }
+    void FinshStep() {}
+    void UpdateAllThermalStatesPowerDissipation() {}
+    void ResetAllThermalStatesPowerDissipation() {}
+    void InitializeStopCriterion() {}
+    bool IsStopCriterionFulfilled() const { return false; }
+    void SaveStatesForLaterReset() {}
+    void ResetStatesToPointOfTime( double time )
+    {
+        mResetTime = time;
+        mTime = time;
+    }
+
+    boost::shared_ptr< FakeTwoPort > mRootTwoPort;
+    boost::shared_ptr< TimeRecorder > mObserver;
+    double mTime;
+    double mDeltaTime;
+    double mSimulationDuration;
+    double mMaxSimulationStepDuration;
+    double mStepStartTime;
+    size_t mNumberOfSteps;
+    double mResetTime;
+};
+
+class FakeThermalSimulation
+{
+    public:
+    FakeThermalSimulation( double simulationDuration, double stopCriterionTime )
+        : mTime( 0.0 )
+        , mDeltaTime( 0.0 )
+        , mSimulationDuration( simulationDuration )
+        , mStopCriterionTime( stopCriterionTime )
+        , mNumberOfStopCriteria( 0 )
+        , mNumberOfSystemUpdates( 0 )
+        , mNumberOfTemperatureUpdates( 0 )
+    {
+    }
+    bool CheckIfSumlationTimeHasNotEnded() { return mTime < mSimulationDuration; }
+    bool CheckLoopConditionAndSetDeltaTime( double endTime )
+    {
+        mDeltaTime = std::min( 0.5, endTime - mTime );
+        return mTime < endTime;
+    }
+    void InitializeStopCriterion() {}
+    /// The stop criterion is fulfilled once, when mStopCriterionTime has been reached
+    bool IsStopCriterionFulfilled()
+    {
+        if ( mNumberOfStopCriteria > 0 || mTime < mStopCriterionTime )
+            return false;
+        ++mNumberOfStopCriteria;
+        return true;
+    }
+    void UpdateSystem() { ++mNumberOfSystemUpdates; }
+    void UpdateAllThermalStatesTemperatures() { ++mNumberOfTemperatureUpdates; }
+
+    double mTime;
+    double mDeltaTime;
+    double mSimulationDuration;
+    double mStopCriterionTime;
+    size_t mNumberOfStopCriteria;
+    size_t mNumberOfSystemUpdates;
+    size_t mNumberOfTemperatureUpdates;
+};
+
+class FakeElectricalStepper
+{
+    public:
+    typedef FakeElectricalSimulation SimulationType;
+    FakeElectricalStepper( SimulationType *electricalSimulation )
+        : mElectricalSimulation( electricalSimulation )
+    {
+    }
+    void operator()()
+    {
+        mElectricalSimulation->mTime += mElectricalSimulation->mDeltaTime;
+        ++mElectricalSimulation->mNumberOfSteps;
+    }
+
+    private:
+    SimulationType *mElectricalSimulation;
+};
+
+class FakeThermalStepper
+{
+    public:
+    typedef FakeThermalSimulation SimulationType;
+    FakeThermalStepper( SimulationType *thermalSimulation )
+        : mThermalSimulation( thermalSimulation )
+    {
+    }
+    void operator()() { mThermalSimulation->mTime += mThermalSimulation->mDeltaTime; }
+
+    private:
+    SimulationType *mThermalSimulation;
+};
+
+typedef CouplingDriver< FakeElectricalStepper, FakeThermalStepper > FakeCouplingDriver;
+}
+
+
+void TestCouplingDriver::TestErrorHandlingAtConstruction()
+{
+    TS_ASSERT_THROWS_EQUALS( FakeCouplingDriver driver( 0, 0 ), std::runtime_error & e,
+                             !strstr( e.what(), "needs an electrical or a thermal simulation" ), 0 );
+}
+
+void TestCouplingDriver::TestCoupledRunWithReset()
+{
+    FakeElectricalSimulation electricalSimulation( 4.0, 12.0 );
+    FakeThermalSimulation thermalSimulation( 12.0, 6.0 );
+    std::vector< boost::shared_ptr< ::state::ThermalState< double > > > thermalStates;
+    CouplingScheduler<> scheduler( thermalStates, 5.0, 1.0, 4.0, 0.5 );
+    FakeCouplingDriver driver( &electricalSimulation, &thermalSimulation, &scheduler );
+    FakeInput input( 100.0, 100.0 );
+    TimeRecorder thermalObserver;
+    TimeRecorder resetObserver;
+    driver.Run( input, thermalObserver, resetObserver );
+
+    // The stop criterion at 6 sec resets the electrical simulation, which has reached 8 sec, and the coupling intervals
+    // are [0, 4], [4, 6], [6, 7], [7, 9] and [9, 12]
+    TS_ASSERT_DELTA( electricalSimulation.mResetTime, 6.0, sDelta );
+    TS_ASSERT_EQUALS( resetObserver.mTimes.size(), 1 );
+    TS_ASSERT_DELTA( resetObserver.mTimes.front(), 6.0, sDelta );
+    TS_ASSERT_EQUALS( scheduler.GetNumberOfIntervals(), 5 );
+    TS_ASSERT_EQUALS( scheduler.GetNumberOfResets(), 1 );
+    TS_ASSERT_EQUALS( electricalSimulation.mNumberOfSteps, 14 );
+    TS_ASSERT_DELTA( electricalSimulation.mTime, 12.0, sDelta );
+    TS_ASSERT_DELTA( thermalSimulation.mTime, 12.0, sDelta );
+
+    // The thermal simulation catches up with the electrical one in steps of 0.5 sec
+    TS_ASSERT_EQUALS( thermalObserver.mTimes.size(), 24 );
+    for ( size_t i = 0; i < thermalObserver.mTimes.size(); ++i )
+        TS_ASSERT_DELTA( thermalObserver.mTimes[i], 0.5 * ( i + 1 ), sDelta );
+
+    // The electrical observer is called once before the first step
+    TS_ASSERT_DELTA( electricalSimulation.mRootTwoPort->mCurrent, 0.0, sDelta );
+    TS_ASSERT_EQUALS( electricalSimulation.mObserver->mTimes.size(), 15 );
+    TS_ASSERT_DELTA( electricalSimulation.mObserver->mTimes.front(), 0.0, sDelta );
+    TS_ASSERT_EQUALS( input.mTimes.size(), 1 );
+}
+
+void TestCouplingDriver::TestElectricalRunAlone()
+{
+    FakeElectricalSimulation electricalSimulation( 4.0, 10.0 );
+    FakeCouplingDriver driver( &electricalSimulation, 0 );
+    FakeInput input( 6.0, 100.0 );
+    TimeRecorder observer;
+    driver.Run( input, observer );
+
+    // The input change at 6 sec ends the second step early
+    TS_ASSERT_EQUALS( input.mTimes.size(), 2 );
+    TS_ASSERT_DELTA( input.mTimes[1], 6.0, sDelta );
+    const double stepEndTimes[] = {4.0, 6.0, 10.0};
+    TS_ASSERT_EQUALS( observer.mTimes.size(), 3 );
+    for ( size_t i = 0; i < observer.mTimes.size() && i < 3; ++i )
+        TS_ASSERT_DELTA( observer.mTimes[i], stepEndTimes[i], sDelta );
+    TS_ASSERT_EQUALS( electricalSimulation.mNumberOfSteps, 10 );
+    TS_ASSERT_DELTA( electricalSimulation.mResetTime, -1.0, sDelta );
+}
+
+void TestCouplingDriver::TestThermalRunAlone()
+{
+    FakeThermalSimulation thermalSimulation( 3.0, 1.0 );
+    FakeCouplingDriver driver( 0, &thermalSimulation );
+    FakeInput input( 2.0, 3.0 );
+    TimeRecorder observer;
+    driver.Run( input, observer );
+
+    // The stop criterion at 1 sec only updates the thermal states and starts the next step, the input is updated at 2 sec
+    TS_ASSERT_EQUALS( thermalSimulation.mNumberOfStopCriteria, 1 );
+    TS_ASSERT_EQUALS( thermalSimulation.mNumberOfSystemUpdates, 7 );
+    TS_ASSERT_EQUALS( thermalSimulation.mNumberOfTemperatureUpdates, 7 );
+    TS_ASSERT_EQUALS( input.mTimes.size(), 2 );
+    TS_ASSERT_DELTA( input.mTimes[1], 2.0, sDelta );
+    TS_ASSERT_EQUALS( observer.mTimes.size(), 6 );
+    for ( size_t i = 0; i < observer.mTimes.size(); ++i )
+        TS_ASSERT_DELTA( observer.mTimes[i], 0.5 * ( i + 1 ), sDelta );
+}
@@ -0,0 +1,75 @@
+/*
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see http://www.gnu.org/licenses/.
+*/
+#include "TestCouplingScheduler.h"
+#include "../../thermal/coupling_scheduler.h"
+#include "exception_tester.h"
+#include <cstring>
+
+using namespace simulation;
+static const double sDelta = 0.000001;
+
+
+void TestCouplingScheduler::TestErrorHandlingAtConstruction()
+{
+    std::vector< boost::shared_ptr< ::state::ThermalState< double > > > thermalStates;
+    TS_ASSERT_THROWS_EQUALS( CouplingScheduler<> scheduler( thermalStates, 5.0, 0.0, 10.0 ), std::runtime_error & e,
+                             !strstr( e.what(), "minimum coupling interval must be positive" ), 0 );
+    TS_ASSERT_THROWS_EQUALS( CouplingScheduler<> scheduler( thermalStates, 5.0, 20.0, 10.0 ), std::runtime_error & e,
+                             !strstr( e.what(), "minimum coupling interval must be positive" ), 0 );
+    TS_ASSERT_THROWS_EQUALS( CouplingScheduler<> scheduler( thermalStates, 5.0, 1.0, 10.0, 1.5 ), std::runtime_error & e,
+                             !strstr( e.what(), "safety factor of the coupling scheduler" ), 0 );
+}
+
+void TestCouplingScheduler::TestIntervalPrediction()
+{
+    std::vector< boost::shared_ptr< ::state::ThermalState< double > > > thermalStates( 2 );
+    thermalStates[0].reset( new ::state::ThermalState< double >( 20.0 ) );
+    thermalStates[1].reset( new ::state::ThermalState< double >( 20.0 ) );
+    thermalStates[0]->SetFixedPowerDissipation( 10.0 );
+    thermalStates[1]->SetFixedPowerDissipation( 0.0 );
+
+    CouplingScheduler<> scheduler( thermalStates, 5.0, 1.0, 100.0 );
+    TS_ASSERT_DELTA( scheduler.GetInterval(), 100.0, sDelta );
+
+    // Constant rate of 0.05 K/s, 0.8 * 5 K are reached after 80 s
+    scheduler.StartInterval( 0.0 );
+    thermalStates[0]->ResetTemperature();
+    thermalStates[0]->AddTemperature( 22.0, 1.0 );
+    scheduler.FinishInterval( 40.0, false );
+    TS_ASSERT_DELTA( scheduler.GetInterval(), 80.0, sDelta );
+
+    // Power dissipation doubles, so the temperature rate is expected to grow and the interval shrinks
+    scheduler.StartInterval( 40.0 );
+    thermalStates[0]->SetFixedPowerDissipation( 20.0 );
+    thermalStates[0]->ResetTemperature();
+    thermalStates[0]->AddTemperature( 26.0, 1.0 );
+    scheduler.FinishInterval( 120.0, false );
+    TS_ASSERT_DELTA( scheduler.GetInterval(), 63.303027798, 1.0e-8 );
+
+    // After a reset the interval stays below the one that has been reached
+    scheduler.StartInterval( 120.0 );
+    scheduler.FinishInterval( 130.0, true );
+    TS_ASSERT_DELTA( scheduler.GetInterval(), 8.0, sDelta );
+
+    // Intervals are limited by minInterval
+    scheduler.StartInterval( 130.0 );
+    thermalStates[1]->ResetTemperature();
+    thermalStates[1]->AddTemperature( 30.0, 1.0 );
+    scheduler.FinishInterval( 131.0, false );
+    TS_ASSERT_DELTA( scheduler.GetInterval(), 1.0, sDelta );
+
+    TS_ASSERT_EQUALS( scheduler.GetNumberOfIntervals(), 4 );
+    TS_ASSERT_EQUALS( scheduler.GetNumberOfResets(), 1 );
+}
@@ -31,6 +31,8 @@ along with this program.  If not, see http://www.gnu.org/licenses/.
 #include <iterator>
 #include <algorithm>
 #include "../../thermal/ode_system_thermal.h"
+#include "../../thermal/reduced_ode_system_thermal.h"
+#include "../../thermal/rosenbrock_stepper_thermal.h"
 #include "../../thermal/blocks/rectangular_block.h"
 #include "../../thermal/thermal_model.h"
 #include "../../observer/thermal_observer.h"
@@ -41,6 +43,63 @@ along with this program.  If not, see http://www.gnu.org/licenses/.
 using namespace thermal;
 static const double sDelta = 0.000001;
 
+namespace
+{
+/// Data of a large block with a small heated block on top as passed to OdeSystemThermal, with convection and radiation
+struct TwoBlockOdeSystemData
+{
+    /// @param[in] zDiscretisation Number of thermal elements of the large block in z-direction
+    /// @param[in] heatedBlockFirst If true, the elements of the heated block come first in the ODE system
+    TwoBlockOdeSystemData( size_t zDiscretisation, bool heatedBlockFirst = false )
+        : mThermalStates( 1 )
+        , mMaterial( 250.0, 1000.0, 50.0, 50.0, 50.0 )
+        , mConvection( 3 )
+        , mRadiation( new Radiation<> )
+    {
+        mThermalStates.at( 0 ).reset( new ::state::ThermalState<> );
+        mThermalStates.at( 0 )->SetFixedPowerDissipation( 100.0 );
+        RectangularBlock<> largeBlock( "descriptionText", Cartesian<>( 0.0, 0.0, 0.0 ), 0.8, 0.6, 0.2, 8, 6,
+                                       zDiscretisation, &mMaterial, 27.0 );
+        RectangularBlock<> heatedBlock( "descriptionText", Cartesian<>( 0.1, 0.1, 0.2 ), 0.4, 0.2, 0.2, 2, 1, 1,
+                                        &mMaterial, 27.0, mThermalStates );
+
+        ThermalModel<> thermalModel( Tolerance<>( 0.000001, Angle<>::Deg( 0.001 ), 0.1 ), ThermalModel<>::AGGREGATE_BY_PLANE_AND_BLOCKS );
+        vector< IndexedArea< double > > surfaceElements;
+        shared_ptr< BlockGeometry<> > blockGeometry;
+        const RectangularBlock<> *blocks[] = {&largeBlock, &heatedBlock};
+        for ( size_t i = 0; i < 2; ++i )
+        {
+            blocks[heatedBlockFirst ? 1 - i : i]->CreateData( mThermalElements, mConductivityMatrix, surfaceElements, blockGeometry );
+            thermalModel.AddBlock( mThermalElements, mConductivityMatrix, surfaceElements, blockGeometry );
+        }
+        thermalModel.CreateDataByFusingBlocks( mThermalElements, mConductivityMatrix, mCoolingDataVector, mDirichletDataVector );
+
+        mConvection.at( TOP ) = shared_ptr< DefaultConvection<> >( new ConvectionByFormula<>( 0.71 ) );
+        mConvection.at( SIDE ) = shared_ptr< DefaultConvection<> >( new ConvectionByFormula<>( 0.548 ) );
+    }
+
+    /// Every call creates a new system from copies of the data. The systems share the thermal elements, which are only
+    /// read during the integration.
+    OdeSystemThermal<> *CreateSystem() const
+    {
+        vector< shared_ptr< ThermalElement<> > > thermalElements( mThermalElements );
+        vector< vector< IndexedValue< double > > > conductivityMatrix( mConductivityMatrix );
+        vector< vector< TaylorData< double > > > coolingDataVector( mCoolingDataVector );
+        return new OdeSystemThermal<>( thermalElements, conductivityMatrix, coolingDataVector, mDirichletDataVector,
+                                       mConvection, mRadiation, 20.0, mThermalStates );
+    }
+
+    vector< shared_ptr< ::state::ThermalState<> > > mThermalStates;
+    Material<> mMaterial;
+    vector< shared_ptr< ThermalElement<> > > mThermalElements;
+    vector< vector< IndexedValue< double > > > mConductivityMatrix;
+    vector< vector< TaylorData< double > > > mCoolingDataVector;
+    vector< vector< TaylorData< double > > > mDirichletDataVector;
+    vector< shared_ptr< DefaultConvection<> > > mConvection;
+    shared_ptr< Radiation<> > mRadiation;
+};
+}
+
 
 void TestOdeSystemThermal::TestOdeSystem2RectangularBlocks()
 {
@@ -169,9 +228,24 @@ void TestOdeSystemThermal::TestOdeSystem2RectangularBlocks()
     thermalStates.insert( thermalStates.end(), block2.GetThermalStates().begin(), block2.GetThermalStates().end() );
 
 
+    const vector< vector< IndexedValue< double > > > conductivityMatrixCopy( conductivityMatrix );
     OdeSystemThermal<> system( thermalElements, conductivityMatrix, coolingDataVector, dirichletDataVector, convection,
                                radiation, 23.0, thermalStates );
 
+    // The conductivity matrix is moved into contiguous storage row by row
+    TS_ASSERT( conductivityMatrix.empty() );
+    TS_ASSERT_EQUALS( system.GetA_th_Conductivity().GetNumberOfArrays(), conductivityMatrixCopy.size() );
+    for ( size_t i = 0; i < conductivityMatrixCopy.size(); ++i )
+    {
+        TS_ASSERT_EQUALS( static_cast< size_t >( system.GetA_th_Conductivity().End( i ) - system.GetA_th_Conductivity().Begin( i ) ),
+                          conductivityMatrixCopy[i].size() );
+        for ( size_t j = 0; j < conductivityMatrixCopy[i].size(); ++j )
+        {
+            TS_ASSERT_EQUALS( system.GetA_th_Conductivity().Begin( i )[j].mIndex, conductivityMatrixCopy[i][j].mIndex );
+            TS_ASSERT_EQUALS( system.GetA_th_Conductivity().Begin( i )[j].mValue, conductivityMatrixCopy[i][j].mValue );
+        }
+    }
+
     vector< double > tempVec;
     system.GetTemperatureVector( tempVec );
     system.SetTemperatureVector( tempVec );
@@ -199,9 +273,12 @@ void TestOdeSystemThermal::TestOdeSystem2RectangularBlocks()
     vector< misc::StrCont > volumeNames;
     vector< Cartesian< double > > vertices;
     thermalModel.CreateDataForVisualization( thermalElementsOfAreas, areas, volumes, volumeNames, vertices );
-    observer::ThermalObserver< double > thermaVisualizer( thermalElementsOfAreas, areas, volumes, volumeNames, vertices );
-    thermaVisualizer.AddFilter( new observer::CsvFilterThermal< double >( "./Patch_Temperatures.csv", true ) );
-    thermaVisualizer( 0.0 );
+    {
+        // The filter writes its buffered lines into the file when it is destroyed
+        observer::ThermalObserver< double > csvVisualizer( thermalElementsOfAreas, areas, volumes, volumeNames, vertices );
+        csvVisualizer.AddFilter( new observer::CsvFilterThermal< double >( "./Patch_Temperatures.csv", true ) );
+        csvVisualizer( 0.0 );
+    }
 #ifndef __NO_STRING__
     std::ifstream fileVertices( "./Patch_Vertices.csv" );
     std::ifstream fileAreas( "./Patch_Areas.csv" );
@@ -234,6 +311,10 @@ void TestOdeSystemThermal::TestOdeSystem2RectangularBlocks()
     TS_ASSERT_EQUALS( stringTemperatures, stringTemperaturesSave );
 #endif
 
+    observer::ThermalObserver< double > thermaVisualizer( thermalElementsOfAreas, areas, volumes, volumeNames, vertices );
+    thermaVisualizer.AddFilter( new observer::CsvFilterThermal< double >( "./Patch_Temperatures.csv", true ) );
+    thermaVisualizer( 0.0 );
+
     boost::numeric::odeint::result_of::make_controlled< boost::numeric::odeint::runge_kutta_cash_karp54< vector< double > > >::type stepper =
      make_controlled( 1.0e-10, 1.0e-10, boost::numeric::odeint::runge_kutta_cash_karp54< vector< double > >() );
 
@@ -269,4 +350,275 @@ void TestOdeSystemThermal::TestOdeSystem2RectangularBlocks()
             system.SetTemperatureVector( tempVec );
         }
     }
-}
+}
+
+void TestOdeSystemThermal::TestRosenbrockStepper()
+{
+#if defined( _EIGEN_ ) || defined( USE_EIGEN )
+    TwoBlockOdeSystemData data( 40 );
+    boost::scoped_ptr< OdeSystemThermal<> > explicitSystem( data.CreateSystem() );
+    boost::scoped_ptr< OdeSystemThermal<> > implicitSystem( data.CreateSystem() );
+
+    boost::numeric::odeint::result_of::make_controlled< boost::numeric::odeint::runge_kutta_cash_karp54< vector< double > > >::type stepper =
+     make_controlled( 1.0e-10, 1.0e-10, boost::numeric::odeint::runge_kutta_cash_karp54< vector< double > >() );
+    RosenbrockStepperThermal<> rosenbrockStepper( 1.0e-6, 1.0e-6 );
+
+    const double endTime = 200.0;
+    vector< double > explicitTemperatures;
+    explicitSystem->GetTemperatureVector( explicitTemperatures );
+    double t = 0.0;
+    double dt = 1.0;
+    size_t explicitSteps = 0;
+    while ( t < endTime )
+    {
+        dt = std::min( dt, endTime - t );
+        if ( stepper.try_step( boost::ref( *explicitSystem ), explicitTemperatures, t, dt ) == boost::numeric::odeint::success )
+            ++explicitSteps;
+    }
+
+    vector< double > implicitTemperatures;
+    implicitSystem->GetTemperatureVector( implicitTemperatures );
+    t = 0.0;
+    dt = 1.0;
+    size_t implicitSteps = 0;
+    while ( t < endTime )
+    {
+        dt = std::min( dt, endTime - t );
+        if ( rosenbrockStepper.try_step( boost::ref( *implicitSystem ), implicitTemperatures, t, dt ) == boost::numeric::odeint::success )
+            ++implicitSteps;
+    }
+
+    TS_ASSERT_EQUALS( implicitTemperatures.size(), explicitTemperatures.size() );
+    for ( size_t i = 0; i < explicitTemperatures.size(); ++i )
+        TS_ASSERT_DELTA( implicitTemperatures[i], explicitTemperatures[i], 0.001 );
+    // The thin elements in z-direction limit the explicit solver, but not the implicit one
+    TS_ASSERT_LESS_THAN( implicitSteps, explicitSteps );
+
+    // The sparsity pattern of the iteration matrix does not change between steps
+    TS_ASSERT_EQUALS( rosenbrockStepper.mIterationMatrixSolver.GetAnalyzePatternCount(), 1 );
+#endif
+}
+
+void TestOdeSystemThermal::TestThreadedLoops()
+{
+#ifdef BOOST_THREAD
+    TwoBlockOdeSystemData data( 4 );
+    boost::scoped_ptr< OdeSystemThermal<> > sequentialSystem( data.CreateSystem() );
+    boost::scoped_ptr< OdeSystemThermal<> > threadedSystem( data.CreateSystem() );
+    threadedSystem->SetNumberOfThreads( 3 );
+
+    vector< double > temperatures;
+    sequentialSystem->GetTemperatureVector( temperatures );
+    for ( size_t i = 0; i < temperatures.size(); ++i )
+        temperatures[i] += 0.1 * i;
+
+    vector< double > sequentialDxdt( temperatures.size() );
+    vector< double > threadedDxdt( temperatures.size() );
+    for ( size_t step = 1; step <= 3; ++step )
+    {
+        sequentialSystem->Update( step, 1.0 );
+        threadedSystem->Update( step, 1.0 );
+        ( *sequentialSystem )( temperatures, sequentialDxdt, 0.0 );
+        ( *threadedSystem )( temperatures, threadedDxdt, 0.0 );
+
+        // Every element is evaluated by the same code in both systems, so the results are identical
+        for ( size_t i = 0; i < temperatures.size(); ++i )
+        {
+            TS_ASSERT_EQUALS( threadedDxdt[i], sequentialDxdt[i] );
+            TS_ASSERT_EQUALS( threadedSystem->mMatrixBoundarySource.mA_th[i], sequentialSystem->mMatrixBoundarySource.mA_th[i] );
+            TS_ASSERT_EQUALS( threadedSystem->mMatrixBoundarySource.mC_th[i], sequentialSystem->mMatrixBoundarySource.mC_th[i] );
+        }
+    }
+#endif
+}
+
+void TestOdeSystemThermal::TestThreadedLoopsRethrowErrors()
+{
+#if defined( BOOST_THREAD ) && defined( __EXCEPTIONS__ )
+    // The block with the thermal state comes first, so its elements are updated by the first worker thread
+    TwoBlockOdeSystemData data( 4, true );
+    boost::scoped_ptr< OdeSystemThermal<> > threadedSystem( data.CreateSystem() );
+    threadedSystem->SetNumberOfThreads( 3 );
+    TS_ASSERT( threadedSystem->GetThermalElements().front()->HasThermalState() );
+    TS_ASSERT( !threadedSystem->GetThermalElements().back()->HasThermalState() );
+
+    // Power dissipation is only known from t = 10 s on, so an update of the time step ending at 1 s throws
+    data.mThermalStates.at( 0 )->AddPowerDissipation( 100.0, 10.0 );
+    TS_ASSERT_THROWS( threadedSystem->Update( 1.0, 1.0 ), std::runtime_error );
+
+    // The error has been consumed and the threads are still usable
+    TS_ASSERT_THROWS_NOTHING( threadedSystem->Update( 12.0, 1.0 ) );
+    vector< double > temperatures;
+    threadedSystem->GetTemperatureVector( temperatures );
+    vector< double > dxdt( temperatures.size() );
+    TS_ASSERT_THROWS_NOTHING( ( *threadedSystem )( temperatures, dxdt, 0.0 ) );
+#endif
+}
+
+void TestOdeSystemThermal::TestThreadedLoopsWithLookUpBoundaries()
+{
+#ifdef BOOST_THREAD
+    TwoBlockOdeSystemData data( 4 );
+    boost::scoped_ptr< OdeSystemThermal<> > formulaSystem( data.CreateSystem() );
+    formulaSystem->SetNumberOfThreads( 3 );
+    TS_ASSERT( formulaSystem->mIsBoundaryUpdateThreadSafe );
+
+    // The lookups store the last looked up value, so the threads must not evaluate them concurrently
+    vector< double > temperaturePoints( 2 );
+    temperaturePoints[0] = 20.0;
+    temperaturePoints[1] = 40.0;
+    vector< double > lengthPoints( 2 );
+    lengthPoints[0] = 0.01;
+    lengthPoints[1] = 1.0;
+    vector< vector< double > > offsets( 2, vector< double >( 2 ) );
+    offsets[0][0] = 0.0;
+    offsets[0][1] = 0.0;
+    offsets[1][0] = 200.0;
+    offsets[1][1] = 100.0;
+    vector< vector< double > > slopes( 2, vector< double >( 2, 5.0 ) );
+    slopes[1][0] = 10.0;
+    data.mConvection.at( TOP ) = shared_ptr< DefaultConvection<> >( new ConvectionByLookUp<>(
+     shared_ptr< object::Object< double > >( new object::LookupObj2D< double >( offsets, temperaturePoints, lengthPoints ) ),
+     shared_ptr< object::Object< double > >( new object::LookupObj2D< double >( slopes, temperaturePoints, lengthPoints ) ) ) );
+
+    vector< double > coolingOffsets( 2 );
+    coolingOffsets[0] = 50.0;
+    coolingOffsets[1] = 400.0;
+    vector< double > coolingSlopes( 2, 20.0 );
+    CoolingByLookUp<> cooling( shared_ptr< object::Object< double > >(
+                                new object::LookupObj1D< double >( coolingOffsets, temperaturePoints ) ),
+                               shared_ptr< object::Object< double > >(
+                                new object::LookupObj1D< double >( coolingSlopes, temperaturePoints ) ) );
+    size_t cooledFaces = 0;
+    for ( size_t i = 0; i < data.mCoolingDataVector.size(); i += 2 )
+        for ( size_t j = 0; j < data.mCoolingDataVector[i].size(); ++j, ++cooledFaces )
+            data.mCoolingDataVector[i][j].mCooling = &cooling;
+    TS_ASSERT_LESS_THAN( 0, cooledFaces );
+
+    boost::scoped_ptr< OdeSystemThermal<> > sequentialSystem( data.CreateSystem() );
+    boost::scoped_ptr< OdeSystemThermal<> > threadedSystem( data.CreateSystem() );
+    threadedSystem->SetNumberOfThreads( 3 );
+    TS_ASSERT( !threadedSystem->mIsBoundaryUpdateThreadSafe );
+
+    vector< double > temperatures;
+    sequentialSystem->GetTemperatureVector( temperatures );
+    for ( size_t i = 0; i < temperatures.size(); ++i )
+        temperatures[i] += 0.1 * i;
+
+    vector< double > sequentialDxdt( temperatures.size() );
+    vector< double > threadedDxdt( temperatures.size() );
+    for ( size_t step = 1; step <= 3; ++step )
+    {
+        sequentialSystem->SetTemperatureVector( temperatures );
+        threadedSystem->SetTemperatureVector( temperatures );
+        sequentialSystem->Update( step, 1.0 );
+        threadedSystem->Update( step, 1.0 );
+        ( *sequentialSystem )( temperatures, sequentialDxdt, 0.0 );
+        ( *threadedSystem )( temperatures, threadedDxdt, 0.0 );
+
+        for ( size_t i = 0; i < temperatures.size(); ++i )
+        {
+            TS_ASSERT_EQUALS( threadedDxdt[i], sequentialDxdt[i] );
+            TS_ASSERT_EQUALS( threadedSystem->mMatrixBoundarySource.mA_th[i], sequentialSystem->mMatrixBoundarySource.mA_th[i] );
+            TS_ASSERT_EQUALS( threadedSystem->mMatrixBoundarySource.mC_th[i], sequentialSystem->mMatrixBoundarySource.mC_th[i] );
+            temperatures[i] += sequentialDxdt[i];
+        }
+    }
+#endif
+}
+
+void TestOdeSystemThermal::TestNonPositiveCharacteristicLength()
+{
+#if defined( __EXCEPTIONS__ )
+    TwoBlockOdeSystemData data( 2 );
+    TaylorData< double > *convectedArea = 0;
+    for ( size_t i = 0; i < data.mCoolingDataVector.size() && !convectedArea; ++i )
+        for ( size_t j = 0; j < data.mCoolingDataVector[i].size() && !convectedArea; ++j )
+            if ( data.mConvection.at( data.mCoolingDataVector[i][j].mLocation ) )
+                convectedArea = &data.mCoolingDataVector[i][j];
+    TS_ASSERT( convectedArea );
+    if ( !convectedArea )
+        return;
+
+    convectedArea->mCharacteristicLength = 0.0;
+    TS_ASSERT_THROWS( delete data.CreateSystem(), std::runtime_error );
+    convectedArea->mCharacteristicLength = -1.0;
+    TS_ASSERT_THROWS( delete data.CreateSystem(), std::runtime_error );
+
+    // Areas with a cooling of their own are not cooled by the default convection and need no characteristic length
+    CoolingByConstantValue<> cooling( 10.0 );
+    convectedArea->mCooling = &cooling;
+    TS_ASSERT_THROWS_NOTHING( delete data.CreateSystem() );
+#endif
+}
+
+void TestOdeSystemThermal::TestReducedOdeSystem()
+{
+#if defined( _EIGEN_ ) || defined( USE_EIGEN )
+    TwoBlockOdeSystemData data( 4 );
+    boost::scoped_ptr< OdeSystemThermal<> > systemPtr( data.CreateSystem() );
+    OdeSystemThermal<> &system = *systemPtr;
+    size_t heatedIndex = 0;
+    for ( size_t i = 0; i < system.GetThermalElements().size(); ++i )
+        if ( system.GetThermalElements()[i]->HasThermalState() )
+            heatedIndex = i;
+
+    // Reference solution of the full system, boundary conditions are updated every 10 s like in ThermalSimulation
+    const double endTime = 2000.0;
+    vector< double > initialTemperatures;
+    system.GetTemperatureVector( initialTemperatures );
+    vector< double > fullTemperatures( initialTemperatures );
+    boost::numeric::odeint::result_of::make_controlled< boost::numeric::odeint::runge_kutta_cash_karp54< vector< double > > >::type stepper =
+     make_controlled( 1.0e-8, 1.0e-8, boost::numeric::odeint::runge_kutta_cash_karp54< vector< double > >() );
+    double t = 0.0;
+    double dt = 1.0;
+    while ( t < endTime )
+    {
+        const double stopTime = t + 10.0;
+        while ( t < stopTime )
+        {
+            dt = std::min( dt, stopTime - t );
+            stepper.try_step( boost::ref( system ), fullTemperatures, t, dt );
+        }
+        system.Update( t, 10.0 );
+        system.SetTemperatureVector( fullTemperatures );
+    }
+
+    system.SetTemperatureVector( initialTemperatures );
+    system.Update( 0.0, 0.0 );
+    ReducedOdeSystemThermal<> reducedSystem( system, vector< size_t >( 1, heatedIndex ), 20, 1.0e-3 );
+    TS_ASSERT_LESS_THAN_EQUALS( reducedSystem.GetOrder(), 20 );
+    TS_ASSERT_LESS_THAN( reducedSystem.GetOrder(), initialTemperatures.size() );
+
+    // The uniform initial temperature lies in the reduced subspace
+    vector< double > reducedTemperatures;
+    reducedSystem.GetTemperatureVector( reducedTemperatures );
+    TS_ASSERT_EQUALS( reducedTemperatures.size(), reducedSystem.GetOrder() );
+    reducedSystem.SetTemperatureVector( reducedTemperatures );
+    vector< double > reconstructedTemperatures;
+    system.GetTemperatureVector( reconstructedTemperatures );
+    for ( size_t i = 0; i < initialTemperatures.size(); ++i )
+        TS_ASSERT_DELTA( reconstructedTemperatures[i], initialTemperatures[i], sDelta );
+
+    boost::numeric::odeint::result_of::make_controlled< boost::numeric::odeint::runge_kutta_cash_karp54< vector< double > > >::type reducedStepper =
+     make_controlled( 1.0e-8, 1.0e-8, boost::numeric::odeint::runge_kutta_cash_karp54< vector< double > >() );
+    t = 0.0;
+    dt = 1.0;
+    while ( t < endTime )
+    {
+        const double stopTime = t + 10.0;
+        while ( t < stopTime )
+        {
+            dt = std::min( dt, stopTime - t );
+            reducedStepper.try_step( boost::ref( reducedSystem ), reducedTemperatures, t, dt );
+        }
+        reducedSystem.Update( t, 10.0 );
+        reducedSystem.SetTemperatureVector( reducedTemperatures );
+    }
+
+    system.GetTemperatureVector( reconstructedTemperatures );
+    TS_ASSERT_DELTA( reconstructedTemperatures[heatedIndex], fullTemperatures[heatedIndex], 0.01 );
+    for ( size_t i = 0; i < fullTemperatures.size(); ++i )
+        TS_ASSERT_DELTA( reconstructedTemperatures[i], fullTemperatures[i], 0.05 );
+#endif
+}
@@ -20,6 +20,12 @@ class TestOdeSystemThermal : public CxxTest::TestSuite
 {
     public:
     void TestOdeSystem2RectangularBlocks();
+    void TestRosenbrockStepper();
+    void TestThreadedLoops();
+    void TestThreadedLoopsRethrowErrors();
+    void TestThreadedLoopsWithLookUpBoundaries();
+    void TestNonPositiveCharacteristicLength();
+    void TestReducedOdeSystem();
 
     private:
     protected:
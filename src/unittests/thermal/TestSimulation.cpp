@@ -68,6 +68,8 @@ void TestSimulation::RunScenario( double electricalStopCriterion, double thermal
     }
 
 
+    // All TwoPorts of the cell, including the Zarc elements, are compiled into the stamp
+    TS_ASSERT( electricalSimulation->IsStateSystemStampCompiled() );
     TS_ASSERT_DELTA( thermalSimulation->mThermalSystem->mAirTemperature, 25.0, sDelta );
     if ( thermalStopCriterion <= 0.0 )
     {
@@ -0,0 +1,116 @@
+/*
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see http://www.gnu.org/licenses/.
+*/
+#include "TestStateHistory.h"
+#include "../../thermal/state_history.h"
+#include "exception_tester.h"
+#include <boost/shared_ptr.hpp>
+#include <cstring>
+
+using namespace simulation;
+static const double sDelta = 0.000001;
+
+namespace
+{
+struct SocValue
+{
+    explicit SocValue( double value )
+        : mValue( value )
+    {
+    }
+    double GetValue() const { return mValue; }
+    double mValue;
+};
+
+void AddEntry( StateHistory< std::vector< double > > &history, double time )
+{
+    std::vector< boost::shared_ptr< SocValue > > socValues;
+    socValues.push_back( boost::shared_ptr< SocValue >( new SocValue( 10.0 * time ) ) );
+    socValues.push_back( boost::shared_ptr< SocValue >( new SocValue( -10.0 * time ) ) );
+    history.Add( time, std::vector< double >( 3, time ), socValues );
+}
+}
+
+
+void TestStateHistory::TestErrorHandlingAtConstruction()
+{
+    TS_ASSERT_THROWS_EQUALS( StateHistory< std::vector< double > > history( 1 ), std::runtime_error & e,
+                             !strstr( e.what(), "RollbackHistorySize" ), 0 );
+}
+
+void TestStateHistory::TestAddAndFind()
+{
+    StateHistory< std::vector< double > > history( 4 );
+    TS_ASSERT_EQUALS( history.GetCapacity(), 4 );
+    TS_ASSERT_EQUALS( history.GetSize(), 0 );
+
+    for ( size_t i = 0; i < 4; ++i )
+        AddEntry( history, static_cast< double >( i ) );
+    TS_ASSERT_EQUALS( history.GetSize(), 4 );
+
+    TS_ASSERT_EQUALS( history.FindIndex( -1.0 ), 0 );
+    TS_ASSERT_EQUALS( history.FindIndex( 0.0 ), 0 );
+    TS_ASSERT_EQUALS( history.FindIndex( 1.5 ), 1 );
+    TS_ASSERT_EQUALS( history.FindIndex( 2.0 ), 2 );
+    TS_ASSERT_EQUALS( history.FindIndex( 5.0 ), 3 );
+
+    TS_ASSERT_DELTA( history.GetTime( 2 ), 2.0, sDelta );
+    TS_ASSERT_EQUALS( history.GetStates( 2 ).size(), 3 );
+    TS_ASSERT_DELTA( history.GetStates( 2 )[1], 2.0, sDelta );
+    TS_ASSERT_DELTA( history.GetSocValues( 3 )[0], 30.0, sDelta );
+    TS_ASSERT_DELTA( history.GetSocValues( 3 )[1], -30.0, sDelta );
+
+    history.Clear();
+    TS_ASSERT_EQUALS( history.GetSize(), 0 );
+    AddEntry( history, 7.0 );
+    TS_ASSERT_EQUALS( history.GetSize(), 1 );
+    TS_ASSERT_DELTA( history.GetTime( 0 ), 7.0, sDelta );
+    TS_ASSERT_DELTA( history.GetSocValues( 0 )[0], 70.0, sDelta );
+}
+
+void TestStateHistory::TestThinning()
+{
+    StateHistory< std::vector< double > > history( 4 );
+    for ( size_t i = 0; i < 5; ++i )
+        AddEntry( history, static_cast< double >( i ) );
+
+    // Steps 1 and 3 have been dropped
+    TS_ASSERT_EQUALS( history.GetSize(), 3 );
+    const double times[] = {0.0, 2.0, 4.0};
+    for ( size_t i = 0; i < 3; ++i )
+    {
+        TS_ASSERT_DELTA( history.GetTime( i ), times[i], sDelta );
+        TS_ASSERT_DELTA( history.GetStates( i )[0], times[i], sDelta );
+        TS_ASSERT_DELTA( history.GetSocValues( i )[0], 10.0 * times[i], sDelta );
+        TS_ASSERT_DELTA( history.GetSocValues( i )[1], -10.0 * times[i], sDelta );
+    }
+    TS_ASSERT_EQUALS( history.FindIndex( 3.0 ), 1 );
+
+    // Only every second step is kept now, the latest one is replaced by the next step
+    AddEntry( history, 5.0 );
+    TS_ASSERT_EQUALS( history.GetSize(), 4 );
+    TS_ASSERT_DELTA( history.GetTime( 3 ), 5.0, sDelta );
+    AddEntry( history, 6.0 );
+    TS_ASSERT_EQUALS( history.GetSize(), 4 );
+    TS_ASSERT_DELTA( history.GetTime( 2 ), 4.0, sDelta );
+    TS_ASSERT_DELTA( history.GetTime( 3 ), 6.0, sDelta );
+    TS_ASSERT_DELTA( history.GetSocValues( 3 )[0], 60.0, sDelta );
+
+    // The first and the latest step are kept however many steps are added
+    for ( size_t i = 7; i < 100; ++i )
+        AddEntry( history, static_cast< double >( i ) );
+    TS_ASSERT_LESS_THAN_EQUALS( history.GetSize(), 4 );
+    TS_ASSERT_DELTA( history.GetTime( 0 ), 0.0, sDelta );
+    TS_ASSERT_DELTA( history.GetTime( history.GetSize() - 1 ), 99.0, sDelta );
+}
@@ -0,0 +1,298 @@
+/*
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see http://www.gnu.org/licenses/.
+*/
+#include "TestThermalModelCache.h"
+#include "../../thermal/thermal_model.h"
+#include "../../thermal/thermal_model_cache.h"
+#include "../../thermal/blocks/rectangular_block.h"
+#include "../../thermal/boundaryConditions/cooling.h"
+#include "../../thermal/boundaryConditions/cooling_block.h"
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+using namespace thermal;
+static const char *sCacheFileName = "TestThermalModelCache.bin";
+
+namespace
+{
+/// Fused thermal model as it is passed to ThermalModelCache
+struct FusedData
+{
+    vector< shared_ptr< ThermalElement<> > > mThermalElements;
+    vector< vector< IndexedValue< double > > > mConductivityMatrix;
+    vector< vector< TaylorData< double > > > mCoolingDataVector;
+    vector< vector< TaylorData< double > > > mDirichletDataVector;
+    vector< ThermalElement<> * > mThermalElementsOfAreas;
+    vector< vector< size_t > > mAreas;
+    vector< vector< size_t > > mVolumes;
+    vector< misc::StrCont > mVolumeNames;
+    vector< Cartesian<> > mVertices;
+    vector< ::probe::ThermalProbe > mThermalProbes;
+};
+
+/// Two adjacent blocks with a cooling and a Dirichlet boundary condition
+class CachedModel
+{
+    public:
+    CachedModel()
+        : mMaterial( 250.0, 1000.0, 47.0, 50.0, 53.0 )
+        , mOtherMaterial( 100.0, 500.0, 20.0, 20.0, 20.0 )
+        , mBlockThermalStates( 1, shared_ptr< ::state::ThermalState<> >( new ::state::ThermalState<>( 27.0 ) ) )
+        , mBlock1( "Block1", Cartesian<>( 0.0, 0.0, 0.0 ), 0.4, 0.2, 0.2, 2, 1, 1, &mMaterial, 27.0 )
+        , mBlock2( "Block2", Cartesian<>( 0.05, 0.2, 0.05 ), 0.2, 0.1, 0.1, 1, 1, 1, &mOtherMaterial, 30.0, mBlockThermalStates )
+    {
+        mMaterials.push_back( &mMaterial );
+        mMaterials.push_back( &mOtherMaterial );
+        mThermalStates.push_back( mBlockThermalStates[0].get() );
+        vector< TwoDim<> > vertices( 3 );
+        vertices.at( 0 ) = TwoDim<>( 0.0, 0.0 );
+        vertices.at( 1 ) = TwoDim<>( 0.2, 0.0 );
+        vertices.at( 2 ) = TwoDim<>( 0.2, -1.0 );
+        mCoolingBlock.reset( new CoolingPrismatic<>( "Cooling", vertices, 0.0, 1.0,
+                                                     shared_ptr< Cooling<> >( new CoolingByConstantValue<>( 25.6 ) ) ) );
+        vertices.resize( 4 );
+        vertices.at( 0 ) = TwoDim<>( 0.1, 0.0 );
+        vertices.at( 1 ) = TwoDim<>( 0.3, 0.0 );
+        vertices.at( 2 ) = TwoDim<>( 0.3, 0.2 );
+        vertices.at( 3 ) = TwoDim<>( 0.1, 0.2 );
+        mDirichletBlock.reset( new CoolingPrismatic<>( "Dirichlet", vertices, 0.2, 0.3,
+                                                       shared_ptr< Cooling<> >( new DirichletBoundaryCondition<>( 10.0 ) ) ) );
+        mCoolings.push_back( mCoolingBlock->GetCooling().get() );
+        mCoolings.push_back( mDirichletBlock->GetCooling().get() );
+    }
+
+    /// Creates the fused data with ThermalModel
+    void Fuse( FusedData &data )
+    {
+        ThermalModel<> thermalModel( Tolerance<>( 0.000001, Angle<>::Deg( 0.001 ), 0.1 ), ThermalModel<>::AGGREGATE_BY_PLANE_AND_BLOCKS );
+        vector< shared_ptr< ThermalElement<> > > thermalElements;
+        vector< vector< IndexedValue< double > > > conductivityMatrix;
+        vector< IndexedArea< double > > surfaceAreas;
+        shared_ptr< BlockGeometry<> > blockGeometry;
+        vector< Area<> > coolingAreas;
+        mBlock1.CreateData( thermalElements, conductivityMatrix, surfaceAreas, blockGeometry );
+        thermalModel.AddBlock( thermalElements, conductivityMatrix, surfaceAreas, blockGeometry, "Block1" );
+        mBlock2.CreateData( thermalElements, conductivityMatrix, surfaceAreas, blockGeometry );
+        thermalModel.AddBlock( thermalElements, conductivityMatrix, surfaceAreas, blockGeometry, "Block2" );
+        shared_ptr< Cooling<> > cooling = mCoolingBlock->GetCooling();
+        mCoolingBlock->GetCoolingAreas( coolingAreas );
+        mCoolingBlock->GetBlockGeometry( blockGeometry );
+        thermalModel.AddCooling( coolingAreas, blockGeometry, cooling );
+        cooling = mDirichletBlock->GetCooling();
+        mDirichletBlock->GetCoolingAreas( coolingAreas );
+        mDirichletBlock->GetBlockGeometry( blockGeometry );
+        thermalModel.AddCooling( coolingAreas, blockGeometry, cooling );
+
+        thermalModel.CreateDataByFusingBlocks( data.mThermalElements, data.mConductivityMatrix, data.mCoolingDataVector,
+                                               data.mDirichletDataVector );
+        thermalModel.CreateDataForVisualization( data.mThermalElementsOfAreas, data.mAreas, data.mVolumes,
+                                                 data.mVolumeNames, data.mVertices );
+        data.mThermalProbes.push_back( ::probe::ThermalProbe( 0.3, 0.1, 0.1 ) );
+        data.mThermalProbes.push_back( ::probe::ThermalProbe( 0.1, 0.25, 0.1 ) );
+        thermalModel.ProbeThermalElemnts( data.mThermalProbes );
+    }
+
+    void Save( const FusedData &data, const std::string &description ) const
+    {
+        ThermalModelCache<>::Save( sCacheFileName, description, mMaterials, mThermalStates, data.mThermalElements,
+                                   data.mConductivityMatrix, data.mCoolingDataVector, data.mDirichletDataVector, mCoolings,
+                                   data.mThermalElementsOfAreas, data.mAreas, data.mVolumes, data.mVolumeNames,
+                                   data.mVertices, data.mThermalProbes );
+    }
+
+    bool Load( const std::string &description, FusedData &data ) const
+    {
+        return ThermalModelCache<>::Load( sCacheFileName, description, mMaterials, mThermalStates, data.mThermalElements,
+                                          data.mConductivityMatrix, data.mCoolingDataVector, data.mDirichletDataVector,
+                                          mCoolings, data.mThermalElementsOfAreas, data.mAreas, data.mVolumes,
+                                          data.mVolumeNames, data.mVertices, data.mThermalProbes );
+    }
+
+    Material<> mMaterial;
+    Material<> mOtherMaterial;
+    vector< shared_ptr< ::state::ThermalState<> > > mBlockThermalStates;
+    vector< const Material<> * > mMaterials;
+    vector< ::state::ThermalState<> * > mThermalStates;
+    RectangularBlock<> mBlock1;
+    RectangularBlock<> mBlock2;
+    shared_ptr< CoolingPrismatic<> > mCoolingBlock;
+    shared_ptr< CoolingPrismatic<> > mDirichletBlock;
+    vector< Cooling<> * > mCoolings;
+};
+
+void CompareTaylorData( const vector< vector< TaylorData< double > > > &lhs, const vector< vector< TaylorData< double > > > &rhs,
+                        bool isDirichlet )
+{
+    TS_ASSERT_EQUALS( lhs.size(), rhs.size() );
+    for ( size_t i = 0; i < lhs.size(); ++i )
+    {
+        TS_ASSERT_EQUALS( lhs[i].size(), rhs[i].size() );
+        for ( size_t j = 0; j < lhs[i].size(); ++j )
+        {
+            TS_ASSERT_EQUALS( lhs[i][j].mCharacteristicLength, rhs[i][j].mCharacteristicLength );
+            TS_ASSERT_EQUALS( lhs[i][j].mA_cool, rhs[i][j].mA_cool );
+            TS_ASSERT_EQUALS( lhs[i][j].mLocation, rhs[i][j].mLocation );
+            TS_ASSERT_EQUALS( lhs[i][j].mConductivity, rhs[i][j].mConductivity );
+            TS_ASSERT_EQUALS( lhs[i][j].mDistanceToGridVertex, rhs[i][j].mDistanceToGridVertex );
+            TS_ASSERT_EQUALS( lhs[i][j].mCooling, rhs[i][j].mCooling );
+            if ( isDirichlet )
+                TS_ASSERT_EQUALS( lhs[i][j].mTempSurfLastStep, rhs[i][j].mTempSurfLastStep );
+        }
+    }
+}
+
+/// Returns the index of thermalElement in thermalElements
+size_t IndexOf( const vector< shared_ptr< ThermalElement<> > > &thermalElements, const ThermalElement<> *thermalElement )
+{
+    for ( size_t i = 0; i < thermalElements.size(); ++i )
+        if ( thermalElements[i].get() == thermalElement )
+            return i;
+    return thermalElements.size();
+}
+}
+
+void TestThermalModelCache::TestKeyAndFileName()
+{
+    TS_ASSERT_EQUALS( ThermalModelCache<>::CreateKey( "" ), 14695981039346656037ULL );
+    TS_ASSERT_EQUALS( ThermalModelCache<>::CreateKey( "a" ), 0xaf63dc4c8601ec8cULL );
+    TS_ASSERT_DIFFERS( ThermalModelCache<>::CreateKey( "<ThermalBlock dx=\"1\"/>" ),
+                       ThermalModelCache<>::CreateKey( "<ThermalBlock dx=\"2\"/>" ) );
+
+    TS_ASSERT_EQUALS( ThermalModelCache<>::CreateFileName( "cache", 0x1a ), "cache/thermalModel_000000000000001a.bin" );
+    TS_ASSERT_EQUALS( ThermalModelCache<>::CreateFileName( "cache/", 0x1a ), "cache/thermalModel_000000000000001a.bin" );
+    TS_ASSERT_EQUALS( ThermalModelCache<>::CreateFileName( "", 0xaf63dc4c8601ec8cULL ), "thermalModel_af63dc4c8601ec8c.bin" );
+}
+
+void TestThermalModelCache::TestSaveAndLoad()
+{
+    CachedModel model;
+    FusedData saved;
+    model.Fuse( saved );
+    model.Save( saved, "42" );
+
+    // The thermal state gets the temperature of the restored thermal elements
+    model.mBlockThermalStates[0]->ResetTemperature();
+    FusedData loaded;
+    loaded.mThermalProbes.push_back( ::probe::ThermalProbe( 0.3, 0.1, 0.1 ) );
+    loaded.mThermalProbes.push_back( ::probe::ThermalProbe( 0.1, 0.25, 0.1 ) );
+    TS_ASSERT( model.Load( "42", loaded ) );
+    TS_ASSERT_DELTA( model.mBlockThermalStates[0]->GetValue(), 30.0, 1.0e-12 );
+
+    TS_ASSERT_EQUALS( loaded.mThermalElements.size(), saved.mThermalElements.size() );
+    size_t numberOfElementsWithThermalState = 0;
+    for ( size_t i = 0; i < saved.mThermalElements.size() && i < loaded.mThermalElements.size(); ++i )
+    {
+        const ThermalElement<> &savedElement = *saved.mThermalElements[i];
+        const ThermalElement<> &loadedElement = *loaded.mThermalElements[i];
+        TS_ASSERT_EQUALS( loadedElement.GetGridVertex().Distance( savedElement.GetGridVertex() ), 0.0 );
+        TS_ASSERT_EQUALS( loadedElement.GetVolume(), savedElement.GetVolume() );
+        TS_ASSERT_EQUALS( loadedElement.GetTemperature(), savedElement.GetTemperature() );
+        TS_ASSERT_EQUALS( loadedElement.GetMaterial(), savedElement.GetMaterial() );
+        TS_ASSERT_EQUALS( loadedElement.GetThermalState(), savedElement.GetThermalState() );
+        TS_ASSERT_EQUALS( loadedElement.GetThermalStateFactor(), savedElement.GetThermalStateFactor() );
+        if ( loadedElement.HasThermalState() )
+            ++numberOfElementsWithThermalState;
+    }
+    TS_ASSERT_EQUALS( numberOfElementsWithThermalState, 1 );
+
+    TS_ASSERT_EQUALS( loaded.mConductivityMatrix.size(), saved.mConductivityMatrix.size() );
+    for ( size_t i = 0; i < saved.mConductivityMatrix.size(); ++i )
+    {
+        TS_ASSERT_EQUALS( loaded.mConductivityMatrix[i].size(), saved.mConductivityMatrix[i].size() );
+        for ( size_t j = 0; j < saved.mConductivityMatrix[i].size(); ++j )
+        {
+            TS_ASSERT_EQUALS( loaded.mConductivityMatrix[i][j].mIndex, saved.mConductivityMatrix[i][j].mIndex );
+            TS_ASSERT_EQUALS( loaded.mConductivityMatrix[i][j].mValue, saved.mConductivityMatrix[i][j].mValue );
+        }
+    }
+    CompareTaylorData( loaded.mCoolingDataVector, saved.mCoolingDataVector, false );
+    CompareTaylorData( loaded.mDirichletDataVector, saved.mDirichletDataVector, true );
+
+    TS_ASSERT_EQUALS( loaded.mThermalElementsOfAreas.size(), saved.mThermalElementsOfAreas.size() );
+    for ( size_t i = 0; i < saved.mThermalElementsOfAreas.size() && i < loaded.mThermalElementsOfAreas.size(); ++i )
+        TS_ASSERT_EQUALS( IndexOf( loaded.mThermalElements, loaded.mThermalElementsOfAreas[i] ),
+                          IndexOf( saved.mThermalElements, saved.mThermalElementsOfAreas[i] ) );
+    TS_ASSERT( loaded.mAreas == saved.mAreas );
+    TS_ASSERT( loaded.mVolumes == saved.mVolumes );
+    TS_ASSERT_EQUALS( loaded.mVolumeNames.size(), saved.mVolumeNames.size() );
+    for ( size_t i = 0; i < saved.mVolumeNames.size(); ++i )
+        TS_ASSERT_EQUALS( strcmp( loaded.mVolumeNames[i], saved.mVolumeNames[i] ), 0 );
+    TS_ASSERT_EQUALS( loaded.mVertices.size(), saved.mVertices.size() );
+    for ( size_t i = 0; i < saved.mVertices.size(); ++i )
+        TS_ASSERT_EQUALS( loaded.mVertices[i].Distance( saved.mVertices[i] ), 0.0 );
+    for ( size_t i = 0; i < saved.mThermalProbes.size(); ++i )
+        TS_ASSERT_EQUALS( IndexOf( loaded.mThermalElements, loaded.mThermalProbes[i].GetCorrespondingThermalElement() ),
+                          IndexOf( saved.mThermalElements, saved.mThermalProbes[i].GetCorrespondingThermalElement() ) );
+
+    std::remove( sCacheFileName );
+}
+
+void TestThermalModelCache::TestRejectedFiles()
+{
+    CachedModel model;
+    FusedData saved;
+    model.Fuse( saved );
+    std::remove( sCacheFileName );
+
+    FusedData loaded;
+    loaded.mThermalProbes = saved.mThermalProbes;
+    TS_ASSERT( !model.Load( "42", loaded ) );
+
+    model.Save( saved, "42" );
+    TS_ASSERT( !model.Load( "43", loaded ) );
+
+    // Materials and thermal states of another model
+    model.mMaterials.pop_back();
+    TS_ASSERT( !model.Load( "42", loaded ) );
+    model.mMaterials.push_back( &model.mOtherMaterial );
+    model.mThermalStates.push_back( model.mThermalStates.back() );
+    TS_ASSERT( !model.Load( "42", loaded ) );
+    model.mThermalStates.pop_back();
+    TS_ASSERT( loaded.mThermalElements.empty() );
+    TS_ASSERT( loaded.mConductivityMatrix.empty() );
+    TS_ASSERT( loaded.mAreas.empty() );
+
+    // Stored description that differs from the passed one with the same key, as for a collision of the keys
+    std::string content;
+    {
+        std::ifstream file( sCacheFileName, std::ios::in | std::ios::binary );
+        content.assign( std::istreambuf_iterator< char >( file ), std::istreambuf_iterator< char >() );
+    }
+    std::string otherContent( content );
+    otherContent[sizeof( ThermalModelCache<>::Header ) + sizeof( boost::uint64_t )] = '3';
+    {
+        std::ofstream file( sCacheFileName, std::ios::out | std::ios::binary | std::ios::trunc );
+        file.write( otherContent.data(), otherContent.size() );
+    }
+    TS_ASSERT( !model.Load( "42", loaded ) );
+    TS_ASSERT( loaded.mThermalElements.empty() );
+
+    // Truncated file
+    {
+        std::ofstream file( sCacheFileName, std::ios::out | std::ios::binary | std::ios::trunc );
+        file.write( content.data(), content.size() / 2 );
+    }
+    TS_ASSERT( !model.Load( "42", loaded ) );
+    TS_ASSERT( loaded.mConductivityMatrix.empty() );
+
+    // Thermal elements with a material that is not passed are not saved
+    std::remove( sCacheFileName );
+    model.mMaterials.pop_back();
+    model.Save( saved, "44" );
+    model.mMaterials.push_back( &model.mOtherMaterial );
+    TS_ASSERT( !std::ifstream( sCacheFileName ) );
+
+    std::remove( sCacheFileName );
+}
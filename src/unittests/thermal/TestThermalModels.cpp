@@ -14,6 +14,7 @@ along with this program.  If not, see http://www.gnu.org/licenses/.
 */
 #include "TestThermalModels.h"
 #include "exception_tester.h"
+#include <algorithm>
 
 using namespace thermal;
 static const double sDelta = 0.0001;
@@ -758,3 +759,149 @@ void TestThermalModels::TestCharacteristicLengthCalculationAdvancedAggregation()
         }
     }
 }
+
+/// Axis-parallel box with its lower edge at (x, y, z), used to place geometries on an exactly representable grid
+static shared_ptr< BlockGeometry<> > CreateBox( double x, double y, double z, double dx, double dy, double dz )
+{
+    vector< TwoDim<> > vertices( 4 );
+    vertices.at( 0 ) = TwoDim<>( x, y );
+    vertices.at( 1 ) = TwoDim<>( x + dx, y );
+    vertices.at( 2 ) = TwoDim<>( x + dx, y + dy );
+    vertices.at( 3 ) = TwoDim<>( x, y + dy );
+    return shared_ptr< BlockGeometry<> >( new BlockGeometry<>( Geometry2D<>( vertices ), z, z + dz, "Box" ) );
+}
+
+/// Brute-force reference: the gap between two bounding boxes is the biggest gap along any of the three axes
+static bool BoundingBoxesWithinDistance( const BlockGeometry<> &lhs, const BlockGeometry<> &rhs, double distance )
+{
+    TwoDim<> lhsLower, lhsHigher, rhsLower, rhsHigher;
+    double lhsZLower, lhsZUpper, rhsZLower, rhsZUpper;
+    lhs.GetBoundingBox( lhsLower, lhsHigher, lhsZLower, lhsZUpper );
+    rhs.GetBoundingBox( rhsLower, rhsHigher, rhsZLower, rhsZUpper );
+
+    const double gapX = std::max( rhsLower.Get1() - lhsHigher.Get1(), lhsLower.Get1() - rhsHigher.Get1() );
+    const double gapY = std::max( rhsLower.Get2() - lhsHigher.Get2(), lhsLower.Get2() - rhsHigher.Get2() );
+    const double gapZ = std::max( rhsZLower - lhsZUpper, lhsZLower - rhsZUpper );
+    return std::max( gapX, std::max( gapY, gapZ ) ) <= distance;
+}
+
+void TestThermalModels::TestCandidatePairsMatchBruteForce()
+{
+    // Length tolerance and all coordinates are multiples of 1/16, so that gaps of exactly the tolerance and exactly the
+    // candidate distance are represented without rounding
+    const double toleranceLength = 0.125;
+    const double candidateDistance = 2.0 * toleranceLength;
+    ThermalModel<> thermalModel( Tolerance<>( toleranceLength, Angle<>::Deg( 0.001 ), 0.1 ), ThermalModel<>::AGGREGATE_BY_PLANE_AND_BLOCKS );
+
+    vector< shared_ptr< BlockGeometry<> > > blockGeometries;
+    blockGeometries.push_back( CreateBox( 0.0, 0.0, 0.0, 1.0, 1.0, 1.0 ) );
+    blockGeometries.push_back( CreateBox( 1.0, 0.0, 0.0, 1.0, 1.0, 1.0 ) );         // Touches block 0 without a gap
+    blockGeometries.push_back( CreateBox( 2.0625, 0.0, 0.0, 1.0, 1.0, 1.0 ) );      // Half the tolerance away from block 1
+    blockGeometries.push_back( CreateBox( 3.1875, 0.0, 0.0, 1.0, 1.0, 1.0 ) );      // Exactly the tolerance away from block 2
+    blockGeometries.push_back( CreateBox( 4.4375, 0.0, 0.0, 1.0, 1.0, 1.0 ) );      // Exactly the candidate distance away from block 3
+    blockGeometries.push_back( CreateBox( 5.8125, 0.0, 0.0, 1.0, 1.0, 1.0 ) );      // Just beyond the candidate distance from block 4
+    blockGeometries.push_back( CreateBox( 0.0, 0.0, 1.0625, 1.0, 1.0, 1.0 ) );      // Half the tolerance over block 0
+    blockGeometries.push_back( CreateBox( 0.0, 1.25, 0.0, 1.0, 1.0, 1.0 ) );        // Exactly the candidate distance beside block 0
+    blockGeometries.push_back( CreateBox( 1.0625, 1.0625, 1.0625, 1.0, 1.0, 1.0 ) );    // Only the corners are close
+    blockGeometries.push_back( CreateBox( 0.5, 0.5, -0.5, 1.0, 1.0, 1.0 ) );        // Collides with blocks 0 and 1
+    vector< TwoDim<> > vertices( 3 );
+    vertices.at( 0 ) = TwoDim<>( 6.8125, 2.0 );
+    vertices.at( 1 ) = TwoDim<>( 8.0, 0.0 );
+    vertices.at( 2 ) = TwoDim<>( 8.0, 2.0 );
+    // Bounding box touches block 5, but the triangle itself is far away from it
+    blockGeometries.push_back( shared_ptr< BlockGeometry<> >( new BlockGeometry<>( Geometry2D<>( vertices ), 0.0, 1.0, "Triangle" ) ) );
+
+    // Dense, reproducible layout of boxes with many close and overlapping neighbours
+    size_t seed = 1;
+    for ( size_t i = 0; i < 40; ++i )
+    {
+        double position[6];
+        for ( size_t k = 0; k < 6; ++k )
+        {
+            seed = ( seed * 1103515245 + 12345 ) % 2147483648u;
+            position[k] = static_cast< double >( seed % 32 ) / 16.0;
+        }
+        blockGeometries.push_back( CreateBox( 10.0 + 2.0 * position[0], 2.0 * position[1], 2.0 * position[2],
+                                              0.25 + position[3] / 2.0, 0.25 + position[4] / 2.0, 0.25 + position[5] / 2.0 ) );
+    }
+
+    vector< shared_ptr< BlockGeometry<> > > coolingGeometries;
+    coolingGeometries.push_back( CreateBox( 0.0, -1.125, 0.0, 1.0, 1.0, 1.0 ) );    // Exactly the tolerance beside block 0
+    coolingGeometries.push_back( CreateBox( 0.0, -2.375, 0.0, 1.0, 1.0, 1.0 ) );    // Exactly the candidate distance beside cooling 0
+    coolingGeometries.push_back( CreateBox( 6.0, 0.0, -1.0, 3.0, 1.0, 0.9375 ) );    // Half the tolerance under blocks 5 and 10
+    coolingGeometries.push_back( CreateBox( 11.0, 1.0, 1.0, 2.0, 2.0, 2.0 ) );       // Collides with the dense layout
+
+    for ( size_t i = 0; i < blockGeometries.size(); ++i )
+    {
+        thermalModel.mBlocks.push_back( ThermalModel<>::BlockData() );
+        thermalModel.mBlocks.back().mBlockGeometry = blockGeometries[i];
+    }
+    for ( size_t i = 0; i < coolingGeometries.size(); ++i )
+    {
+        thermalModel.mCoolings.push_back( ThermalModel<>::CoolingData() );
+        thermalModel.mCoolings.back().mBlockGeometry = coolingGeometries[i];
+    }
+
+    vector< pair< size_t, size_t > > blockPairs, blockCoolingPairs, coolingPairs;
+    thermalModel.FindCandidatePairs( blockPairs, blockCoolingPairs, coolingPairs );
+
+    // The layout really exercises contact within the tolerance
+    const Tolerance<> tolerance( toleranceLength, Angle<>::Deg( 0.001 ), 0.1 );
+    TS_ASSERT( blockGeometries[0]->IsAdjacentTo( *blockGeometries[1], tolerance ) != NOT_ADJACENT );
+    TS_ASSERT( blockGeometries[1]->IsAdjacentTo( *blockGeometries[2], tolerance ) != NOT_ADJACENT );
+    TS_ASSERT( blockGeometries[0]->IsAdjacentTo( *blockGeometries[6], tolerance ) != NOT_ADJACENT );
+    TS_ASSERT( blockGeometries[0]->CollidesWith( *blockGeometries[9], tolerance ) );
+
+    vector< pair< size_t, size_t > > expectedBlockPairs, expectedBlockCoolingPairs, expectedCoolingPairs;
+    size_t pairsInContact = 0;
+    for ( size_t i = 0; i < blockGeometries.size(); ++i )
+    {
+        for ( size_t j = i + 1; j < blockGeometries.size(); ++j )
+        {
+            const bool isCandidate = BoundingBoxesWithinDistance( *blockGeometries[i], *blockGeometries[j], candidateDistance );
+            if ( isCandidate )
+                expectedBlockPairs.push_back( pair< size_t, size_t >( i, j ) );
+
+            // No pair that collides or is adjacent may be pruned
+            if ( blockGeometries[i]->CollidesWith( *blockGeometries[j], tolerance ) ||
+                 blockGeometries[i]->IsAdjacentTo( *blockGeometries[j], tolerance ) != NOT_ADJACENT )
+            {
+                ++pairsInContact;
+                TS_ASSERT( isCandidate );
+            }
+        }
+        for ( size_t j = 0; j < coolingGeometries.size(); ++j )
+        {
+            const bool isCandidate = BoundingBoxesWithinDistance( *blockGeometries[i], *coolingGeometries[j], candidateDistance );
+            if ( isCandidate )
+                expectedBlockCoolingPairs.push_back( pair< size_t, size_t >( i, j ) );
+
+            if ( blockGeometries[i]->CollidesWith( *coolingGeometries[j], tolerance ) ||
+                 blockGeometries[i]->IsAdjacentTo( *coolingGeometries[j], tolerance ) != NOT_ADJACENT )
+            {
+                ++pairsInContact;
+                TS_ASSERT( isCandidate );
+            }
+        }
+    }
+    for ( size_t i = 0; i < coolingGeometries.size(); ++i )
+        for ( size_t j = i + 1; j < coolingGeometries.size(); ++j )
+            if ( BoundingBoxesWithinDistance( *coolingGeometries[i], *coolingGeometries[j], candidateDistance ) )
+                expectedCoolingPairs.push_back( pair< size_t, size_t >( i, j ) );
+
+    TS_ASSERT_LESS_THAN( 20, pairsInContact );
+    TS_ASSERT_EQUALS( blockPairs.size(), expectedBlockPairs.size() );
+    TS_ASSERT( blockPairs == expectedBlockPairs );
+    TS_ASSERT_EQUALS( blockCoolingPairs.size(), expectedBlockCoolingPairs.size() );
+    TS_ASSERT( blockCoolingPairs == expectedBlockCoolingPairs );
+    TS_ASSERT_EQUALS( coolingPairs.size(), expectedCoolingPairs.size() );
+    TS_ASSERT( coolingPairs == expectedCoolingPairs );
+
+    // Pairs exactly at the candidate distance are kept, pairs just beyond it are pruned
+    TS_ASSERT( std::binary_search( blockPairs.begin(), blockPairs.end(), pair< size_t, size_t >( 3, 4 ) ) );
+    TS_ASSERT( std::binary_search( blockPairs.begin(), blockPairs.end(), pair< size_t, size_t >( 0, 7 ) ) );
+    TS_ASSERT( !std::binary_search( blockPairs.begin(), blockPairs.end(), pair< size_t, size_t >( 4, 5 ) ) );
+    TS_ASSERT( std::binary_search( blockPairs.begin(), blockPairs.end(), pair< size_t, size_t >( 5, 10 ) ) );
+    TS_ASSERT( std::binary_search( blockPairs.begin(), blockPairs.end(), pair< size_t, size_t >( 0, 8 ) ) );
+    TS_ASSERT( std::binary_search( coolingPairs.begin(), coolingPairs.end(), pair< size_t, size_t >( 0, 1 ) ) );
+}
@@ -33,6 +33,7 @@ class TestThermalModels : public CxxTest::TestSuite
     void TestThermalModel();
     void TestCharacteristicLengthCalculation();
     void TestCharacteristicLengthCalculationAdvancedAggregation();
+    void TestCandidatePairsMatchBruteForce();
 
     private:
     protected:
@@ -20,8 +20,14 @@ along with this program.  If not, see http://www.gnu.org/licenses/.
 _._._._._._._._._._._._._._._._._._._._._.*/
 #include "TestThermalSimulation.h"
 #include "../../thermal/thermal_simulation.h"
+#include "../../thermal/blocks/rectangular_block.h"
 #include "../../xmlparser/tinyxml2/xmlparserimpl.h"
+#include "../../misc/tinydir.h"
+#include <cstdio>
+#include <cstring>
+#include <fstream>
 #include <iostream>
+#include <iterator>
 
 
 void TestThermalSimulation::TestThermalSimulationRun()
@@ -40,3 +46,112 @@ void TestThermalSimulation::TestThermalSimulationRun()
                     sim.mThermalProbes.at( i ).GetCoordinates() ) < 0.0001 );
     }
 }
+
+void TestThermalSimulation::TestParallelBlockCreation()
+{
+#ifdef BOOST_THREAD
+    typedef simulation::ThermalSimulation< myMatrixType, double, true > ThermalSimulationType;
+    thermal::Material<> material( 2700.0, 897.0, 235.0, 235.0, 235.0 );
+    std::vector< boost::shared_ptr< thermal::ThermalBlock<> > > blockOwners;
+    std::vector< thermal::ThermalBlock<> * > blocks;
+    for ( size_t i = 0; i < 7; ++i )
+    {
+        char description[16];
+        sprintf( description, "Block%lu", static_cast< unsigned long >( i ) );
+        blockOwners.push_back( boost::shared_ptr< thermal::ThermalBlock<> >(
+         new thermal::RectangularBlock<>( description, geometry::Cartesian<>( 0.1 * i, 0.0, 0.0 ), 0.1, 0.2, 0.05, 2 + i,
+                                          3, 1 + i % 3, &material, 20.0 + i ) ) );
+        blocks.push_back( blockOwners.back().get() );
+    }
+
+    // The data of every block must not depend on the number of threads
+    std::vector< ThermalSimulationType::ThermalBlockData > serialData;
+    std::vector< ThermalSimulationType::ThermalBlockData > parallelData;
+    ThermalSimulationType::CreateThermalBlockData( blocks, true, 1, serialData );
+    ThermalSimulationType::CreateThermalBlockData( blocks, true, 3, parallelData );
+    TS_ASSERT_EQUALS( serialData.size(), blocks.size() );
+    TS_ASSERT_EQUALS( parallelData.size(), blocks.size() );
+
+    for ( size_t i = 0; i < blocks.size(); ++i )
+    {
+        const ThermalSimulationType::ThermalBlockData &serial = serialData[i];
+        const ThermalSimulationType::ThermalBlockData &parallel = parallelData[i];
+        TS_ASSERT_EQUALS( strcmp( serial.mDescription, parallel.mDescription ), 0 );
+        TS_ASSERT_EQUALS( parallel.mThermalElements.size(), blocks[i]->GetNumberOfThermalElements() );
+        TS_ASSERT_EQUALS( serial.mThermalElements.size(), parallel.mThermalElements.size() );
+        for ( size_t j = 0; j < serial.mThermalElements.size(); ++j )
+        {
+            TS_ASSERT_EQUALS( serial.mThermalElements[j]->GetGridVertex().Distance( parallel.mThermalElements[j]->GetGridVertex() ), 0.0 );
+            TS_ASSERT_EQUALS( serial.mThermalElements[j]->GetTemperature(), parallel.mThermalElements[j]->GetTemperature() );
+        }
+        TS_ASSERT_EQUALS( serial.mConductivityMatrix.size(), parallel.mConductivityMatrix.size() );
+        for ( size_t j = 0; j < serial.mConductivityMatrix.size(); ++j )
+        {
+            TS_ASSERT_EQUALS( serial.mConductivityMatrix[j].size(), parallel.mConductivityMatrix[j].size() );
+            for ( size_t k = 0; k < serial.mConductivityMatrix[j].size(); ++k )
+            {
+                TS_ASSERT_EQUALS( serial.mConductivityMatrix[j][k].mIndex, parallel.mConductivityMatrix[j][k].mIndex );
+                TS_ASSERT_EQUALS( serial.mConductivityMatrix[j][k].mValue, parallel.mConductivityMatrix[j][k].mValue );
+            }
+        }
+        TS_ASSERT_EQUALS( serial.mSurfaceElements.size(), parallel.mSurfaceElements.size() );
+        TS_ASSERT_EQUALS( serial.mInnerSurfaceElements.size(), parallel.mInnerSurfaceElements.size() );
+        TS_ASSERT( parallel.mBlockGeometry );
+    }
+#endif
+}
+
+void TestThermalSimulation::TestThermalModelCacheRun()
+{
+    std::ifstream xmlFile( "./TestRectangularblock.xml" );
+    std::string xml( ( std::istreambuf_iterator< char >( xmlFile ) ), std::istreambuf_iterator< char >() );
+    xml.insert( xml.find( "<Options>" ) + strlen( "<Options>" ), "<ThermalModelCache>.</ThermalModelCache>" );
+    xmlparser::tinyxml2::XmlParserImpl parser;
+    parser.ReadFromMem( xml.c_str() );
+    boost::shared_ptr< xmlparser::XmlParameter > rootXmlNode = parser.GetRoot();
+
+    // The first simulation fuses the thermal model and writes the cache, the second one loads it
+    simulation::ThermalSimulation< myMatrixType, double, true > fusedSim( rootXmlNode, 0.001, 0.5, 5, 0, 0, 0 );
+    std::vector< std::string > cacheFiles = _tinydir_get_dir_entries( ".", std::string( ".bin" ) );
+    size_t numberOfCacheFiles = 0;
+    for ( size_t i = 0; i < cacheFiles.size(); ++i )
+        if ( cacheFiles[i].compare( 0, strlen( "thermalModel_" ), "thermalModel_" ) == 0 )
+            ++numberOfCacheFiles;
+    TS_ASSERT_EQUALS( numberOfCacheFiles, 1 );
+    simulation::ThermalSimulation< myMatrixType, double, true > cachedSim( rootXmlNode, 0.001, 0.5, 5, 0, 0, 0 );
+
+    const std::vector< boost::shared_ptr< thermal::ThermalElement<> > > &fusedElements =
+     fusedSim.mThermalSystem->GetThermalElements();
+    const std::vector< boost::shared_ptr< thermal::ThermalElement<> > > &cachedElements =
+     cachedSim.mThermalSystem->GetThermalElements();
+    TS_ASSERT_EQUALS( fusedElements.size(), cachedElements.size() );
+    for ( size_t i = 0; i < fusedElements.size() && i < cachedElements.size(); ++i )
+    {
+        // Cached elements are restored from the file instead of being discretized again
+        TS_ASSERT( dynamic_cast< thermal::RestoredElement<>* >( cachedElements[i].get() ) );
+        TS_ASSERT_EQUALS( fusedElements[i]->GetGridVertex().Distance( cachedElements[i]->GetGridVertex() ), 0.0 );
+        TS_ASSERT_DELTA( fusedElements[i]->GetVolume(), cachedElements[i]->GetVolume(), 1.0e-15 );
+        TS_ASSERT_EQUALS( fusedElements[i]->GetMaterial()->GetDensity(), cachedElements[i]->GetMaterial()->GetDensity() );
+        TS_ASSERT_EQUALS( fusedElements[i]->HasThermalState(), cachedElements[i]->HasThermalState() );
+    }
+    TS_ASSERT_EQUALS( fusedSim.mThermalProbes.size(), cachedSim.mThermalProbes.size() );
+    for ( size_t i = 0; i < cachedSim.mThermalProbes.size(); ++i )
+        TS_ASSERT_EQUALS( fusedSim.mThermalProbes[i].GetCorrespondingThermalElement()->GetGridVertex().Distance(
+                           cachedSim.mThermalProbes[i].GetCorrespondingThermalElement()->GetGridVertex() ),
+                          0.0 );
+
+    // Both thermal systems evolve identically
+    std::vector< double > fusedDxdt( fusedSim.mTemperatures.size() );
+    std::vector< double > cachedDxdt( cachedSim.mTemperatures.size() );
+    fusedSim.UpdateSystem();
+    cachedSim.UpdateSystem();
+    ( *fusedSim.mThermalSystem )( fusedSim.mTemperatures, fusedDxdt, 0.0 );
+    ( *cachedSim.mThermalSystem )( cachedSim.mTemperatures, cachedDxdt, 0.0 );
+    TS_ASSERT_EQUALS( fusedDxdt.size(), cachedDxdt.size() );
+    for ( size_t i = 0; i < fusedDxdt.size() && i < cachedDxdt.size(); ++i )
+        TS_ASSERT_DELTA( fusedDxdt[i], cachedDxdt[i], 1.0e-12 );
+
+    for ( size_t i = 0; i < cacheFiles.size(); ++i )
+        if ( cacheFiles[i].compare( 0, strlen( "thermalModel_" ), "thermalModel_" ) == 0 )
+            std::remove( cacheFiles[i].c_str() );
+}
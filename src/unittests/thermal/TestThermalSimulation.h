@@ -27,5 +27,7 @@ class TestThermalSimulation : public CxxTest::TestSuite
 {
     public:
     void TestThermalSimulationRun();
+    void TestParallelBlockCreation();
+    void TestThermalModelCacheRun();
 };
 #endif /* _TESTERMALSIMULATION_ */
@@ -77,6 +77,9 @@ void TestThermalStructs::TestJaggedArray()
     TS_ASSERT_EQUALS(jaggedArray.Begin(1), intPtr + 3);
     TS_ASSERT_EQUALS(jaggedArray.Begin(2), intPtr + 3);
     TS_ASSERT_EQUALS(jaggedArray.Begin(3), intPtr + 4);
+    TS_ASSERT_EQUALS(jaggedArray.End(0), jaggedArray.Begin(1));
+    TS_ASSERT_EQUALS(jaggedArray.End(1), jaggedArray.Begin(1));
+    TS_ASSERT_EQUALS(jaggedArray.End(2), intPtr + 4);
 
     TS_ASSERT_EQUALS(*intPtr++, 8);
     TS_ASSERT_EQUALS(*intPtr++, -4);
@@ -21,7 +21,9 @@ _._._._._._._._._._._._._._._._._._._._._.*/
 #include "TestXML.h"
 
 // STD
+#include <cstdio>
 #include <cstring>
+#include <string>
 
 // BOOST
 #include <boost/shared_ptr.hpp>
@@ -86,6 +88,35 @@ void TestXML::TestXmlGetAttributeDoubleGetUnrefrencedChild()
     TS_ASSERT( strcmp( children.at( 1 )->GetElementName(), "ElementWithRef2" ) == 0 );
 }
 
+void TestXML::TestXmlElementAsStringContainsReferencedElements()
+{
+    const char *xmlConfig =
+     "<?xml version='1.0'?>\
+        <Configuration>\
+            <CustomDefinitions>\
+                <MyMaterial class='Material'><Density>%s</Density></MyMaterial>\
+                <MyBlock class='RectangularBlock'><Material ref='MyMaterial'/><Parent ref='MyBlock'/></MyBlock>\
+            </CustomDefinitions>\
+            <ThermalBlock ref='MyBlock'/>\
+        </Configuration>";
+    char xmlConfigWithDensity[1024] = {0};
+
+    // The nested references are resolved, the reference of MyBlock to itself is not resolved again
+    snprintf( xmlConfigWithDensity, sizeof( xmlConfigWithDensity ), xmlConfig, "2000" );
+    xmlparser::tinyxml2::XmlParserImpl parser;
+    parser.ReadFromMem( xmlConfigWithDensity );
+    const std::string description = parser.GetRoot()->GetElementChild( "ThermalBlock" )->GetElementAsString();
+    TS_ASSERT_EQUALS( description,
+                      "<MyBlock class=\"RectangularBlock\"><Material ref=\"MyMaterial\"><MyMaterial class=\"Material\">"
+                      "<Density>2000</Density></MyMaterial></Material><Parent ref=\"MyBlock\"/></MyBlock>" );
+
+    // A change of the referenced material changes the text
+    snprintf( xmlConfigWithDensity, sizeof( xmlConfigWithDensity ), xmlConfig, "2100" );
+    xmlparser::tinyxml2::XmlParserImpl otherParser;
+    otherParser.ReadFromMem( xmlConfigWithDensity );
+    TS_ASSERT_DIFFERS( otherParser.GetRoot()->GetElementChild( "ThermalBlock" )->GetElementAsString(), description );
+}
+
 template < typename T >
 bool TestXML::CheckTwoPortTypeAndValue( electrical::TwoPort< T >* testedTwoPort, const char* expectedType, double expectedValue )
 {
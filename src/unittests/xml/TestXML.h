@@ -32,6 +32,7 @@ class TestXML : public CxxTest::TestSuite
 {
     public:
     void TestXmlGetAttributeDoubleGetUnrefrencedChild();
+    void TestXmlElementAsStringContainsReferencedElements();
     void testXMLCacheRefInstance();
     void testXMLTestConfigfile();
     void testXMLReferencedCapacitance();
@@ -20,6 +20,7 @@ along with this program.  If not, see http://www.gnu.org/licenses/.
  */
 
 #include "xmlparameterimpl.h"
+#include <algorithm>
 #include <cstring>
 #include "../../misc/charArrayCmp.h"
 #include "../../cstring/strtok_rbsd.h"
@@ -473,5 +474,39 @@ boost::shared_ptr< XmlParameter > XmlParameterImpl::GetConfigurationRoot() const
     XMLElement* root = mNodePtr->GetDocument()->FirstChildElement();
     return boost::shared_ptr< XmlParameter >( new XmlParameterImpl( root ) );
 }
+
+std::string XmlParameterImpl::GetElementAsString() const
+{
+    XMLPrinter printer( 0, true );
+    std::vector< XMLElement* > printedElements;
+    PrintElement( mNodePtr, printer, printedElements );
+    return printer.CStr();
+}
+
+void XmlParameterImpl::PrintElement( XMLElement* node, XMLPrinter& printer, std::vector< XMLElement* >& printedElements ) const
+{
+    printedElements.push_back( node );
+    printer.OpenElement( node->Name() );
+    for ( const XMLAttribute* attribute = node->FirstAttribute(); attribute; attribute = attribute->Next() )
+        printer.PushAttribute( attribute->Name(), attribute->Value() );
+
+    // A reference is printed with the referenced element inside, unless that element is already being printed
+    if ( IsReference( node ) )
+    {
+        XMLElement* referencedElement = GetReferencedRawElement( node );
+        if ( std::find( printedElements.begin(), printedElements.end(), referencedElement ) == printedElements.end() )
+            PrintElement( referencedElement, printer, printedElements );
+    }
+
+    for ( XMLNode* child = node->FirstChild(); child; child = child->NextSibling() )
+    {
+        if ( child->ToElement() )
+            PrintElement( child->ToElement(), printer, printedElements );
+        else if ( child->ToText() )
+            printer.PushText( child->Value(), child->ToText()->CData() );
+    }
+    printer.CloseElement();
+    printedElements.pop_back();
+}
 }
 } /* namespace factory */
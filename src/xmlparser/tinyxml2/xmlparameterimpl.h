@@ -79,6 +79,8 @@ class XmlParameterImpl : public xmlparser::XmlParameter
 
     size_t GetLineNumber() const;
 
+    std::string GetElementAsString() const;
+
     private:
     XMLElement* GetRawElement( const char* elementName, bool throwOnMiss = true ) const;
 
@@ -88,6 +90,10 @@ class XmlParameterImpl : public xmlparser::XmlParameter
 
     XMLElement* GetReferencedRawElement( XMLElement* node ) const;
 
+    /// Prints node and its subnodes, references to elements in printedElements, which are being printed, are not
+    /// resolved
+    void PrintElement( XMLElement* node, XMLPrinter& printer, std::vector< XMLElement* >& printedElements ) const;
+
     bool IsReference( XMLElement* node ) const;
 
     bool HasAttribute( XMLElement* param, const char* attrName ) const;
@@ -108,6 +108,10 @@ class XmlParameter
 
     /// Gets line number of this parameter in xml-file
     virtual size_t GetLineNumber() const = 0;
+
+    /// Returns this node with all its subnodes as compact xml text. Elements with a ref attribute contain the referenced
+    /// element, so the text changes if a referenced definition changes.
+    virtual std::string GetElementAsString() const = 0;
 };
 
 } /* namespace xmlfactory */
@@ -0,0 +1,127 @@
+/*
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see http://www.gnu.org/licenses/.
+*/
+/* -.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.
+* File Name : binaryResultConverter.cpp
+* Creation Date : 17-10-2026
+_._._._._._._._._._._._._._._._._._._._._.*/
+
+// Converts a binary result file of the BinaryFilter into a csv-file or a mat-file.
+// The csv-file has one line per point of time and element like the CsvFilter of the electrical observer, the mat-file
+// holds the time as diga.daten.Programmdauer and every quantity as diga.daten.<name> with one row per element.
+
+// STD
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <string>
+#include <vector>
+
+// ETC
+#include "../src/observer/filter/binaryResultFile.h"
+#include "../src/container/matio_file.h"
+
+
+void WriteCsv( const observer::BinaryResultReader &reader, const std::string &fileName )
+{
+    std::ofstream file( fileName.c_str() );
+    file << std::fixed << std::setprecision( std::numeric_limits< double >::digits10 + 1 );
+
+    file << "#Time, Elementnr";
+    for ( size_t i = 0; i < reader.GetNumberOfQuantities(); ++i )
+        file << ", " << reader.GetName( i );
+    file << "\n#s, Number";
+    for ( size_t i = 0; i < reader.GetNumberOfQuantities(); ++i )
+        file << ", " << reader.GetName( i ) << " / " << reader.GetUnit( i );
+    file << "\n";
+
+    for ( size_t record = 0; record < reader.GetNumberOfRecords(); ++record )
+    {
+        const double time = reader.GetTime( record );
+        for ( size_t element = 0; element < reader.GetNumberOfElements(); ++element )
+        {
+            file << time << "," << reader.GetElementId( element );
+            for ( size_t quantity = 0; quantity < reader.GetNumberOfQuantities(); ++quantity )
+                file << "," << reader.GetValue( record, quantity, element );
+            file << "\n";
+        }
+    }
+}
+
+void WriteMat( const observer::BinaryResultReader &reader, const std::string &fileName )
+{
+    const size_t numberOfRecords = reader.GetNumberOfRecords();
+    const size_t numberOfElements = reader.GetNumberOfElements();
+
+    // The values are not copied by MatioData and have to outlive the write in the destructor of the MatFile
+    std::vector< double > times( numberOfRecords );
+    for ( size_t record = 0; record < numberOfRecords; ++record )
+        times[record] = reader.GetTime( record );
+
+    // The file is read column by column, a column of the file is a row of the matrix
+    std::vector< std::vector< double > > quantities( reader.GetNumberOfQuantities(),
+                                                    std::vector< double >( numberOfElements * numberOfRecords ) );
+    std::vector< double > column;
+    for ( size_t quantity = 0; quantity < quantities.size(); ++quantity )
+        for ( size_t element = 0; element < numberOfElements; ++element )
+        {
+            reader.GetValues( quantity, element, column );
+            for ( size_t record = 0; record < numberOfRecords; ++record )
+                quantities[quantity][record * numberOfElements + element] = column[record];
+        }
+
+    matlab::MatFile matFile( fileName, MAT_ACC_RDWR );
+    if ( !numberOfRecords )
+        return;
+    matFile << matlab::MatioData( &times[0], 1, numberOfRecords, "diga.daten.Programmdauer" );
+    for ( size_t quantity = 0; quantity < quantities.size(); ++quantity )
+    {
+        if ( numberOfElements )
+            matFile << matlab::MatioData( &quantities[quantity][0], numberOfElements, numberOfRecords,
+                                          "diga.daten." + reader.GetName( quantity ) );
+    }
+}
+
+int main( int argc, char *argv[] )
+{
+    if ( argc != 3 )
+    {
+        printf( "Error, must be called with exactly 2 parameters:\nbinary result file\ncsv-file or mat-file\n" );
+        return EXIT_FAILURE;
+    }
+
+    try
+    {
+        observer::BinaryResultReader reader( argv[1] );
+        const std::string fileName( argv[2] );
+        if ( fileName.size() > 4 && fileName.substr( fileName.size() - 4 ) == ".mat" )
+            WriteMat( reader, fileName );
+        else
+            WriteCsv( reader, fileName );
+    }
+    catch ( std::exception &e )
+    {
+        printf( "%s\n", e.what() );
+        return EXIT_FAILURE;
+    }
+    catch ( ... )
+    {
+        printf( "Unidentified error\n" );
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -18,20 +18,23 @@ along with this program.  If not, see http://www.gnu.org/licenses/.
 #include <cstring>
 #include <string>
 
-// BOOST
-#include <boost/numeric/odeint.hpp>
-
 // ETC
 #include "../src/xmlparser/tinyxml2/xmlparserimpl.h"
 #include "../src/misc/StrCont.h"
 #include "../src/misc/matrixInclude.h"
-#include "../src/misc/fast_copy_matrix.h"
-#include "../src/thermal/electrical_simulation.h"
+#include "../src/thermal/coupling_driver.h"
+#include "../src/thermal/simulation_steppers.h"
 #include "../src/time_series/time_series.h"
 #include "../src/time_series/eval_linear_interpolation.h"
 #include "../src/container/matio_file.h"
 
 
+/// Prints the point of time after each step of the electrical simulation
+struct TimePrinter
+{
+    void operator()( double time ) { printf( "%f\n", time ); }
+};
+
 int main( int argc, char *argv[] )
 {
     if ( argc != 3 )
@@ -108,6 +111,8 @@ int main( int argc, char *argv[] )
         electricalSimulation.reset(
          new simulation::ElectricalSimulation< myMatrixType, double >( rootXmlNode, stepTime,
                                                                        currentProfile->GetMaxTime(), 0.1, &cells ) );
+        if ( !electricalSimulation->IsStateSystemStampCompiled() )
+            printf( "Not all electrical elements support the compiled stamp, the equations are assembled in each step\n" );
         parser.reset();
     }
     catch ( std::exception &e )
@@ -124,75 +129,12 @@ int main( int argc, char *argv[] )
     }
 
 
-// Equation solvers
-#if defined( _ARMADILLO_ ) && not defined( SPARSE_MATRIX_FORMAT )
-    boost::numeric::odeint::result_of::make_controlled< boost::numeric::odeint::runge_kutta_cash_karp54< myMatrixType > >::type stepperElectrical =
-     make_controlled( 1.0e-10, 1.0e-10, boost::numeric::odeint::runge_kutta_cash_karp54< myMatrixType >() );
-#else
-    boost::numeric::odeint::result_of::make_controlled< boost::numeric::odeint::runge_kutta_cash_karp54< std::vector< double > > >::type stepperElectrical =
-     make_controlled( 1.0e-10, 1.0e-10, boost::numeric::odeint::runge_kutta_cash_karp54< std::vector< double > >() );
-    std::vector< double > tmpStateVector( electricalSimulation->mStateSystemGroup.mStateVector.n_rows, 0.0 );
-#endif
-
     // Run simulation
-    electricalSimulation->mRootTwoPort->SetCurrent( 0.0 );
-    electricalSimulation->UpdateSystem();
-    electricalSimulation->UpdateSystemValues();
-    ( *electricalSimulation->mObserver )( electricalSimulation->mTime );
-    double currentChangeTime = 0.0;
-    while ( electricalSimulation->CheckIfSumlationTimeHasNotEndedAndSetStepStartTime() )
-    {
-        printf( "%f\n", electricalSimulation->mTime );
-        // Current profile
-        if ( electricalSimulation->mTime >= currentChangeTime )
-        {
-            currentProfile->SetTimeAndTriggerEvaluation( electricalSimulation->mTime );
-            electricalSimulation->mRootTwoPort->SetCurrent( currentProfile->GetValue() );
-            currentChangeTime = currentProfile->GetTimeUntilMaxValueDeviation( 0.0 );
-        }
-
-        // Electrical simulation
-        //// Initialize block Observer
-        electricalSimulation->InitializeStopCriterion();
-        while ( electricalSimulation->CheckLoopConditionAndSetDeltaTime( currentChangeTime ) &&
-                !electricalSimulation->IsStopCriterionFulfilled() )
-        {
-            electricalSimulation->UpdateSystem();
-
-#if defined( _ARMADILLO_ ) && !defined( SPARSE_MATRIX_FORMAT )
-            // Run electrical equation solver
-
-            myMatrixType state = electricalSimulation->mStateSystemGroup.mStateVector.submat(
-             0, 0, electricalSimulation->mStateSystemGroup.mStateVector.n_rows - 2, 0 );
-            electricalSimulation->mStateSystemGroup.mDt = electricalSimulation->mDeltaTime;
-            while ( stepperElectrical.try_step( boost::ref( *electricalSimulation->mEqSystem ), state, electricalSimulation->mTime,
-                                                electricalSimulation->mDeltaTime ) != boost::numeric::odeint::success )
-            {
-                electricalSimulation->mStateSystemGroup.mStateVector.submat(
-                 0, 0, electricalSimulation->mStateSystemGroup.mStateVector.n_rows - 2, 0 ) = state;
-                electricalSimulation->mStateSystemGroup.mDt = electricalSimulation->mDeltaTime;
-            }
-#else
-            // Run electrical equation solver
-            misc::FastCopyMatrix( &tmpStateVector[0], electricalSimulation->mStateSystemGroup.mStateVector, tmpStateVector.size() );
-            electricalSimulation->mStateSystemGroup.mDt = electricalSimulation->mDeltaTime;
-            while ( stepperElectrical.try_step( boost::ref( *electricalSimulation->mEqSystem ), tmpStateVector,
-                                                electricalSimulation->mTime,
-                                                electricalSimulation->mDeltaTime ) != boost::numeric::odeint::success )
-            {
-                electricalSimulation->mStateSystemGroup.mDt = electricalSimulation->mDeltaTime;
-            }
-            misc::FastCopyMatrix( electricalSimulation->mStateSystemGroup.mStateVector, &tmpStateVector[0], tmpStateVector.size() );
-#endif
-
-            electricalSimulation->UpdateSystemValues();
-            ( *electricalSimulation->mObserver )( electricalSimulation->mTime );
-            electricalSimulation->SaveStatesForLaterReset();
-        }
-
-        // Finish step
-        electricalSimulation->FinshStep();
-    }
+    simulation::CouplingDriver< simulation::ElectricalStepper< myMatrixType >, simulation::ThermalStepper< myMatrixType > >
+     couplingDriver( electricalSimulation.get(), 0 );
+    simulation::CurrentProfileInput< myMatrixType > currentInput( electricalSimulation.get(), currentProfile.get() );
+    TimePrinter timePrinter;
+    couplingDriver.Run( currentInput, timePrinter );
 
     // Sucessful exit
     return EXIT_SUCCESS;
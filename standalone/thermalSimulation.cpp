@@ -20,7 +20,8 @@ along with this program.  If not, see http://www.gnu.org/licenses/.
 _._._._._._._._._._._._._._._._._._._._._.*/
 
 #include "../src/misc/matrixInclude.h"
-#include "../src/thermal/thermal_simulation.h"
+#include "../src/thermal/coupling_driver.h"
+#include "../src/thermal/simulation_steppers.h"
 #include "../src/xmlparser/tinyxml2/xmlparserimpl.h"
 #include "../src/time_series/time_series.h"
 #include "../src/time_series/eval_linear_interpolation.h"
@@ -30,6 +31,36 @@ _._._._._._._._._._._._._._._._._._._._._.*/
 
 #include <iostream>
 using namespace matlab;
+
+/// Writes the temperature, the thermal visualizer and the power dissipation after each thermal step
+class ThermalResultWriter
+{
+    public:
+    ThermalResultWriter( const simulation::ThermalSimulation< myMatrixType, double, true > *thermalSimulation,
+                         observer::ThermalObserver< double > *thermalVisualizer,
+                         const electrical::TimeSeries< double, electrical::EvalNoInterpolation > *powerProfile, std::ostream *file )
+        : mThermalSimulation( thermalSimulation )
+        , mThermalVisualizer( thermalVisualizer )
+        , mPowerProfile( powerProfile )
+        , mFile( file )
+    {
+    }
+
+    void operator()( double time )
+    {
+        std::cout << "time: " << time << "\t Temperature: "
+                  << mThermalSimulation->mThermalStates[mThermalSimulation->mThermalStates.size() - 1]->GetValue() << std::endl;
+        ( *mThermalVisualizer )( time );
+        *mFile << mPowerProfile->GetValue() << "\n";
+    }
+
+    private:
+    const simulation::ThermalSimulation< myMatrixType, double, true > *const mThermalSimulation;
+    observer::ThermalObserver< double > *const mThermalVisualizer;
+    const electrical::TimeSeries< double, electrical::EvalNoInterpolation > *const mPowerProfile;
+    std::ostream *const mFile;
+};
+
 int main( int argc, char *argv[] )
 {
     if ( argc != 3 )
@@ -125,10 +156,6 @@ int main( int argc, char *argv[] )
         return EXIT_FAILURE;
     }
 
-    // Equation solvers
-    boost::numeric::odeint::result_of::make_controlled< boost::numeric::odeint::runge_kutta_cash_karp54< vector< double > > >::type stepperThermal =
-     make_controlled( 1.0e-10, 1.0e-10, boost::numeric::odeint::runge_kutta_cash_karp54< vector< double > >() );
-
     // Set fixed power dissipation
     powerProfile->SetTimeAndTriggerEvaluation( thermalSimulation->mTime );
     std::cout << "Thermal Size: " << thermalSimulation->mThermalStates.size() << std::endl;
@@ -143,51 +170,12 @@ int main( int argc, char *argv[] )
     ( *thermalVisualizer )( thermalSimulation->mTime );
 
     // Thermal simulation
-    double currentChangeTime = 0.0;
-    while ( thermalSimulation->CheckIfSumlationTimeHasNotEnded() )
-    {
-
-        if ( thermalSimulation->mTime >= currentChangeTime )
-        {
-            powerProfile->SetTimeAndTriggerEvaluation( thermalSimulation->mTime );
-            thermalSimulation->mThermalStates.at( 0 )->SetFixedPowerDissipation( powerProfile->GetValue() );
-            currentChangeTime = powerProfile->GetTimeUntilMaxValueDeviation( 0.0 );
-        }
-
-
-        thermalSimulation->InitializeStopCriterion();
-        while ( thermalSimulation->CheckLoopConditionAndSetDeltaTime( currentChangeTime ) )
-        {
-
-            if ( thermalSimulation->IsStopCriterionFulfilled() )
-            {
-                thermalSimulation->UpdateSystem();
-
-                thermalSimulation->UpdateAllThermalStatesTemperatures();
-
-
-                break;
-            }
-
-            std::cout << "time: " << thermalSimulation->mTime << "\t Temperature: "
-                      << thermalSimulation->mThermalStates[thermalSimulation->mThermalStates.size() - 1]->GetValue()
-                      << std::endl;
-            // Run thermal equation solver
-            while ( stepperThermal.try_step( boost::ref( *thermalSimulation->mThermalSystem ),
-                                             thermalSimulation->mTemperatures, thermalSimulation->mTime,
-                                             thermalSimulation->mDeltaTime ) != boost::numeric::odeint::success )
-            {
-            }
-
-            thermalSimulation->UpdateSystem();
-
-
-            thermalSimulation->UpdateAllThermalStatesTemperatures();
-
-            ( *thermalVisualizer )( thermalSimulation->mTime );
-            fileVolumeDissapation << powerProfile->GetValue() << "\n";
-        }
-    }
+    simulation::CouplingDriver< simulation::ElectricalStepper< myMatrixType >, simulation::ThermalStepper< myMatrixType > >
+     couplingDriver( 0, thermalSimulation.get() );
+    simulation::PowerProfileInput< myMatrixType > powerInput( thermalSimulation.get(), powerProfile.get() );
+    ThermalResultWriter thermalResultWriter( thermalSimulation.get(), thermalVisualizer.get(), powerProfile.get(),
+                                             &fileVolumeDissapation );
+    couplingDriver.Run( powerInput, thermalResultWriter );
 
     // Sucessful exit
     std::cout << "Run was successful" << std::endl;
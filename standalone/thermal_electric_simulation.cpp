@@ -15,20 +15,16 @@ along with this program.  If not, see http://www.gnu.org/licenses/.
 #include <cstring>
 
 #include "../src/container/matio_file.h"
-#include "../src/misc/fast_copy_matrix.h"
+#include "../src/misc/format_buffer.h"
 #include "../src/misc/matrixInclude.h"
 #include "../src/misc/StrCont.h"
-#include "../src/thermal/electrical_simulation.h"
-#include "../src/thermal/thermal_simulation.h"
+#include "../src/thermal/coupling_driver.h"
+#include "../src/thermal/simulation_steppers.h"
 #include "../src/xmlparser/tinyxml2/xmlparserimpl.h"
 
 #include <fstream>
 #include <string>
 
-// BOOST
-#include <boost/numeric/odeint.hpp>
-
-
 // forward declarations
 const double thermal::globalMaxValue = 1000000000.0;
 const double thermal::globalMinValue = -thermal::globalMaxValue;
@@ -38,6 +34,67 @@ const double socStopCriterion = 5.0;             // percent
 const double thermalStateStopCriterion = 5.0;    // degree C
 
 
+/// Writes the temperatures of the thermal elements and the thermal visualizer 1000 times during the simulation
+class ThermalResultWriter
+{
+    public:
+    ThermalResultWriter( const simulation::ThermalSimulation< myMatrixType, double, true > *thermalSimulation,
+                         observer::ThermalObserver< double > *thermalVisualizer, double simulationDuration, std::ostream *file )
+        : mThermalSimulation( thermalSimulation )
+        , mThermalVisualizer( thermalVisualizer )
+        , mSimulationDuration( simulationDuration )
+        , mFile( file )
+        , mTimeCounter( 0 )
+        , mTemperatureBuffer( 6 )    // 6 digits like the default precision of the stream
+    {
+    }
+
+    void operator()( double time )
+    {
+        if ( time < mSimulationDuration / 1000.0 * mTimeCounter )
+            return;
+
+        // Write simulation data to file
+        ++mTimeCounter;
+        ( *mThermalVisualizer )( time );
+
+        // Output finite volumes temperatures
+        mTemperatureBuffer << time;
+        BOOST_FOREACH ( const boost::shared_ptr< thermal::ThermalElement<> > &elem,
+                        mThermalSimulation->mThermalSystem->GetThermalElements() )
+        {
+            mTemperatureBuffer << ", " << elem->GetTemperature();
+        }
+        mTemperatureBuffer << "\n";
+        if ( mTemperatureBuffer.IsFull() )
+            mTemperatureBuffer.WriteTo( *mFile );
+
+        // Output simulation progress to console during program is running
+        printf( "%.2f, ", std::ceil( static_cast< int >( time * 100.0 + 0.5 ) ) / 100.0 );
+    }
+
+    void Flush() { mTemperatureBuffer.WriteTo( *mFile ); }
+
+    private:
+    const simulation::ThermalSimulation< myMatrixType, double, true > *const mThermalSimulation;
+    observer::ThermalObserver< double > *const mThermalVisualizer;
+    const double mSimulationDuration;
+    std::ostream *const mFile;
+    size_t mTimeCounter;
+    // Collects the lines and writes them in blocks
+    misc::FormatBuffer mTemperatureBuffer;
+};
+
+/// Reports the resets of the electrical simulation by the thermal stop criterion on the console
+struct ResetPrinter
+{
+    void operator()( double time ) const
+    {
+        printf( "Temperature stop criterion triggered at %.0f sec, electrical states reset\n", time );
+    }
+};
+
+
 int main( int argc, char *argv[] )
 {
     if ( argc != 4 )
@@ -124,6 +181,8 @@ int main( int argc, char *argv[] )
         electricalSimulation.reset(
          new simulation::ElectricalSimulation< myMatrixType, double >( rootXmlNode, stepTime, currentProfile->GetMaxTime(),
                                                                        socStopCriterion, &cells ) );
+        if ( !electricalSimulation->IsStateSystemStampCompiled() )
+            printf( "Not all electrical elements support the compiled stamp, the equations are assembled in each step\n" );
 
         std::vector< std::vector< boost::shared_ptr< ThermalState< double > > > > thermalStatesOfCellBlocks;
         thermalSimulation.reset( new simulation::ThermalSimulation< myMatrixType, double, true >(
@@ -150,12 +209,13 @@ int main( int argc, char *argv[] )
     //{
     // Output conductivity matrix
     std::ofstream fileConduction( "Conductivity.csv" );
-    BOOST_FOREACH ( const std::vector< thermal::IndexedValue< double > > &line,
-                    thermalSimulation->mThermalSystem->GetA_th_Conductivity() )
+    const thermal::JaggedArray< thermal::IndexedValue< double > > &conductivity =
+     thermalSimulation->mThermalSystem->GetA_th_Conductivity();
+    for ( size_t i = 0; i < conductivity.GetNumberOfArrays(); ++i )
     {
-        BOOST_FOREACH ( const thermal::IndexedValue< double > &indexedValue, line )
-            fileConduction << indexedValue.mIndex << ", " << indexedValue.mValue << "; ";
-        fileConduction << std::endl;
+        for ( const thermal::IndexedValue< double > *it = conductivity.Begin( i ); it != conductivity.End( i ); ++it )
+            fileConduction << it->mIndex << ", " << it->mValue << "; ";
+        fileConduction << "\n";
     }
 
     // Output finite volumes coordinates
@@ -164,131 +224,32 @@ int main( int argc, char *argv[] )
                     thermalSimulation->mThermalSystem->GetThermalElements() )
     {
         AllGridVerticesXYZCoordinates << elem->GetGridVertex().GetX() << ", " << elem->GetGridVertex().GetY() << ", "
-                                      << elem->GetGridVertex().GetZ() << std::endl;
+                                      << elem->GetGridVertex().GetZ() << "\n";
     }
     ofstream AllGridVerticesTemperatures( "AllGridVerticesTemperatures.csv" );
+    ThermalResultWriter thermalResultWriter( thermalSimulation.get(), thermalVisualizer.get(),
+                                             electricalSimulation->mSimulationDuration, &AllGridVerticesTemperatures );
 
-    // Equation solvers
-    boost::numeric::odeint::result_of::make_controlled< boost::numeric::odeint::runge_kutta_cash_karp54< vector< double > > >::type stepperThermal =
-     make_controlled( 1.0e-10, 1.0e-10, boost::numeric::odeint::runge_kutta_cash_karp54< vector< double > >() );
-#if defined( _ARMADILLO_ ) && !defined( SPARSE_MATRIX_FORMAT )
-    boost::numeric::odeint::result_of::make_controlled< boost::numeric::odeint::runge_kutta_cash_karp54< myMatrixType > >::type stepperElectrical =
-     make_controlled( 1.0e-10, 1.0e-10, boost::numeric::odeint::runge_kutta_cash_karp54< myMatrixType >() );
-#else
-    boost::numeric::odeint::result_of::make_controlled< boost::numeric::odeint::runge_kutta_cash_karp54< vector< double > > >::type stepperElectrical =
-     make_controlled( 1.0e-10, 1.0e-10, boost::numeric::odeint::runge_kutta_cash_karp54< vector< double > >() );
-    std::vector< double > tmpStateVector( electricalSimulation->mStateSystemGroup.mStateVector.n_rows, 0.0 );
-#endif
 
+    // The step time is the longest coupling interval, shorter ones are chosen if temperatures change fast
+    simulation::CouplingScheduler< double > couplingScheduler( electricalSimulation->mThermalStates,
+                                                               thermalSimulation->GetThermalStateStopCriterion(),
+                                                               stepTime / 100.0, stepTime );
 
-    // Run simulation
-    size_t timeCounter = 0;
 
-    electricalSimulation->mRootTwoPort->SetCurrent( 0.0 );
-    electricalSimulation->UpdateSystem();
-    electricalSimulation->UpdateSystemValues();
-    ( *electricalSimulation->mObserver )( electricalSimulation->mTime );
-
-    double currentChangeTime = 0.0;
+    // Run simulation
     ( *thermalVisualizer )( thermalSimulation->mTime );
-    while ( electricalSimulation->CheckIfSumlationTimeHasNotEndedAndSetStepStartTime() )
-    {
-        // Current profile
-        if ( electricalSimulation->mTime >= currentChangeTime )
-        {
-            currentProfile->SetTimeAndTriggerEvaluation( electricalSimulation->mTime );
-            electricalSimulation->mRootTwoPort->SetCurrent( currentProfile->GetValue() );
-            currentChangeTime = currentProfile->GetTimeUntilMaxValueDeviation( 0.0 );
-        }
-
-
-        // Initialize block Observer
-        electricalSimulation->ResetAllThermalStatesPowerDissipation();
-        electricalSimulation->InitializeStopCriterion();
-        while ( electricalSimulation->CheckLoopConditionAndSetDeltaTime( currentChangeTime ) &&
-                !electricalSimulation->IsStopCriterionFulfilled() )
-        {
-            electricalSimulation->UpdateSystem();
-#if defined( _ARMADILLO_ ) && !defined( SPARSE_MATRIX_FORMAT )
-            // Run electrical equation solver
-            myMatrixType state = electricalSimulation->mStateSystemGroup.mStateVector.submat(
-             0, 0, electricalSimulation->mStateSystemGroup.mStateVector.n_rows - 2, 0 );
-            electricalSimulation->mStateSystemGroup.mDt = electricalSimulation->mDeltaTime;
-            while ( stepperElectrical.try_step( boost::ref( *electricalSimulation->mEqSystem ), state, electricalSimulation->mTime,
-                                                electricalSimulation->mDeltaTime ) != boost::numeric::odeint::success )
-            {
-                electricalSimulation->mStateSystemGroup.mStateVector.submat(
-                 0, 0, electricalSimulation->mStateSystemGroup.mStateVector.n_rows - 2, 0 ) = state;
-                electricalSimulation->mStateSystemGroup.mDt = electricalSimulation->mDeltaTime;
-            }
-#else
-            // Run electrical equation solver
-            misc::FastCopyMatrix( &tmpStateVector[0], electricalSimulation->mStateSystemGroup.mStateVector, tmpStateVector.size() );
-            electricalSimulation->mStateSystemGroup.mDt = electricalSimulation->mDeltaTime;
-            while ( stepperElectrical.try_step( boost::ref( *electricalSimulation->mEqSystem ), tmpStateVector,
-                                                electricalSimulation->mTime,
-                                                electricalSimulation->mDeltaTime ) != boost::numeric::odeint::success )
-            {
-                electricalSimulation->mStateSystemGroup.mDt = electricalSimulation->mDeltaTime;
-            }
-            misc::FastCopyMatrix( electricalSimulation->mStateSystemGroup.mStateVector, &tmpStateVector[0], tmpStateVector.size() );
-#endif
-
-            electricalSimulation->UpdateSystemValues();
-            electricalSimulation->UpdateAllThermalStatesPowerDissipation();
-            ( *electricalSimulation->mObserver )( electricalSimulation->mTime );
-            electricalSimulation->SaveStatesForLaterReset();
-        }
-
-
-        // Thermal simulation
-        thermalSimulation->InitializeStopCriterion();
-        while ( thermalSimulation->CheckLoopConditionAndSetDeltaTime( electricalSimulation->mTime ) )
-        {
-            // Handle stop criterion
-            if ( thermalSimulation->IsStopCriterionFulfilled() )
-            {
-                printf( "Temperature stop criterion triggered at %.0f sec, electrical states reset\n", thermalSimulation->mTime );
-                electricalSimulation->ResetStatesToPointOfTime( thermalSimulation->mTime );
-                break;
-            }
-
-            // Run thermal equation solver
-            while ( stepperThermal.try_step( boost::ref( *thermalSimulation->mThermalSystem ),
-                                             thermalSimulation->mTemperatures, thermalSimulation->mTime,
-                                             thermalSimulation->mDeltaTime ) != boost::numeric::odeint::success )
-            {
-            }
-
-            thermalSimulation->UpdateSystem();
-
-            if ( thermalSimulation->mTime >= electricalSimulation->mSimulationDuration / 1000.0 * timeCounter )
-            {
-                // Write simulation data to file
-                ++timeCounter;
-                ( *thermalVisualizer )( thermalSimulation->mTime );
-
-                // Output finite volumes temperatures
-                AllGridVerticesTemperatures << thermalSimulation->mTime;
-                BOOST_FOREACH ( const boost::shared_ptr< thermal::ThermalElement<> > &elem,
-                                thermalSimulation->mThermalSystem->GetThermalElements() )
-                {
-                    AllGridVerticesTemperatures << ", " << elem->GetTemperature();
-                }
-                AllGridVerticesTemperatures << std::endl;
-
-                // Output simulation progress to console during program is running
-                printf( "%.2f, ", std::ceil( static_cast< int >( electricalSimulation->mTime * 100.0 + 0.5 ) ) / 100.0 );
-            }
-
-            thermalSimulation->UpdateAllThermalStatesTemperatures();
-        }
-
-        // Finish step
-        electricalSimulation->FinshStep();
-    }
+    simulation::CouplingDriver< simulation::ElectricalStepper< myMatrixType >, simulation::ThermalStepper< myMatrixType > >
+     couplingDriver( electricalSimulation.get(), thermalSimulation.get(), &couplingScheduler );
+    simulation::CurrentProfileInput< myMatrixType > currentInput( electricalSimulation.get(), currentProfile.get() );
+    ResetPrinter resetPrinter;
+    couplingDriver.Run( currentInput, thermalResultWriter, resetPrinter );
+    thermalResultWriter.Flush();
 
     // Sucessful exit
+    printf( "\n%lu of %lu coupling intervals have been reset\n",
+            static_cast< unsigned long >( couplingScheduler.GetNumberOfResets() ),
+            static_cast< unsigned long >( couplingScheduler.GetNumberOfIntervals() ) );
     printf( "Run was succesful\n" );
     return EXIT_SUCCESS;
 }